@@ -98,11 +98,14 @@
 #include <QTranslator>
 #include <QWindow>
 
+#include "HardwareInfo.h"
 #include "InstanceList.h"
+#include "LogSink.h"
 #include "MTPixmapCache.h"
 
 #include <minecraft/auth/AccountList.h>
 #include "icons/IconList.h"
+#include "modplatform/helpers/HashCache.h"
 #include "net/HttpMetaCache.h"
 
 #include "java/JavaUtils.h"
@@ -115,6 +118,8 @@
 
 #include "settings/INISettingsObject.h"
 #include "settings/Setting.h"
+#include "tasks/Executor.h"
+#include "tasks/TaskTrace.h"
 
 #include "meta/Index.h"
 #include "translations/TranslationsModel.h"
@@ -155,16 +160,11 @@ namespace {
 /** This is used so that we can output to the log file in addition to the CLI. */
 void appDebugOutput(QtMsgType type, const QMessageLogContext& context, const QString& msg)
 {
-    static std::mutex loggerMutex;
-    const std::lock_guard<std::mutex> lock(loggerMutex);  // synchronized, QFile logFile is not thread-safe
-
     QString out = qFormatLogMessage(type, context, msg);
     out += QChar::LineFeed;
 
-    APPLICATION->logFile->write(out.toUtf8());
-    APPLICATION->logFile->flush();
-    QTextStream(stderr) << out.toLocal8Bit();
-    fflush(stderr);
+    // the sink writes on its own thread, only wait for it when we are about to abort
+    APPLICATION->logSink->write(std::move(out), type == QtFatalMsg);
 }
 
 }  // namespace
@@ -213,7 +213,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
           { { "a", "profile" }, "Use the account specified by its profile name (only valid in combination with --launch)", "profile" },
           { "alive", "Write a small '" + liveCheckFile + "' file after the launcher starts" },
           { { "I", "import" }, "Import instance from specified zip (local path or URL)", "file" },
-          { "show", "Opens the window for the specified instance (by instance ID)", "show" } });
+          { "show", "Opens the window for the specified instance (by instance ID)", "show" },
+          { "trace-tasks", "Record the timing and I/O of every task and write it as a Chrome trace to the given file on exit", "file" } });
     parser.addHelpOption();
     parser.addVersionOption();
 
@@ -226,6 +227,10 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
 
     m_instanceIdToShowWindowOf = parser.value("show");
 
+    if (parser.isSet("trace-tasks")) {
+        m_taskTracePath = QFileInfo(parser.value("trace-tasks")).absoluteFilePath();
+    }
+
     for (auto zip_path : parser.values("import")) {
         m_zipsToImport.append(QUrl::fromLocalFile(QFileInfo(zip_path).absoluteFilePath()));
     }
@@ -373,11 +378,8 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
                     moveFile(oldName, logBase.arg(i));
         }
 
-        for (auto i = 4; i > 0; i--)
-            moveFile(logBase.arg(i - 1), logBase.arg(i));
-
-        logFile = std::unique_ptr<QFile>(new QFile(logBase.arg(0)));
-        if (!logFile->open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        logSink = std::make_unique<LogSink>(logBase, 5);
+        if (!logSink->open()) {
             showFatalErrorMessage("The launcher data folder is not writable!",
                                   QString("The launcher couldn't create a log file - the data folder is not writable.\n"
                                           "\n"
@@ -707,6 +709,16 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_settings->registerSetting("ModrinthToken", "");
         m_settings->registerSetting("UserAgentOverride", "");
 
+        // Diagnostics
+        m_settings->registerSetting("RecordTaskTrace", false);
+        if (m_taskTracePath.isEmpty() && m_settings->get("RecordTaskTrace").toBool()) {
+            m_taskTracePath = FS::PathCombine("logs", "task-trace.json");
+        }
+        if (!m_taskTracePath.isEmpty()) {
+            qDebug() << "Recording a task trace to" << m_taskTracePath;
+            TaskTrace::instance().setEnabled(true);
+        }
+
         // Init page provider
         {
             m_globalSettingsProvider = std::make_shared<GenericPageProvider>(tr("Settings"));
@@ -825,9 +837,18 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
         m_metacache->addBase("icons", QDir("cache/icons").absolutePath());
         m_metacache->addBase("meta", QDir("meta").absolutePath());
         m_metacache->Load();
+
+        m_hashCache.reset(new Hashing::HashCache("cache/hashes.json"));
+        m_hashCache->Load();
         qDebug() << "<> Cache initialized.";
     }
 
+    // every launch prints this, get it out of the way now
+    {
+        m_hardwareInfo.reset(new HardwareInfo::Provider("/", QDir("cache").absoluteFilePath("hardware.json")));
+        m_hardwareInfo->prefetch();
+    }
+
     // now we have network, download translation updates
     m_translations->downloadIndex();
 
@@ -852,9 +873,16 @@ Application::Application(int& argc, char** argv) : QApplication(argc, argv)
             // save any remaining instance state
             m_instances->saveNow();
         }
-        if (logFile) {
-            logFile->flush();
-            logFile->close();
+        for (const auto& metrics : Executor::allMetrics()) {
+            qDebug().nospace() << "Executor " << metrics.name << ": " << metrics.completed << " jobs completed, " << metrics.cancelled
+                               << " cancelled, " << metrics.queued << " queued, average wait " << metrics.averageWaitMs << "ms (max "
+                               << metrics.maxWaitMs << "ms), average run " << metrics.averageRunMs << "ms";
+        }
+        if (!m_taskTracePath.isEmpty()) {
+            TaskTrace::instance().save(m_taskTracePath);
+        }
+        if (logSink) {
+            logSink->shutdown();
         }
     });
 
@@ -1421,6 +1449,11 @@ shared_qobject_ptr<HttpMetaCache> Application::metacache()
     return m_metacache;
 }
 
+shared_qobject_ptr<Hashing::HashCache> Application::hashCache()
+{
+    return m_hashCache;
+}
+
 shared_qobject_ptr<QNetworkAccessManager> Application::network()
 {
     return m_network;
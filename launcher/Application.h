@@ -58,6 +58,13 @@ class SetupWizard;
 class GenericPageProvider;
 class QFile;
 class HttpMetaCache;
+class LogSink;
+namespace Hashing {
+class HashCache;
+}
+namespace HardwareInfo {
+class Provider;
+}
 class SettingsObject;
 class InstanceList;
 class AccountList;
@@ -147,6 +154,10 @@ class Application : public QApplication {
 
     shared_qobject_ptr<HttpMetaCache> metacache();
 
+    shared_qobject_ptr<Hashing::HashCache> hashCache();
+
+    HardwareInfo::Provider* hardwareInfo() const { return m_hardwareInfo.get(); }
+
     shared_qobject_ptr<Meta::Index> metadataIndex();
 
     void updateCapabilities();
@@ -235,6 +246,8 @@ class Application : public QApplication {
     shared_qobject_ptr<AccountList> m_accounts;
 
     shared_qobject_ptr<HttpMetaCache> m_metacache;
+    shared_qobject_ptr<Hashing::HashCache> m_hashCache;
+    std::unique_ptr<HardwareInfo::Provider> m_hardwareInfo;
     shared_qobject_ptr<Meta::Index> m_metadataIndex;
 
     std::shared_ptr<SettingsObject> m_settings;
@@ -290,5 +303,6 @@ class Application : public QApplication {
     bool m_liveCheck = false;
     QList<QUrl> m_zipsToImport;
     QString m_instanceIdToShowWindowOf;
-    std::unique_ptr<QFile> logFile;
+    QString m_taskTracePath;
+    std::unique_ptr<LogSink> logSink;
 };
@@ -25,8 +25,6 @@ class DataMigrationTask : public Task {
     virtual void executeTask() override;
 
    protected slots:
-    void dryRunFinished();
-    void dryRunAborted();
     void copyFinished();
     void copyAborted();
 
@@ -36,7 +34,6 @@ class DataMigrationTask : public Task {
     const IPathMatcher::Ptr m_pathMatcher;
 
     FS::copy m_copy;
-    int m_toCopy = 0;
     QFuture<bool> m_copyFuture;
     QFutureWatcher<bool> m_copyFutureWatcher;
 };
@@ -45,13 +45,18 @@
 #include <QDirIterator>
 #include <QFile>
 #include <QFileInfo>
+#include <QMutex>
 #include <QSaveFile>
+#include <QSet>
 #include <QStandardPaths>
 #include <QStorageInfo>
 #include <QTextStream>
 #include <QUrl>
+#include <QtConcurrent>
 #include <QtNetwork>
+#include <functional>
 #include <system_error>
+#include <vector>
 
 #include "DesktopServices.h"
 #include "StringUtils.h"
@@ -102,6 +107,8 @@ namespace fs = ghc::filesystem;
 #include <fcntl.h> /* Definition of FICLONE* constants */
 #include <linux/fs.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #elif defined(Q_OS_MACOS)
 #include <sys/attr.h>
@@ -247,6 +254,8 @@ bool copy::operator()(const QString& offset, bool dryRun)
 {
     using copy_opts = fs::copy_options;
     m_copied = 0;  // reset counter
+    m_bytesCopied = 0;
+    m_bytesTotal = 0;
     m_failedPaths.clear();
 
 // NOTE always deep copy on windows. the alternatives are too messy.
@@ -257,54 +266,101 @@ bool copy::operator()(const QString& offset, bool dryRun)
     auto src = PathCombine(m_src.absolutePath(), offset);
     auto dst = PathCombine(m_dst.absolutePath(), offset);
 
-    std::error_code err;
-
     fs::copy_options opt = copy_opts::none;
 
     // The default behavior is to follow symlinks
     if (!m_followSymlinks)
         opt |= copy_opts::copy_symlinks;
 
-    // Function that'll do the actual copying
-    auto copy_file = [&](QString src_path, QString relative_dst_path) {
+    struct CopyEntry {
+        QString src_path;
+        QString relative_path;
+        qint64 size;
+        bool symlink;
+    };
+    QList<CopyEntry> entries;
+    QSet<QString> dst_dirs;
+
+    auto add_entry = [&](const QFileInfo& info, const QString& relative_dst_path) {
         if (m_matcher && (m_matcher->matches(relative_dst_path) != m_whitelist))
             return;
 
-        auto dst_path = PathCombine(dst, relative_dst_path);
-        if (!dryRun) {
-            ensureFilePathExists(dst_path);
-            fs::copy(StringUtils::toStdString(src_path), StringUtils::toStdString(dst_path), opt, err);
+        bool symlink = !m_followSymlinks && info.isSymLink();
+        qint64 size = symlink ? 0 : info.size();
+        entries.append({ info.filePath(), relative_dst_path, size, symlink });
+        dst_dirs.insert(QFileInfo(PathCombine(dst, relative_dst_path)).path());
+        m_bytesTotal += size;
+    };
+
+    // We can't use copy_opts::recursive because we need to take into account the
+    // blacklisted paths, so we iterate over the source directory once and collect
+    // everything that has to be copied.
+    if (fs::is_directory(StringUtils::toStdString(src))) {
+        QDir src_dir(src);
+        QDirIterator source_it(src, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::Subdirectories);
+
+        while (source_it.hasNext()) {
+            source_it.next();
+            add_entry(source_it.fileInfo(), src_dir.relativeFilePath(source_it.filePath()));
         }
+    } else {
+        add_entry(QFileInfo(src), "");
+    }
+
+    if (dryRun) {
+        m_copied = entries.length();
+        return true;
+    }
+
+    // create the whole directory structure up front instead of once per file
+    QDir root;
+    for (auto& dir : dst_dirs) {
+        if (!root.mkpath(dir))
+            qWarning() << "Failed to create directory:" << dir;
+    }
+
+#if defined(Q_OS_LINUX)
+    // FICLONE fails quickly when unsupported, so just try it and stop after the first failure
+    std::atomic_bool tryClone{ true };
+#else
+    std::atomic_bool tryClone{ canClone(src, dst) };
+#endif
+
+    QMutex failedLock;
+
+    auto copy_entry = [&](const CopyEntry& entry) {
+        auto dst_path = PathCombine(dst, entry.relative_path);
+        std::error_code err;
+
+        if (entry.symlink) {
+            fs::copy(StringUtils::toStdString(entry.src_path), StringUtils::toStdString(dst_path), opt, err);
+        } else {
+            copy_file(entry.src_path, dst_path, tryClone, err);
+        }
+
         if (err) {
             qWarning() << "Failed to copy files:" << QString::fromStdString(err.message());
-            qDebug() << "Source file:" << src_path;
+            qDebug() << "Source file:" << entry.src_path;
             qDebug() << "Destination file:" << dst_path;
-            m_failedPaths.append(dst_path);
-            emit copyFailed(relative_dst_path);
+            {
+                QMutexLocker locker(&failedLock);
+                m_failedPaths.append(dst_path);
+            }
+            emit copyFailed(entry.relative_path);
             return;
         }
         m_copied++;
-        emit fileCopied(relative_dst_path);
+        emit fileCopied(entry.relative_path);
+        emit copyProgress(m_bytesCopied += entry.size, m_bytesTotal);
     };
 
-    // We can't use copy_opts::recursive because we need to take into account the
-    // blacklisted paths, so we iterate over the source directory, and if there's no blacklist
-    // match, we copy the file.
-    QDir src_dir(src);
-    QDirIterator source_it(src, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::Subdirectories);
-
-    while (source_it.hasNext()) {
-        auto src_path = source_it.next();
-        auto relative_path = src_dir.relativeFilePath(src_path);
-
-        copy_file(src_path, relative_path);
+    if (entries.length() == 1) {
+        copy_entry(entries.first());
+    } else {
+        QtConcurrent::blockingMap(entries, copy_entry);
     }
 
-    // If the root src is not a directory, the previous iterator won't run.
-    if (!fs::is_directory(StringUtils::toStdString(src)))
-        copy_file(src, "");
-
-    return err.value() == 0;
+    return m_failedPaths.isEmpty();
 }
 
 /// qDebug print support for the LinkPair struct
@@ -369,68 +425,93 @@ void create_link::make_link_list(const QString& offset)
             if (m_debug)
                 qDebug() << "linking recursively:" << src << "to" << dst << ", max_depth:" << m_max_depth;
             QDir src_dir(src);
-            QDirIterator source_it(src, QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::Subdirectories);
 
-            QStringList linkedPaths;
-
-            while (source_it.hasNext()) {
-                auto src_path = source_it.next();
-                auto relative_path = src_dir.relativeFilePath(src_path);
-
-                if (m_max_depth >= 0 && pathDepth(relative_path) > m_max_depth) {
-                    relative_path = pathTruncate(relative_path, m_max_depth);
-                    src_path = src_dir.filePath(relative_path);
-                    if (linkedPaths.contains(src_path)) {
+            // Walk the tree ourselves instead of listing every file, so that once a directory is at m_max_depth
+            // it gets linked as a whole without descending into it.
+            std::function<void(const QString&, int)> walk = [&](const QString& dir_path, int depth) {
+                QDir dir(dir_path);
+                for (auto& info : dir.entryInfoList(QDir::Filter::Files | QDir::Filter::Hidden)) {
+                    link_file(info.filePath(), src_dir.relativeFilePath(info.filePath()));
+                }
+                for (auto& info : dir.entryInfoList(QDir::Filter::Dirs | QDir::Filter::Hidden | QDir::Filter::NoDotAndDotDot)) {
+                    // QDirIterator did not follow directory symlinks either
+                    if (info.isSymLink())
                         continue;
+                    if (m_max_depth >= 0 && depth >= m_max_depth) {
+                        // only link directories that actually contain files, like the full listing used to
+                        QDirIterator has_files(info.filePath(), QDir::Filter::Files | QDir::Filter::Hidden, QDirIterator::Subdirectories);
+                        if (has_files.hasNext())
+                            link_file(info.filePath(), src_dir.relativeFilePath(info.filePath()));
+                    } else {
+                        walk(info.filePath(), depth + 1);
                     }
                 }
-
-                linkedPaths.append(src_path);
-
-                link_file(src_path, relative_path);
-            }
+            };
+            walk(src, 0);
         }
     }
 }
 
 bool create_link::make_links()
 {
-    for (auto link : m_links_to_make) {
+    // create all the parent folders once, before linking in parallel
+    QSet<QString> dst_dirs;
+    for (auto& link : m_links_to_make)
+        dst_dirs.insert(QFileInfo(link.dst).path());
+    QDir root;
+    for (auto& dir : dst_dirs)
+        root.mkpath(dir);
+
+    std::atomic_bool failed{ false };
+
+    auto make_link = [&](const LinkPair& link) {
+        // stop at the first failure, the caller may retry everything with privileges
+        if (failed)
+            return;
+
         QString src_path = link.src;
         QString dst_path = link.dst;
         auto src_path_std = StringUtils::toStdString(link.src);
         auto dst_path_std = StringUtils::toStdString(link.dst);
+        std::error_code os_err;
 
-        ensureFilePathExists(dst_path);
         if (m_useHardLinks) {
             if (m_debug)
                 qDebug() << "making hard link:" << src_path << "to" << dst_path;
-            fs::create_hard_link(src_path_std, dst_path_std, m_os_err);
+            fs::create_hard_link(src_path_std, dst_path_std, os_err);
         } else if (fs::is_directory(src_path_std)) {
             if (m_debug)
                 qDebug() << "making directory_symlink:" << src_path << "to" << dst_path;
-            fs::create_directory_symlink(src_path_std, dst_path_std, m_os_err);
+            fs::create_directory_symlink(src_path_std, dst_path_std, os_err);
         } else {
             if (m_debug)
                 qDebug() << "making symlink:" << src_path << "to" << dst_path;
-            fs::create_symlink(src_path_std, dst_path_std, m_os_err);
+            fs::create_symlink(src_path_std, dst_path_std, os_err);
         }
 
-        if (m_os_err) {
-            qWarning() << "Failed to link files:" << QString::fromStdString(m_os_err.message());
+        if (os_err) {
+            if (failed.exchange(true))
+                return;
+            m_os_err = os_err;
+            qWarning() << "Failed to link files:" << QString::fromStdString(os_err.message());
             qDebug() << "Source file:" << src_path;
             qDebug() << "Destination file:" << dst_path;
-            qDebug() << "Error category:" << m_os_err.category().name();
-            qDebug() << "Error code:" << m_os_err.value();
-            emit linkFailed(src_path, dst_path, QString::fromStdString(m_os_err.message()), m_os_err.value());
+            qDebug() << "Error category:" << os_err.category().name();
+            qDebug() << "Error code:" << os_err.value();
+            emit linkFailed(src_path, dst_path, QString::fromStdString(os_err.message()), os_err.value());
         } else {
             m_linked++;
             emit fileLinked(src_path, dst_path);
         }
-        if (m_os_err)
-            return false;
+    };
+
+    if (m_links_to_make.length() == 1) {
+        make_link(m_links_to_make.first());
+    } else {
+        QtConcurrent::blockingMap(m_links_to_make, make_link);
     }
-    return true;
+
+    return !failed;
 }
 
 void create_link::runPrivileged(const QString& offset)
@@ -1242,6 +1323,39 @@ bool clone_file(const QString& src, const QString& dst, std::error_code& ec)
     return true;
 }
 
+/**
+ * @brief copy the contents and permissions of a single file from src to dst
+ *
+ */
+bool copy_file(const QString& src, const QString& dst, std::atomic_bool& tryClone, std::error_code& ec)
+{
+    auto src_path = StringUtils::toStdString(QDir::toNativeSeparators(src));
+    auto dst_path = StringUtils::toStdString(QDir::toNativeSeparators(dst));
+
+#if defined(Q_OS_LINUX)
+
+    return linux_copy_file(src_path, dst_path, tryClone, ec);
+
+#else
+
+    if (tryClone) {
+        std::error_code clone_ec;
+#if defined(Q_OS_WIN)
+        if (win_ioctl_clone(src_path, dst_path, clone_ec))
+            return true;
+#elif defined(Q_OS_MACOS)
+        if (macos_bsd_clonefile(src_path, dst_path, clone_ec))
+            return true;
+#endif
+        tryClone = false;
+    }
+
+    fs::copy_file(src_path, dst_path, ec);
+    return !ec;
+
+#endif
+}
+
 #if defined(Q_OS_WIN)
 
 static long RoundUpToPowerOf2(long originalValue, long roundingMultiplePowerOf2)
@@ -1453,6 +1567,118 @@ bool linux_ficlone(const std::string& src_path, const std::string& dst_path, std
     return true;
 }
 
+bool linux_copy_file(const std::string& src_path, const std::string& dst_path, std::atomic_bool& tryClone, std::error_code& ec)
+{
+    int src_fd = open(src_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (src_fd == -1) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        return false;
+    }
+    struct stat src_stat;
+    if (fstat(src_fd, &src_stat) == -1) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        close(src_fd);
+        return false;
+    }
+    int dst_fd = open(dst_path.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, src_stat.st_mode & 07777);
+    if (dst_fd == -1) {
+        ec = std::make_error_code(static_cast<std::errc>(errno));
+        close(src_fd);
+        return false;
+    }
+    // the mode passed to open() is subject to the umask
+    fchmod(dst_fd, src_stat.st_mode & 07777);
+
+    auto fail = [&](int err) {
+        ec = std::make_error_code(static_cast<std::errc>(err));
+        close(src_fd);
+        close(dst_fd);
+        unlink(dst_path.c_str());
+        return false;
+    };
+    // errors meaning "this method does not work here", as opposed to an actual I/O error
+    auto unsupported = [](int err) { return err == ENOSYS || err == EXDEV || err == EINVAL || err == EOPNOTSUPP || err == ENOTTY; };
+
+    bool done = false;
+
+    // 1. reflink
+    if (tryClone) {
+        if (ioctl(dst_fd, FICLONE, src_fd) == 0) {
+            done = true;
+        } else if (unsupported(errno)) {
+            tryClone = false;
+        } else {
+            return fail(errno);
+        }
+    }
+
+    // 2. in kernel copy, without bouncing the data through userspace
+    constexpr size_t chunk_size = 16 * 1024 * 1024;
+    off_t copied = 0;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+    while (!done) {
+        ssize_t n = copy_file_range(src_fd, nullptr, dst_fd, nullptr, chunk_size, 0);
+        if (n > 0) {
+            copied += n;
+        } else if (n == 0) {
+            // some pseudo filesystems report 0 instead of failing, let the next method deal with them
+            done = copied > 0 || src_stat.st_size == 0;
+            break;
+        } else if (copied == 0 && unsupported(errno)) {
+            break;
+        } else if (errno != EINTR) {
+            return fail(errno);
+        }
+    }
+#endif
+    while (!done) {
+        ssize_t n = sendfile(dst_fd, src_fd, nullptr, chunk_size);
+        if (n > 0) {
+            copied += n;
+        } else if (n == 0) {
+            done = copied > 0 || src_stat.st_size == 0;
+            break;
+        } else if (copied == 0 && unsupported(errno)) {
+            break;
+        } else if (errno != EINTR) {
+            return fail(errno);
+        }
+    }
+
+    // 3. plain buffered copy
+    if (!done) {
+        std::vector<char> buffer(1024 * 1024);
+        for (;;) {
+            ssize_t n = read(src_fd, buffer.data(), buffer.size());
+            if (n == 0)
+                break;
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                return fail(errno);
+            }
+            for (ssize_t written = 0; written < n;) {
+                ssize_t w = write(dst_fd, buffer.data() + written, n - written);
+                if (w < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    return fail(errno);
+                }
+                written += w;
+            }
+        }
+    }
+
+    close(src_fd);
+    if (close(dst_fd)) {
+        int err = errno;
+        unlink(dst_path.c_str());
+        ec = std::make_error_code(static_cast<std::errc>(err));
+        return false;
+    }
+    return true;
+}
+
 #elif defined(Q_OS_MACOS)
 
 bool macos_bsd_clonefile(const std::string& src_path, const std::string& dst_path, std::error_code& ec)
@@ -1508,4 +1734,11 @@ uintmax_t hardLinkCount(const QString& path)
     return count;
 }
 
+bool hard_link_file(const QString& src, const QString& dst, std::error_code& ec)
+{
+    fs::create_hard_link(StringUtils::toStdString(QDir::toNativeSeparators(src)), StringUtils::toStdString(QDir::toNativeSeparators(dst)),
+                         ec);
+    return !ec;
+}
+
 }  // namespace FS
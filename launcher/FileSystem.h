@@ -40,6 +40,7 @@
 #include "Exception.h"
 #include "pathmatcher/IPathMatcher.h"
 
+#include <atomic>
 #include <system_error>
 
 #include <QDir>
@@ -110,15 +111,24 @@ class copy : public QObject {
         return *this;
     }
 
+    /**
+     * @brief copies all matched files, in parallel on the global thread pool
+     * @param dryRun only enumerate the files that would be copied, totalCopied() and totalBytes() are filled in
+     */
     bool operator()(bool dryRun = false) { return operator()(QString(), dryRun); }
 
     int totalCopied() { return m_copied; }
     int totalFailed() { return m_failedPaths.length(); }
     QStringList failed() { return m_failedPaths; }
 
+    qint64 totalBytes() { return m_bytesTotal; }
+    qint64 bytesCopied() { return m_bytesCopied; }
+
    signals:
+    // NOTE: these are emitted from the worker threads doing the copy
     void fileCopied(const QString& relativeName);
     void copyFailed(const QString& relativeName);
+    void copyProgress(qint64 bytesCopied, qint64 bytesTotal);
     // TODO: maybe add a "shouldCopy" signal in the future?
 
    private:
@@ -130,7 +140,9 @@ class copy : public QObject {
     bool m_whitelist = false;
     QDir m_src;
     QDir m_dst;
-    int m_copied;
+    std::atomic_int m_copied{ 0 };
+    std::atomic<qint64> m_bytesCopied{ 0 };
+    qint64 m_bytesTotal = 0;
     QStringList m_failedPaths;
 };
 
@@ -248,7 +260,7 @@ class create_link : public QObject {
     QList<LinkResult> m_path_results;
     QList<LinkPair> m_links_to_make;
 
-    int m_linked;
+    std::atomic_int m_linked{ 0 };
     bool m_debug = false;
     std::error_code m_os_err;
 
@@ -501,10 +513,19 @@ class clone : public QObject {
  */
 bool clone_file(const QString& src, const QString& dst, std::error_code& ec);
 
+/**
+ * @brief copy the contents and permissions of a single file from src to dst, dst must not exist yet
+ * Tries, in order, a reflink, an in-kernel copy (copy_file_range/sendfile) and a buffered copy.
+ *
+ * @param tryClone whether to attempt a reflink first, reset to false if the filesystem does not support it
+ */
+bool copy_file(const QString& src, const QString& dst, std::atomic_bool& tryClone, std::error_code& ec);
+
 #if defined(Q_OS_WIN)
 bool win_ioctl_clone(const std::wstring& src_path, const std::wstring& dst_path, std::error_code& ec);
 #elif defined(Q_OS_LINUX)
 bool linux_ficlone(const std::string& src_path, const std::string& dst_path, std::error_code& ec);
+bool linux_copy_file(const std::string& src_path, const std::string& dst_path, std::atomic_bool& tryClone, std::error_code& ec);
 #elif defined(Q_OS_MACOS) || defined(Q_OS_FREEBSD) || defined(Q_OS_OPENBSD)
 bool macos_bsd_clonefile(const std::string& src_path, const std::string& dst_path, std::error_code& ec);
 #endif
@@ -529,4 +550,9 @@ bool canLink(const QString& src, const QString& dst);
 
 uintmax_t hardLinkCount(const QString& path);
 
+/**
+ * @brief hard link a single file from src to dst, dst must not exist yet
+ */
+bool hard_link_file(const QString& src, const QString& dst, std::error_code& ec);
+
 }  // namespace FS
@@ -0,0 +1,512 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "FileWatchService.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QSocketNotifier>
+
+#if defined(Q_OS_LINUX)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+FileWatch::FileWatch(FileWatchService* service, const QString& path, bool recursive, QObject* parent)
+    : QObject(parent), m_service(service), m_path(path), m_recursive(recursive)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(100);
+    connect(&m_timer, &QTimer::timeout, this, &FileWatch::flush);
+}
+
+FileWatch::~FileWatch()
+{
+    if (m_service) {
+        m_service->unwatch(this);
+    }
+}
+
+bool FileWatch::covers(const QString& path) const
+{
+    if (path == m_path) {
+        return true;
+    }
+    if (path.size() <= m_path.size() + 1 || !path.startsWith(m_path) || path.at(m_path.size()) != '/') {
+        return false;
+    }
+    return m_recursive || path.indexOf('/', m_path.size() + 1) == -1;
+}
+
+void FileWatch::post(const FileChange& change)
+{
+    auto append = [this](const FileChange& change) {
+        m_pendingIndex.insert(change.path, m_pending.size());
+        m_pending.append({ change });
+    };
+
+    if (change.kind == FileChange::Rescan) {
+        // covers whatever else happened
+        m_pending.clear();
+        m_pendingIndex.clear();
+        append(change);
+    } else if (change.kind == FileChange::Renamed) {
+        auto old = m_pendingIndex.find(change.oldPath);
+        bool isNew = false;
+        if (old != m_pendingIndex.end()) {
+            isNew = m_pending[*old].change.kind == FileChange::Created;
+            m_pending[*old].dropped = true;
+            m_pendingIndex.erase(old);
+        }
+        const auto moved = isNew ? FileChange{ FileChange::Created, change.path, {} } : change;
+
+        auto it = m_pendingIndex.find(change.path);
+        if (it == m_pendingIndex.end()) {
+            append(moved);
+        } else {
+            // moved over something that already changed, like a file saved through a temporary one
+            auto& pending = m_pending[*it].change;
+            switch (pending.kind) {
+                case FileChange::Created:
+                    pending = moved;
+                    break;
+                case FileChange::Modified:
+                case FileChange::Removed:
+                    // it was there before, so it's been replaced
+                    pending.kind = FileChange::Modified;
+                    if (!isNew) {
+                        append({ FileChange::Removed, change.oldPath, {} });
+                    }
+                    break;
+                case FileChange::Renamed: {
+                    // whatever was moved here first is gone now
+                    const auto replaced = pending.oldPath;
+                    pending = moved;
+                    auto again = m_pendingIndex.find(replaced);
+                    if (again == m_pendingIndex.end()) {
+                        append({ FileChange::Removed, replaced, {} });
+                    } else if (m_pending[*again].change.kind == FileChange::Created) {
+                        // and something new took its place
+                        m_pending[*again].change.kind = FileChange::Modified;
+                    }
+                    break;
+                }
+                case FileChange::Rescan:
+                    break;
+            }
+        }
+    } else {
+        auto it = m_pendingIndex.find(change.path);
+        if (it == m_pendingIndex.end()) {
+            append(change);
+        } else {
+            auto& pending = m_pending[*it];
+            switch (pending.change.kind) {
+                case FileChange::Created:
+                    // created and removed again, there's nothing to tell
+                    if (change.kind == FileChange::Removed) {
+                        pending.dropped = true;
+                        m_pendingIndex.erase(it);
+                    }
+                    break;
+                case FileChange::Modified:
+                    if (change.kind == FileChange::Removed) {
+                        pending.change.kind = FileChange::Removed;
+                    }
+                    break;
+                case FileChange::Removed:
+                    // replaced by something else
+                    if (change.kind != FileChange::Removed) {
+                        pending.change.kind = FileChange::Modified;
+                    }
+                    break;
+                case FileChange::Renamed:
+                    // moved here and removed, so it's just gone from where it was
+                    if (change.kind == FileChange::Removed) {
+                        auto oldPath = pending.change.oldPath;
+                        pending.dropped = true;
+                        m_pendingIndex.erase(it);
+                        append({ FileChange::Removed, oldPath, {} });
+                    }
+                    break;
+                case FileChange::Rescan:
+                    break;
+            }
+        }
+    }
+
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void FileWatch::flush()
+{
+    QList<FileChange> changes;
+    changes.reserve(m_pending.size());
+    for (auto& pending : m_pending) {
+        if (!pending.dropped) {
+            changes.append(pending.change);
+        }
+    }
+    m_pending.clear();
+    m_pendingIndex.clear();
+    if (!changes.isEmpty()) {
+        emit changed(changes);
+    }
+}
+
+FileWatchService::FileWatchService(QObject* parent) : QObject(parent)
+{
+#if defined(Q_OS_LINUX)
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify != -1) {
+        m_notifier = new QSocketNotifier(m_inotify, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated, this, &FileWatchService::readInotify);
+        return;
+    }
+    qWarning() << "Couldn't set up inotify, falling back to QFileSystemWatcher:" << qt_error_string(errno);
+#endif
+    m_fallback = new QFileSystemWatcher(this);
+    connect(m_fallback, &QFileSystemWatcher::directoryChanged, this, &FileWatchService::directoryChanged);
+}
+
+FileWatchService::~FileWatchService()
+{
+    for (auto watch : m_watches) {
+        watch->m_service = nullptr;
+    }
+#if defined(Q_OS_LINUX)
+    if (m_inotify != -1) {
+        ::close(m_inotify);
+    }
+#endif
+}
+
+FileWatchService* FileWatchService::instance()
+{
+    static QPointer<FileWatchService> service;
+    if (!service) {
+        service = new FileWatchService(QCoreApplication::instance());
+    }
+    return service;
+}
+
+FileWatch* FileWatchService::watch(const QString& path, bool recursive, QObject* parent)
+{
+    auto watch = new FileWatch(this, QDir::cleanPath(QFileInfo(path).absoluteFilePath()), recursive, parent);
+    m_watches.append(watch);
+    if (QFileInfo(watch->m_path).isDir()) {
+        if (recursive) {
+            addTree(watch, watch->m_path, false);
+        } else {
+            addDirectory(watch, watch->m_path);
+        }
+    }
+    watch->m_valid = watch->m_directories.contains(watch->m_path);
+    return watch;
+}
+
+void FileWatchService::unwatch(FileWatch* watch)
+{
+    const auto directories = watch->m_directories;
+    for (auto& dir : directories) {
+        removeDirectory(watch, dir);
+    }
+    m_watches.removeOne(watch);
+}
+
+bool FileWatchService::addDirectory(FileWatch* watch, const QString& dir)
+{
+    if (watch->m_directories.contains(dir)) {
+        return true;
+    }
+    auto refs = m_directoryRefs.find(dir);
+    if (refs == m_directoryRefs.end()) {
+        if (!systemAdd(dir)) {
+            return false;
+        }
+        refs = m_directoryRefs.insert(dir, 0);
+    }
+    (*refs)++;
+    watch->m_directories.insert(dir);
+    return true;
+}
+
+void FileWatchService::removeDirectory(FileWatch* watch, const QString& dir)
+{
+    if (!watch->m_directories.remove(dir)) {
+        return;
+    }
+    auto refs = m_directoryRefs.find(dir);
+    if (refs != m_directoryRefs.end() && --(*refs) == 0) {
+        m_directoryRefs.erase(refs);
+        systemRemove(dir);
+    }
+}
+
+void FileWatchService::addTree(FileWatch* watch, const QString& dir, bool reportContents)
+{
+    if (!addDirectory(watch, dir)) {
+        return;
+    }
+    QDirIterator it(dir, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const auto path = it.next();
+        const auto info = it.fileInfo();
+        if (info.isDir() && !info.isSymLink()) {
+            addDirectory(watch, path);
+        }
+        if (reportContents) {
+            watch->post({ FileChange::Created, path, {} });
+        }
+    }
+}
+
+void FileWatchService::removeTree(const QString& dir)
+{
+    const auto prefix = dir + '/';
+    for (auto watch : m_watches) {
+        const auto directories = watch->m_directories;
+        for (auto& directory : directories) {
+            if (directory == dir || directory.startsWith(prefix)) {
+                removeDirectory(watch, directory);
+            }
+        }
+    }
+}
+
+bool FileWatchService::systemAdd(const QString& dir)
+{
+#if defined(Q_OS_LINUX)
+    if (m_inotify != -1) {
+        const uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO |
+                              IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+        const int descriptor = inotify_add_watch(m_inotify, QFile::encodeName(dir).constData(), mask);
+        if (descriptor == -1) {
+            qWarning() << "Failed to watch" << dir << ":" << qt_error_string(errno);
+            return false;
+        }
+        m_descriptorPaths.insert(descriptor, dir);
+        m_pathDescriptors.insert(dir, descriptor);
+        return true;
+    }
+#endif
+    m_listings.insert(dir, list(dir));
+    if (!m_fallback->addPath(dir)) {
+        m_listings.remove(dir);
+        qWarning() << "Failed to watch" << dir;
+        return false;
+    }
+    return true;
+}
+
+void FileWatchService::systemRemove(const QString& dir)
+{
+#if defined(Q_OS_LINUX)
+    if (m_inotify != -1) {
+        auto descriptor = m_pathDescriptors.find(dir);
+        if (descriptor != m_pathDescriptors.end()) {
+            // fails harmlessly if the directory is already gone
+            inotify_rm_watch(m_inotify, *descriptor);
+            m_descriptorPaths.remove(*descriptor);
+            m_pathDescriptors.erase(descriptor);
+        }
+        return;
+    }
+#endif
+    m_fallback->removePath(dir);
+    m_listings.remove(dir);
+}
+
+void FileWatchService::dispatch(const FileChange& change)
+{
+    for (auto watch : m_watches) {
+        const bool seesPath = watch->covers(change.path);
+        if (change.kind != FileChange::Renamed) {
+            if (seesPath) {
+                watch->post(change);
+            }
+            continue;
+        }
+        // a move into or out of what the watch sees is a creation or removal to it
+        const bool seesOldPath = watch->covers(change.oldPath);
+        if (seesPath && seesOldPath) {
+            watch->post(change);
+        } else if (seesOldPath) {
+            watch->post({ FileChange::Removed, change.oldPath, {} });
+        } else if (seesPath) {
+            watch->post({ FileChange::Created, change.path, {} });
+        }
+    }
+}
+
+void FileWatchService::created(const QString& path, bool isDir)
+{
+    dispatch({ FileChange::Created, path, {} });
+    if (isDir) {
+        for (auto watch : m_watches) {
+            if (watch->m_recursive && watch->covers(path)) {
+                addTree(watch, path, true);
+            }
+        }
+    }
+}
+
+void FileWatchService::removed(const QString& path, bool isDir)
+{
+    if (isDir) {
+        removeTree(path);
+    }
+    dispatch({ FileChange::Removed, path, {} });
+}
+
+void FileWatchService::renamed(const QString& oldPath, const QString& path, bool isDir)
+{
+    if (isDir) {
+        removeTree(oldPath);
+    }
+    dispatch({ FileChange::Renamed, path, oldPath });
+    if (isDir) {
+        for (auto watch : m_watches) {
+            if (watch->m_recursive && watch->covers(path)) {
+                addTree(watch, path, true);
+            }
+        }
+    }
+}
+
+#if defined(Q_OS_LINUX)
+void FileWatchService::readInotify()
+{
+    struct Move {
+        QString path;
+        bool isDir;
+    };
+    // moves are reported as a pair of events with the same cookie, a lone half is a move out of or into what's watched
+    QHash<quint32, Move> moves;
+
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    for (;;) {
+        const auto length = ::read(m_inotify, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const auto event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (auto watch : m_watches) {
+                    watch->post({ FileChange::Rescan, watch->m_path, {} });
+                }
+                continue;
+            }
+
+            const auto dir = m_descriptorPaths.value(event->wd);
+            if (dir.isEmpty()) {
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                m_descriptorPaths.remove(event->wd);
+                if (m_pathDescriptors.value(dir, -1) == event->wd) {
+                    m_pathDescriptors.remove(dir);
+                }
+                continue;
+            }
+
+            const auto path = event->len ? dir + '/' + QFile::decodeName(event->name) : dir;
+            const bool isDir = event->mask & IN_ISDIR;
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                // the parent directory reports this too, unless the directory is the root of a watch
+                for (auto watch : m_watches) {
+                    if (watch->m_path == path) {
+                        watch->post({ FileChange::Removed, path, {} });
+                    }
+                }
+            } else if (event->mask & IN_MOVED_FROM) {
+                moves.insert(event->cookie, { path, isDir });
+            } else if (event->mask & IN_MOVED_TO) {
+                auto from = moves.find(event->cookie);
+                if (from != moves.end()) {
+                    renamed(from->path, path, isDir);
+                    moves.erase(from);
+                } else {
+                    created(path, isDir);
+                }
+            } else if (event->mask & IN_CREATE) {
+                created(path, isDir);
+            } else if (event->mask & IN_DELETE) {
+                removed(path, isDir);
+            } else if (!isDir && (event->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB))) {
+                dispatch({ FileChange::Modified, path, {} });
+            }
+        }
+    }
+    for (auto& move : moves) {
+        removed(move.path, move.isDir);
+    }
+}
+#endif
+
+FileWatchService::Listing FileWatchService::list(const QString& dir)
+{
+    Listing listing;
+    for (auto& info : QDir(dir).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden | QDir::System)) {
+        listing.insert(info.fileName(), { info.isDir() && !info.isSymLink(), info.size(), info.lastModified().toMSecsSinceEpoch() });
+    }
+    return listing;
+}
+
+void FileWatchService::directoryChanged(const QString& dir)
+{
+    if (!m_listings.contains(dir)) {
+        return;
+    }
+    if (!QFileInfo(dir).isDir()) {
+        // the parent directory reports this, unless the directory is the root of a watch
+        for (auto watch : m_watches) {
+            if (watch->m_path == dir) {
+                watch->post({ FileChange::Removed, dir, {} });
+            }
+        }
+        return;
+    }
+
+    const auto previous = m_listings.value(dir);
+    const auto current = list(dir);
+    m_listings.insert(dir, current);
+    for (auto it = previous.cbegin(); it != previous.cend(); ++it) {
+        if (!current.contains(it.key())) {
+            removed(dir + '/' + it.key(), it->isDir);
+        }
+    }
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        auto before = previous.constFind(it.key());
+        if (before == previous.cend()) {
+            created(dir + '/' + it.key(), it->isDir);
+        } else if (!it->isDir && (before->size != it->size || before->modified != it->modified)) {
+            dispatch({ FileChange::Modified, dir + '/' + it.key(), {} });
+        }
+    }
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+
+class QFileSystemWatcher;
+class QSocketNotifier;
+class FileWatchService;
+
+struct FileChange {
+    enum Kind {
+        Created,
+        Modified,
+        Removed,
+        //! path was moved to from oldPath
+        Renamed,
+        //! events were lost, everything below path has to be looked at again
+        Rescan,
+    };
+
+    Kind kind;
+    //! absolute path
+    QString path;
+    QString oldPath;
+
+    bool operator==(const FileChange& other) const { return kind == other.kind && path == other.path && oldPath == other.oldPath; }
+};
+Q_DECLARE_METATYPE(FileChange)
+
+/**
+ * Changes below one path, as handed out by FileWatchService::watch().
+ *
+ * Changes are collected for a short while and then reported together, with the changes to the same path merged: a file that
+ * was created and then written to is only reported as created, and one that was created and removed again isn't reported.
+ * A removed or renamed directory stands for everything that was below it. For a directory that was created or moved in,
+ * everything already inside it is reported as created as well.
+ */
+class FileWatch : public QObject {
+    Q_OBJECT
+   public:
+    ~FileWatch() override;
+
+    QString path() const { return m_path; }
+    bool isRecursive() const { return m_recursive; }
+    //! Whether the path could be watched.
+    bool isValid() const { return m_valid; }
+
+    //! How long changes are collected before they are reported. 100 ms by default.
+    void setDebounce(int msecs) { m_timer.setInterval(msecs); }
+
+    //! Whether the change is below the watched path, or just in it if the watch isn't recursive.
+    bool covers(const QString& path) const;
+
+   signals:
+    void changed(const QList<FileChange>& changes);
+
+   private:
+    friend class FileWatchService;
+    FileWatch(FileWatchService* service, const QString& path, bool recursive, QObject* parent);
+
+    void post(const FileChange& change);
+    void flush();
+
+    QPointer<FileWatchService> m_service;
+    QString m_path;
+    bool m_recursive;
+    bool m_valid = false;
+    //! the directories registered for this watch
+    QSet<QString> m_directories;
+
+    struct Pending {
+        FileChange change;
+        bool dropped = false;
+    };
+    QList<Pending> m_pending;
+    QHash<QString, int> m_pendingIndex;
+    QTimer m_timer;
+};
+
+/**
+ * Watches directories for everyone in the process, so each directory is only registered with the system once no matter
+ * how many models look at it.
+ *
+ * On Linux this is a single inotify instance watching directories, which also covers the files in them. Everywhere else
+ * (or when inotify isn't available) it's a QFileSystemWatcher on the directories, with the changes worked out by comparing
+ * their listings.
+ */
+class FileWatchService : public QObject {
+    Q_OBJECT
+   public:
+    explicit FileWatchService(QObject* parent = nullptr);
+    ~FileWatchService() override;
+
+    //! The one used by the launcher, which lives as long as the application.
+    static FileWatchService* instance();
+
+    /**
+     * Starts watching the path, which should be a directory. The watch stops when it's deleted, which the parent takes
+     * care of otherwise.
+     */
+    FileWatch* watch(const QString& path, bool recursive, QObject* parent = nullptr);
+
+    //! How many directories are registered with the system.
+    int watchedDirectories() const { return m_directoryRefs.size(); }
+
+   private:
+    friend class FileWatch;
+    void unwatch(FileWatch* watch);
+
+    bool addDirectory(FileWatch* watch, const QString& dir);
+    void removeDirectory(FileWatch* watch, const QString& dir);
+    //! Registers dir and everything below it for the watch, optionally reporting what's inside as created.
+    void addTree(FileWatch* watch, const QString& dir, bool reportContents);
+    void removeTree(const QString& dir);
+
+    bool systemAdd(const QString& dir);
+    void systemRemove(const QString& dir);
+
+    void dispatch(const FileChange& change);
+    void created(const QString& path, bool isDir);
+    void removed(const QString& path, bool isDir);
+    void renamed(const QString& oldPath, const QString& path, bool isDir);
+
+    QList<FileWatch*> m_watches;
+    QHash<QString, int> m_directoryRefs;
+
+#if defined(Q_OS_LINUX)
+    void readInotify();
+
+    int m_inotify = -1;
+    QSocketNotifier* m_notifier = nullptr;
+    QHash<int, QString> m_descriptorPaths;
+    QHash<QString, int> m_pathDescriptors;
+#endif
+
+    struct Entry {
+        bool isDir;
+        qint64 size;
+        qint64 modified;
+    };
+    using Listing = QHash<QString, Entry>;
+    static Listing list(const QString& dir);
+    void directoryChanged(const QString& dir);
+
+    QFileSystemWatcher* m_fallback = nullptr;
+    QHash<QString, Listing> m_listings;
+};
@@ -36,6 +36,16 @@
 #include "GZip.h"
 #include <zlib.h>
 #include <QByteArray>
+#include <QtEndian>
+
+#include <limits>
+
+namespace {
+// how much compressed data is held at a time by the streaming reader and writer
+constexpr int bufferSize = 64 * 1024;
+// deflate can't do better than about 1:1032
+constexpr qint64 maxRatio = 1032;
+}  // namespace
 
 bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes)
 {
@@ -44,38 +54,39 @@ bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedByte
         return true;
     }
 
-    unsigned uncompLength = compressedBytes.size();
-    uncompressedBytes.clear();
-    uncompressedBytes.resize(uncompLength);
-
     z_stream strm;
     memset(&strm, 0, sizeof(strm));
     strm.next_in = (Bytef*)compressedBytes.data();
     strm.avail_in = compressedBytes.size();
 
-    bool done = false;
-
     if (inflateInit2(&strm, (16 + MAX_WBITS)) != Z_OK) {
         return false;
     }
 
-    int err = Z_OK;
+    uncompressedBytes.clear();
+    // a gzip member ends with the size of its contents (modulo 4 GiB), which saves growing the output over and over
+    if (compressedBytes.size() >= 18) {
+        qint64 expected = qFromLittleEndian<quint32>(compressedBytes.constData() + compressedBytes.size() - 4);
+        expected = qMin(expected, qMin(compressedBytes.size() * maxRatio, qint64(std::numeric_limits<int>::max() / 2)));
+        uncompressedBytes.reserve(int(expected));
+    }
 
+    char buffer[bufferSize];
+    bool done = false;
     while (!done) {
-        // If our output buffer is too small
-        if (strm.total_out >= uncompLength) {
-            uncompressedBytes.resize(uncompLength * 2);
-            uncompLength *= 2;
-        }
-
-        strm.next_out = reinterpret_cast<Bytef*>((uncompressedBytes.data() + strm.total_out));
-        strm.avail_out = uncompLength - strm.total_out;
+        strm.next_out = reinterpret_cast<Bytef*>(buffer);
+        strm.avail_out = bufferSize;
 
-        // Inflate another chunk.
-        err = inflate(&strm, Z_SYNC_FLUSH);
-        if (err == Z_STREAM_END)
-            done = true;
-        else if (err != Z_OK) {
+        int err = inflate(&strm, Z_NO_FLUSH);
+        uncompressedBytes.append(buffer, bufferSize - strm.avail_out);
+        if (err == Z_STREAM_END) {
+            // concatenated members are one stream, anything else after the end is ignored
+            if (strm.avail_in == 0 || strm.next_in[0] != 0x1f) {
+                done = true;
+            } else if (inflateReset(&strm) != Z_OK) {
+                break;
+            }
+        } else if (err != Z_OK) {
             break;
         }
     }
@@ -83,8 +94,6 @@ bool GZip::unzip(const QByteArray& compressedBytes, QByteArray& uncompressedByte
     if (inflateEnd(&strm) != Z_OK || !done) {
         return false;
     }
-
-    uncompressedBytes.resize(strm.total_out);
     return true;
 }
 
@@ -95,10 +104,6 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
         return true;
     }
 
-    unsigned compLength = qMin(uncompressedBytes.size(), 16);
-    compressedBytes.clear();
-    compressedBytes.resize(compLength);
-
     z_stream zs;
     memset(&zs, 0, sizeof(zs));
 
@@ -109,23 +114,14 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
     zs.next_in = (Bytef*)uncompressedBytes.data();
     zs.avail_in = uncompressedBytes.size();
 
-    int ret;
-    compressedBytes.resize(uncompressedBytes.size());
-
-    unsigned offset = 0;
-    unsigned temp = 0;
-    do {
-        auto remaining = compressedBytes.size() - offset;
-        if (remaining < 1) {
-            compressedBytes.resize(compressedBytes.size() * 2);
-        }
-        zs.next_out = reinterpret_cast<Bytef*>((compressedBytes.data() + offset));
-        temp = zs.avail_out = compressedBytes.size() - offset;
-        ret = deflate(&zs, Z_FINISH);
-        offset += temp - zs.avail_out;
-    } while (ret == Z_OK);
+    // the bound includes the gzip header and trailer, so everything fits in one go
+    compressedBytes.clear();
+    compressedBytes.resize(int(deflateBound(&zs, uncompressedBytes.size())));
+    zs.next_out = reinterpret_cast<Bytef*>(compressedBytes.data());
+    zs.avail_out = compressedBytes.size();
 
-    compressedBytes.resize(offset);
+    int ret = deflate(&zs, Z_FINISH);
+    compressedBytes.resize(int(zs.total_out));
 
     if (deflateEnd(&zs) != Z_OK) {
         return false;
@@ -136,3 +132,198 @@ bool GZip::zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes)
     }
     return true;
 }
+
+GZipReader::GZipReader(QIODevice* source, QObject* parent) : QIODevice(parent), m_source(source), m_stream(new z_stream_s{}) {}
+
+GZipReader::~GZipReader()
+{
+    close();
+}
+
+bool GZipReader::open(OpenMode mode)
+{
+    if ((mode & ReadWrite) != ReadOnly) {
+        setErrorString("GZipReader can only be opened for reading");
+        return false;
+    }
+    if (!m_source->isOpen() && !m_source->open(QIODevice::ReadOnly)) {
+        setErrorString(m_source->errorString());
+        return false;
+    }
+    *m_stream = {};
+    if (inflateInit2(m_stream.get(), (16 + MAX_WBITS)) != Z_OK) {
+        setErrorString("Unable to set up zlib");
+        return false;
+    }
+    m_input.resize(bufferSize);
+    m_finished = false;
+    m_failed = false;
+    return QIODevice::open(mode);
+}
+
+void GZipReader::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+    inflateEnd(m_stream.get());
+    m_input.clear();
+    QIODevice::close();
+}
+
+bool GZipReader::atEnd() const
+{
+    return (m_finished || m_failed) && QIODevice::atEnd();
+}
+
+bool GZipReader::fill()
+{
+    auto length = m_source->read(m_input.data(), bufferSize);
+    if (length < 0) {
+        setErrorString(m_source->errorString());
+        m_failed = true;
+        return false;
+    }
+    m_stream->next_in = reinterpret_cast<Bytef*>(m_input.data());
+    m_stream->avail_in = uInt(length);
+    return length > 0;
+}
+
+qint64 GZipReader::readData(char* data, qint64 maxSize)
+{
+    if (m_failed) {
+        return -1;
+    }
+    if (m_finished) {
+        return 0;
+    }
+    m_stream->next_out = reinterpret_cast<Bytef*>(data);
+    m_stream->avail_out = uInt(qMin<qint64>(maxSize, std::numeric_limits<uInt>::max()));
+    const auto wanted = m_stream->avail_out;
+
+    while (m_stream->avail_out > 0) {
+        if (m_stream->avail_in == 0 && !fill()) {
+            if (!m_failed) {
+                // nothing at all is an empty stream, anything else has been cut short
+                if (m_stream->total_in == 0) {
+                    m_finished = true;
+                } else {
+                    setErrorString("Unexpected end of compressed data");
+                    m_failed = true;
+                }
+            }
+            break;
+        }
+        int err = inflate(m_stream.get(), Z_NO_FLUSH);
+        if (err == Z_STREAM_END) {
+            // another member might follow, anything else after the end is ignored
+            if ((m_stream->avail_in == 0 && !fill()) || m_stream->next_in[0] != 0x1f) {
+                m_finished = !m_failed;
+                break;
+            }
+            inflateReset(m_stream.get());
+        } else if (err != Z_OK && err != Z_BUF_ERROR) {
+            setErrorString(m_stream->msg ? QString::fromUtf8(m_stream->msg) : QString("Corrupt compressed data"));
+            m_failed = true;
+            break;
+        }
+    }
+
+    const qint64 produced = wanted - m_stream->avail_out;
+    if (produced == 0 && m_failed) {
+        return -1;
+    }
+    return produced;
+}
+
+GZipWriter::GZipWriter(QIODevice* target, QObject* parent) : QIODevice(parent), m_target(target), m_stream(new z_stream_s{}) {}
+
+GZipWriter::~GZipWriter()
+{
+    close();
+}
+
+bool GZipWriter::open(OpenMode mode)
+{
+    if ((mode & ReadWrite) != WriteOnly) {
+        setErrorString("GZipWriter can only be opened for writing");
+        return false;
+    }
+    if (!m_target->isOpen() && !m_target->open(QIODevice::WriteOnly)) {
+        setErrorString(m_target->errorString());
+        return false;
+    }
+    *m_stream = {};
+    if (deflateInit2(m_stream.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED, (16 + MAX_WBITS), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        setErrorString("Unable to set up zlib");
+        return false;
+    }
+    m_output.resize(bufferSize);
+    m_finished = false;
+    m_failed = false;
+    return QIODevice::open(mode);
+}
+
+void GZipWriter::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+    finish();
+    m_output.clear();
+    QIODevice::close();
+}
+
+bool GZipWriter::finish()
+{
+    if (!isOpen() || m_finished) {
+        return !m_failed;
+    }
+    m_finished = true;
+    if (!m_failed) {
+        m_failed = !deflateInto(Z_FINISH);
+    }
+    deflateEnd(m_stream.get());
+    return !m_failed;
+}
+
+bool GZipWriter::deflateInto(int flush)
+{
+    for (;;) {
+        m_stream->next_out = reinterpret_cast<Bytef*>(m_output.data());
+        m_stream->avail_out = bufferSize;
+        int ret = deflate(m_stream.get(), flush);
+        if (ret == Z_STREAM_ERROR) {
+            setErrorString("Unable to compress data");
+            return false;
+        }
+        const qint64 produced = bufferSize - m_stream->avail_out;
+        if (produced > 0 && m_target->write(m_output.constData(), produced) != produced) {
+            setErrorString(m_target->errorString());
+            return false;
+        }
+        // all the input is in once there's room left over, and the stream is done once zlib says so
+        if (flush == Z_FINISH ? ret == Z_STREAM_END : m_stream->avail_out != 0) {
+            return true;
+        }
+    }
+}
+
+qint64 GZipWriter::writeData(const char* data, qint64 size)
+{
+    if (m_failed || m_finished) {
+        return -1;
+    }
+    qint64 written = 0;
+    while (written < size) {
+        const auto chunk = qMin<qint64>(size - written, std::numeric_limits<uInt>::max());
+        m_stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + written));
+        m_stream->avail_in = uInt(chunk);
+        if (!deflateInto(Z_NO_FLUSH)) {
+            m_failed = true;
+            return -1;
+        }
+        written += chunk;
+    }
+    return written;
+}
@@ -1,8 +1,73 @@
 #pragma once
 #include <QByteArray>
+#include <QIODevice>
+
+#include <memory>
+
+struct z_stream_s;
 
 class GZip {
    public:
     static bool unzip(const QByteArray& compressedBytes, QByteArray& uncompressedBytes);
     static bool zip(const QByteArray& uncompressedBytes, QByteArray& compressedBytes);
 };
+
+/**
+ * Decompresses a gzip stream read from another device, one fixed-size buffer at a time, so only what's asked for is ever
+ * inflated. Concatenated gzip members are read as one stream.
+ *
+ * Reading fails (returns -1, see errorString()) if the data is corrupt or the source ends before the stream does.
+ */
+class GZipReader : public QIODevice {
+   public:
+    explicit GZipReader(QIODevice* source, QObject* parent = nullptr);
+    ~GZipReader() override;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    bool atEnd() const override;
+
+   protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+   private:
+    bool fill();
+
+    QIODevice* m_source;
+    std::unique_ptr<z_stream_s> m_stream;
+    QByteArray m_input;
+    bool m_finished = false;
+    bool m_failed = false;
+};
+
+/**
+ * Compresses everything written to it as a gzip stream into another device, one fixed-size buffer at a time.
+ * The stream is completed by finish(), or close().
+ */
+class GZipWriter : public QIODevice {
+   public:
+    explicit GZipWriter(QIODevice* target, QObject* parent = nullptr);
+    ~GZipWriter() override;
+
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+
+    //! Writes out the rest of the stream. Returns whether everything made it to the target.
+    bool finish();
+
+   protected:
+    qint64 readData(char*, qint64) override { return -1; }
+    qint64 writeData(const char* data, qint64 size) override;
+
+   private:
+    bool deflateInto(int flush);
+
+    QIODevice* m_target;
+    std::unique_ptr<z_stream_s> m_stream;
+    QByteArray m_output;
+    bool m_finished = false;
+    bool m_failed = false;
+};
@@ -0,0 +1,377 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HardwareInfo.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRegularExpression>
+#include <QSet>
+
+#include "FileSystem.h"
+#include "Json.h"
+#include "tasks/Executor.h"
+
+namespace HardwareInfo {
+
+namespace {
+
+// where distributions put the PCI ID database, relative to the root
+const QStringList PCI_IDS_PATHS = { "usr/share/hwdata/pci.ids", "usr/share/misc/pci.ids", "usr/share/pci.ids",
+                                    "usr/share/pciids/pci.ids" };
+
+QString readFirstLine(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return {};
+    return QString::fromUtf8(file.readLine()).trimmed();
+}
+
+// sysfs has ids like "0x10de", the database has "10de"
+QString pciId(const QString& path)
+{
+    auto id = readFirstLine(path).toLower();
+    if (id.startsWith("0x"))
+        id.remove(0, 2);
+    return id;
+}
+
+QString readCpuModel(const QString& root)
+{
+    QFile cpuinfo(FS::PathCombine(root, "proc/cpuinfo"));
+    if (!cpuinfo.open(QIODevice::ReadOnly | QIODevice::Text))
+        return {};
+    while (!cpuinfo.atEnd()) {
+        const auto line = QString::fromUtf8(cpuinfo.readLine());
+        if (line.startsWith("model name")) {
+            return line.mid(line.indexOf(':') + 1).trimmed();
+        }
+    }
+    return {};
+}
+
+#if defined(Q_OS_FREEBSD)
+QStringList runCommand(const char* command)
+{
+    QStringList lines;
+    // FIXME: fixed size buffers...
+    char buff[512];
+    FILE* output = popen(command, "r");
+    if (!output)
+        return lines;
+    while (fgets(buff, 512, output) != NULL)
+        lines << QString::fromUtf8(buff).trimmed();
+    pclose(output);
+    return lines;
+}
+
+QStringList probeFreeBSD()
+{
+    QStringList log;
+    log << runCommand("sysctl hw.model").value(0);
+
+    QString card;
+    for (auto& line : runCommand("pciconf -lv -a vgapci0")) {
+        if (line.startsWith("vendor") || line.startsWith("device")) {
+            if (!card.isEmpty())
+                card += ' ';
+            card += line.section('\'', 1, 1);
+        }
+    }
+    log << card;
+
+    for (auto& line : runCommand("glxinfo")) {
+        if (line.startsWith("OpenGL version string:")) {
+            log << line;
+            break;
+        }
+    }
+    return log;
+}
+#endif
+
+}  // namespace
+
+QString Report::fingerprint() const
+{
+    QStringList parts{ kernelVersion };
+    for (auto& gpu : gpus) {
+        parts << QString("%1 %2:%3 %4:%5 %6 %7")
+                     .arg(gpu.slot, gpu.vendorId, gpu.deviceId, gpu.subsystemVendorId, gpu.subsystemDeviceId, gpu.driver, gpu.driverVersion);
+    }
+    return parts.join('\n');
+}
+
+QStringList Report::logLines() const
+{
+    QStringList log;
+    if (!cpuModel.isEmpty())
+        log << cpuModel;
+    for (auto& gpu : gpus) {
+        auto vendor = gpu.vendorName.isEmpty() ? QString("Vendor %1").arg(gpu.vendorId) : gpu.vendorName;
+        auto device = gpu.deviceName.isEmpty() ? QString("Device %1").arg(gpu.deviceId) : gpu.deviceName;
+        log << QString("%1 %2 [%3:%4]").arg(vendor, device, gpu.vendorId, gpu.deviceId);
+        if (!gpu.subsystemName.isEmpty())
+            log << QString("\tSubsystem: %1").arg(gpu.subsystemName);
+        if (!gpu.driver.isEmpty()) {
+            if (gpu.driverVersion.isEmpty())
+                log << QString("\tKernel driver in use: %1").arg(gpu.driver);
+            else
+                log << QString("\tKernel driver in use: %1 %2").arg(gpu.driver, gpu.driverVersion);
+        }
+    }
+    log << extraLines;
+    return log;
+}
+
+QJsonObject Report::toJson() const
+{
+    QJsonObject obj;
+    obj["kernelVersion"] = kernelVersion;
+    obj["cpuModel"] = cpuModel;
+    QJsonArray gpuArray;
+    for (auto& gpu : gpus) {
+        QJsonObject gpuObj;
+        gpuObj["slot"] = gpu.slot;
+        gpuObj["vendorId"] = gpu.vendorId;
+        gpuObj["deviceId"] = gpu.deviceId;
+        gpuObj["subsystemVendorId"] = gpu.subsystemVendorId;
+        gpuObj["subsystemDeviceId"] = gpu.subsystemDeviceId;
+        gpuObj["driver"] = gpu.driver;
+        gpuObj["driverVersion"] = gpu.driverVersion;
+        gpuObj["vendorName"] = gpu.vendorName;
+        gpuObj["deviceName"] = gpu.deviceName;
+        gpuObj["subsystemName"] = gpu.subsystemName;
+        gpuArray.append(gpuObj);
+    }
+    obj["gpus"] = gpuArray;
+    return obj;
+}
+
+Report Report::fromJson(const QJsonObject& obj)
+{
+    Report report;
+    report.kernelVersion = Json::ensureString(obj, "kernelVersion");
+    report.cpuModel = Json::ensureString(obj, "cpuModel");
+    for (auto value : Json::ensureArray(obj, "gpus")) {
+        auto gpuObj = Json::ensureObject(value);
+        Gpu gpu;
+        gpu.slot = Json::ensureString(gpuObj, "slot");
+        gpu.vendorId = Json::ensureString(gpuObj, "vendorId");
+        gpu.deviceId = Json::ensureString(gpuObj, "deviceId");
+        gpu.subsystemVendorId = Json::ensureString(gpuObj, "subsystemVendorId");
+        gpu.subsystemDeviceId = Json::ensureString(gpuObj, "subsystemDeviceId");
+        gpu.driver = Json::ensureString(gpuObj, "driver");
+        gpu.driverVersion = Json::ensureString(gpuObj, "driverVersion");
+        gpu.vendorName = Json::ensureString(gpuObj, "vendorName");
+        gpu.deviceName = Json::ensureString(gpuObj, "deviceName");
+        gpu.subsystemName = Json::ensureString(gpuObj, "subsystemName");
+        report.gpus.append(gpu);
+    }
+    return report;
+}
+
+Report readSysfs(const QString& root)
+{
+    Report report;
+    report.kernelVersion = readFirstLine(FS::PathCombine(root, "proc/sys/kernel/osrelease"));
+    report.cpuModel = readCpuModel(root);
+
+    // card0, card1... the entries with a dash in them are the connectors of those cards
+    static const QRegularExpression cardName("^card\\d+$");
+    QDir drm(FS::PathCombine(root, "sys/class/drm"));
+    auto cards = drm.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (auto& card : cards) {
+        if (!cardName.match(card).hasMatch())
+            continue;
+
+        const QString device = FS::PathCombine(drm.absoluteFilePath(card), "device");
+        Gpu gpu;
+        gpu.vendorId = pciId(FS::PathCombine(device, "vendor"));
+        gpu.deviceId = pciId(FS::PathCombine(device, "device"));
+        if (gpu.vendorId.isEmpty() || gpu.deviceId.isEmpty())
+            continue;  // not a PCI device, e.g. a display controller of an ARM board
+        gpu.subsystemVendorId = pciId(FS::PathCombine(device, "subsystem_vendor"));
+        gpu.subsystemDeviceId = pciId(FS::PathCombine(device, "subsystem_device"));
+
+        QFile uevent(FS::PathCombine(device, "uevent"));
+        if (uevent.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            while (!uevent.atEnd()) {
+                const auto line = QString::fromUtf8(uevent.readLine()).trimmed();
+                if (line.startsWith("DRIVER="))
+                    gpu.driver = line.mid(7);
+                else if (line.startsWith("PCI_SLOT_NAME="))
+                    gpu.slot = line.mid(14);
+            }
+        }
+        if (!gpu.driver.isEmpty()) {
+            // only out of tree modules like nvidia have their own version, in tree ones go with the kernel
+            gpu.driverVersion = readFirstLine(FS::PathCombine(root, QString("sys/module/%1/version").arg(gpu.driver)));
+        }
+
+        // render nodes and such can point at the same device again
+        bool seen = false;
+        for (auto& other : report.gpus) {
+            if (!gpu.slot.isEmpty() && other.slot == gpu.slot) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen)
+            report.gpus.append(gpu);
+    }
+    return report;
+}
+
+void resolveNames(Report& report, const QString& root)
+{
+    if (report.gpus.isEmpty())
+        return;
+
+    QFile database;
+    for (auto& path : PCI_IDS_PATHS) {
+        database.setFileName(FS::PathCombine(root, path));
+        if (database.open(QIODevice::ReadOnly | QIODevice::Text))
+            break;
+    }
+    if (!database.isOpen()) {
+        qDebug() << "No PCI ID database found, GPUs will be listed by their IDs only";
+        return;
+    }
+
+    QSet<QString> remainingVendors;
+    for (auto& gpu : report.gpus)
+        remainingVendors.insert(gpu.vendorId);
+
+    // vendors are sorted and not indented, their devices are indented once and subsystems of those twice
+    QString vendor;
+    QString device;
+    while (!database.atEnd()) {
+        const auto line = QString::fromUtf8(database.readLine());
+        if (line.isEmpty() || line.startsWith('#') || line.trimmed().isEmpty())
+            continue;
+
+        int depth = 0;
+        while (depth < line.size() && line.at(depth) == '\t')
+            depth++;
+        const auto content = line.mid(depth).trimmed();
+        const int split = content.indexOf("  ");
+        if (split < 0)
+            continue;
+        const auto id = content.left(split).toLower();
+        const auto name = content.mid(split + 2).trimmed();
+
+        if (depth == 0) {
+            remainingVendors.remove(vendor);
+            // the device classes at the end of the file use the same layout
+            if (remainingVendors.isEmpty() || content.startsWith("C "))
+                break;
+            vendor = id;
+            device.clear();
+            for (auto& gpu : report.gpus) {
+                if (gpu.vendorId == vendor)
+                    gpu.vendorName = name;
+            }
+        } else if (!remainingVendors.contains(vendor)) {
+            continue;
+        } else if (depth == 1) {
+            device = id;
+            for (auto& gpu : report.gpus) {
+                if (gpu.vendorId == vendor && gpu.deviceId == device)
+                    gpu.deviceName = name;
+            }
+        } else if (depth == 2) {
+            for (auto& gpu : report.gpus) {
+                if (gpu.vendorId == vendor && gpu.deviceId == device && id == gpu.subsystemVendorId + ' ' + gpu.subsystemDeviceId)
+                    gpu.subsystemName = name;
+            }
+        }
+    }
+}
+
+Report probe(const QString& root, const QString& cacheFile)
+{
+    auto report = readSysfs(root);
+    const auto fingerprint = report.fingerprint();
+
+    if (!cacheFile.isEmpty()) {
+        QFile cache(cacheFile);
+        if (cache.open(QIODevice::ReadOnly)) {
+            try {
+                auto obj = Json::requireObject(Json::requireDocument(cache.readAll()), "hardware cache");
+                if (Json::ensureString(obj, "fingerprint") == fingerprint) {
+                    auto cached = Report::fromJson(Json::ensureObject(obj, "report"));
+                    // the CPU model is read every time anyway, the names are what's worth keeping
+                    cached.cpuModel = report.cpuModel;
+                    return cached;
+                }
+            } catch (const Json::JsonException& e) {
+                qWarning() << "Failed to read hardware cache:" << e.cause();
+            }
+        }
+    }
+
+    resolveNames(report, root);
+
+    if (!cacheFile.isEmpty()) {
+        QJsonObject obj;
+        obj["fingerprint"] = fingerprint;
+        obj["report"] = report.toJson();
+        try {
+            FS::write(cacheFile, QJsonDocument(obj).toJson(QJsonDocument::Compact));
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Failed to write hardware cache:" << e.cause();
+        }
+    }
+    return report;
+}
+
+Provider::Provider(QString root, QString cacheFile) : m_root(std::move(root)), m_cacheFile(std::move(cacheFile)) {}
+
+void Provider::prefetch()
+{
+    if (m_started)
+        return;
+    m_started = true;
+
+    m_report = Executor::io().run(
+        [root = m_root, cacheFile = m_cacheFile] {
+#if defined(Q_OS_LINUX)
+            return probe(root, cacheFile);
+#elif defined(Q_OS_FREEBSD)
+            Report report;
+            report.extraLines = probeFreeBSD();
+            return report;
+#else
+            return Report();
+#endif
+        },
+        Executor::Priority::Low);
+}
+
+QFuture<Report> Provider::report()
+{
+    prefetch();
+    return m_report;
+}
+
+}  // namespace HardwareInfo
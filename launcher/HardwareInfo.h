@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * The CPU and GPU details printed at the top of every game log.
+ *
+ * On Linux they are read straight from /proc and /sys instead of running lspci and glxinfo, and the
+ * expensive part (looking up names in the PCI ID database) is cached for as long as the kernel, the
+ * devices and their drivers stay the same.
+ */
+namespace HardwareInfo {
+
+struct Gpu {
+    QString slot;
+    QString vendorId;
+    QString deviceId;
+    QString subsystemVendorId;
+    QString subsystemDeviceId;
+    QString driver;
+    QString driverVersion;
+
+    QString vendorName;
+    QString deviceName;
+    QString subsystemName;
+};
+
+struct Report {
+    QString kernelVersion;
+    QString cpuModel;
+    QList<Gpu> gpus;
+    //! lines from other tools, on systems without sysfs
+    QStringList extraLines;
+
+    //! Identifies the hardware and drivers the names were resolved for.
+    QString fingerprint() const;
+
+    QStringList logLines() const;
+
+    QJsonObject toJson() const;
+    static Report fromJson(const QJsonObject& obj);
+};
+
+/** Reads the kernel version, the CPU and the GPUs with their drivers from proc and sys below root, without resolving names. */
+Report readSysfs(const QString& root);
+
+/** Fills in vendor, device and subsystem names from the first PCI ID database found below root. */
+void resolveNames(Report& report, const QString& root);
+
+/** Reads sysfs below root and takes the names from the cache file if it was written for the same hardware, resolving and caching them otherwise. */
+Report probe(const QString& root, const QString& cacheFile);
+
+/** Gathers the report in the background once, for every launch to print. */
+class Provider {
+   public:
+    Provider(QString root, QString cacheFile);
+
+    /** Starts gathering the report, unless that already happened. */
+    void prefetch();
+
+    /** The report, which is being gathered in the background if it isn't ready yet. */
+    QFuture<Report> report();
+
+   private:
+    QString m_root;
+    QString m_cacheFile;
+    QFuture<Report> m_report;
+    bool m_started = false;
+};
+
+}  // namespace HardwareInfo
@@ -1,10 +1,10 @@
 #include "InstanceCopyTask.h"
 #include <QDebug>
-#include <QtConcurrentRun>
 #include "FileSystem.h"
 #include "NullInstance.h"
 #include "pathmatcher/RegexpMatcher.h"
 #include "settings/INISettingsObject.h"
+#include "tasks/Executor.h"
 
 InstanceCopyTask::InstanceCopyTask(InstancePtr origInstance, const InstanceCopyPrefs& prefs)
 {
@@ -54,7 +54,7 @@ void InstanceCopyTask::executeTask()
         return savesCopy();
     };
 
-    m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this, copySaves] {
+    m_copyFuture = Executor::io().run([this, copySaves] {
         if (m_useClone) {
             FS::clone folderClone(m_origInstance->instanceRoot(), m_stagingPath);
             folderClone.matcher(m_matcher.get());
@@ -116,8 +116,12 @@ void InstanceCopyTask::executeTask()
         } else {
             FS::copy folderCopy(m_origInstance->instanceRoot(), m_stagingPath);
             folderCopy.followSymlinks(false).matcher(m_matcher.get());
+            connect(&folderCopy, &FS::copy::copyProgress, this, &InstanceCopyTask::setProgress);
 
-            return folderCopy();
+            bool copied = folderCopy();
+            addBytesRead(folderCopy.bytesCopied());
+            addBytesWritten(folderCopy.bytesCopied());
+            return copied;
         }
     });
     connect(&m_copyFutureWatcher, &QFutureWatcher<bool>::finished, this, &InstanceCopyTask::copyFinished);
@@ -3,6 +3,9 @@
 #include <QDebug>
 #include <QFile>
 
+// what files are renamed to while the update that removes them isn't done
+static const QString removedSuffix = ".update-removed";
+
 InstanceCreationTask::InstanceCreationTask() = default;
 
 void InstanceCreationTask::executeTask()
@@ -43,15 +46,28 @@ void InstanceCreationTask::executeTask()
         setStatus(tr("Removing old conflicting files..."));
         qDebug() << "Removing old files";
 
+        // Everything is moved out of the way first, so that a file which can't be removed leaves the instance as it was.
+        QStringList moved;
         for (auto path : m_files_to_remove) {
             if (!QFile::exists(path))
                 continue;
             qDebug() << "Removing" << path;
-            if (!QFile::remove(path)) {
-                qCritical() << "Couldn't remove the old conflicting files.";
+            auto aside = path + removedSuffix;
+            if (QFile::exists(aside))
+                QFile::remove(aside);
+            if (!QFile::rename(path, aside)) {
+                qCritical() << "Couldn't remove the old conflicting files, restoring" << moved.size() << "of them.";
+                for (auto const& restore : moved)
+                    QFile::rename(restore + removedSuffix, restore);
                 emitFailed(tr("Failed to remove old conflicting files."));
                 return;
             }
+            moved.append(path);
+        }
+
+        for (auto const& path : moved) {
+            if (!QFile::remove(path + removedSuffix))
+                qWarning() << "Couldn't remove" << path + removedSuffix;
         }
     }
 
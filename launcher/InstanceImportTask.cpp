@@ -50,8 +50,8 @@
 #include "modplatform/technic/TechnicPackProcessor.h"
 
 #include "settings/INISettingsObject.h"
+#include "tasks/Executor.h"
 
-#include <QtConcurrentRun>
 #include <algorithm>
 
 #include <quazip/quazipdir.h>
@@ -184,8 +184,8 @@ void InstanceImportTask::processZipPack()
     }
 
     // make sure we extract just the pack
-    m_extractFuture =
-        QtConcurrent::run(QThreadPool::globalInstance(), MMCZip::extractSubDir, m_packZip.get(), root, extractDir.absolutePath());
+    m_extractFuture = Executor::io().run(
+        [zip = m_packZip.get(), root, target = extractDir.absolutePath()] { return MMCZip::extractSubDir(zip, root, target); });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &InstanceImportTask::extractFinished);
     m_extractFutureWatcher.setFuture(m_extractFuture);
 }
@@ -165,7 +165,18 @@ void LaunchController::login()
             return;
         }
 
-        switch (m_accountToUse->accountState()) {
+        auto accountState = m_accountToUse->accountState();
+        if ((accountState == AccountState::Unchecked || accountState == AccountState::Errored) &&
+            m_accountToUse->canLaunchWithStoredToken()) {
+            // the stored token is good for hours, so don't make the user wait for the auth servers and check it in the background
+            qDebug() << "Launching with the stored token of" << m_accountToUse->accountDisplayString() << "and validating it in the background";
+            if (auto task = m_accountToUse->validate()) {
+                task->start();
+            }
+            accountState = AccountState::Online;
+        }
+
+        switch (accountState) {
             case AccountState::Offline: {
                 m_session->wants_online = false;
             }
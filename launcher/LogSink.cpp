@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LogSink.h"
+
+#include <QTextStream>
+
+#include <cstdio>
+
+// NOTE: nothing in here may use qDebug() and friends, we are the thing that handles them.
+
+LogSink::LogSink(QString logPattern, int maxFiles, qint64 maxFileSize)
+    : m_logPattern(std::move(logPattern)), m_maxFiles(maxFiles), m_maxFileSize(maxFileSize), m_head(&m_stub), m_tail(&m_stub)
+{}
+
+LogSink::~LogSink()
+{
+    shutdown();
+
+    // anything that raced with the shutdown
+    while (Node* node = pop()) {
+        if (node != &m_stub)
+            delete node;
+    }
+}
+
+bool LogSink::open()
+{
+    rotate();
+    if (!m_file.isOpen())
+        return false;
+
+    m_running = true;
+    m_writer = std::thread(&LogSink::writerLoop, this);
+    return true;
+}
+
+void LogSink::rotate()
+{
+    if (m_file.isOpen())
+        m_file.close();
+
+    auto moveFile = [](const QString& oldName, const QString& newName) {
+        QFile::remove(newName);
+        QFile::rename(oldName, newName);
+    };
+    for (auto i = m_maxFiles - 1; i > 0; i--)
+        moveFile(m_logPattern.arg(i - 1), m_logPattern.arg(i));
+
+    m_file.setFileName(m_logPattern.arg(0));
+    m_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate);
+}
+
+void LogSink::push(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+LogSink::Node* LogSink::pop()
+{
+    Node* tail = m_tail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &m_stub) {
+        if (!next)
+            return nullptr;
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    if (tail != m_head.load(std::memory_order_acquire)) {
+        // a producer is in the middle of pushing, we'll get it next time
+        return nullptr;
+    }
+    push(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+void LogSink::write(QString message, bool flushNow)
+{
+    if (!m_running) {
+        // not started yet or already shut down, don't lose the message entirely
+        QTextStream(stderr) << message.toLocal8Bit();
+        return;
+    }
+
+    qint64 size = message.size();
+    if (m_pendingBytes.fetch_add(size, std::memory_order_relaxed) + size > maxPendingBytes && !flushNow) {
+        m_pendingBytes.fetch_sub(size, std::memory_order_relaxed);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto node = new Node;
+    node->message = std::move(message);
+    push(node);
+
+    if (flushNow) {
+        std::unique_lock<std::mutex> lock(m_wakeLock);
+        auto ticket = ++m_flushRequests;
+        m_wake.notify_one();
+        m_flushed.wait_for(lock, std::chrono::seconds(5), [this, ticket] { return m_flushesDone >= ticket || !m_running; });
+    }
+}
+
+void LogSink::drain()
+{
+    QByteArray fileBatch;
+    QByteArray errBatch;
+
+    auto dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+        auto note = QString("Log writer fell behind, dropped %1 messages\n").arg(dropped - m_reportedDropped);
+        fileBatch += note.toUtf8();
+        errBatch += note.toLocal8Bit();
+        m_reportedDropped = dropped;
+    }
+
+    while (Node* node = pop()) {
+        m_pendingBytes.fetch_sub(node->message.size(), std::memory_order_relaxed);
+        fileBatch += node->message.toUtf8();
+        errBatch += node->message.toLocal8Bit();
+        if (node != &m_stub)
+            delete node;
+    }
+
+    if (!fileBatch.isEmpty()) {
+        m_file.write(fileBatch);
+        m_file.flush();
+        if (m_maxFileSize > 0 && m_file.size() > m_maxFileSize)
+            rotate();
+    }
+    if (!errBatch.isEmpty()) {
+        fwrite(errBatch.constData(), 1, errBatch.size(), stderr);
+        fflush(stderr);
+    }
+}
+
+void LogSink::writerLoop()
+{
+    while (m_running) {
+        quint64 requested;
+        {
+            std::unique_lock<std::mutex> lock(m_wakeLock);
+            m_wake.wait_for(lock, flushInterval, [this] { return m_flushRequests != m_flushesDone || !m_running; });
+            // everything pushed before these requests is in the queue now
+            requested = m_flushRequests;
+        }
+        drain();
+        if (requested != m_flushesDone) {
+            std::lock_guard<std::mutex> lock(m_wakeLock);
+            m_flushesDone = requested;
+            m_flushed.notify_all();
+        }
+    }
+    drain();
+}
+
+void LogSink::shutdown()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeLock);
+        m_wake.notify_one();
+        m_flushed.notify_all();
+    }
+    if (m_writer.joinable())
+        m_writer.join();
+    m_file.close();
+}
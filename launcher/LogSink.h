@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * Asynchronous backend for the launcher log.
+ *
+ * Any thread can hand messages to write() without taking a lock: they are pushed to a lock-free
+ * multi-producer queue and a background thread writes them to the log file and stderr in batches,
+ * flushing every flushInterval, on fatal messages and on shutdown.
+ *
+ * The log file is rotated once it grows past maxFileSize, keeping maxFiles old logs around.
+ * If the writer falls behind by more than maxPendingBytes, new messages are dropped and counted.
+ */
+class LogSink {
+   public:
+    // logPattern must contain a %0 placeholder for the rotation index, e.g. "logs/Launcher-%0.log"
+    LogSink(QString logPattern, int maxFiles = 5, qint64 maxFileSize = 50 * 1024 * 1024);
+    ~LogSink();
+
+    // rotates the previous logs and opens a fresh log file
+    bool open();
+    QString errorString() const { return m_file.errorString(); }
+
+    // thread-safe and lock-free, blocks until everything is written if flushNow is set
+    void write(QString message, bool flushNow = false);
+
+    // drains the queue, flushes and stops the writer thread. write() after this is a no-op
+    void shutdown();
+
+    quint64 droppedMessages() const { return m_dropped; }
+
+    std::chrono::milliseconds flushInterval{ 500 };
+    qint64 maxPendingBytes = 16 * 1024 * 1024;
+
+   private:
+    struct Node {
+        std::atomic<Node*> next{ nullptr };
+        QString message;
+    };
+
+    void push(Node* node);
+    Node* pop();
+
+    void rotate();
+    void writerLoop();
+    void drain();
+
+   private:
+    QString m_logPattern;
+    int m_maxFiles;
+    qint64 m_maxFileSize;
+    QFile m_file;
+
+    // Vyukov style intrusive MPSC queue, producers push at m_head, the writer thread pops at m_tail
+    Node m_stub;
+    std::atomic<Node*> m_head;
+    Node* m_tail;
+
+    std::atomic<qint64> m_pendingBytes{ 0 };
+    std::atomic<quint64> m_dropped{ 0 };
+    quint64 m_reportedDropped = 0;
+
+    std::atomic_bool m_running{ false };
+    // flush tickets, write(..., true) waits until m_flushesDone catches up with the ticket it took
+    std::atomic<quint64> m_flushRequests{ 0 };
+    std::atomic<quint64> m_flushesDone{ 0 };
+    std::mutex m_wakeLock;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    std::thread m_writer;
+};
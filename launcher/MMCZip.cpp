@@ -39,10 +39,16 @@
 #include <quazip/quazipdir.h>
 #include <quazip/quazipfile.h>
 #include "FileSystem.h"
+#include "ZipReader.h"
+#include "tasks/Executor.h"
 
 #include <QCoreApplication>
 #include <QDebug>
-#include <QtConcurrentRun>
+#include <QSaveFile>
+#include <QUrl>
+#include <QtConcurrent>
+
+#include <atomic>
 
 namespace MMCZip {
 // ours
@@ -386,6 +392,151 @@ bool extractFile(QString fileCompressed, QString file, QString target)
     return extractRelFile(&zip, file, target);
 }
 
+static QFileDevice::Permissions permissionsFromUnixMode(quint32 mode)
+{
+    QFileDevice::Permissions permissions;
+    if (mode & 0400)
+        permissions |= QFileDevice::ReadOwner | QFileDevice::ReadUser;
+    if (mode & 0200)
+        permissions |= QFileDevice::WriteOwner | QFileDevice::WriteUser;
+    if (mode & 0100)
+        permissions |= QFileDevice::ExeOwner | QFileDevice::ExeUser;
+    if (mode & 0040)
+        permissions |= QFileDevice::ReadGroup;
+    if (mode & 0020)
+        permissions |= QFileDevice::WriteGroup;
+    if (mode & 0010)
+        permissions |= QFileDevice::ExeGroup;
+    if (mode & 0004)
+        permissions |= QFileDevice::ReadOther;
+    if (mode & 0002)
+        permissions |= QFileDevice::WriteOther;
+    if (mode & 0001)
+        permissions |= QFileDevice::ExeOther;
+    return permissions;
+}
+
+std::optional<QStringList> extractOverlay(const QStringList& archives,
+                                          const QString& dir,
+                                          std::function<void(qint64, qint64)> progress,
+                                          std::function<bool()> cancelled)
+{
+    struct ArchiveJob {
+        std::unique_ptr<ZipReader> zip;
+        QList<const ZipReader::Entry*> entries;
+        QStringList targets;
+    };
+
+    const auto target_top_dir = QUrl::fromLocalFile(dir);
+    const auto clean_dir = QDir::cleanPath(dir);
+
+    struct Owner {
+        int archive;
+        const ZipReader::Entry* entry;
+        QString name;
+        QString target;
+    };
+
+    // find the archive that writes each path last, only that one needs to extract it
+    std::vector<ArchiveJob> jobs(archives.size());
+    QHash<QString, Owner> owners;
+    for (int i = 0; i < archives.size(); i++) {
+        jobs[i].zip = std::make_unique<ZipReader>(archives[i]);
+        if (!jobs[i].zip->open()) {
+            qWarning() << "Could not open archive for unzipping:" << archives[i];
+            return std::nullopt;
+        }
+        for (const auto& entry : jobs[i].zip->entries()) {
+            auto name = QDir::fromNativeSeparators(entry.name);
+            while (name.startsWith('/'))
+                name.remove(0, 1);
+            if (name.isEmpty())
+                continue;
+            // key by where the entry ends up, so entries like "a//b" and "./a/b" have one owner
+            const auto target_path = FS::PathCombine(dir, name);
+#if defined(Q_OS_WIN) || defined(Q_OS_MAC)
+            owners.insert(target_path.toCaseFolded(), { i, &entry, name, target_path });
+#else
+            owners.insert(target_path, { i, &entry, name, target_path });
+#endif
+        }
+    }
+
+    QSet<QString> folders;
+    qint64 total = 0;
+    for (const auto& owner : owners) {
+        const auto& target_path = owner.target;
+        if (owner.name.endsWith('/') && target_path == clean_dir)
+            continue;
+        if (!target_top_dir.isParentOf(QUrl::fromLocalFile(target_path))) {
+            qWarning() << "Extracting" << owner.name << "was cancelled, because it was effectively outside of the target path" << dir;
+            return std::nullopt;
+        }
+        if (owner.name.endsWith('/')) {
+            folders.insert(target_path);
+            continue;
+        }
+        folders.insert(QFileInfo(target_path).absolutePath());
+
+        auto& job = jobs[owner.archive];
+        job.entries.append(owner.entry);
+        job.targets.append(target_path);
+        total += owner.entry->size;
+    }
+
+    // create the folders up front, so the workers don't race each other creating the same parents
+    for (const auto& folder : folders) {
+        if (!FS::ensureFolderPathExists(folder)) {
+            qWarning() << "Could not create folder" << folder;
+            return std::nullopt;
+        }
+    }
+
+    QList<int> indexes;
+    for (int i = 0; i < int(jobs.size()); i++) {
+        if (!jobs[i].entries.isEmpty())
+            indexes.append(i);
+    }
+
+    std::atomic_bool failed{ false };
+    std::atomic<qint64> written{ 0 };
+    QtConcurrent::blockingMap(indexes, [&](int index) {
+        auto& job = jobs[index];
+        for (int i = 0; i < job.entries.size(); i++) {
+            if (failed || (cancelled && cancelled())) {
+                failed = true;
+                return;
+            }
+            const auto* entry = job.entries[i];
+            const auto& target_path = job.targets[i];
+
+            // streamed, so only a chunk of each entry is in memory at a time
+            QSaveFile file(target_path);
+            if (!file.open(QIODevice::WriteOnly) || !job.zip->extract(*entry, file) || !file.commit()) {
+                qWarning() << "Failed to extract file" << entry->name << "from" << job.zip->path() << "to" << target_path;
+                failed = true;
+                return;
+            }
+
+            if (auto mode = entry->unixMode()) {
+                QFile::setPermissions(target_path, permissionsFromUnixMode(mode) | QFileDevice::ReadOwner | QFileDevice::WriteOwner |
+                                                       QFileDevice::ReadUser | QFileDevice::WriteUser);
+            }
+
+            if (progress)
+                progress(written += entry->size, total);
+        }
+    });
+
+    if (failed)
+        return std::nullopt;
+
+    QStringList extracted;
+    for (const auto& job : jobs)
+        extracted.append(job.targets);
+    return extracted;
+}
+
 bool collectFileListRecursively(const QString& rootDir, const QString& subDir, QFileInfoList* files, FilterFunction excludeFilter)
 {
     QDir rootDirectory(rootDir);
@@ -426,7 +577,8 @@ void ExportToZipTask::executeTask()
 {
     setStatus("Adding files...");
     setProgress(0, m_files.length());
-    m_build_zip_future = QtConcurrent::run(QThreadPool::globalInstance(), [this]() { return exportZip(); });
+    // exports can take a long time, let shorter jobs on the same executor go first
+    m_build_zip_future = Executor::io().run([this]() { return exportZip(); }, Executor::Priority::Low);
     connect(&m_build_zip_watcher, &QFutureWatcher<ZipResult>::finished, this, &ExportToZipTask::finish);
     m_build_zip_watcher.setFuture(m_build_zip_future);
 }
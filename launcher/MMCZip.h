@@ -137,6 +137,24 @@ std::optional<QStringList> extractDir(QString fileCompressed, QString subdir, QS
  */
 bool extractFile(QString fileCompressed, QString file, QString dir);
 
+/**
+ * Extract several archives into a directory, with later archives overwriting the files of earlier ones.
+ *
+ * The central directories are read first to find which archive writes each path last, so the archives
+ * can then be extracted in parallel without racing for the same files. Files keep the permissions stored
+ * in the archive, but are always readable and writable by the current user.
+ *
+ * \param archives The archives, in the order they would be extracted in.
+ * \param dir The directory to extract to.
+ * \param progress Called from the worker threads with the uncompressed bytes written so far, and in total.
+ * \param cancelled Checked before every file, the extraction stops when it returns true.
+ * \return The list of the full paths of the files extracted, std::nullopt on failure or when cancelled.
+ */
+std::optional<QStringList> extractOverlay(const QStringList& archives,
+                                          const QString& dir,
+                                          std::function<void(qint64, qint64)> progress = {},
+                                          std::function<bool()> cancelled = {});
+
 /**
  * Populate a QFileInfoList with a directory tree recursively, while allowing to excludeFilter what shouldn't be included.
  * \param rootDir directory to start off
@@ -1,13 +1,12 @@
 #include "RecursiveFileSystemWatcher.h"
 
 #include <QDebug>
+#include <QFileInfo>
 #include <QRegularExpression>
 
-RecursiveFileSystemWatcher::RecursiveFileSystemWatcher(QObject* parent) : QObject(parent), m_watcher(new QFileSystemWatcher(this))
-{
-    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &RecursiveFileSystemWatcher::fileChange);
-    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &RecursiveFileSystemWatcher::directoryChange);
-}
+#include <algorithm>
+
+RecursiveFileSystemWatcher::RecursiveFileSystemWatcher(QObject* parent) : QObject(parent) {}
 
 void RecursiveFileSystemWatcher::setRootDir(const QDir& root)
 {
@@ -35,7 +34,10 @@ void RecursiveFileSystemWatcher::enable()
         return;
     }
     Q_ASSERT(m_root != QDir::root());
-    addFilesToWatcherRecursive(m_root);
+    m_watch = FileWatchService::instance()->watch(m_root.absolutePath(), true, this);
+    connect(m_watch, &FileWatch::changed, this, &RecursiveFileSystemWatcher::applyChanges);
+    // nothing was watched while disabled
+    setFiles(scanRecursive(m_root));
     m_isEnabled = true;
 }
 void RecursiveFileSystemWatcher::disable()
@@ -44,8 +46,8 @@ void RecursiveFileSystemWatcher::disable()
         return;
     }
     m_isEnabled = false;
-    m_watcher->removePaths(m_watcher->files());
-    m_watcher->removePaths(m_watcher->directories());
+    delete m_watch;
+    m_watch = nullptr;
 }
 
 void RecursiveFileSystemWatcher::setFiles(const QStringList& files)
@@ -56,18 +58,6 @@ void RecursiveFileSystemWatcher::setFiles(const QStringList& files)
     }
 }
 
-void RecursiveFileSystemWatcher::addFilesToWatcherRecursive(const QDir& dir)
-{
-    m_watcher->addPath(dir.absolutePath());
-    for (const QString& directory : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        addFilesToWatcherRecursive(dir.absoluteFilePath(directory));
-    }
-    if (m_watchFiles) {
-        for (const QFileInfo& info : dir.entryInfoList(QDir::Files)) {
-            m_watcher->addPath(info.absoluteFilePath());
-        }
-    }
-}
 QStringList RecursiveFileSystemWatcher::scanRecursive(const QDir& directory)
 {
     QStringList ret;
@@ -86,11 +76,48 @@ QStringList RecursiveFileSystemWatcher::scanRecursive(const QDir& directory)
     return ret;
 }
 
-void RecursiveFileSystemWatcher::fileChange(const QString& path)
+void RecursiveFileSystemWatcher::applyChanges(const QList<FileChange>& changes)
 {
-    emit fileChanged(path);
-}
-void RecursiveFileSystemWatcher::directoryChange(const QString& path)
-{
-    setFiles(scanRecursive(m_root));
+    auto files = m_files;
+    auto removeBelow = [&files](const QString& relPath) {
+        const auto prefix = relPath + '/';
+        files.erase(std::remove_if(files.begin(), files.end(),
+                                   [&](const QString& file) { return file == relPath || file.startsWith(prefix); }),
+                    files.end());
+    };
+    // directories are reported together with everything in them, so only files need to be looked at
+    auto add = [this, &files](const QString& path) {
+        if (!m_matcher || !QFileInfo(path).isFile()) {
+            return;
+        }
+        auto relPath = m_root.relativeFilePath(path);
+        if (m_matcher->matches(relPath) && !files.contains(relPath)) {
+            files.append(relPath);
+        }
+    };
+
+    for (auto& change : changes) {
+        switch (change.kind) {
+            case FileChange::Created:
+                add(change.path);
+                break;
+            case FileChange::Modified:
+                add(change.path);
+                if (m_watchFiles) {
+                    emit fileChanged(change.path);
+                }
+                break;
+            case FileChange::Removed:
+                removeBelow(m_root.relativeFilePath(change.path));
+                break;
+            case FileChange::Renamed:
+                removeBelow(m_root.relativeFilePath(change.oldPath));
+                add(change.path);
+                break;
+            case FileChange::Rescan:
+                files = scanRecursive(m_root);
+                break;
+        }
+    }
+    setFiles(files);
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <QDir>
-#include <QFileSystemWatcher>
+#include "FileWatchService.h"
 #include "pathmatcher/IPathMatcher.h"
 
 class RecursiveFileSystemWatcher : public QObject {
@@ -12,7 +12,7 @@ class RecursiveFileSystemWatcher : public QObject {
     void setRootDir(const QDir& root);
     QDir rootDir() const { return m_root; }
 
-    // WARNING: setting this to true may be bad for performance
+    // emit fileChanged for every file that's written to
     void setWatchFiles(const bool watchFiles);
     bool watchFiles() const { return m_watchFiles; }
 
@@ -34,15 +34,13 @@ class RecursiveFileSystemWatcher : public QObject {
     bool m_isEnabled = false;
     IPathMatcher::Ptr m_matcher;
 
-    QFileSystemWatcher* m_watcher;
+    FileWatch* m_watch = nullptr;
 
     QStringList m_files;
     void setFiles(const QStringList& files);
 
-    void addFilesToWatcherRecursive(const QDir& dir);
     QStringList scanRecursive(const QDir& dir);
 
    private slots:
-    void fileChange(const QString& path);
-    void directoryChange(const QString& path);
+    void applyChanges(const QList<FileChange>& changes);
 };
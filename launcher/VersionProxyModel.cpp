@@ -41,6 +41,14 @@
 #include <QSortFilterProxyModel>
 #include "Application.h"
 
+/**
+ * Filters and sorts the version list against an index of the values involved, which is built once whenever the list is (re)loaded.
+ *
+ * Loader version lists have thousands of entries, so going through QVariant conversions and the filters for every row on
+ * every keystroke makes the search field stall. The index keeps the search keys already case folded, the sort keys and,
+ * per filtered role, which rows the filter accepts, so filtering a row is a lookup. A search that extends the previous one
+ * only has to look at the rows that are still shown.
+ */
 class VersionFilterModel : public QSortFilterProxyModel {
     Q_OBJECT
    public:
@@ -51,29 +59,193 @@ class VersionFilterModel : public QSortFilterProxyModel {
         sort(0, Qt::DescendingOrder);
     }
 
-    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
+    void setSourceModel(QAbstractItemModel* source) override
     {
-        const auto& filters = m_parent->filters();
-        const QString& search = m_parent->search();
-        const QModelIndex idx = sourceModel()->index(source_row, 0, source_parent);
+        for (auto& connection : m_sourceConnections) {
+            disconnect(connection);
+        }
+        m_sourceConnections.clear();
+        // these have to run before the slots of QSortFilterProxyModel, which filter with the index
+        if (source) {
+            m_sourceConnections = {
+                connect(source, &QAbstractItemModel::modelReset, this, &VersionFilterModel::rebuildIndex),
+                connect(source, &QAbstractItemModel::layoutChanged, this, &VersionFilterModel::rebuildIndex),
+                connect(source, &QAbstractItemModel::rowsInserted, this, &VersionFilterModel::rebuildIndex),
+                connect(source, &QAbstractItemModel::rowsRemoved, this, &VersionFilterModel::rebuildIndex),
+                connect(source, &QAbstractItemModel::dataChanged, this, &VersionFilterModel::updateIndex),
+            };
+        }
+        QSortFilterProxyModel::setSourceModel(source);
+        rebuildIndex();
+    }
 
-        if (!search.isEmpty() && !sourceModel()->data(idx, BaseVersionList::VersionRole).toString().contains(search, Qt::CaseInsensitive))
+    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override
+    {
+        if (source_parent.isValid() || source_row < 0 || source_row >= static_cast<int>(m_accepted.size()))
             return false;
+        return m_accepted[source_row];
+    }
 
-        for (auto it = filters.begin(); it != filters.end(); ++it) {
-            auto data = sourceModel()->data(idx, it.key());
-            auto match = data.toString();
-            if (!it.value()->accepts(match)) {
-                return false;
+    bool lessThan(const QModelIndex& source_left, const QModelIndex& source_right) const override
+    {
+        if (!m_hasSortKeys || source_left.row() >= m_sortKeys.size() || source_right.row() >= m_sortKeys.size())
+            return QSortFilterProxyModel::lessThan(source_left, source_right);
+        return m_sortKeys[source_left.row()] < m_sortKeys[source_right.row()];
+    }
+
+    //! All the filters changed, so all their results are evaluated again.
+    void filterChanged()
+    {
+        m_search = m_parent->search().toCaseFolded();
+        m_filterResults.clear();
+        m_columns.clear();
+        for (auto it = m_parent->filters().begin(); it != m_parent->filters().end(); ++it) {
+            evaluateFilter(it.key());
+        }
+        refilter();
+    }
+
+    //! Only the filter for the given role changed.
+    void filterChanged(BaseVersionList::ModelRoles role)
+    {
+        evaluateFilter(role);
+        refilter();
+    }
+
+    void searchChanged()
+    {
+        const auto search = m_parent->search().toCaseFolded();
+        if (search.contains(m_search)) {
+            // rows that didn't contain the previous search can't contain this one either
+            for (int row = 0; row < m_searchKeys.size(); row++) {
+                if (m_accepted[row] && !m_searchKeys[row].contains(search))
+                    m_accepted[row] = false;
+            }
+            m_search = search;
+            invalidateFilter();
+            return;
+        }
+        m_search = search;
+        refilter();
+    }
+
+   private slots:
+    void rebuildIndex()
+    {
+        const auto list = dynamic_cast<BaseVersionList*>(sourceModel());
+        const int rows = list ? list->rowCount(QModelIndex()) : 0;
+
+        m_searchKeys.clear();
+        m_searchKeys.reserve(rows);
+        m_sortKeys.clear();
+        m_hasSortKeys = list && list->providesRoles().contains(BaseVersionList::SortRole);
+        if (m_hasSortKeys)
+            m_sortKeys.reserve(rows);
+        for (int row = 0; row < rows; row++) {
+            const auto idx = list->index(row, 0);
+            m_searchKeys.append(list->data(idx, BaseVersionList::VersionRole).toString().toCaseFolded());
+            if (m_hasSortKeys)
+                m_sortKeys.append(list->data(idx, BaseVersionList::SortRole).toLongLong());
+        }
+
+        m_columns.clear();
+        m_filterResults.clear();
+        for (auto it = m_parent->filters().begin(); it != m_parent->filters().end(); ++it) {
+            evaluateFilter(it.key());
+        }
+        m_search = m_parent->search().toCaseFolded();
+        updateAccepted();
+    }
+
+    void updateIndex(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+    {
+        if (topLeft.parent().isValid())
+            return;
+        const int last = qMin(bottomRight.row(), static_cast<int>(m_searchKeys.size() - 1));
+        for (int row = topLeft.row(); row <= last; row++) {
+            const auto idx = sourceModel()->index(row, 0);
+            m_searchKeys[row] = sourceModel()->data(idx, BaseVersionList::VersionRole).toString().toCaseFolded();
+            if (m_hasSortKeys)
+                m_sortKeys[row] = sourceModel()->data(idx, BaseVersionList::SortRole).toLongLong();
+
+            for (auto it = m_columns.begin(); it != m_columns.end(); ++it) {
+                it.value()[row] = sourceModel()->data(idx, it.key()).toString();
+                const auto filter = m_parent->filters().value(static_cast<BaseVersionList::ModelRoles>(it.key()));
+                if (filter)
+                    m_filterResults[it.key()][row] = filter->accepts(it.value()[row]);
             }
+            m_accepted[row] = acceptsRow(row);
         }
-        return true;
     }
 
-    void filterChanged() { invalidateFilter(); }
+   private:
+    //! Runs the filter for the role over its column, fetching the column from the list the first time it's filtered on.
+    void evaluateFilter(BaseVersionList::ModelRoles role)
+    {
+        const auto filter = m_parent->filters().value(role);
+        if (!filter) {
+            m_filterResults.remove(role);
+            return;
+        }
+
+        const int rows = m_searchKeys.size();
+        auto column = m_columns.find(role);
+        if (column == m_columns.end()) {
+            QStringList values;
+            values.reserve(rows);
+            for (int row = 0; row < rows; row++) {
+                values.append(sourceModel()->data(sourceModel()->index(row, 0), role).toString());
+            }
+            column = m_columns.insert(role, values);
+        }
+
+        std::vector<bool> results(rows);
+        for (int row = 0; row < rows; row++) {
+            results[row] = filter->accepts(column.value().at(row));
+        }
+        m_filterResults.insert(role, std::move(results));
+    }
+
+    bool acceptsRow(int row) const
+    {
+        for (auto it = m_filterResults.begin(); it != m_filterResults.end(); ++it) {
+            if (!it.value()[row])
+                return false;
+        }
+        return m_search.isEmpty() || m_searchKeys[row].contains(m_search);
+    }
+
+    void updateAccepted()
+    {
+        m_accepted.assign(m_searchKeys.size(), false);
+        for (int row = 0; row < m_searchKeys.size(); row++) {
+            m_accepted[row] = acceptsRow(row);
+        }
+    }
+
+    void refilter()
+    {
+        updateAccepted();
+        invalidateFilter();
+    }
 
    private:
     VersionProxyModel* m_parent;
+    QList<QMetaObject::Connection> m_sourceConnections;
+
+    //! case folded VersionRole of every row
+    QStringList m_searchKeys;
+    //! SortRole of every row, if the list provides it
+    QVector<qint64> m_sortKeys;
+    bool m_hasSortKeys = false;
+    //! the values of the roles that are filtered on
+    QHash<int, QStringList> m_columns;
+    //! which rows each filter accepts
+    QHash<int, std::vector<bool>> m_filterResults;
+
+    //! the case folded search m_accepted was computed for
+    QString m_search;
+    std::vector<bool> m_accepted;
 };
 
 VersionProxyModel::VersionProxyModel(QObject* parent) : QAbstractProxyModel(parent)
@@ -374,13 +546,15 @@ void VersionProxyModel::clearFilters()
 void VersionProxyModel::setFilter(const BaseVersionList::ModelRoles column, Filter* f)
 {
     m_filters[column].reset(f);
-    filterModel->filterChanged();
+    filterModel->filterChanged(column);
 }
 
 void VersionProxyModel::setSearch(const QString& search)
 {
+    if (m_search == search)
+        return;
     m_search = search;
-    filterModel->filterChanged();
+    filterModel->searchChanged();
 }
 
 const VersionProxyModel::FilterMap& VersionProxyModel::filters() const
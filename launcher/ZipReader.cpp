@@ -0,0 +1,426 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ZipReader.h"
+
+#include <QCache>
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <zlib.h>
+
+#include <limits>
+
+namespace {
+
+constexpr quint32 LOCAL_HEADER_SIG = 0x04034b50;
+constexpr quint32 CENTRAL_HEADER_SIG = 0x02014b50;
+constexpr quint32 EOCD_SIG = 0x06054b50;
+constexpr quint32 ZIP64_EOCD_SIG = 0x06064b50;
+constexpr quint32 ZIP64_LOCATOR_SIG = 0x07064b50;
+
+constexpr qint64 LOCAL_HEADER_SIZE = 30;
+constexpr qint64 CENTRAL_HEADER_SIZE = 46;
+constexpr qint64 EOCD_SIZE = 22;
+constexpr qint64 ZIP64_LOCATOR_SIZE = 20;
+constexpr qint64 ZIP64_EOCD_SIZE = 56;
+
+// a directory costs one unit per entry, so this keeps the directories of a few thousand typical mods around
+constexpr int CACHE_MAX_COST = 1 << 18;
+
+// how much of an entry is decompressed at once when extracting it
+constexpr qint64 EXTRACT_CHUNK_SIZE = 256 * 1024;
+
+quint16 read16(const uchar* p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+quint32 read32(const uchar* p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+quint64 read64(const uchar* p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+struct CachedDirectory {
+    qint64 size;
+    qint64 mtime;
+    std::shared_ptr<const void> directory;
+};
+
+QMutex s_cacheLock;
+QCache<QString, CachedDirectory> s_cache(CACHE_MAX_COST);
+
+}  // namespace
+
+ZipReader::ZipReader(QString path) : m_path(std::move(path)), m_file(m_path) {}
+
+ZipReader::~ZipReader()
+{
+    close();
+}
+
+bool ZipReader::open()
+{
+    if (isOpen())
+        return true;
+
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    m_size = m_file.size();
+    if (m_size < EOCD_SIZE) {
+        close();
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        // some filesystems don't support mapping, just read it all instead
+        m_buffer = m_file.readAll();
+        if (m_buffer.size() != m_size) {
+            close();
+            return false;
+        }
+        m_data = reinterpret_cast<const uchar*>(m_buffer.constData());
+    }
+
+    const QFileInfo info(m_file);
+    const QString key = info.absoluteFilePath();
+    const qint64 mtime = info.lastModified().toMSecsSinceEpoch();
+    {
+        QMutexLocker locker(&s_cacheLock);
+        if (auto cached = s_cache.object(key); cached && cached->size == m_size && cached->mtime == mtime)
+            m_directory = std::static_pointer_cast<const Directory>(cached->directory);
+    }
+
+    if (!m_directory) {
+        m_directory = parseDirectory();
+        if (!m_directory) {
+            qWarning() << "Could not read the central directory of" << m_path;
+            close();
+            return false;
+        }
+        QMutexLocker locker(&s_cacheLock);
+        s_cache.insert(key, new CachedDirectory{ m_size, mtime, m_directory }, m_directory->entries.size() + 1);
+    }
+    return true;
+}
+
+void ZipReader::close()
+{
+    if (m_data && m_buffer.isNull())
+        m_file.unmap(const_cast<uchar*>(m_data));
+    m_data = nullptr;
+    m_buffer.clear();
+    m_size = 0;
+    m_directory.reset();
+    m_file.close();
+}
+
+void ZipReader::clearCache()
+{
+    QMutexLocker locker(&s_cacheLock);
+    s_cache.clear();
+}
+
+std::shared_ptr<const ZipReader::Directory> ZipReader::parseDirectory() const
+{
+    // the end of central directory record is at the very end, followed only by a comment of up to 64 KiB
+    qint64 eocd = -1;
+    const qint64 lowest = qMax<qint64>(0, m_size - EOCD_SIZE - 0xFFFF);
+    for (qint64 pos = m_size - EOCD_SIZE; pos >= lowest; pos--) {
+        if (read32(m_data + pos) == EOCD_SIG) {
+            eocd = pos;
+            break;
+        }
+    }
+    if (eocd < 0)
+        return nullptr;
+
+    quint64 count = read16(m_data + eocd + 10);
+    quint64 cdSize = read32(m_data + eocd + 12);
+    quint64 cdOffset = read32(m_data + eocd + 16);
+
+    const qint64 locator = eocd - ZIP64_LOCATOR_SIZE;
+    if (locator >= 0 && read32(m_data + locator) == ZIP64_LOCATOR_SIG) {
+        const quint64 zip64Eocd = read64(m_data + locator + 8);
+        if (zip64Eocd + ZIP64_EOCD_SIZE > quint64(m_size) || read32(m_data + zip64Eocd) != ZIP64_EOCD_SIG)
+            return nullptr;
+        count = read64(m_data + zip64Eocd + 32);
+        cdSize = read64(m_data + zip64Eocd + 40);
+        cdOffset = read64(m_data + zip64Eocd + 48);
+    }
+
+    if (cdOffset > quint64(m_size) || cdSize > quint64(m_size) - cdOffset)
+        return nullptr;
+
+    auto directory = std::make_shared<Directory>();
+    directory->entries.reserve(int(qMin<quint64>(count, cdSize / CENTRAL_HEADER_SIZE)));
+
+    const uchar* p = m_data + cdOffset;
+    const uchar* const end = p + cdSize;
+    while (p + CENTRAL_HEADER_SIZE <= end && read32(p) == CENTRAL_HEADER_SIG) {
+        const quint16 nameLength = read16(p + 28);
+        const quint16 extraLength = read16(p + 30);
+        const quint16 commentLength = read16(p + 32);
+        if (p + CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength > end)
+            return nullptr;
+
+        Entry entry;
+        entry.versionMadeBy = read16(p + 4);
+        entry.flags = read16(p + 8);
+        entry.method = read16(p + 10);
+        entry.crc = read32(p + 16);
+        entry.compressedSize = read32(p + 20);
+        entry.size = read32(p + 24);
+        entry.externalAttributes = read32(p + 38);
+        entry.localHeaderOffset = read32(p + 42);
+
+        // names are UTF-8 in practically every jar, whether or not the archiver set the flag for it
+        const auto name = reinterpret_cast<const char*>(p + CENTRAL_HEADER_SIZE);
+        entry.name = QString::fromUtf8(name, nameLength);
+
+        // the zip64 extended information only holds the fields that overflowed, in this order
+        const uchar* extra = p + CENTRAL_HEADER_SIZE + nameLength;
+        const uchar* const extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd) {
+            const quint16 id = read16(extra);
+            const quint16 length = read16(extra + 2);
+            const uchar* field = extra + 4;
+            const uchar* const fieldEnd = qMin(field + length, extraEnd);
+            if (id == 0x0001) {
+                if (entry.size == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                    entry.size = read64(field);
+                    field += 8;
+                }
+                if (entry.compressedSize == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                    entry.compressedSize = read64(field);
+                    field += 8;
+                }
+                if (entry.localHeaderOffset == 0xFFFFFFFF && field + 8 <= fieldEnd) {
+                    entry.localHeaderOffset = read64(field);
+                }
+            }
+            extra += 4 + length;
+        }
+
+        // remember every parent directory, plenty of archives don't store entries for them
+        for (int slash = entry.name.indexOf('/'); slash > 0; slash = entry.name.indexOf('/', slash + 1))
+            directory->dirs.insert(entry.name.left(slash));
+
+        directory->index.insert(entry.name, directory->entries.size());
+        directory->entries.append(std::move(entry));
+
+        p += CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+    }
+
+    return directory;
+}
+
+bool ZipReader::contains(const QString& name) const
+{
+    return entry(name) != nullptr;
+}
+
+bool ZipReader::containsDir(const QString& dir) const
+{
+    if (!m_directory)
+        return false;
+    QString normalized = dir;
+    while (normalized.startsWith('/'))
+        normalized.remove(0, 1);
+    while (normalized.endsWith('/'))
+        normalized.chop(1);
+    if (normalized.isEmpty())
+        return !m_directory->entries.isEmpty();
+    return m_directory->dirs.contains(normalized);
+}
+
+const ZipReader::Entry* ZipReader::entry(const QString& name) const
+{
+    if (!m_directory)
+        return nullptr;
+    auto it = m_directory->index.constFind(name);
+    if (it == m_directory->index.constEnd())
+        return nullptr;
+    return &m_directory->entries.at(*it);
+}
+
+const QList<ZipReader::Entry>& ZipReader::entries() const
+{
+    static const QList<Entry> empty;
+    return m_directory ? m_directory->entries : empty;
+}
+
+QStringList ZipReader::fileNames() const
+{
+    QStringList names;
+    if (!m_directory)
+        return names;
+    names.reserve(m_directory->entries.size());
+    for (const auto& entry : m_directory->entries)
+        names.append(entry.name);
+    return names;
+}
+
+std::optional<QByteArray> ZipReader::read(const QString& name) const
+{
+    auto found = entry(name);
+    if (!found)
+        return {};
+    return read(*found);
+}
+
+const uchar* ZipReader::entryData(const Entry& entry) const
+{
+    if (!isOpen())
+        return nullptr;
+    if (entry.flags & 0x1) {
+        qWarning() << "Encrypted entry" << entry.name << "in" << m_path << "is not supported";
+        return nullptr;
+    }
+
+    const qint64 header = entry.localHeaderOffset;
+    if (header < 0 || header > m_size - LOCAL_HEADER_SIZE || read32(m_data + header) != LOCAL_HEADER_SIG)
+        return nullptr;
+    const qint64 dataOffset = header + LOCAL_HEADER_SIZE + read16(m_data + header + 26) + read16(m_data + header + 28);
+    if (dataOffset > m_size || entry.compressedSize > m_size - dataOffset)
+        return nullptr;
+    return m_data + dataOffset;
+}
+
+std::optional<QByteArray> ZipReader::read(const Entry& entry) const
+{
+    const uchar* data = entryData(entry);
+    if (!data)
+        return {};
+    if (entry.size > std::numeric_limits<int>::max() / 2) {
+        qWarning() << "Entry" << entry.name << "in" << m_path << "is too big to be read into memory";
+        return {};
+    }
+
+    if (entry.size == 0)
+        return QByteArray("");
+
+    QByteArray result;
+    switch (entry.method) {
+        case 0:  // stored
+            if (entry.compressedSize != entry.size)
+                return {};
+            result = QByteArray(reinterpret_cast<const char*>(data), int(entry.size));
+            break;
+        case 8: {  // deflated
+            result.resize(int(entry.size));
+
+            z_stream stream{};
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                return {};
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = uInt(entry.compressedSize);
+            stream.next_out = reinterpret_cast<Bytef*>(result.data());
+            stream.avail_out = uInt(entry.size);
+            const int status = inflate(&stream, Z_FINISH);
+            inflateEnd(&stream);
+            if (status != Z_STREAM_END || stream.total_out != uLong(entry.size))
+                return {};
+            break;
+        }
+        default:
+            qWarning() << "Unsupported compression method" << entry.method << "for" << entry.name << "in" << m_path;
+            return {};
+    }
+
+    if (crc32(0L, reinterpret_cast<const Bytef*>(result.constData()), uInt(result.size())) != entry.crc) {
+        qWarning() << "CRC mismatch for" << entry.name << "in" << m_path;
+        return {};
+    }
+    return result;
+}
+
+bool ZipReader::extract(const Entry& entry, QIODevice& out) const
+{
+    const uchar* data = entryData(entry);
+    if (!data)
+        return false;
+
+    uLong crc = crc32(0L, Z_NULL, 0);
+    switch (entry.method) {
+        case 0: {  // stored
+            if (entry.compressedSize != entry.size)
+                return false;
+            for (qint64 done = 0; done < entry.size;) {
+                const qint64 length = qMin(EXTRACT_CHUNK_SIZE, entry.size - done);
+                crc = crc32(crc, data + done, uInt(length));
+                if (out.write(reinterpret_cast<const char*>(data + done), length) != length)
+                    return false;
+                done += length;
+            }
+            break;
+        }
+        case 8: {  // deflated
+            z_stream stream{};
+            if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+                return false;
+            QByteArray buffer(int(EXTRACT_CHUNK_SIZE), Qt::Uninitialized);
+            qint64 consumed = 0;
+            qint64 produced = 0;
+            int status = Z_OK;
+            while (status == Z_OK) {
+                // the input is mapped, but zlib only takes so much of it at once
+                if (stream.avail_in == 0 && consumed < entry.compressedSize) {
+                    const qint64 length = qMin(EXTRACT_CHUNK_SIZE, entry.compressedSize - consumed);
+                    stream.next_in = const_cast<Bytef*>(data + consumed);
+                    stream.avail_in = uInt(length);
+                    consumed += length;
+                }
+                stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+                stream.avail_out = uInt(buffer.size());
+                status = inflate(&stream, Z_NO_FLUSH);
+                if (status != Z_OK && status != Z_STREAM_END)
+                    break;
+
+                const qint64 length = buffer.size() - stream.avail_out;
+                crc = crc32(crc, reinterpret_cast<const Bytef*>(buffer.constData()), uInt(length));
+                produced += length;
+                if (out.write(buffer.constData(), length) != length) {
+                    inflateEnd(&stream);
+                    return false;
+                }
+            }
+            inflateEnd(&stream);
+            if (status != Z_STREAM_END || produced != entry.size)
+                return false;
+            break;
+        }
+        default:
+            qWarning() << "Unsupported compression method" << entry.method << "for" << entry.name << "in" << m_path;
+            return false;
+    }
+
+    if (crc != entry.crc) {
+        qWarning() << "CRC mismatch for" << entry.name << "in" << m_path;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+
+/**
+ * Read-only zip archive reader for the many small lookups done while parsing mods and packs.
+ *
+ * The archive is memory mapped, and its parsed central directory is kept in a process-wide cache
+ * (invalidated by file size and modification time), so opening the same jar again for a different
+ * entry does not parse the directory again. Only stored and deflated entries are supported.
+ */
+class ZipReader {
+   public:
+    struct Entry {
+        QString name;
+        quint16 flags = 0;
+        quint16 method = 0;
+        quint32 crc = 0;
+        qint64 compressedSize = 0;
+        qint64 size = 0;
+        qint64 localHeaderOffset = 0;
+        quint16 versionMadeBy = 0;
+        quint32 externalAttributes = 0;
+
+        bool isDir() const { return name.endsWith('/'); }
+        /** The unix permission bits stored by the archiver, or 0 if it didn't store any. */
+        quint32 unixMode() const { return (versionMadeBy >> 8) == 3 ? (externalAttributes >> 16) & 07777 : 0; }
+    };
+
+    explicit ZipReader(QString path);
+    ~ZipReader();
+
+    ZipReader(const ZipReader&) = delete;
+    ZipReader& operator=(const ZipReader&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    QString path() const { return m_path; }
+
+    bool contains(const QString& name) const;
+    /** Whether any entry lives below the given directory. Leading and trailing slashes are ignored. */
+    bool containsDir(const QString& dir) const;
+    /** Returns nullptr if there is no such entry. */
+    const Entry* entry(const QString& name) const;
+    const QList<Entry>& entries() const;
+    QStringList fileNames() const;
+
+    /** Decompresses the given entry, or returns std::nullopt if it is missing or could not be read. */
+    std::optional<QByteArray> read(const QString& name) const;
+    std::optional<QByteArray> read(const Entry& entry) const;
+    /** Decompresses the given entry into `out` a chunk at a time, so entries of any size can be extracted. */
+    bool extract(const Entry& entry, QIODevice& out) const;
+
+    /** Drops every cached central directory. */
+    static void clearCache();
+
+   private:
+    struct Directory {
+        QList<Entry> entries;
+        QHash<QString, int> index;
+        QSet<QString> dirs;
+    };
+
+    std::shared_ptr<const Directory> parseDirectory() const;
+    /** The compressed data of the entry, or nullptr if it can't be read. */
+    const uchar* entryData(const Entry& entry) const;
+
+    QString m_path;
+    QFile m_file;
+    QByteArray m_buffer;  // fallback when the file can't be mapped
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    std::shared_ptr<const Directory> m_directory;
+};
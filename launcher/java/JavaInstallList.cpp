@@ -41,6 +41,7 @@
 
 #include "java/JavaCheckerJob.h"
 #include "java/JavaInstallList.h"
+#include "java/JavaRuntime.h"
 #include "java/JavaUtils.h"
 #include "minecraft/VersionFilterData.h"
 
@@ -132,6 +133,24 @@ void JavaInstallList::updateListData(QList<BaseVersion::Ptr> versions)
     m_loadTask.reset();
 }
 
+void JavaInstallList::addInstall(JavaInstallPtr java)
+{
+    // until the list is loaded, loading it finds the Java anyway
+    if (m_status != Status::Done)
+        return;
+
+    QList<BaseVersion::Ptr> versions;
+    for (auto& version : m_vlist) {
+        auto install = std::dynamic_pointer_cast<JavaInstall>(version);
+        if (install->path == java->path)
+            continue;
+        install->recommended = false;
+        versions.append(version);
+    }
+    versions.append(java);
+    updateListData(versions);
+}
+
 bool sortJavas(BaseVersion::Ptr left, BaseVersion::Ptr right)
 {
     auto rleft = std::dynamic_pointer_cast<JavaInstall>(right);
@@ -161,6 +180,12 @@ void JavaListLoadTask::executeTask()
     JavaUtils ju;
     QList<QString> candidate_paths = ju.FindJavaPaths();
 
+    // the runtimes the launcher installed itself are known to work, and don't need to be probed
+    m_managed = JavaRuntime::installed(JavaRuntime::defaultRoot());
+    for (auto java : m_managed) {
+        candidate_paths.removeAll(java->path);
+    }
+
     m_job.reset(new JavaCheckerJob("Java detection"));
     connect(m_job.get(), &Task::finished, this, &JavaListLoadTask::javaCheckerFinished);
     connect(m_job.get(), &Task::progress, this, &Task::setProgress);
@@ -199,6 +224,10 @@ void JavaListLoadTask::javaCheckerFinished()
             qDebug() << " " << javaVersion->id.toString() << javaVersion->arch << javaVersion->path;
         }
     }
+    for (auto java : m_managed) {
+        candidates.append(java);
+        qDebug() << " " << java->id.toString() << java->arch << java->path << "(installed by the launcher)";
+    }
 
     QList<BaseVersion::Ptr> javas_bvp;
     for (auto java : candidates) {
@@ -44,6 +44,9 @@ class JavaInstallList : public BaseVersionList {
     QVariant data(const QModelIndex& index, int role) const override;
     RoleList providesRoles() const override;
 
+    /** Adds a Java that is known to work without probing it, like a freshly installed runtime. */
+    void addInstall(JavaInstallPtr java);
+
    public slots:
     void updateListData(QList<BaseVersion::Ptr> versions) override;
 
@@ -71,5 +74,6 @@ class JavaListLoadTask : public Task {
    protected:
     shared_qobject_ptr<JavaCheckerJob> m_job;
     JavaInstallList* m_list;
+    QList<JavaInstallPtr> m_managed;
     JavaInstall* m_currentRecommended;
 };
@@ -0,0 +1,489 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JavaRuntime.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSysInfo>
+
+#include <atomic>
+#include <filesystem>
+
+#include "FileSystem.h"
+#include "Json.h"
+#include "StringUtils.h"
+
+namespace JavaRuntime {
+
+namespace {
+// written into the runtime folder, so deleting the runtime also forgets about it
+const QString MARKER_FILE = ".runtime.json";
+
+bool isSha1(const QString& sha1)
+{
+    static const QRegularExpression hex("^[0-9a-f]{40}$");
+    return hex.match(sha1).hasMatch();
+}
+
+bool isSafeRelativePath(const QString& path)
+{
+    if (path.isEmpty() || QDir::isAbsolutePath(path))
+        return false;
+    for (auto& segment : path.split('/')) {
+        if (segment == "..")
+            return false;
+    }
+    return true;
+}
+
+/* Whether following the target of a link in `folder` leaves the runtime. Going down is always fine, as every link below
+ * points inside too, but going back up out of a link could end up anywhere.
+ */
+bool linkEscapes(const QString& folder, const QString& target, const QSet<QString>& links)
+{
+    if (target.isEmpty() || QDir::isAbsolutePath(target) || target.startsWith('/') || target.startsWith('\\') || target.contains(':'))
+        return true;
+    QStringList path;
+    if (folder != ".")
+        path = folder.split('/');
+    for (auto& segment : QString(target).replace('\\', '/').split('/')) {
+        if (segment.isEmpty() || segment == ".")
+            continue;
+        if (segment != "..") {
+            path.append(segment);
+            continue;
+        }
+        if (path.isEmpty() || links.contains(path.join('/')))
+            return true;
+        path.removeLast();
+    }
+    return false;
+}
+
+Download readDownload(const QJsonObject& object)
+{
+    Download download;
+    download.url = Json::requireUrl(object, "url");
+    download.sha1 = Json::requireString(object, "sha1").toLower();
+    download.size = static_cast<qint64>(Json::ensureDouble(object, "size", 0));
+    if (!isSha1(download.sha1))
+        throw JSONValidationError(QString("'%1' is not a SHA-1").arg(download.sha1));
+    return download;
+}
+
+// the legacy runtime calls itself "8u51", where Java itself says "1.8.0_51"
+QString javaVersionName(const QString& name)
+{
+    static const QRegularExpression legacy("^(\\d+)u(\\d+)$");
+    auto match = legacy.match(name);
+    if (match.hasMatch())
+        return QString("1.%1.0_%2").arg(match.captured(1), match.captured(2));
+    return name;
+}
+
+// what Java reports as os.arch on each platform
+QString architectureOf(const QString& platform)
+{
+    if (platform == "linux" || platform == "windows-x64")
+        return "amd64";
+    if (platform == "mac-os")
+        return "x86_64";
+    if (platform == "mac-os-arm64" || platform == "windows-arm64")
+        return "aarch64";
+    if (platform == "linux-i386" || platform == "windows-x86")
+        return "x86";
+    return {};
+}
+
+struct Marker {
+    Release release;
+    QString java;
+};
+
+std::optional<Marker> readMarker(const QString& runtime)
+{
+    QFile file(FS::PathCombine(runtime, MARKER_FILE));
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    auto root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("formatVersion").toInt() != 1)
+        return {};
+    Marker marker;
+    marker.release.component = root.value("component").toString();
+    marker.release.platform = root.value("platform").toString();
+    marker.release.version = root.value("version").toString();
+    marker.release.manifest.sha1 = root.value("manifest").toString();
+    marker.java = root.value("java").toString();
+    if (marker.java.isEmpty() || marker.release.version.isEmpty())
+        return {};
+    return marker;
+}
+
+bool writeMarker(const QString& runtime, const Release& release, const QString& java)
+{
+    QJsonObject root;
+    root["formatVersion"] = 1;
+    root["component"] = release.component;
+    root["platform"] = release.platform;
+    root["version"] = release.version;
+    root["manifest"] = release.manifest.sha1;
+    root["java"] = java;
+    try {
+        FS::write(FS::PathCombine(runtime, MARKER_FILE), QJsonDocument(root).toJson());
+        return true;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write the runtime marker:" << e.cause();
+        return false;
+    }
+}
+}  // namespace
+
+QString defaultRoot()
+{
+    return QDir("java").absolutePath();
+}
+
+QString currentPlatform()
+{
+    auto arch = QSysInfo::currentCpuArchitecture();
+#if defined(Q_OS_WIN)
+    if (arch == "x86_64")
+        return "windows-x64";
+    if (arch == "i386")
+        return "windows-x86";
+    if (arch == "arm64")
+        return "windows-arm64";
+#elif defined(Q_OS_MACOS)
+    if (arch == "x86_64")
+        return "mac-os";
+    if (arch == "arm64")
+        return "mac-os-arm64";
+#elif defined(Q_OS_LINUX)
+    if (arch == "x86_64")
+        return "linux";
+    if (arch == "i386")
+        return "linux-i386";
+#endif
+    return {};
+}
+
+std::optional<Release> findRelease(const QByteArray& index, const QString& platform, const QString& component)
+{
+    auto root = Json::requireObject(Json::requireDocument(index, "Java runtime index"), "Java runtime index");
+    auto releases = Json::ensureArray(Json::ensureObject(root, platform), component);
+    // an empty list means there's no such runtime for the platform
+    if (releases.isEmpty())
+        return {};
+
+    auto object = Json::requireObject(releases.first(), "Java runtime release");
+    Release release;
+    release.component = component;
+    release.platform = platform;
+    release.version = Json::requireString(Json::requireObject(object, "version"), "name");
+    release.manifest = readDownload(Json::requireObject(object, "manifest"));
+    return release;
+}
+
+QList<Entry> parseManifest(const QByteArray& manifest)
+{
+    auto files = Json::requireObject(Json::requireObject(Json::requireDocument(manifest, "Java runtime manifest")), "files");
+
+    QList<Entry> entries;
+    entries.reserve(files.size());
+    QSet<QString> paths;
+    QSet<QString> links;
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+        auto object = Json::requireObject(it.value(), it.key());
+        Entry entry;
+        entry.path = QDir::cleanPath(it.key());
+        if (!isSafeRelativePath(entry.path))
+            throw JSONValidationError(QString("'%1' is not a path inside the runtime").arg(it.key()));
+        if (paths.contains(entry.path))
+            throw JSONValidationError(QString("'%1' is listed more than once").arg(it.key()));
+        paths.insert(entry.path);
+
+        auto type = Json::requireString(object, "type");
+        if (type == "directory") {
+            entry.type = Entry::Type::Directory;
+        } else if (type == "link") {
+            entry.type = Entry::Type::Link;
+            entry.target = Json::requireString(object, "target");
+            links.insert(entry.path);
+        } else if (type == "file") {
+            entry.type = Entry::Type::File;
+            entry.executable = Json::ensureBoolean(object, "executable", false);
+            // there's also an LZMA compressed download, which would need a decompressor for little gain per file
+            entry.download = readDownload(Json::requireObject(Json::requireObject(object, "downloads"), "raw"));
+        } else {
+            throw JSONValidationError(QString("Unknown runtime entry type '%1'").arg(type));
+        }
+        entries.append(entry);
+    }
+
+    // nothing can be put through a link, or it would end up wherever that points
+    for (auto& entry : entries) {
+        const auto folder = QFileInfo(entry.path).path();
+        for (auto parent = folder; parent != "."; parent = QFileInfo(parent).path()) {
+            if (links.contains(parent))
+                throw JSONValidationError(QString("'%1' is inside the link '%2'").arg(entry.path, parent));
+        }
+        if (entry.type == Entry::Type::Link && linkEscapes(folder, entry.target, links))
+            throw JSONValidationError(QString("The link '%1' points outside the runtime").arg(entry.path));
+    }
+    return entries;
+}
+
+QString javaBinary(const QList<Entry>& entries)
+{
+#ifdef Q_OS_WIN
+    static const QStringList names = { "javaw.exe", "java.exe" };
+#else
+    static const QStringList names = { "java" };
+#endif
+    for (auto& name : names) {
+        QString best;
+        for (auto& entry : entries) {
+            if (entry.type != Entry::Type::File || !(entry.path == "bin/" + name || entry.path.endsWith("/bin/" + name)))
+                continue;
+            // the binary at the top, not the one of some bundled tool
+            if (best.isEmpty() || entry.path.size() < best.size())
+                best = entry.path;
+        }
+        if (!best.isEmpty())
+            return best;
+    }
+    return {};
+}
+
+JavaCheckResult expectedCheckResult(const Release& release, const QString& javaPath)
+{
+    JavaCheckResult result;
+    result.path = javaPath;
+    result.realPlatform = architectureOf(release.platform);
+    result.is_64bit = result.realPlatform != "x86";
+    result.mojangPlatform = result.is_64bit ? "64" : "32";
+    result.javaVersion = javaVersionName(release.version);
+    result.javaVendor = "Mojang";
+    result.validity = JavaCheckResult::Validity::Valid;
+    return result;
+}
+
+Store::Store(const QString& root) : m_root(root) {}
+
+QString Store::objectPath(const QString& sha1) const
+{
+    return FS::PathCombine(m_root, "objects", sha1.left(2), sha1);
+}
+
+bool Store::contains(const QString& sha1) const
+{
+    return QFileInfo::exists(objectPath(sha1));
+}
+
+QList<Entry> Store::missing(const QList<Entry>& entries) const
+{
+    QList<Entry> missing;
+    QSet<QString> seen;
+    for (auto& entry : entries) {
+        if (entry.type != Entry::Type::File || seen.contains(entry.download.sha1))
+            continue;
+        seen.insert(entry.download.sha1);
+        if (!contains(entry.download.sha1))
+            missing.append(entry);
+    }
+    return missing;
+}
+
+bool Store::import(const QString& path, const QString& sha1)
+{
+    if (!isSha1(sha1))
+        return false;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file) || hash.result().toHex() != sha1) {
+        qWarning() << "Not importing" << path << "into the runtime store, it doesn't have the SHA-1" << sha1;
+        return false;
+    }
+    file.close();
+
+    // objects only ever appear complete
+    auto target = objectPath(sha1);
+    auto part = target + ".part";
+    std::atomic_bool tryClone = true;
+    std::error_code ec;
+    QFile::remove(part);
+    if (!FS::ensureFilePathExists(target) || !FS::copy_file(path, part, tryClone, ec) || !QFile::rename(part, target)) {
+        QFile::remove(part);
+        return contains(sha1);
+    }
+    return true;
+}
+
+bool Store::assemble(const Release& release, const QList<Entry>& entries, const QString& target, QString* error)
+{
+    auto fail = [error](const QString& reason) {
+        qWarning() << "Failed to assemble Java runtime:" << reason;
+        if (error)
+            *error = reason;
+        return false;
+    };
+
+    auto java = javaBinary(entries);
+    if (java.isEmpty())
+        return fail(QObject::tr("The runtime has no Java binary."));
+
+    // assembled next to the target, so the old runtime stays usable until the new one is complete
+    auto staging = target + ".assembling";
+    if (QFileInfo::exists(staging) && !FS::deletePath(staging))
+        return fail(QObject::tr("Could not clear %1.").arg(staging));
+    QDir dir(staging);
+    if (!dir.mkpath("."))
+        return fail(QObject::tr("Could not create %1.").arg(staging));
+
+    QSet<QString> folders;
+    auto ensureFolder = [&](const QString& path) {
+        auto folder = QFileInfo(path).path();
+        if (folder == "." || folders.contains(folder))
+            return true;
+        folders.insert(folder);
+        return dir.mkpath(folder);
+    };
+
+    bool tryLink = true;
+    std::atomic_bool tryClone = true;
+    int linked = 0;
+    int copied = 0;
+    for (auto& entry : entries) {
+        auto path = dir.absoluteFilePath(entry.path);
+        switch (entry.type) {
+            case Entry::Type::Directory:
+                folders.insert(entry.path);
+                if (!dir.mkpath(entry.path))
+                    return fail(QObject::tr("Could not create %1.").arg(path));
+                break;
+            case Entry::Type::Link:
+                // made last, so nothing is ever created through one
+                break;
+            case Entry::Type::File: {
+                auto object = objectPath(entry.download.sha1);
+                if (!QFileInfo::exists(object))
+                    return fail(QObject::tr("%1 is missing from the runtime store.").arg(entry.path));
+                if (!ensureFolder(entry.path))
+                    return fail(QObject::tr("Could not create the folder of %1.").arg(path));
+                // links share the permissions of the object, and being executable doesn't hurt the runtimes that don't need it
+                if (entry.executable) {
+                    QFile::setPermissions(object, QFile::permissions(object) | QFile::ExeOwner | QFile::ExeGroup | QFile::ExeOther);
+                }
+
+                std::error_code ec;
+                bool ok = false;
+                if (tryLink) {
+                    ok = FS::hard_link_file(object, path, ec);
+                    if (ok) {
+                        linked++;
+                    } else {
+                        // most likely a different filesystem, which won't change for the next file either
+                        qDebug() << "Could not hard link the runtime, falling back to copies:" << QString::fromStdString(ec.message());
+                        tryLink = false;
+                        ec.clear();
+                    }
+                }
+                if (!ok) {
+                    if (!FS::copy_file(object, path, tryClone, ec))
+                        return fail(QObject::tr("Could not copy %1: %2").arg(entry.path, QString::fromStdString(ec.message())));
+                    if (entry.executable)
+                        QFile::setPermissions(path, QFile::permissions(path) | QFile::ExeOwner | QFile::ExeGroup | QFile::ExeOther);
+                    copied++;
+                }
+                break;
+            }
+        }
+    }
+
+    for (auto& entry : entries) {
+        if (entry.type != Entry::Type::Link)
+            continue;
+        auto path = dir.absoluteFilePath(entry.path);
+        if (!ensureFolder(entry.path))
+            return fail(QObject::tr("Could not create the folder of %1.").arg(path));
+        std::error_code ec;
+        std::filesystem::create_symlink(StringUtils::toStdString(entry.target), StringUtils::toStdString(path), ec);
+        if (ec)
+            qWarning() << "Could not link" << entry.path << "to" << entry.target << ":" << QString::fromStdString(ec.message());
+    }
+
+    if (!writeMarker(staging, release, java))
+        return fail(QObject::tr("Could not write down what the runtime is."));
+
+    if (QFileInfo::exists(target) && !FS::deletePath(target))
+        return fail(QObject::tr("Could not remove the previous runtime at %1.").arg(target));
+    if (!QDir().rename(staging, target))
+        return fail(QObject::tr("Could not move the runtime to %1.").arg(target));
+
+    qDebug() << "Assembled" << release.component << release.version << "in" << target << ":" << linked << "files linked," << copied
+             << "copied";
+    return true;
+}
+
+QList<JavaInstallPtr> installed(const QString& root)
+{
+    QList<JavaInstallPtr> javas;
+    for (auto& info : QDir(root).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        auto marker = readMarker(info.absoluteFilePath());
+        if (!marker)
+            continue;
+        auto path = FS::PathCombine(info.absoluteFilePath(), marker->java);
+        if (!QFileInfo::exists(path))
+            continue;
+        auto result = expectedCheckResult(marker->release, path);
+        javas.append(std::make_shared<JavaInstall>(result.javaVersion.toString(), result.realPlatform, path));
+    }
+    return javas;
+}
+
+std::optional<JavaCheckResult> checkResultFor(const QString& javaPath)
+{
+    QFileInfo java(javaPath);
+    if (!java.exists())
+        return {};
+    auto canonical = java.canonicalFilePath();
+
+    // the binary is somewhere below the runtime folder, like bin/java or jre.bundle/Contents/Home/bin/java
+    QDir dir = java.absoluteDir();
+    for (int depth = 0; depth < 6; depth++) {
+        if (auto marker = readMarker(dir.absolutePath())) {
+            if (QFileInfo(dir.absoluteFilePath(marker->java)).canonicalFilePath() != canonical)
+                return {};
+            return expectedCheckResult(marker->release, javaPath);
+        }
+        if (!dir.cdUp())
+            break;
+    }
+    return {};
+}
+
+}  // namespace JavaRuntime
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+#include <optional>
+
+#include "java/JavaChecker.h"
+#include "java/JavaInstall.h"
+
+/**
+ * The Java runtimes Mojang distributes for the game, as described by their runtime manifests.
+ *
+ * An index lists, per platform and component (like "java-runtime-gamma"), the manifest of the current release of that
+ * runtime. Manifests list every file of the runtime with its SHA-1. The files are kept in a content-addressed store,
+ * and the runtimes are put together from hard links into it, so releases that share files share the disk space too.
+ */
+namespace JavaRuntime {
+
+struct Download {
+    QUrl url;
+    QString sha1;
+    qint64 size = 0;
+};
+
+struct Release {
+    QString component;
+    QString platform;
+    QString version;
+    Download manifest;
+};
+
+struct Entry {
+    enum class Type { File, Directory, Link };
+    Type type = Type::File;
+    // relative to the runtime folder
+    QString path;
+    Download download;
+    bool executable = false;
+    // for links, relative to the link
+    QString target;
+};
+
+/** Where the launcher keeps its runtimes, relative to the data directory like the libraries and assets. */
+QString defaultRoot();
+
+/** The name Mojang uses for the platform the launcher runs on, or an empty string if there are no runtimes for it. */
+QString currentPlatform();
+
+/** Finds the release of `component` for `platform` in the runtime index. Throws a JSONValidationError if it's malformed. */
+std::optional<Release> findRelease(const QByteArray& index, const QString& platform, const QString& component);
+
+/** Reads the entries of a runtime manifest. Throws a JSONValidationError if it's malformed. */
+QList<Entry> parseManifest(const QByteArray& manifest);
+
+/** The path of the Java binary of a runtime, relative to its folder. Empty if the manifest has none. */
+QString javaBinary(const QList<Entry>& entries);
+
+/** What a JavaChecker run would say about the Java binary of a release, without running it. */
+JavaCheckResult expectedCheckResult(const Release& release, const QString& javaPath);
+
+class Store {
+   public:
+    explicit Store(const QString& root);
+
+    QString root() const { return m_root; }
+    QString objectPath(const QString& sha1) const;
+    bool contains(const QString& sha1) const;
+
+    /** The files of the entries that aren't in the store yet, each listed once. */
+    QList<Entry> missing(const QList<Entry>& entries) const;
+
+    /** Copies a local file into the store, if it really has the given SHA-1. */
+    bool import(const QString& path, const QString& sha1);
+
+    /** Puts together the runtime of a release in `target` from the objects in the store, replacing what was there.
+     *  Also writes down what the runtime is, for installed() to find.
+     */
+    bool assemble(const Release& release, const QList<Entry>& entries, const QString& target, QString* error = nullptr);
+
+   private:
+    QString m_root;
+};
+
+/** The runtimes assembled in the folders under `root`, with the details a JavaChecker would have found out. */
+QList<JavaInstallPtr> installed(const QString& root);
+
+/** The check result written down with the runtime a Java binary belongs to, if it's one that was assembled here. */
+std::optional<JavaCheckResult> checkResultFor(const QString& javaPath);
+
+}  // namespace JavaRuntime
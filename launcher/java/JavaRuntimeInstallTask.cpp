@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "JavaRuntimeInstallTask.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+
+#include "Application.h"
+#include "BuildConfig.h"
+#include "FileSystem.h"
+#include "Json.h"
+#include "java/JavaInstallList.h"
+#include "net/ChecksumValidator.h"
+
+JavaRuntimeInstallTask::JavaRuntimeInstallTask(QUrl index,
+                                               QString component,
+                                               QString platform,
+                                               QString root,
+                                               shared_qobject_ptr<QNetworkAccessManager> network,
+                                               std::shared_ptr<JavaInstallList> list)
+    : m_index(index), m_component(component), m_platform(platform), m_store(root), m_network(network), m_list(list)
+{}
+
+shared_qobject_ptr<JavaRuntimeInstallTask> JavaRuntimeInstallTask::make(const QString& component)
+{
+    return makeShared<JavaRuntimeInstallTask>(QUrl(BuildConfig.JAVA_RUNTIMES_URL), component, JavaRuntime::currentPlatform(),
+                                              JavaRuntime::defaultRoot(), APPLICATION->network(), APPLICATION->javalist());
+}
+
+void JavaRuntimeInstallTask::executeTask()
+{
+    if (m_platform.isEmpty()) {
+        emitFailed(tr("There are no Java runtimes for this platform."));
+        return;
+    }
+    setStatus(tr("Getting the list of Java runtimes..."));
+    fetch(m_index, {}, [this](const QByteArray& data) { indexFetched(data); });
+}
+
+void JavaRuntimeInstallTask::fetch(const QUrl& url, const QString& sha1, std::function<void(const QByteArray&)> next)
+{
+    if (url.isLocalFile()) {
+        QByteArray data;
+        try {
+            data = FS::read(url.toLocalFile());
+        } catch (const FS::FileSystemException& e) {
+            emitFailed(e.cause());
+            return;
+        }
+        if (!sha1.isEmpty() && QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex() != sha1) {
+            emitFailed(tr("%1 doesn't have the expected checksum.").arg(url.toLocalFile()));
+            return;
+        }
+        next(data);
+        return;
+    }
+
+    auto output = std::make_shared<QByteArray>();
+    auto dl = Net::Download::makeByteArray(url, output);
+    if (!sha1.isEmpty())
+        dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, QByteArray::fromHex(sha1.toLatin1())));
+    m_job.reset(new NetJob(tr("Java runtime metadata"), m_network));
+    m_job->addNetAction(dl);
+    connect(m_job.get(), &NetJob::succeeded, this, [output, next] { next(*output); });
+    connect(m_job.get(), &NetJob::failed, this, &JavaRuntimeInstallTask::emitFailed);
+    connect(m_job.get(), &NetJob::aborted, this, [this] { emitFailed(tr("Aborted")); });
+    m_job->setParentTask(this);
+    m_job->start();
+}
+
+void JavaRuntimeInstallTask::indexFetched(const QByteArray& data)
+{
+    try {
+        auto release = JavaRuntime::findRelease(data, m_platform, m_component);
+        if (!release) {
+            emitFailed(tr("There is no Java runtime %1 for %2.").arg(m_component, m_platform));
+            return;
+        }
+        m_release = *release;
+    } catch (const JSONValidationError& e) {
+        emitFailed(tr("Couldn't read the list of Java runtimes: %1").arg(e.cause()));
+        return;
+    }
+
+    setStatus(tr("Getting the file list of Java %1...").arg(m_release.version));
+    fetch(m_release.manifest.url, m_release.manifest.sha1, [this](const QByteArray& data) { manifestFetched(data); });
+}
+
+void JavaRuntimeInstallTask::manifestFetched(const QByteArray& data)
+{
+    try {
+        m_entries = JavaRuntime::parseManifest(data);
+    } catch (const JSONValidationError& e) {
+        emitFailed(tr("Couldn't read the file list of Java %1: %2").arg(m_release.version, e.cause()));
+        return;
+    }
+
+    auto missing = m_store.missing(m_entries);
+    qDebug() << "Java" << m_release.version << "has" << m_entries.size() << "entries," << missing.size() << "files not in the store yet";
+
+    NetJob::Ptr job;
+    for (auto& entry : missing) {
+        auto& download = entry.download;
+        if (download.url.isLocalFile()) {
+            if (!m_store.import(download.url.toLocalFile(), download.sha1)) {
+                emitFailed(tr("Couldn't get %1 from %2.").arg(entry.path, download.url.toLocalFile()));
+                return;
+            }
+            continue;
+        }
+        if (!job)
+            job.reset(new NetJob(tr("Java %1").arg(m_release.version), m_network));
+        auto dl = Net::Download::makeFile(download.url, m_store.objectPath(download.sha1));
+        dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Sha1, QByteArray::fromHex(download.sha1.toLatin1())));
+        job->addNetAction(dl);
+    }
+
+    if (!job) {
+        assemble();
+        return;
+    }
+
+    setStatus(tr("Downloading Java %1...").arg(m_release.version));
+    m_job = job;
+    connect(m_job.get(), &NetJob::succeeded, this, &JavaRuntimeInstallTask::assemble);
+    connect(m_job.get(), &NetJob::failed, this, [this](QString reason) { emitFailed(tr("Failed to download Java:\n%1").arg(reason)); });
+    connect(m_job.get(), &NetJob::aborted, this, [this] { emitFailed(tr("Aborted")); });
+    connect(m_job.get(), &NetJob::progress, this, &JavaRuntimeInstallTask::setProgress);
+    connect(m_job.get(), &NetJob::stepProgress, this, &JavaRuntimeInstallTask::propagateStepProgress);
+    m_job->setParentTask(this);
+    m_job->start();
+}
+
+void JavaRuntimeInstallTask::assemble()
+{
+    setStatus(tr("Setting up Java %1...").arg(m_release.version));
+    auto target = FS::PathCombine(m_store.root(), m_component);
+    QString error;
+    if (!m_store.assemble(m_release, m_entries, target, &error)) {
+        emitFailed(error);
+        return;
+    }
+    m_java_path = FS::PathCombine(target, JavaRuntime::javaBinary(m_entries));
+
+    if (m_list) {
+        auto result = JavaRuntime::expectedCheckResult(m_release, m_java_path);
+        m_list->addInstall(std::make_shared<JavaInstall>(result.javaVersion.toString(), result.realPlatform, m_java_path));
+    }
+    emitSucceeded();
+}
+
+bool JavaRuntimeInstallTask::abort()
+{
+    if (m_job && m_job->isRunning())
+        return m_job->abort();
+    return Task::abort();
+}
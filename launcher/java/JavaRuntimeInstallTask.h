@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "java/JavaRuntime.h"
+#include "net/NetJob.h"
+#include "tasks/Task.h"
+
+class JavaInstallList;
+
+/**
+ * Installs (or updates) one of Mojang's Java runtimes into `<root>/<component>`.
+ *
+ * Only the files the runtime store doesn't have yet are downloaded, in parallel. Local `file:` URLs are read directly,
+ * which is how a mirror on disk can be used.
+ */
+class JavaRuntimeInstallTask : public Task {
+    Q_OBJECT
+   public:
+    JavaRuntimeInstallTask(QUrl index,
+                           QString component,
+                           QString platform,
+                           QString root,
+                           shared_qobject_ptr<QNetworkAccessManager> network,
+                           std::shared_ptr<JavaInstallList> list = nullptr);
+    ~JavaRuntimeInstallTask() override = default;
+
+    /** Installs `component` for the platform the launcher runs on, from Mojang, next to the other runtimes of the launcher. */
+    static shared_qobject_ptr<JavaRuntimeInstallTask> make(const QString& component);
+
+    bool canAbort() const override { return true; }
+
+    /** The Java binary of the installed runtime, once the task succeeded. */
+    QString javaPath() const { return m_java_path; }
+
+   public slots:
+    bool abort() override;
+
+   protected:
+    void executeTask() override;
+
+   private:
+    void fetch(const QUrl& url, const QString& sha1, std::function<void(const QByteArray&)> next);
+    void indexFetched(const QByteArray& data);
+    void manifestFetched(const QByteArray& data);
+    void assemble();
+
+   private:
+    QUrl m_index;
+    QString m_component;
+    QString m_platform;
+    JavaRuntime::Store m_store;
+    shared_qobject_ptr<QNetworkAccessManager> m_network;
+    std::shared_ptr<JavaInstallList> m_list;
+
+    JavaRuntime::Release m_release;
+    QList<JavaRuntime::Entry> m_entries;
+    NetJob::Ptr m_job;
+    QString m_java_path;
+};
@@ -19,6 +19,7 @@
 void LaunchStep::bind(LaunchTask* parent)
 {
     m_parent = parent;
+    setParentTask(parent);
     connect(this, &LaunchStep::readyForLaunch, parent, &LaunchTask::onReadyForLaunch);
     connect(this, &LaunchStep::logLine, parent, &LaunchTask::onLogLine);
     connect(this, &LaunchStep::logLines, parent, &LaunchTask::onLogLines);
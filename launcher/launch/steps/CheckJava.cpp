@@ -39,6 +39,7 @@
 #include <sys.h>
 #include <QFileInfo>
 #include <QStandardPaths>
+#include "java/JavaRuntime.h"
 #include "java/JavaUtils.h"
 
 void CheckJava::executeTask()
@@ -90,6 +91,11 @@ void CheckJava::executeTask()
     // if timestamps are not the same, or something is missing, check!
     if (m_javaSignature != storedSignature || storedVersion.size() == 0 || storedArchitecture.size() == 0 ||
         storedRealArchitecture.size() == 0 || storedVendor.size() == 0) {
+        // the runtimes the launcher installed itself say what they are
+        if (auto result = JavaRuntime::checkResultFor(realJavaPath)) {
+            checkJavaFinished(*result);
+            return;
+        }
         m_JavaChecker.reset(new JavaChecker);
         emit logLine(QString("Checking Java version..."), MessageLevel::Launcher);
         connect(m_JavaChecker.get(), &JavaChecker::checkFinished, this, &CheckJava::checkJavaFinished);
@@ -24,6 +24,7 @@ void Update::executeTask()
     }
     m_updateTask.reset(m_parent->instance()->createUpdateTask(m_mode));
     if (m_updateTask) {
+        m_updateTask->setParentTask(this);
         connect(m_updateTask.get(), &Task::finished, this, &Update::updateFinished);
         connect(m_updateTask.get(), &Task::progress, this, &Update::setProgress);
         connect(m_updateTask.get(), &Task::stepProgress, this, &Update::propagateStepProgress);
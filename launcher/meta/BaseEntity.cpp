@@ -15,13 +15,24 @@
 
 #include "BaseEntity.h"
 
+#include <QCryptographicHash>
+
+#include "FileSystem.h"
 #include "Json.h"
+#include "meta/BinaryFormat.h"
+#include "meta/JsonFormat.h"
 #include "net/Download.h"
 #include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 
 #include "Application.h"
 #include "BuildConfig.h"
+#include "tasks/Executor.h"
+
+namespace {
+const quint32 snapshotMagic = 0x504d5348;  // "PMSH"
+const quint32 snapshotVersion = 1;
+}  // namespace
 
 class ParsingValidator : public Net::Validator {
    public: /* con/des */
@@ -43,6 +54,7 @@ class ParsingValidator : public Net::Validator {
             auto doc = Json::requireDocument(data, fname);
             auto obj = Json::requireObject(doc, fname);
             m_entity->parse(obj);
+            m_entity->saveSnapshot(data);
             return true;
         } catch (const Exception& e) {
             qWarning() << "Unable to parse response:" << e.cause();
@@ -68,17 +80,107 @@ QUrl Meta::BaseEntity::url() const
     }
 }
 
+bool Meta::BaseEntity::serializeBinary(QDataStream&) const
+{
+    return false;
+}
+
+void Meta::BaseEntity::parseBinary(QDataStream&)
+{
+    throw ParseException(QObject::tr("No binary format for %1").arg(localFilename()));
+}
+
+QString Meta::BaseEntity::snapshotFilename() const
+{
+    auto name = localFilename();
+    name.chop(QString(".json").size());
+    // resolved right away, the snapshot is written later on the io executor
+    return QDir("cache/meta").absoluteFilePath(name + ".snapshot");
+}
+
+bool Meta::BaseEntity::loadSnapshot()
+{
+    if (m_sha256.isEmpty()) {
+        return false;
+    }
+    QFile file(snapshotFilename());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const auto data = file.readAll();
+    file.close();
+
+    QDataStream in(data);
+    in.setVersion(binaryStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString sha256;
+    in >> magic >> version >> sha256;
+    if (in.status() != QDataStream::Ok || magic != snapshotMagic || version != snapshotVersion) {
+        return false;
+    }
+    // made from another version of the file
+    if (sha256.compare(m_sha256, Qt::CaseInsensitive) != 0) {
+        return false;
+    }
+    try {
+        parseBinary(in);
+        return true;
+    } catch (const Exception& e) {
+        qDebug() << QString("Unable to load snapshot %1: %2").arg(file.fileName(), e.cause());
+        QFile::remove(file.fileName());
+        return false;
+    }
+}
+
+void Meta::BaseEntity::saveSnapshot(const QByteArray& json)
+{
+    if (m_sha256.isEmpty()) {
+        return;
+    }
+    QByteArray snapshot;
+    {
+        QDataStream out(&snapshot, QIODevice::WriteOnly);
+        out.setVersion(binaryStreamVersion);
+        out << snapshotMagic << snapshotVersion << m_sha256;
+        if (!serializeBinary(out)) {
+            return;
+        }
+    }
+    // checking the file is the one the index lists and writing the snapshot don't need to hold up loading
+    Executor::io().run(
+        [json, snapshot, sha256 = m_sha256, filename = snapshotFilename()] {
+            const auto actual = QCryptographicHash::hash(json, QCryptographicHash::Sha256).toHex();
+            if (QString::fromLatin1(actual).compare(sha256, Qt::CaseInsensitive) != 0) {
+                // it would never be used
+                return;
+            }
+            try {
+                FS::write(filename, snapshot);
+            } catch (const FS::FileSystemException& e) {
+                qWarning() << "Unable to write meta snapshot" << filename << ":" << e.cause();
+            }
+        },
+        Executor::Priority::Low);
+}
+
 bool Meta::BaseEntity::loadLocalFile()
 {
+    // a snapshot of the file the index lists saves parsing it
+    if (loadSnapshot()) {
+        return true;
+    }
     const QString fname = QDir("meta").absoluteFilePath(localFilename());
     if (!QFile::exists(fname)) {
         return false;
     }
     // TODO: check if the file has the expected checksum
     try {
-        auto doc = Json::requireDocument(fname, fname);
+        auto data = FS::read(fname);
+        auto doc = Json::requireDocument(data, fname);
         auto obj = Json::requireObject(doc, fname);
         parse(obj);
+        saveSnapshot(data);
         return true;
     } catch (const Exception& e) {
         qDebug() << QString("Unable to parse file %1: %2").arg(fname, e.cause());
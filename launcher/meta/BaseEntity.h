@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <QDataStream>
 #include <QJsonObject>
 #include <QObject>
 #include "QObjectPtr.h"
@@ -22,6 +23,8 @@
 #include "net/Mode.h"
 #include "net/NetJob.h"
 
+class ParsingValidator;
+
 namespace Meta {
 class BaseEntity {
    public: /* types */
@@ -33,10 +36,20 @@ class BaseEntity {
     virtual ~BaseEntity();
 
     virtual void parse(const QJsonObject& obj) = 0;
+    /**
+     * Writes what parse() read into a binary snapshot, which parseBinary() can load without going through the JSON again.
+     * Entities that have no binary format return false.
+     */
+    virtual bool serializeBinary(QDataStream& out) const;
+    virtual void parseBinary(QDataStream& in);
 
     virtual QString localFilename() const = 0;
     virtual QUrl url() const;
 
+    //! The checksum the index lists for the file. Snapshots are only used when they were made from a file with it.
+    QString sha256() const { return m_sha256; }
+    void setSha256(const QString& sha256) { m_sha256 = sha256; }
+
     bool isLoaded() const;
     bool shouldStartRemoteUpdate() const;
 
@@ -47,6 +60,13 @@ class BaseEntity {
     bool loadLocalFile();
 
    private:
+    friend class ::ParsingValidator;
+
+    QString snapshotFilename() const;
+    bool loadSnapshot();
+    void saveSnapshot(const QByteArray& json);
+
+    QString m_sha256;
     LoadStatus m_loadStatus = LoadStatus::NotLoaded;
     UpdateStatus m_updateStatus = UpdateStatus::NotDone;
     NetJob::Ptr m_updateTask;
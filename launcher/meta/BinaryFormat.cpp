@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BinaryFormat.h"
+
+#include "JsonFormat.h"
+#include "Version.h"
+#include "VersionList.h"
+
+namespace Meta {
+
+static void writeRequires(QDataStream& out, const RequireSet& set)
+{
+    out << quint32(set.size());
+    for (auto& require : set) {
+        out << require.uid << require.equalsVersion << require.suggests;
+    }
+}
+
+static RequireSet readRequires(QDataStream& in)
+{
+    quint32 count = 0;
+    in >> count;
+    RequireSet set;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        Require require;
+        in >> require.uid >> require.equalsVersion >> require.suggests;
+        set.insert(require);
+    }
+    return set;
+}
+
+void serializeVersionListBinary(QDataStream& out, const VersionList* list)
+{
+    const auto versions = list->versions();
+    out << list->uid() << list->name() << quint32(versions.size());
+    for (auto& version : versions) {
+        out << version->version() << version->type() << version->rawTime() << version->isRecommended() << version->isVolatile();
+        writeRequires(out, version->requiredSet());
+        writeRequires(out, version->conflictSet());
+    }
+}
+
+void parseVersionListBinary(QDataStream& in, VersionList* ptr)
+{
+    QString uid;
+    QString name;
+    quint32 count = 0;
+    in >> uid >> name >> count;
+    if (in.status() != QDataStream::Ok || uid != ptr->uid()) {
+        throw ParseException(QObject::tr("Snapshot of a different version list"));
+    }
+
+    QVector<Version::Ptr> versions;
+    for (quint32 i = 0; i < count; i++) {
+        QString id;
+        QString type;
+        qint64 time = 0;
+        bool recommended = false;
+        bool isVolatile = false;
+        in >> id >> type >> time >> recommended >> isVolatile;
+        auto reqs = readRequires(in);
+        auto conflicts = readRequires(in);
+        if (in.status() != QDataStream::Ok) {
+            throw ParseException(QObject::tr("Truncated snapshot"));
+        }
+
+        auto version = std::make_shared<Version>(uid, id);
+        version->setTime(time);
+        version->setType(type);
+        version->setRecommended(recommended);
+        version->setVolatile(isVolatile);
+        version->setRequires(reqs, conflicts);
+        version->setProvidesRecommendations();
+        versions.append(version);
+    }
+    if (!in.atEnd()) {
+        throw ParseException(QObject::tr("Unexpected data after the snapshot"));
+    }
+
+    VersionList::Ptr list = std::make_shared<VersionList>(uid);
+    list->setName(name);
+    list->setVersions(versions);
+    ptr->merge(list);
+}
+
+}  // namespace Meta
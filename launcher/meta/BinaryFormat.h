@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QDataStream>
+
+namespace Meta {
+class VersionList;
+
+/*
+ * The same as what the JSON format parsers read, written with QDataStream so it loads without parsing anything.
+ * It's only ever a copy of a JSON file, so anything about it that isn't right is a ParseException and the JSON is used.
+ */
+constexpr QDataStream::Version binaryStreamVersion = QDataStream::Qt_5_12;
+
+void serializeVersionListBinary(QDataStream& out, const VersionList* list);
+void parseVersionListBinary(QDataStream& in, VersionList* ptr);
+}  // namespace Meta
@@ -64,6 +64,8 @@ class VersionList : public BaseVersionList, public BaseEntity {
     void merge(const VersionList::Ptr& other);
     void mergeFromIndex(const VersionList::Ptr& other);
     void parse(const QJsonObject& obj) override;
+    bool serializeBinary(QDataStream& out) const override;
+    void parseBinary(QDataStream& in) override;
 
    signals:
     void nameChanged(const QString& name);
@@ -36,13 +36,16 @@
 #include <QCryptographicHash>
 #include <QDebug>
 #include <QDir>
-#include <QDirIterator>
 #include <QFileInfo>
+#include <QHash>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
+#include <QSet>
 #include <QVariant>
 
+#include <atomic>
+
 #include "AssetsUtils.h"
 #include "BuildConfig.h"
 #include "FileSystem.h"
@@ -52,26 +55,72 @@
 #include "Application.h"
 
 namespace {
-QSet<QString> collectPathsFromDir(QString dirPath)
-{
-    QFileInfo dirInfo(dirPath);
+// written into the reconstructed folder, so deleting the folder also forgets about it
+const QString STAMP_FILE = ".assets_stamp.json";
+
+struct Stamp {
+    QString indexHash;
+    bool complete = false;
+    QHash<QString, QString> objects;  // target path relative to the folder -> object hash
+};
 
-    if (!dirInfo.exists()) {
+QString hashFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
         return {};
-    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result().toHex();
+}
+
+Stamp readStamp(const QString& path)
+{
+    Stamp stamp;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return stamp;
+    auto doc = QJsonDocument::fromJson(file.readAll());
+    auto root = doc.object();
+    if (root.value("formatVersion").toInt() != 1)
+        return stamp;
+    stamp.indexHash = root.value("index").toString();
+    stamp.complete = root.value("complete").toBool();
+    auto objects = root.value("objects").toObject();
+    stamp.objects.reserve(objects.size());
+    for (auto it = objects.constBegin(); it != objects.constEnd(); ++it)
+        stamp.objects.insert(it.key(), it.value().toString());
+    return stamp;
+}
 
-    QSet<QString> out;
+bool writeStamp(const QString& path, const Stamp& stamp)
+{
+    QJsonObject objects;
+    for (auto it = stamp.objects.constBegin(); it != stamp.objects.constEnd(); ++it)
+        objects.insert(it.key(), it.value());
+    QJsonObject root;
+    root["formatVersion"] = 1;
+    root["index"] = stamp.indexHash;
+    root["complete"] = stamp.complete;
+    root["objects"] = objects;
+    try {
+        FS::write(path, QJsonDocument(root).toJson(QJsonDocument::Compact));
+        return true;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Failed to write assets stamp:" << e.cause();
+        return false;
+    }
+}
 
-    QDirIterator iter(dirPath, QDirIterator::Subdirectories);
-    while (iter.hasNext()) {
-        QString value = iter.next();
-        QFileInfo info(value);
-        if (info.isFile()) {
-            out.insert(value);
-            qDebug() << value;
-        }
+bool isSafeRelativePath(const QString& path)
+{
+    if (path.isEmpty() || QDir::isAbsolutePath(path))
+        return false;
+    for (auto& segment : path.split('/')) {
+        if (segment == "..")
+            return false;
     }
-    return out;
+    return true;
 }
 }  // namespace
 
@@ -216,8 +265,6 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
         return false;
     }
 
-    qDebug() << "reconstructAssets" << assetsDir.path() << indexDir.path() << objectDir.path() << virtualDir.path() << virtualRoot.path();
-
     AssetsIndex index;
     if (!AssetsUtils::loadAssetsIndexJson(assetsId, indexPath, index)) {
         qCritical() << "Failed to load asset index file" << indexPath << "; can't reconstruct assets!";
@@ -229,48 +276,117 @@ bool reconstructAssets(QString assetsId, QString resourcesFolder)
     if (index.isVirtual) {
         targetPath = virtualRoot.path();
         removeLeftovers = true;
-        qDebug() << "Reconstructing virtual assets folder at" << targetPath;
     } else if (index.mapToResources) {
         targetPath = resourcesFolder;
-        qDebug() << "Reconstructing resources folder at" << targetPath;
+    }
+    if (targetPath.isNull()) {
+        return true;
     }
 
-    if (!targetPath.isNull()) {
-        auto presentFiles = collectPathsFromDir(targetPath);
-        for (QString map : index.objects.keys()) {
-            AssetObject asset_object = index.objects.value(map);
-            QString target_path = FS::PathCombine(targetPath, map);
-            QFile target(target_path);
-
-            QString tlk = asset_object.hash.left(2);
+    // nothing to do if the folder was completely reconstructed from this very index before
+    const QString stampPath = FS::PathCombine(targetPath, STAMP_FILE);
+    const Stamp previous = readStamp(stampPath);
+    const QString indexHash = hashFile(indexPath);
+    if (previous.complete && !indexHash.isEmpty() && previous.indexHash == indexHash) {
+        return true;
+    }
+    qDebug() << "Reconstructing" << (index.isVirtual ? "virtual assets folder" : "resources folder") << "at" << targetPath;
+
+    Stamp stamp;
+    stamp.indexHash = indexHash;
+    stamp.complete = true;
+    stamp.objects.reserve(index.objects.size());
+
+    // The virtual folder only ever gets read by the game, so it can share the files with the object store. The resources
+    // folder belongs to the instance and may get edited in place, so it gets clones or copies instead.
+    bool tryLink = removeLeftovers;
+    std::atomic_bool tryClone{ true };
+    QSet<QString> createdDirs;
+    int placed = 0;
+    int linked = 0;
+    int failed = 0;
+
+    for (auto it = index.objects.constBegin(); it != index.objects.constEnd(); ++it) {
+        const QString& relPath = it.key();
+        const QString& hash = it.value().hash;
+        if (!isSafeRelativePath(relPath)) {
+            qWarning() << "Skipping asset with unsafe path" << relPath;
+            continue;
+        }
+        const QString targetFile = FS::PathCombine(targetPath, relPath);
 
-            QString original_path = FS::PathCombine(objectDir.path(), tlk, asset_object.hash);
-            QFile original(original_path);
-            if (!original.exists())
-                continue;
+        // placed by an earlier reconstruction and unchanged since, no need to look at it again
+        auto before = previous.objects.constFind(relPath);
+        if (before != previous.objects.constEnd() && *before == hash) {
+            stamp.objects.insert(relPath, hash);
+            continue;
+        }
 
-            presentFiles.remove(target_path);
+        const QString originalPath = FS::PathCombine(objectDir.path(), hash.left(2), hash);
+        QFileInfo original(originalPath);
+        if (!original.isFile()) {
+            // not downloaded (yet), try again next time
+            stamp.complete = false;
+            continue;
+        }
 
-            if (!target.exists()) {
-                QFileInfo info(target_path);
-                QDir target_dir = info.dir();
+        QFileInfo target(targetFile);
+        if (target.exists()) {
+            // left over by an older launcher version, or the index changed what this path should be
+            if (before == previous.objects.constEnd() && target.size() == it.value().size) {
+                stamp.objects.insert(relPath, hash);
+                continue;
+            }
+            QFile::remove(targetFile);
+        }
 
-                qDebug() << target_dir.path();
-                FS::ensureFolderPathExists(target_dir.path());
+        const QString targetDir = target.path();
+        if (!createdDirs.contains(targetDir)) {
+            FS::ensureFolderPathExists(targetDir);
+            createdDirs.insert(targetDir);
+        }
 
-                bool couldCopy = original.copy(target_path);
-                qDebug() << " Copying" << original_path << "to" << target_path << QString::number(couldCopy);
+        std::error_code ec;
+        bool ok = false;
+        if (tryLink) {
+            ok = FS::hard_link_file(originalPath, targetFile, ec);
+            if (ok) {
+                linked++;
+            } else {
+                // most likely a different filesystem, which won't change for the next file either
+                qDebug() << "Could not hard link assets, falling back to copies:" << QString::fromStdString(ec.message());
+                tryLink = false;
+                ec.clear();
             }
         }
+        if (!ok) {
+            ok = FS::copy_file(originalPath, targetFile, tryClone, ec);
+        }
+        if (ok) {
+            placed++;
+            stamp.objects.insert(relPath, hash);
+        } else {
+            qWarning() << "Failed to reconstruct asset" << relPath << ":" << QString::fromStdString(ec.message());
+            failed++;
+            stamp.complete = false;
+        }
+    }
 
-        // TODO: Write last used time to virtualRoot/.lastused
-        if (removeLeftovers) {
-            for (auto& file : presentFiles) {
-                qDebug() << "Would remove" << file;
+    // only ever remove files that an earlier reconstruction put there itself
+    int removed = 0;
+    if (removeLeftovers) {
+        for (auto it = previous.objects.constBegin(); it != previous.objects.constEnd(); ++it) {
+            if (!stamp.objects.contains(it.key()) && !index.objects.contains(it.key())) {
+                if (QFile::remove(FS::PathCombine(targetPath, it.key())))
+                    removed++;
             }
         }
     }
-    return true;
+
+    qDebug() << "Reconstructed assets:" << placed << "placed (" << linked << "hard linked )," << removed << "removed," << failed
+             << "failed";
+    writeStamp(stampPath, stamp);
+    return failed == 0;
 }
 
 }  // namespace AssetsUtils
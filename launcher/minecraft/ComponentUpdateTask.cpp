@@ -164,6 +164,9 @@ void ComponentUpdateTask::loadComponents()
         result = composeLoadResult(result, singleResult);
         if (indexLoadTask) {
             qDebug() << "Remote loading is being run for metadata index";
+            // the load may be shared with other updates, the first one gets to show it in the task trace
+            if (indexLoadTask->parentTaskUid().isNull())
+                indexLoadTask->setParentTask(this);
             RemoteLoadStatus status;
             status.type = RemoteLoadStatus::Type::Index;
             d->remoteLoadStatusList.append(status);
@@ -206,6 +209,8 @@ void ComponentUpdateTask::loadComponents()
         result = composeLoadResult(result, singleResult);
         if (loadTask) {
             qDebug() << "Remote loading is being run for" << component->getName();
+            if (loadTask->parentTaskUid().isNull())
+                loadTask->setParentTask(this);
             connect(loadTask.get(), &Task::succeeded, [=]() { remoteLoadSucceeded(taskIndex); });
             connect(loadTask.get(), &Task::failed, [=](const QString& error) { remoteLoadFailed(taskIndex, error); });
             connect(loadTask.get(), &Task::aborted, [=]() { remoteLoadFailed(taskIndex, tr("Aborted")); });
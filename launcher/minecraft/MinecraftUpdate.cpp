@@ -107,6 +107,7 @@ void MinecraftUpdate::next()
         qCritical() << "MinecraftUpdate: Skipping finished subtask" << m_currentTask << ":" << task.get();
         next();
     }
+    task->setParentTask(this);
     connect(task.get(), &Task::succeeded, this, &MinecraftUpdate::subtaskSucceeded);
     connect(task.get(), &Task::failed, this, &MinecraftUpdate::subtaskFailed);
     connect(task.get(), &Task::aborted, this, &Task::abort);
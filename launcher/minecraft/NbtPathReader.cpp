@@ -0,0 +1,293 @@
+#include "NbtPathReader.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+// deeper than anything the game writes, and shallow enough not to run out of stack
+constexpr int maxDepth = 512;
+
+int fixedSize(NbtPathReader::TagType type)
+{
+    switch (type) {
+        case NbtPathReader::Byte:
+            return 1;
+        case NbtPathReader::Short:
+            return 2;
+        case NbtPathReader::Int:
+        case NbtPathReader::Float:
+            return 4;
+        case NbtPathReader::Long:
+        case NbtPathReader::Double:
+            return 8;
+        default:
+            return 0;
+    }
+}
+}  // namespace
+
+NbtPathReader::NbtPathReader(const QStringList& paths)
+{
+    for (auto& path : paths) {
+        m_wanted.insert(path);
+        for (int dot = path.indexOf('.'); dot != -1; dot = path.indexOf('.', dot + 1)) {
+            m_prefixes.insert(path.left(dot));
+        }
+    }
+}
+
+NbtPathReader::TagType NbtPathReader::type(const QString& path) const
+{
+    auto it = m_found.constFind(path);
+    return it == m_found.constEnd() ? End : it->type;
+}
+
+QVariant NbtPathReader::value(const QString& path) const
+{
+    return m_found.value(path).value;
+}
+
+bool NbtPathReader::read(QIODevice* device)
+{
+    m_device = device;
+    m_found.clear();
+    m_error.clear();
+
+    quint8 type;
+    if (!readNumber(type)) {
+        return false;
+    }
+    if (type != Compound) {
+        return fail("The document doesn't start with a compound");
+    }
+    QString rootName;
+    if (!readName(rootName)) {
+        return false;
+    }
+    readCompound(QString(), 0);
+    m_device = nullptr;
+    return m_error.isEmpty();
+}
+
+// returns false when reading should stop, either because something went wrong or because everything was found
+bool NbtPathReader::readCompound(const QString& prefix, int depth)
+{
+    if (depth > maxDepth) {
+        return fail("The document is nested too deeply");
+    }
+    for (;;) {
+        quint8 type;
+        if (!readNumber(type)) {
+            return false;
+        }
+        if (type == End) {
+            return true;
+        }
+        QString name;
+        if (!readName(name)) {
+            return false;
+        }
+        const auto path = prefix.isEmpty() ? name : prefix + '.' + name;
+        const auto tagType = static_cast<TagType>(type);
+
+        if (tagType == Compound && m_prefixes.contains(path)) {
+            if (m_wanted.contains(path)) {
+                m_found.insert(path, { tagType, {} });
+            }
+            if (!readCompound(path, depth + 1)) {
+                return false;
+            }
+        } else if (m_wanted.contains(path)) {
+            QVariant value;
+            if (!readPayload(tagType, value)) {
+                return false;
+            }
+            m_found.insert(path, { tagType, value });
+        } else if (!skip(tagType, depth)) {
+            return false;
+        }
+
+        if (m_found.size() == m_wanted.size()) {
+            return false;
+        }
+    }
+}
+
+bool NbtPathReader::readPayload(TagType type, QVariant& value)
+{
+    switch (type) {
+        case Byte: {
+            qint8 number;
+            if (!readNumber(number)) {
+                return false;
+            }
+            value = int(number);
+            return true;
+        }
+        case Short: {
+            qint16 number;
+            if (!readNumber(number)) {
+                return false;
+            }
+            value = int(number);
+            return true;
+        }
+        case Int: {
+            qint32 number;
+            if (!readNumber(number)) {
+                return false;
+            }
+            value = int(number);
+            return true;
+        }
+        case Long: {
+            qint64 number;
+            if (!readNumber(number)) {
+                return false;
+            }
+            value = qlonglong(number);
+            return true;
+        }
+        case Float: {
+            quint32 bits;
+            if (!readNumber(bits)) {
+                return false;
+            }
+            float number;
+            std::memcpy(&number, &bits, sizeof(number));
+            value = number;
+            return true;
+        }
+        case Double: {
+            quint64 bits;
+            if (!readNumber(bits)) {
+                return false;
+            }
+            double number;
+            std::memcpy(&number, &bits, sizeof(number));
+            value = number;
+            return true;
+        }
+        case String: {
+            QString string;
+            if (!readName(string)) {
+                return false;
+            }
+            value = string;
+            return true;
+        }
+        default:
+            // only numbers and strings are read, the rest is just recorded as being there
+            return skip(type, 0);
+    }
+}
+
+bool NbtPathReader::skip(TagType type, int depth)
+{
+    if (depth > maxDepth) {
+        return fail("The document is nested too deeply");
+    }
+    if (auto size = fixedSize(type)) {
+        return skipBytes(size);
+    }
+    switch (type) {
+        case String: {
+            quint16 length;
+            return readNumber(length) && skipBytes(length);
+        }
+        case ByteArray:
+        case IntArray:
+        case LongArray: {
+            qint32 count;
+            if (!readNumber(count)) {
+                return false;
+            }
+            if (count < 0) {
+                return fail("Negative array length");
+            }
+            const qint64 elementSize = type == ByteArray ? 1 : type == IntArray ? 4 : 8;
+            return skipBytes(count * elementSize);
+        }
+        case List: {
+            quint8 elementType;
+            qint32 count;
+            if (!readNumber(elementType) || !readNumber(count)) {
+                return false;
+            }
+            if (count < 0) {
+                return fail("Negative list length");
+            }
+            if (auto size = fixedSize(static_cast<TagType>(elementType))) {
+                return skipBytes(qint64(count) * size);
+            }
+            for (qint32 i = 0; i < count; i++) {
+                if (!skip(static_cast<TagType>(elementType), depth + 1)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case Compound: {
+            for (;;) {
+                quint8 childType;
+                if (!readNumber(childType)) {
+                    return false;
+                }
+                if (childType == End) {
+                    return true;
+                }
+                quint16 nameLength;
+                if (!readNumber(nameLength) || !skipBytes(nameLength) || !skip(static_cast<TagType>(childType), depth + 1)) {
+                    return false;
+                }
+            }
+        }
+        case End:
+            // only empty lists have elements of this type
+            return true;
+        default:
+            return fail(QString("Unknown tag type %1").arg(int(type)));
+    }
+}
+
+bool NbtPathReader::skipBytes(qint64 count)
+{
+    if (count > 0 && m_device->skip(count) != count) {
+        return fail("Unexpected end of the document");
+    }
+    return true;
+}
+
+bool NbtPathReader::readName(QString& name)
+{
+    quint16 length;
+    if (!readNumber(length)) {
+        return false;
+    }
+    m_nameBuffer.resize(length);
+    if (length > 0 && m_device->read(m_nameBuffer.data(), length) != length) {
+        return fail("Unexpected end of the document");
+    }
+    name = QString::fromUtf8(m_nameBuffer);
+    return true;
+}
+
+template <typename T>
+bool NbtPathReader::readNumber(T& value)
+{
+    T bigEndian;
+    if (m_device->read(reinterpret_cast<char*>(&bigEndian), sizeof(T)) != sizeof(T)) {
+        return fail("Unexpected end of the document");
+    }
+    value = qFromBigEndian(bigEndian);
+    return true;
+}
+
+bool NbtPathReader::fail(const QString& error)
+{
+    if (m_error.isEmpty()) {
+        m_error = error;
+    }
+    return false;
+}
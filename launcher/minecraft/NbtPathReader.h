@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QHash>
+#include <QIODevice>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+/**
+ * Picks a few values out of an (uncompressed) NBT document as it's read, without building the document up in memory.
+ * Everything that isn't on the way to one of the wanted paths is skipped over, and reading stops as soon as all of them
+ * were found.
+ *
+ * A path is the names leading to a tag below the root compound, joined by dots, like "Data.WorldGenSettings.seed".
+ */
+class NbtPathReader {
+   public:
+    enum TagType : quint8 {
+        End = 0,
+        Byte,
+        Short,
+        Int,
+        Long,
+        Float,
+        Double,
+        ByteArray,
+        String,
+        List,
+        Compound,
+        IntArray,
+        LongArray,
+    };
+
+    explicit NbtPathReader(const QStringList& paths);
+
+    //! Reads the document from the device, up to the last of the wanted paths. Fails if what's read of it is malformed.
+    bool read(QIODevice* device);
+    QString errorString() const { return m_error; }
+
+    //! The type of the tag at the path, or End if there's none.
+    TagType type(const QString& path) const;
+    //! The value of the number or string at the path, as an int (Byte, Short and Int), qlonglong, float, double or QString.
+    QVariant value(const QString& path) const;
+
+   private:
+    struct Tag {
+        TagType type;
+        QVariant value;
+    };
+
+    bool readCompound(const QString& prefix, int depth);
+    bool readPayload(TagType type, QVariant& value);
+    bool skip(TagType type, int depth);
+    bool skipBytes(qint64 count);
+    bool readName(QString& name);
+    template <typename T>
+    bool readNumber(T& value);
+    bool fail(const QString& error);
+
+    QSet<QString> m_wanted;
+    //! the compounds the wanted paths are in
+    QSet<QString> m_prefixes;
+
+    QIODevice* m_device = nullptr;
+    QHash<QString, Tag> m_found;
+    QString m_error;
+    QByteArray m_nameBuffer;
+};
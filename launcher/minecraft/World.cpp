@@ -51,6 +51,7 @@
 #include <tag_string.h>
 #include <sstream>
 #include "GZip.h"
+#include "NbtPathReader.h"
 
 #include <QCoreApplication>
 
@@ -250,12 +251,17 @@ bool World::resetIcon()
 
 void World::readFromFS(const QFileInfo& file)
 {
-    auto bytes = getLevelDatDataFromFS(file);
-    if (bytes.isEmpty()) {
+    auto fullFilePath = getLevelDatFromFS(file);
+    if (fullFilePath.isNull()) {
+        is_valid = false;
+        return;
+    }
+    QFile levelDat(fullFilePath);
+    if (!levelDat.open(QIODevice::ReadOnly) || levelDat.size() == 0) {
         is_valid = false;
         return;
     }
-    loadFromLevelDat(bytes);
+    loadFromLevelDat(&levelDat);
     levelDatTime = file.lastModified();
 }
 
@@ -289,7 +295,7 @@ void World::readFromZip(const QFileInfo& file)
     if (!is_valid) {
         return;
     }
-    loadFromLevelDat(zippedFile.readAll());
+    loadFromLevelDat(&zippedFile);
     zippedFile.close();
 }
 
@@ -359,111 +365,87 @@ bool World::rename(const QString& newName)
 
 namespace {
 
-optional<QString> read_string(nbt::value& parent, const char* name)
+optional<QString> read_string(const NbtPathReader& levelDat, const QString& path)
 {
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::String) {
+    switch (levelDat.type(path)) {
+        case NbtPathReader::String:
+            return levelDat.value(path).toString();
+        case NbtPathReader::End:
+            // fallback for old world formats
+            qWarning() << "String NBT tag" << path << "could not be found.";
+            return nullopt;
+        default:
             return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_string>();
-        return QString::fromStdString(tag_str.get());
-    } catch (const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "String NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch (const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to string.";
-        return nullopt;
     }
 }
 
-optional<int64_t> read_long(nbt::value& parent, const char* name)
+optional<int64_t> read_long(const NbtPathReader& levelDat, const QString& path)
 {
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Long) {
+    switch (levelDat.type(path)) {
+        case NbtPathReader::Long:
+            return levelDat.value(path).toLongLong();
+        case NbtPathReader::End:
+            // fallback for old world formats
+            qWarning() << "Long NBT tag" << path << "could not be found.";
+            return nullopt;
+        default:
             return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_long>();
-        return tag_str.get();
-    } catch (const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Long NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch (const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to long.";
-        return nullopt;
     }
 }
 
-optional<int> read_int(nbt::value& parent, const char* name)
+optional<int> read_int(const NbtPathReader& levelDat, const QString& path)
 {
-    try {
-        auto& namedValue = parent.at(name);
-        if (namedValue.get_type() != nbt::tag_type::Int) {
+    switch (levelDat.type(path)) {
+        case NbtPathReader::Int:
+            return levelDat.value(path).toInt();
+        case NbtPathReader::End:
+            // fallback for old world formats
+            qWarning() << "Int NBT tag" << path << "could not be found.";
+            return nullopt;
+        default:
             return nullopt;
-        }
-        auto& tag_str = namedValue.as<nbt::tag_int>();
-        return tag_str.get();
-    } catch (const std::out_of_range& e) {
-        // fallback for old world formats
-        qWarning() << "Int NBT tag" << name << "could not be found.";
-        return nullopt;
-    } catch (const std::bad_cast& e) {
-        // type mismatch
-        qWarning() << "NBT tag" << name << "could not be converted to int.";
-        return nullopt;
     }
 }
 
-GameType read_gametype(nbt::value& parent, const char* name)
+GameType read_gametype(const NbtPathReader& levelDat, const QString& path)
 {
-    return GameType(read_int(parent, name));
+    return GameType(read_int(levelDat, path));
 }
 
 }  // namespace
 
-void World::loadFromLevelDat(QByteArray data)
+void World::loadFromLevelDat(QIODevice* levelDatFile)
 {
-    auto levelData = parseLevelDat(data);
-    if (!levelData) {
+    // only the few fields shown are read, without inflating or parsing anything that comes after them
+    GZipReader uncompressed(levelDatFile);
+    NbtPathReader levelDat({ "Data", "Data.LevelName", "Data.LastPlayed", "Data.GameType", "Data.WorldGenSettings",
+                             "Data.WorldGenSettings.seed", "Data.RandomSeed" });
+    if (!uncompressed.open(QIODevice::ReadOnly) || !levelDat.read(&uncompressed)) {
+        qWarning() << "Unable to parse level.dat of" << m_folderName << ":" << levelDat.errorString();
         is_valid = false;
         return;
     }
 
-    nbt::value* valPtr = nullptr;
-    try {
-        valPtr = &levelData->at("Data");
-    } catch (const std::out_of_range& e) {
-        qWarning() << "Unable to read NBT tags from " << m_folderName << ":" << e.what();
-        is_valid = false;
+    is_valid = levelDat.type("Data") == NbtPathReader::Compound;
+    if (!is_valid) {
+        qWarning() << "Unable to read NBT tags from " << m_folderName << ": no Data compound";
         return;
     }
-    nbt::value& val = *valPtr;
-
-    is_valid = val.get_type() == nbt::tag_type::Compound;
-    if (!is_valid)
-        return;
 
-    auto name = read_string(val, "LevelName");
+    auto name = read_string(levelDat, "Data.LevelName");
     m_actualName = name ? *name : m_folderName;
 
-    auto timestamp = read_long(val, "LastPlayed");
+    auto timestamp = read_long(levelDat, "Data.LastPlayed");
     m_lastPlayed = timestamp ? QDateTime::fromMSecsSinceEpoch(*timestamp) : levelDatTime;
 
-    m_gameType = read_gametype(val, "GameType");
+    m_gameType = read_gametype(levelDat, "Data.GameType");
 
     optional<int64_t> randomSeed;
-    try {
-        auto& WorldGen_val = val.at("WorldGenSettings");
-        randomSeed = read_long(WorldGen_val, "seed");
-    } catch (const std::out_of_range&) {
+    if (levelDat.type("Data.WorldGenSettings") == NbtPathReader::Compound) {
+        randomSeed = read_long(levelDat, "Data.WorldGenSettings.seed");
     }
     if (!randomSeed) {
-        randomSeed = read_long(val, "RandomSeed");
+        randomSeed = read_long(levelDat, "Data.RandomSeed");
     }
     m_randomSeed = randomSeed ? *randomSeed : 0;
 
@@ -18,6 +18,8 @@
 #include <QFileInfo>
 #include <optional>
 
+class QIODevice;
+
 struct GameType {
     GameType() = default;
     GameType(std::optional<int> original);
@@ -75,7 +77,7 @@ class World {
    private:
     void readFromZip(const QFileInfo& file);
     void readFromFS(const QFileInfo& file);
-    void loadFromLevelDat(QByteArray data);
+    void loadFromLevelDat(QIODevice* levelDatFile);
 
    protected:
     QFileInfo m_containerFile;
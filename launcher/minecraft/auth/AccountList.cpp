@@ -693,8 +693,26 @@ void AccountList::tryNext()
         }
         qDebug() << "RefreshSchedule: Account with with internal ID " << accountId << " not found.";
     }
-    // if we get here, no account needed refreshing. Schedule refresh in an hour.
-    m_refreshTimer->start(1000 * 3600);
+    // if we get here, no account needed refreshing. Schedule refresh for when the next one does.
+    m_refreshTimer->start(nextRefreshInterval());
+}
+
+int AccountList::nextRefreshInterval() const
+{
+    // check at least every hour, timers don't know about the machine sleeping in the meantime
+    qint64 interval = 1000 * 3600;
+    auto now = QDateTime::currentDateTimeUtc();
+    for (auto& account : m_accounts) {
+        // accounts in use get checked again on the regular schedule after the game closed
+        if (account->isOffline() || account->isInUse() || account->accountData()->validity_ == Katabasis::Validity::None) {
+            continue;
+        }
+        auto due = account->refreshDueAt();
+        if (due.isValid()) {
+            interval = qMin(interval, now.msecsTo(due));
+        }
+    }
+    return int(qMax<qint64>(interval, 1000 * 60));
 }
 
 void AccountList::authSucceeded()
@@ -112,6 +112,9 @@ class AccountList : public QAbstractListModel {
     void endActivity();
 
    private:
+    //! Milliseconds until the next account is due for a refresh.
+    int nextRefreshInterval() const;
+
     const char* m_name;
     uint32_t m_activityCount = 0;
    signals:
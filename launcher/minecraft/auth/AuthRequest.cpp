@@ -44,14 +44,30 @@
 #include "AuthRequest.h"
 #include "katabasis/Globals.h"
 
+namespace {
+QUrl s_testServer;
+QNetworkAccessManager* s_testNetwork = nullptr;
+}  // namespace
+
 AuthRequest::AuthRequest(QObject* parent) : QObject(parent) {}
 
 AuthRequest::~AuthRequest() {}
 
+void AuthRequest::redirectForTesting(const QUrl& server, QNetworkAccessManager* network)
+{
+    s_testServer = server;
+    s_testNetwork = server.isValid() ? network : nullptr;
+}
+
+QNetworkAccessManager* AuthRequest::network()
+{
+    return s_testNetwork ? s_testNetwork : APPLICATION->network().get();
+}
+
 void AuthRequest::get(const QNetworkRequest& req, int timeout /* = 60*1000*/)
 {
     setup(req, QNetworkAccessManager::GetOperation);
-    reply_ = APPLICATION->network()->get(request_);
+    reply_ = network()->get(request_);
     status_ = Requesting;
     timedReplies_.add(new Katabasis::Reply(reply_, timeout));
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)  // QNetworkReply::errorOccurred added in 5.15
@@ -68,7 +84,7 @@ void AuthRequest::post(const QNetworkRequest& req, const QByteArray& data, int t
     setup(req, QNetworkAccessManager::PostOperation);
     data_ = data;
     status_ = Requesting;
-    reply_ = APPLICATION->network()->post(request_, data_);
+    reply_ = network()->post(request_, data_);
     timedReplies_.add(new Katabasis::Reply(reply_, timeout));
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)  // QNetworkReply::errorOccurred added in 5.15
     connect(reply_, &QNetworkReply::errorOccurred, this, &AuthRequest::onRequestError);
@@ -146,6 +162,11 @@ void AuthRequest::setup(const QNetworkRequest& req, QNetworkAccessManager::Opera
     url_ = req.url();
 
     QUrl url = url_;
+    if (s_testServer.isValid()) {
+        url = s_testServer;
+        url.setPath('/' + url_.host() + url_.path());
+        url.setQuery(url_.query());
+    }
     request_.setUrl(url);
 
     if (!verb.isEmpty()) {
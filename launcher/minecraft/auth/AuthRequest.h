@@ -16,6 +16,10 @@ class AuthRequest : public QObject {
     explicit AuthRequest(QObject* parent = 0);
     ~AuthRequest();
 
+    /// Sends all requests to the given server through the given network manager, with the original host prepended to the path.
+    /// Only meant for testing against a local fake auth server. An invalid URL restores the normal behavior.
+    static void redirectForTesting(const QUrl& server, QNetworkAccessManager* network);
+
    public slots:
     void get(const QNetworkRequest& req, int timeout = 60 * 1000);
     void post(const QNetworkRequest& req, const QByteArray& data, int timeout = 60 * 1000);
@@ -51,6 +55,8 @@ class AuthRequest : public QObject {
     QString errorString_;
 
    protected:
+    static QNetworkAccessManager* network();
+
     void setup(const QNetworkRequest& request, QNetworkAccessManager::Operation operation, const QByteArray& verb = QByteArray());
 
     enum Status { Idle, Requesting, ReRequesting };
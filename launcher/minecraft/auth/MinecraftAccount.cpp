@@ -53,6 +53,11 @@
 #include "flows/Mojang.h"
 #include "flows/Offline.h"
 
+namespace {
+// tokens can't be replaced while the game uses them, so refresh early enough for a long session (fresh tokens last 24 hours)
+constexpr int REFRESH_MARGIN_SECS = 12 * 3600;
+}  // namespace
+
 MinecraftAccount::MinecraftAccount(QObject* parent) : QObject(parent)
 {
     data.internalId = QUuid::createUuid().toString().remove(QRegularExpression("[{}-]"));
@@ -189,6 +194,31 @@ shared_qobject_ptr<AccountTask> MinecraftAccount::refresh()
     return m_currentTask;
 }
 
+shared_qobject_ptr<AccountTask> MinecraftAccount::validate()
+{
+    if (m_currentTask) {
+        return m_currentTask;
+    }
+    if (data.type != AccountType::MSA) {
+        return nullptr;
+    }
+
+    m_currentTask.reset(new MSAValidate(&data));
+    connect(m_currentTask.get(), &Task::succeeded, this, &MinecraftAccount::authSucceeded);
+    connect(m_currentTask.get(), &Task::failed, this, [this](QString reason) {
+        // the servers turned the stored token down, so it can't be launched with again
+        if (m_currentTask->taskState() == AccountTaskState::STATE_FAILED_SOFT) {
+            data.yggdrasilToken.token = QString();
+            data.yggdrasilToken.validity = Katabasis::Validity::None;
+            emit changed();
+        }
+        authFailed(reason);
+    });
+    connect(m_currentTask.get(), &Task::aborted, this, [this] { authFailed(tr("Aborted")); });
+    emit activityChanged(true);
+    return m_currentTask;
+}
+
 shared_qobject_ptr<AccountTask> MinecraftAccount::currentTask()
 {
     return m_currentTask;
@@ -247,8 +277,9 @@ bool MinecraftAccount::shouldRefresh() const
 {
     /*
      * Never refresh accounts that are being used by the game, it breaks the game session.
-     * Always refresh accounts that have not been refreshed yet during this session.
      * Don't refresh broken accounts.
+     * MSA tokens carry their expiry, so those that were not checked yet are trusted until they are due.
+     * Always refresh other accounts that have not been refreshed yet during this session.
      * Refresh accounts that would expire in the next 12 hours (fresh token validity is 24 hours).
      */
     if (isInUse()) {
@@ -262,20 +293,37 @@ bool MinecraftAccount::shouldRefresh() const
             return false;
         }
         case Katabasis::Validity::Assumed: {
-            return true;
+            if (!isMSA() || !data.yggdrasilToken.notAfter.isValid()) {
+                return true;
+            }
+            break;
         }
     }
-    auto now = QDateTime::currentDateTimeUtc();
-    auto issuedTimestamp = data.yggdrasilToken.issueInstant;
-    auto expiresTimestamp = data.yggdrasilToken.notAfter;
+    auto due = refreshDueAt();
+    return !due.isValid() || QDateTime::currentDateTimeUtc() >= due;
+}
 
+QDateTime MinecraftAccount::refreshDueAt() const
+{
+    auto expiresTimestamp = data.yggdrasilToken.notAfter;
     if (!expiresTimestamp.isValid()) {
-        expiresTimestamp = issuedTimestamp.addSecs(24 * 3600);
+        expiresTimestamp = data.yggdrasilToken.issueInstant.addSecs(24 * 3600);
     }
-    if (now.secsTo(expiresTimestamp) < (12 * 3600)) {
-        return true;
+    if (!expiresTimestamp.isValid()) {
+        return {};
+    }
+    return expiresTimestamp.addSecs(-REFRESH_MARGIN_SECS);
+}
+
+bool MinecraftAccount::canLaunchWithStoredToken() const
+{
+    // we also need to know what the account owns, which the token alone doesn't tell
+    if (!isMSA() || data.validity_ == Katabasis::Validity::None || data.yggdrasilToken.token.isEmpty() ||
+        data.yggdrasilToken.validity == Katabasis::Validity::None || !data.yggdrasilToken.notAfter.isValid() ||
+        data.minecraftEntitlement.validity == Katabasis::Validity::None) {
+        return false;
     }
-    return false;
+    return QDateTime::currentDateTimeUtc() < refreshDueAt();
 }
 
 void MinecraftAccount::fillSession(AuthSessionPtr session)
@@ -112,6 +112,12 @@ class MinecraftAccount : public QObject, public Usable {
 
     shared_qobject_ptr<AccountTask> refresh();
 
+    /**
+     * Checks the stored token of an MSA account by fetching the account details with it.
+     * Doesn't replace the token, so this is fine while the game uses it. Returns nullptr for other accounts.
+     */
+    shared_qobject_ptr<AccountTask> validate();
+
     shared_qobject_ptr<AccountTask> currentTask();
 
    public: /* queries */
@@ -169,6 +175,12 @@ class MinecraftAccount : public QObject, public Usable {
 
     bool shouldRefresh() const;
 
+    //! When the token should be refreshed in the background, which is well before it actually expires.
+    QDateTime refreshDueAt() const;
+
+    //! Whether the stored token and account details can be trusted to launch the game without contacting the servers first.
+    bool canLaunchWithStoredToken() const;
+
     void fillSession(AuthSessionPtr session);
 
     QString lastError() const { return data.lastError(); }
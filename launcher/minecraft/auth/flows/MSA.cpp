@@ -5,32 +5,44 @@
 #include "minecraft/auth/steps/LauncherLoginStep.h"
 #include "minecraft/auth/steps/MSAStep.h"
 #include "minecraft/auth/steps/MinecraftProfileStep.h"
+#include "minecraft/auth/steps/ParallelStep.h"
 #include "minecraft/auth/steps/XboxAuthorizationStep.h"
 #include "minecraft/auth/steps/XboxProfileStep.h"
 #include "minecraft/auth/steps/XboxUserStep.h"
 
-MSASilent::MSASilent(AccountData* data, QObject* parent) : AuthFlow(data, parent)
+void MSAFlow::appendAccountDetailSteps(bool withXboxProfile)
+{
+    // these only need the Minecraft token and don't depend on each other, except for the skin coming from the profile
+    QList<QList<AuthStep::Ptr>> chains;
+    if (withXboxProfile) {
+        chains.append(QList<AuthStep::Ptr>{ makeShared<XboxProfileStep>(m_data) });
+    }
+    chains.append(QList<AuthStep::Ptr>{ makeShared<EntitlementsStep>(m_data) });
+    chains.append(QList<AuthStep::Ptr>{ makeShared<MinecraftProfileStep>(m_data), makeShared<GetSkinStep>(m_data) });
+    m_steps.append(makeShared<ParallelStep>(m_data, chains));
+}
+
+MSASilent::MSASilent(AccountData* data, QObject* parent) : MSAFlow(data, parent)
 {
     m_steps.append(makeShared<MSAStep>(m_data, MSAStep::Action::Refresh));
     m_steps.append(makeShared<XboxUserStep>(m_data));
     m_steps.append(makeShared<XboxAuthorizationStep>(m_data, &m_data->xboxApiToken, "http://xboxlive.com", "Xbox"));
     m_steps.append(makeShared<XboxAuthorizationStep>(m_data, &m_data->mojangservicesToken, "rp://api.minecraftservices.com/", "Mojang"));
     m_steps.append(makeShared<LauncherLoginStep>(m_data));
-    m_steps.append(makeShared<XboxProfileStep>(m_data));
-    m_steps.append(makeShared<EntitlementsStep>(m_data));
-    m_steps.append(makeShared<MinecraftProfileStep>(m_data));
-    m_steps.append(makeShared<GetSkinStep>(m_data));
+    appendAccountDetailSteps();
 }
 
-MSAInteractive::MSAInteractive(AccountData* data, QObject* parent) : AuthFlow(data, parent)
+MSAInteractive::MSAInteractive(AccountData* data, QObject* parent) : MSAFlow(data, parent)
 {
     m_steps.append(makeShared<MSAStep>(m_data, MSAStep::Action::Login));
     m_steps.append(makeShared<XboxUserStep>(m_data));
     m_steps.append(makeShared<XboxAuthorizationStep>(m_data, &m_data->xboxApiToken, "http://xboxlive.com", "Xbox"));
     m_steps.append(makeShared<XboxAuthorizationStep>(m_data, &m_data->mojangservicesToken, "rp://api.minecraftservices.com/", "Mojang"));
     m_steps.append(makeShared<LauncherLoginStep>(m_data));
-    m_steps.append(makeShared<XboxProfileStep>(m_data));
-    m_steps.append(makeShared<EntitlementsStep>(m_data));
-    m_steps.append(makeShared<MinecraftProfileStep>(m_data));
-    m_steps.append(makeShared<GetSkinStep>(m_data));
+    appendAccountDetailSteps();
+}
+
+MSAValidate::MSAValidate(AccountData* data, QObject* parent) : MSAFlow(data, parent)
+{
+    appendAccountDetailSteps(false);
 }
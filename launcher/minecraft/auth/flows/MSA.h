@@ -1,14 +1,34 @@
 #pragma once
 #include "AuthFlow.h"
 
-class MSAInteractive : public AuthFlow {
+class MSAFlow : public AuthFlow {
+    Q_OBJECT
+   public:
+    using AuthFlow::AuthFlow;
+
+   protected:
+    //! Fetches the entitlements, the Minecraft profile and the skin at the same time.
+    void appendAccountDetailSteps(bool withXboxProfile = true);
+};
+
+class MSAInteractive : public MSAFlow {
     Q_OBJECT
    public:
     explicit MSAInteractive(AccountData* data, QObject* parent = 0);
 };
 
-class MSASilent : public AuthFlow {
+class MSASilent : public MSAFlow {
     Q_OBJECT
    public:
     explicit MSASilent(AccountData* data, QObject* parent = 0);
 };
+
+/**
+ * Checks the stored Minecraft token by fetching the account details with it, without getting a new one.
+ * Unlike a refresh, this doesn't disturb a game that is already using the token.
+ */
+class MSAValidate : public MSAFlow {
+    Q_OBJECT
+   public:
+    explicit MSAValidate(AccountData* data, QObject* parent = 0);
+};
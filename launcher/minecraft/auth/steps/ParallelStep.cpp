@@ -0,0 +1,112 @@
+#include "ParallelStep.h"
+
+#include <QDebug>
+#include <QStringList>
+
+namespace {
+// how bad a resulting state is, the worst one of all chains is what the flow gets to see
+int severity(AccountTaskState state)
+{
+    switch (state) {
+        case AccountTaskState::STATE_CREATED:
+        case AccountTaskState::STATE_WORKING:
+        case AccountTaskState::STATE_SUCCEEDED:
+            return 0;
+        case AccountTaskState::STATE_OFFLINE:
+            return 1;
+        case AccountTaskState::STATE_FAILED_SOFT:
+            return 2;
+        case AccountTaskState::STATE_DISABLED:
+            return 3;
+        case AccountTaskState::STATE_FAILED_HARD:
+            return 4;
+        case AccountTaskState::STATE_FAILED_GONE:
+            return 5;
+    }
+    return 0;
+}
+}  // namespace
+
+ParallelStep::ParallelStep(AccountData* data, QList<QList<AuthStep::Ptr>> chains) : AuthStep(data), m_chains(std::move(chains)) {}
+
+ParallelStep::~ParallelStep() noexcept = default;
+
+QString ParallelStep::describe()
+{
+    QStringList descriptions;
+    for (auto& step : m_running) {
+        if (step)
+            descriptions.append(step->describe());
+    }
+    if (descriptions.isEmpty())
+        return tr("Fetching account details.");
+    return descriptions.join(' ');
+}
+
+void ParallelStep::perform()
+{
+    m_result = AccountTaskState::STATE_WORKING;
+    m_message.clear();
+    m_running.clear();
+    for (int i = 0; i < m_chains.size(); i++)
+        m_running.append(nullptr);
+
+    m_pending = m_chains.size();
+    if (m_pending == 0) {
+        emit finished(AccountTaskState::STATE_WORKING, QString());
+        return;
+    }
+    for (int i = 0; i < m_chains.size(); i++)
+        startNext(i);
+}
+
+void ParallelStep::rehydrate()
+{
+    for (auto& chain : m_chains) {
+        for (auto& step : chain)
+            step->rehydrate();
+    }
+}
+
+void ParallelStep::startNext(int chain)
+{
+    auto& steps = m_chains[chain];
+    if (steps.isEmpty()) {
+        m_running[chain].reset();
+        if (--m_pending == 0)
+            emit finished(m_result, m_message);
+        return;
+    }
+
+    auto step = steps.takeFirst();
+    m_running[chain] = step;
+    qDebug() << "AuthFlow:" << step->describe();
+    connect(step.get(), &AuthStep::finished, this, &ParallelStep::chainStepFinished);
+    step->perform();
+}
+
+void ParallelStep::chainStepFinished(AccountTaskState resultingState, QString message)
+{
+    auto step = qobject_cast<AuthStep*>(sender());
+    int chain = -1;
+    for (int i = 0; i < m_running.size(); i++) {
+        if (m_running[i].get() == step) {
+            chain = i;
+            break;
+        }
+    }
+    if (chain < 0)
+        return;
+
+    if (severity(resultingState) > severity(m_result)) {
+        m_result = resultingState;
+        m_message = message;
+    } else if (severity(m_result) == 0) {
+        m_message = message;
+    }
+
+    // the chain is done once a step failed or decided nothing else needs doing
+    if (resultingState != AccountTaskState::STATE_WORKING)
+        m_chains[chain].clear();
+    startNext(chain);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <QList>
+#include <QObject>
+
+#include "QObjectPtr.h"
+#include "minecraft/auth/AuthStep.h"
+
+/**
+ * Runs several chains of steps at the same time, each chain in order.
+ *
+ * A chain ends at its first step that doesn't leave the flow working. The step as a whole finishes once every chain
+ * did, with the worst failure among them, or still working if all of them went through.
+ */
+class ParallelStep : public AuthStep {
+    Q_OBJECT
+
+   public:
+    explicit ParallelStep(AccountData* data, QList<QList<AuthStep::Ptr>> chains);
+    virtual ~ParallelStep() noexcept;
+
+    void perform() override;
+    void rehydrate() override;
+
+    QString describe() override;
+
+   private slots:
+    void chainStepFinished(AccountTaskState resultingState, QString message);
+
+   private:
+    void startNext(int chain);
+
+    QList<QList<AuthStep::Ptr>> m_chains;
+    QList<AuthStep::Ptr> m_running;
+    int m_pending = 0;
+    AccountTaskState m_result = AccountTaskState::STATE_WORKING;
+    QString m_message;
+};
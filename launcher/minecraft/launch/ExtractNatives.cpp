@@ -20,6 +20,7 @@
 #include <quazip/quazip.h>
 #include <quazip/quazipdir.h>
 #include <QDir>
+#include <QFileInfo>
 #include "FileSystem.h"
 #include "MMCZip.h"
 
@@ -39,7 +40,12 @@ static QString replaceSuffix(QString target, const QString& suffix, const QStrin
     return target + replacement;
 }
 
-static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibHack, bool nativeOpenAL, bool nativeGLFW)
+static bool unzipNatives(QString source,
+                         QString targetFolder,
+                         bool applyJnilibHack,
+                         bool nativeOpenAL,
+                         bool nativeGLFW,
+                         qint64& bytesWritten)
 {
     QuaZip zip(source);
     if (!zip.open(QuaZip::mdUnzip)) {
@@ -65,6 +71,7 @@ static bool unzipNatives(QString source, QString targetFolder, bool applyJnilibH
         if (!JlCompress::extractFile(&zip, "", absFilePath)) {
             return false;
         }
+        bytesWritten += QFileInfo(absFilePath).size();
     } while (zip.goToNextFile());
     zip.close();
     if (zip.getZipError() != 0) {
@@ -90,7 +97,11 @@ void ExtractNatives::executeTask()
     auto javaVersion = minecraftInstance->getJavaVersion();
     bool jniHackEnabled = javaVersion.major() >= 8;
     for (const auto& source : toExtract) {
-        if (!unzipNatives(source, outputPath, jniHackEnabled, nativeOpenAL, nativeGLFW)) {
+        qint64 bytesWritten = 0;
+        addBytesRead(QFileInfo(source).size());
+        bool extracted = unzipNatives(source, outputPath, jniHackEnabled, nativeOpenAL, nativeGLFW, bytesWritten);
+        addBytesWritten(bytesWritten);
+        if (!extracted) {
             const char* reason = QT_TR_NOOP("Couldn't extract native jar '%1' to destination '%2'");
             emit logLine(QString(reason).arg(source, outputPath), MessageLevel::Fatal);
             emitFailed(tr(reason).arg(source, outputPath));
@@ -39,6 +39,7 @@
 #include "launch/LaunchTask.h"
 #include "minecraft/MinecraftInstance.h"
 #include "minecraft/PackProfile.h"
+#include "minecraft/mod/Mod.h"
 
 void ModMinecraftJar::executeTask()
 {
@@ -71,6 +72,10 @@ void ModMinecraftJar::executeTask()
             emitFailed(tr("Failed to create the custom Minecraft jar file."));
             return;
         }
+        addBytesRead(QFileInfo(sourceJarPath).size());
+        for (const auto& jarMod : jarMods)
+            addBytesRead(jarMod->fileinfo().size());
+        addBytesWritten(QFileInfo(finalJarPath).size());
     }
     emitSucceeded();
 }
@@ -17,6 +17,7 @@
 
 #include <launch/LaunchStep.h>
 #include <memory>
+#include "HardwareInfo.h"
 #include "minecraft/auth/AuthSession.h"
 #include "minecraft/launch/MinecraftServerTarget.h"
 
@@ -32,6 +33,8 @@ class PrintInstanceInfo : public LaunchStep {
     virtual bool canAbort() const { return false; }
 
    private:
+    void printInfo(const HardwareInfo::Report& report);
+
     AuthSessionPtr m_session;
     MinecraftServerTargetPtr m_serverToJoin;
 };
@@ -65,24 +65,26 @@ std::pair<Version, Version> DataPack::compatibleVersions() const
     return s_pack_format_versions.constFind(m_pack_format).value();
 }
 
-std::pair<int, bool> DataPack::compare(const Resource& other, SortType type) const
+auto DataPack::sortKeys() const -> SortKeys
 {
-    auto const& cast_other = static_cast<DataPack const&>(other);
+    auto keys = Resource::sortKeys();
+    keys.packFormat = packFormat();
+    return keys;
+}
 
+std::pair<int, bool> DataPack::compare(const SortKeys& left, const SortKeys& right, SortType type) const
+{
     switch (type) {
         default: {
-            auto res = Resource::compare(other, type);
+            auto res = Resource::compare(left, right, type);
             if (res.first != 0)
                 return res;
             break;
         }
         case SortType::PACK_FORMAT: {
-            auto this_ver = packFormat();
-            auto other_ver = cast_other.packFormat();
-
-            if (this_ver > other_ver)
+            if (left.packFormat > right.packFormat)
                 return { 1, type == SortType::PACK_FORMAT };
-            if (this_ver < other_ver)
+            if (left.packFormat < right.packFormat)
                 return { -1, type == SortType::PACK_FORMAT };
             break;
         }
@@ -90,20 +92,11 @@ std::pair<int, bool> DataPack::compare(const Resource& other, SortType type) con
     return { 0, false };
 }
 
-bool DataPack::applyFilter(QRegularExpression filter) const
+QStringList DataPack::searchFields() const
 {
-    if (filter.match(description()).hasMatch())
-        return true;
-
-    if (filter.match(QString::number(packFormat())).hasMatch())
-        return true;
-
-    if (filter.match(compatibleVersions().first.toString()).hasMatch())
-        return true;
-    if (filter.match(compatibleVersions().second.toString()).hasMatch())
-        return true;
-
-    return Resource::applyFilter(filter);
+    auto versions = compatibleVersions();
+    return QStringList{ description(), QString::number(packFormat()), versions.first.toString(), versions.second.toString() } +
+           Resource::searchFields();
 }
 
 bool DataPack::valid() const
@@ -77,34 +77,35 @@ void Mod::setDetails(const ModDetails& details)
     m_local_details = details;
 }
 
-std::pair<int, bool> Mod::compare(const Resource& other, SortType type) const
+auto Mod::sortKeys() const -> SortKeys
 {
-    auto cast_other = dynamic_cast<Mod const*>(&other);
-    if (!cast_other)
-        return Resource::compare(other, type);
+    auto keys = Resource::sortKeys();
+    keys.version = Version(version());
+    keys.provider = provider().value_or("Unknown").toCaseFolded();
+    return keys;
+}
 
+std::pair<int, bool> Mod::compare(const SortKeys& left, const SortKeys& right, SortType type) const
+{
     switch (type) {
         default:
         case SortType::ENABLED:
         case SortType::NAME:
         case SortType::DATE: {
-            auto res = Resource::compare(other, type);
+            auto res = Resource::compare(left, right, type);
             if (res.first != 0)
                 return res;
             break;
         }
         case SortType::VERSION: {
-            auto this_ver = Version(version());
-            auto other_ver = Version(cast_other->version());
-            if (this_ver > other_ver)
+            if (left.version > right.version)
                 return { 1, type == SortType::VERSION };
-            if (this_ver < other_ver)
+            if (left.version < right.version)
                 return { -1, type == SortType::VERSION };
             break;
         }
         case SortType::PROVIDER: {
-            auto compare_result =
-                QString::compare(provider().value_or("Unknown"), cast_other->provider().value_or("Unknown"), Qt::CaseInsensitive);
+            auto compare_result = QString::compare(left.provider, right.provider);
             if (compare_result != 0)
                 return { compare_result, type == SortType::PROVIDER };
             break;
@@ -113,18 +114,9 @@ std::pair<int, bool> Mod::compare(const Resource& other, SortType type) const
     return { 0, false };
 }
 
-bool Mod::applyFilter(QRegularExpression filter) const
+QStringList Mod::searchFields() const
 {
-    if (filter.match(description()).hasMatch())
-        return true;
-
-    for (auto& author : authors()) {
-        if (filter.match(author).hasMatch()) {
-            return true;
-        }
-    }
-
-    return Resource::applyFilter(filter);
+    return QStringList{ description() } + authors() + Resource::searchFields();
 }
 
 auto Mod::destroy(QDir& index_dir, bool preserve_metadata, bool attempt_trash) -> bool
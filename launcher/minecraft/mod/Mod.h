@@ -88,8 +88,9 @@ class Mod : public Resource {
 
     bool valid() const override;
 
-    [[nodiscard]] auto compare(Resource const& other, SortType type) const -> std::pair<int, bool> override;
-    [[nodiscard]] bool applyFilter(QRegularExpression filter) const override;
+    [[nodiscard]] SortKeys sortKeys() const override;
+    [[nodiscard]] auto compare(SortKeys const& left, SortKeys const& right, SortType type) const -> std::pair<int, bool> override;
+    [[nodiscard]] QStringList searchFields() const override;
 
     // Delete all the files of this mod
     auto destroy(QDir& index_dir, bool preserve_metadata = false, bool attempt_trash = true) -> bool;
@@ -303,8 +303,11 @@ void ModFolderModel::onParseSucceeded(int ticket, QString mod_id)
     auto resource = find(mod_id);
 
     auto result = cast_task->result();
-    if (result && resource)
+    if (result && resource) {
         resource->finishResolvingWithDetails(std::move(result->details));
+        if (!result->icon.isNull())
+            resource->setIcon(result->icon);
+    }
 
     emit dataChanged(index(row), index(row, columnCount(QModelIndex()) - 1));
 }
@@ -56,37 +56,42 @@ void Resource::parseFile()
 
 static void removeThePrefix(QString& string)
 {
-    QRegularExpression regex(QStringLiteral("^(?:the|teh) +"), QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression regex(QStringLiteral("^(?:the|teh) +"), QRegularExpression::CaseInsensitiveOption);
     string.remove(regex);
     string = string.trimmed();
 }
 
-std::pair<int, bool> Resource::compare(const Resource& other, SortType type) const
+auto Resource::sortKeys() const -> SortKeys
+{
+    SortKeys keys;
+    keys.enabled = enabled();
+    keys.changed = dateTimeChanged();
+    keys.name = name();
+    removeThePrefix(keys.name);
+    keys.name = keys.name.toCaseFolded();
+    return keys;
+}
+
+std::pair<int, bool> Resource::compare(const SortKeys& left, const SortKeys& right, SortType type) const
 {
     switch (type) {
         default:
         case SortType::ENABLED:
-            if (enabled() && !other.enabled())
+            if (left.enabled && !right.enabled)
                 return { 1, type == SortType::ENABLED };
-            if (!enabled() && other.enabled())
+            if (!left.enabled && right.enabled)
                 return { -1, type == SortType::ENABLED };
             break;
         case SortType::NAME: {
-            QString this_name{ name() };
-            QString other_name{ other.name() };
-
-            removeThePrefix(this_name);
-            removeThePrefix(other_name);
-
-            auto compare_result = QString::compare(this_name, other_name, Qt::CaseInsensitive);
+            auto compare_result = QString::compare(left.name, right.name);
             if (compare_result != 0)
                 return { compare_result, type == SortType::NAME };
             break;
         }
         case SortType::DATE:
-            if (dateTimeChanged() > other.dateTimeChanged())
+            if (left.changed > right.changed)
                 return { 1, type == SortType::DATE };
-            if (dateTimeChanged() < other.dateTimeChanged())
+            if (left.changed < right.changed)
                 return { -1, type == SortType::DATE };
             break;
     }
@@ -96,7 +101,11 @@ std::pair<int, bool> Resource::compare(const Resource& other, SortType type) con
 
 bool Resource::applyFilter(QRegularExpression filter) const
 {
-    return filter.match(name()).hasMatch();
+    for (auto& field : searchFields()) {
+        if (filter.match(field).hasMatch())
+            return true;
+    }
+    return false;
 }
 
 bool Resource::enable(EnableAction action)
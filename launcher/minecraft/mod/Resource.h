@@ -6,6 +6,7 @@
 #include <QPointer>
 
 #include "QObjectPtr.h"
+#include "Version.h"
 
 enum class ResourceType {
     UNKNOWN,     //!< Indicates an unspecified resource type.
@@ -49,19 +50,36 @@ class Resource : public QObject {
     [[nodiscard]] virtual auto name() const -> QString { return m_name; }
     [[nodiscard]] virtual bool valid() const { return m_type != ResourceType::UNKNOWN; }
 
-    /** Compares two Resources, for sorting purposes, considering a ascending order, returning:
-     *  > 0: 'this' comes after 'other'
-     *  = 0: 'this' is equal to 'other'
-     *  < 0: 'this' comes before 'other'
+    /** What sorting goes by, normalised once so that it doesn't need to be redone for every comparison.
+     *  Only the fields the Resource has a sorting type for are set.
+     */
+    struct SortKeys {
+        bool enabled = false;
+        QDateTime changed;
+        QString name;      //!< Case folded, without a leading "the"
+        QString provider;  //!< Case folded
+        Version version;
+        int packFormat = 0;
+    };
+    [[nodiscard]] virtual SortKeys sortKeys() const;
+
+    /** Compares the sort keys of two Resources of this kind, for sorting purposes, considering a ascending order, returning:
+     *  > 0: 'left' comes after 'right'
+     *  = 0: 'left' is equal to 'right'
+     *  < 0: 'left' comes before 'right'
      *
      *  The second argument in the pair is true if the sorting type that decided which one is greater was 'type'.
      */
-    [[nodiscard]] virtual auto compare(Resource const& other, SortType type = SortType::NAME) const -> std::pair<int, bool>;
+    [[nodiscard]] virtual auto compare(SortKeys const& left, SortKeys const& right, SortType type = SortType::NAME) const
+        -> std::pair<int, bool>;
+
+    /** The texts a filter is matched against. */
+    [[nodiscard]] virtual QStringList searchFields() const { return { name() }; }
 
     /** Returns whether the given filter should filter out 'this' (false),
      *  or if such filter includes the Resource (true).
      */
-    [[nodiscard]] virtual bool applyFilter(QRegularExpression filter) const;
+    [[nodiscard]] bool applyFilter(QRegularExpression filter) const;
 
     /** Changes the enabled property, according to 'action'.
      *
@@ -8,9 +8,11 @@
 #include <QMenu>
 #include <QMimeData>
 #include <QStyle>
-#include <QThreadPool>
 #include <QUrl>
 
+#include <algorithm>
+#include <optional>
+
 #include "Application.h"
 #include "FileSystem.h"
 
@@ -22,7 +24,7 @@
 #include "ui/dialogs/CustomMessageBox.h"
 
 ResourceFolderModel::ResourceFolderModel(QDir dir, BaseInstance* instance, QObject* parent, bool create_dir)
-    : QAbstractListModel(parent), m_dir(dir), m_instance(instance), m_watcher(this)
+    : QAbstractListModel(parent), m_dir(dir), m_instance(instance)
 {
     if (create_dir) {
         FS::ensureFolderPathExists(m_dir.absolutePath());
@@ -31,14 +33,14 @@ ResourceFolderModel::ResourceFolderModel(QDir dir, BaseInstance* instance, QObje
     m_dir.setFilter(QDir::Readable | QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
     m_dir.setSorting(QDir::Name | QDir::IgnoreCase | QDir::LocaleAware);
 
-    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ResourceFolderModel::directoryChanged);
     connect(&m_helper_thread_task, &ConcurrentTask::finished, this, [this] { m_helper_thread_task.clear(); });
 }
 
 ResourceFolderModel::~ResourceFolderModel()
 {
-    while (!QThreadPool::globalInstance()->waitForDone(100))
-        QCoreApplication::processEvents();
+    // only wait for our own scans and parses, not for whatever else is running
+    m_cancel_token.cancel();
+    m_cancel_token.waitForFinished();
 }
 
 bool ResourceFolderModel::startWatching(const QStringList paths)
@@ -46,9 +48,15 @@ bool ResourceFolderModel::startWatching(const QStringList paths)
     if (m_is_watching)
         return false;
 
-    auto couldnt_be_watched = m_watcher.addPaths(paths);
     for (auto path : paths) {
-        if (couldnt_be_watched.contains(path))
+        // a whole batch of changes only needs one update, and files that were just written to don't need one at all
+        auto watch = FileWatchService::instance()->watch(path, false, this);
+        connect(watch, &FileWatch::changed, this, [this, path](const QList<FileChange>& changes) {
+            if (std::any_of(changes.begin(), changes.end(), [](const FileChange& change) { return change.kind != FileChange::Modified; }))
+                directoryChanged(path);
+        });
+        m_watches.insert(path, watch);
+        if (!watch->isValid())
             qDebug() << "Failed to start watching " << path;
         else
             qDebug() << "Started watching " << path;
@@ -65,12 +73,13 @@ bool ResourceFolderModel::stopWatching(const QStringList paths)
     if (!m_is_watching)
         return false;
 
-    auto couldnt_be_stopped = m_watcher.removePaths(paths);
     for (auto path : paths) {
-        if (couldnt_be_stopped.contains(path))
+        auto watch = m_watches.take(path);
+        if (!watch || !watch->isValid())
             qDebug() << "Failed to stop watching " << path;
         else
             qDebug() << "Stopped watching " << path;
+        delete watch;
     }
 
     m_is_watching = !m_is_watching;
@@ -254,7 +263,7 @@ bool ResourceFolderModel::update()
         },
         Qt::ConnectionType::QueuedConnection);
 
-    QThreadPool::globalInstance()->start(m_current_update_task.get());
+    Executor::interactive().start(m_current_update_task.get(), Executor::Priority::High, m_cancel_token);
 
     return true;
 }
@@ -284,7 +293,7 @@ void ResourceFolderModel::resolveResource(Resource* res)
     m_helper_thread_task.addTask(task);
 
     if (!m_helper_thread_task.isRunning()) {
-        QThreadPool::globalInstance()->start(&m_helper_thread_task);
+        Executor::interactive().start(&m_helper_thread_task, Executor::Priority::Normal, m_cancel_token);
     }
 }
 
@@ -584,15 +593,106 @@ SortType ResourceFolderModel::columnToSortKey(size_t column) const
 }
 
 /* Standard Proxy Model for createFilterProxyModel */
+namespace {
+// the filter as plain text, if it doesn't use any regular expression syntax and ignores case like the index does
+std::optional<QString> plainTextFilter(const QRegularExpression& filter)
+{
+    if (!(filter.patternOptions() & QRegularExpression::CaseInsensitiveOption))
+        return {};
+    static const QString syntax = QStringLiteral("\\^$.|?*+()[]{}");
+    auto pattern = filter.pattern();
+    for (auto c : pattern) {
+        if (syntax.contains(c))
+            return {};
+    }
+    return pattern.toCaseFolded();
+}
+}  // namespace
+
+void ResourceFolderModel::ProxyModel::setSourceModel(QAbstractItemModel* source_model)
+{
+    for (auto& connection : m_source_connections)
+        disconnect(connection);
+    m_source_connections.clear();
+    invalidateEntries();
+
+    // connected before the base class connects, so the entries are up to date by the time it sorts and filters again
+    if (source_model) {
+        m_source_connections = {
+            connect(source_model, &QAbstractItemModel::dataChanged, this,
+                    [this](const QModelIndex& top_left, const QModelIndex& bottom_right) {
+                        invalidateEntries(top_left.row(), bottom_right.row());
+                    }),
+            connect(source_model, &QAbstractItemModel::rowsInserted, this,
+                    [this](const QModelIndex&, int first, int last) {
+                        if (first <= m_entries.size())
+                            m_entries.insert(first, last - first + 1, Entry());
+                    }),
+            connect(source_model, &QAbstractItemModel::rowsRemoved, this,
+                    [this](const QModelIndex&, int first, int last) {
+                        if (first < m_entries.size())
+                            m_entries.remove(first, qMin(last, int(m_entries.size()) - 1) - first + 1);
+                    }),
+            connect(source_model, &QAbstractItemModel::rowsMoved, this, [this] { invalidateEntries(); }),
+            connect(source_model, &QAbstractItemModel::layoutChanged, this, [this] { invalidateEntries(); }),
+            connect(source_model, &QAbstractItemModel::modelReset, this, [this] { invalidateEntries(); }),
+        };
+    }
+
+    QSortFilterProxyModel::setSourceModel(source_model);
+}
+
+void ResourceFolderModel::ProxyModel::invalidateEntries(int first, int last)
+{
+    if (last < 0) {
+        m_entries.clear();
+        return;
+    }
+    for (int row = first; row <= last && row < m_entries.size(); row++)
+        m_entries[row] = Entry();
+}
+
+auto ResourceFolderModel::ProxyModel::entry(const ResourceFolderModel& model, int row) const -> Entry&
+{
+    if (row >= m_entries.size())
+        m_entries.resize(qMax(row + 1, model.rowCount()));
+
+    auto& entry = m_entries[row];
+    if (!entry.indexed) {
+        const auto& resource = model.at(row);
+        entry.keys = resource.sortKeys();
+        entry.search = resource.searchFields().join('\n').toCaseFolded();
+        entry.indexed = true;
+    }
+    return entry;
+}
+
 [[nodiscard]] bool ResourceFolderModel::ProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const
 {
     auto* model = qobject_cast<ResourceFolderModel*>(sourceModel());
     if (!model)
         return true;
 
-    const auto& resource = model->at(source_row);
+    auto needle = plainTextFilter(filterRegularExpression());
+    if (!needle)
+        return model->at(source_row).applyFilter(filterRegularExpression());
+    if (needle->isEmpty())
+        return true;
+
+    if (*needle != m_needle) {
+        // a filter that contains the previous one lets through even less, so what that one didn't needn't be looked at again
+        const bool narrowing = !m_needle.isEmpty() && needle->contains(m_needle);
+        for (auto& entry : m_entries) {
+            if (!narrowing || entry.match == Match::Yes)
+                entry.match = Match::Unknown;
+        }
+        m_needle = *needle;
+    }
 
-    return resource.applyFilter(filterRegularExpression());
+    auto& entry = this->entry(*model, source_row);
+    if (entry.match == Match::Unknown)
+        entry.match = entry.search.contains(m_needle) ? Match::Yes : Match::No;
+    return entry.match == Match::Yes;
 }
 
 [[nodiscard]] bool ResourceFolderModel::ProxyModel::lessThan(const QModelIndex& source_left, const QModelIndex& source_right) const
@@ -606,10 +706,11 @@ SortType ResourceFolderModel::columnToSortKey(size_t column) const
     // proceed.
 
     auto column_sort_key = model->columnToSortKey(source_left.column());
-    auto const& resource_left = model->at(source_left.row());
-    auto const& resource_right = model->at(source_right.row());
+    // the first lookup makes room for every row, so the second one doesn't move the first one's keys
+    auto const& left_keys = entry(*model, source_left.row()).keys;
+    auto const& right_keys = entry(*model, source_right.row()).keys;
 
-    auto compare_result = resource_left.compare(resource_right, column_sort_key);
+    auto compare_result = model->at(source_left.row()).compare(left_keys, right_keys, column_sort_key);
     if (compare_result.first == 0)
         return QSortFilterProxyModel::lessThan(source_left, source_right);
 
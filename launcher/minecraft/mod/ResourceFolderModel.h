@@ -3,7 +3,6 @@
 #include <QAbstractListModel>
 #include <QAction>
 #include <QDir>
-#include <QFileSystemWatcher>
 #include <QHeaderView>
 #include <QMutex>
 #include <QSet>
@@ -13,8 +12,10 @@
 #include "Resource.h"
 
 #include "BaseInstance.h"
+#include "FileWatchService.h"
 
 #include "tasks/ConcurrentTask.h"
+#include "tasks/Executor.h"
 #include "tasks/Task.h"
 
 class QSortFilterProxyModel;
@@ -123,20 +124,44 @@ class ResourceFolderModel : public QAbstractListModel {
 
     /** This creates a proxy model to filter / sort the model for a UI.
      *
-     *  The actual comparisons and filtering are done directly by the Resource, so to modify behavior go there instead!
+     *  What it sorts and filters by comes from the Resource (see Resource::sortKeys(), Resource::compare() and
+     *  Resource::searchFields()), so to modify behavior go there instead!
      */
     QSortFilterProxyModel* createFilterProxyModel(QObject* parent = nullptr);
 
     [[nodiscard]] SortType columnToSortKey(size_t column) const;
     [[nodiscard]] QList<QHeaderView::ResizeMode> columnResizeModes() const { return m_column_resize_modes; }
 
+    /** Sorts and filters by keys that are computed once per resource, and dropped only when that resource changes.
+     *
+     *  Filters without any regular expression syntax are looked up as plain text, and a filter that extends the
+     *  previous one (as it does while typing) only looks at the rows that one let through.
+     */
     class ProxyModel : public QSortFilterProxyModel {
        public:
         explicit ProxyModel(QObject* parent = nullptr) : QSortFilterProxyModel(parent) {}
 
+        void setSourceModel(QAbstractItemModel* source_model) override;
+
        protected:
         [[nodiscard]] bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
         [[nodiscard]] bool lessThan(const QModelIndex& source_left, const QModelIndex& source_right) const override;
+
+       private:
+        enum class Match { Unknown, Yes, No };
+        struct Entry {
+            bool indexed = false;
+            Resource::SortKeys keys;
+            QString search;  //!< Every search field, case folded and one per line
+            Match match = Match::Unknown;
+        };
+
+        Entry& entry(const ResourceFolderModel& model, int row) const;
+        void invalidateEntries(int first = 0, int last = -1);
+
+        mutable QVector<Entry> m_entries;
+        mutable QString m_needle;
+        QList<QMetaObject::Connection> m_source_connections;
     };
 
     QString instDirPath() const;
@@ -206,7 +231,7 @@ class ResourceFolderModel : public QAbstractListModel {
 
     QDir m_dir;
     BaseInstance* m_instance;
-    QFileSystemWatcher m_watcher;
+    QHash<QString, FileWatch*> m_watches;
     bool m_is_watching = false;
 
     Task::Ptr m_current_update_task = nullptr;
@@ -220,6 +245,9 @@ class ResourceFolderModel : public QAbstractListModel {
     ConcurrentTask m_helper_thread_task;
     QMap<int, Task::Ptr> m_active_parse_tasks;
     std::atomic<int> m_next_resolution_ticket = 0;
+
+    // shared by every scan and parse job we submit, so teardown only waits for those
+    CancellationToken m_cancel_token;
 };
 
 /* A macro to define useful functions to handle Resource* -> T* more easily on derived classes */
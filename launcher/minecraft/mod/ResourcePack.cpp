@@ -93,24 +93,26 @@ std::pair<Version, Version> ResourcePack::compatibleVersions() const
     return s_pack_format_versions.constFind(m_pack_format).value();
 }
 
-std::pair<int, bool> ResourcePack::compare(const Resource& other, SortType type) const
+auto ResourcePack::sortKeys() const -> SortKeys
 {
-    auto const& cast_other = static_cast<ResourcePack const&>(other);
+    auto keys = Resource::sortKeys();
+    keys.packFormat = packFormat();
+    return keys;
+}
 
+std::pair<int, bool> ResourcePack::compare(const SortKeys& left, const SortKeys& right, SortType type) const
+{
     switch (type) {
         default: {
-            auto res = Resource::compare(other, type);
+            auto res = Resource::compare(left, right, type);
             if (res.first != 0)
                 return res;
             break;
         }
         case SortType::PACK_FORMAT: {
-            auto this_ver = packFormat();
-            auto other_ver = cast_other.packFormat();
-
-            if (this_ver > other_ver)
+            if (left.packFormat > right.packFormat)
                 return { 1, type == SortType::PACK_FORMAT };
-            if (this_ver < other_ver)
+            if (left.packFormat < right.packFormat)
                 return { -1, type == SortType::PACK_FORMAT };
             break;
         }
@@ -118,20 +120,11 @@ std::pair<int, bool> ResourcePack::compare(const Resource& other, SortType type)
     return { 0, false };
 }
 
-bool ResourcePack::applyFilter(QRegularExpression filter) const
+QStringList ResourcePack::searchFields() const
 {
-    if (filter.match(description()).hasMatch())
-        return true;
-
-    if (filter.match(QString::number(packFormat())).hasMatch())
-        return true;
-
-    if (filter.match(compatibleVersions().first.toString()).hasMatch())
-        return true;
-    if (filter.match(compatibleVersions().second.toString()).hasMatch())
-        return true;
-
-    return Resource::applyFilter(filter);
+    auto versions = compatibleVersions();
+    return QStringList{ description(), QString::number(packFormat()), versions.first.toString(), versions.second.toString() } +
+           Resource::searchFields();
 }
 
 bool ResourcePack::valid() const
@@ -44,8 +44,9 @@ class ResourcePack : public Resource {
 
     bool valid() const override;
 
-    [[nodiscard]] auto compare(Resource const& other, SortType type) const -> std::pair<int, bool> override;
-    [[nodiscard]] bool applyFilter(QRegularExpression filter) const override;
+    [[nodiscard]] SortKeys sortKeys() const override;
+    [[nodiscard]] auto compare(SortKeys const& left, SortKeys const& right, SortType type) const -> std::pair<int, bool> override;
+    [[nodiscard]] QStringList searchFields() const override;
 
    protected:
     mutable QMutex m_data_lock;
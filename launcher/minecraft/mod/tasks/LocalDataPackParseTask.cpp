@@ -23,10 +23,7 @@
 
 #include "FileSystem.h"
 #include "Json.h"
-
-#include <quazip/quazip.h>
-#include <quazip/quazipdir.h>
-#include <quazip/quazipfile.h>
+#include "ZipReader.h"
 
 #include <QCryptographicHash>
 
@@ -88,48 +85,26 @@ bool processZIP(DataPack& pack, ProcessingLevel level)
 {
     Q_ASSERT(pack.type() == ResourceType::ZIPFILE);
 
-    QuaZip zip(pack.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(pack.fileinfo().filePath());
+    if (!zip.open())
         return false;  // can't open zip file
 
-    QuaZipFile file(&zip);
-
     auto mcmeta_invalid = [&pack]() {
         qWarning() << "Data pack at" << pack.fileinfo().filePath() << "does not have a valid pack.mcmeta";
         return false;  // the mcmeta is not optional
     };
 
-    if (zip.setCurrentFile("pack.mcmeta")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            qCritical() << "Failed to open file in zip.";
-            zip.close();
-            return mcmeta_invalid();
-        }
-
-        auto data = file.readAll();
+    auto data = zip.read("pack.mcmeta");
+    if (!data)
+        return mcmeta_invalid();  // pack.mcmeta missing or unreadable
 
-        bool mcmeta_result = DataPackUtils::processMCMeta(pack, std::move(data));
-
-        file.close();
-        if (!mcmeta_result) {
-            return mcmeta_invalid();  // mcmeta invalid
-        }
-    } else {
-        return mcmeta_invalid();  // could not set pack.mcmeta as current file.
-    }
+    if (!DataPackUtils::processMCMeta(pack, std::move(*data)))
+        return mcmeta_invalid();  // mcmeta invalid
 
-    QuaZipDir zipDir(&zip);
-    if (!zipDir.exists("/data")) {
+    if (!zip.containsDir("data")) {
         return false;  // data dir does not exists at zip root
     }
 
-    if (level == ProcessingLevel::BasicInfoOnly) {
-        zip.close();
-        return true;  // only need basic info already checked
-    }
-
-    zip.close();
-
     return true;
 }
 
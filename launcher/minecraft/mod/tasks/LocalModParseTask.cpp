@@ -1,8 +1,6 @@
 #include "LocalModParseTask.h"
 
 #include <qdcss.h>
-#include <quazip/quazip.h>
-#include <quazip/quazipfile.h>
 #include <toml++/toml.h>
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -12,6 +10,7 @@
 
 #include "FileSystem.h"
 #include "Json.h"
+#include "ZipReader.h"
 #include "minecraft/mod/ModDetails.h"
 #include "settings/INIFile.h"
 
@@ -443,13 +442,13 @@ ModDetails ReadNilModInfo(QByteArray contents, QString fname)
     return details;
 }
 
-bool process(Mod& mod, ProcessingLevel level)
+bool process(Mod& mod, ProcessingLevel level, QImage* icon)
 {
     switch (mod.type()) {
         case ResourceType::FOLDER:
             return processFolder(mod, level);
         case ResourceType::ZIPFILE:
-            return processZIP(mod, level);
+            return processZIP(mod, level, icon);
         case ResourceType::LITEMOD:
             return processLitemod(mod);
         default:
@@ -458,35 +457,29 @@ bool process(Mod& mod, ProcessingLevel level)
     }
 }
 
-bool processZIP(Mod& mod, ProcessingLevel level)
+bool processZIP(Mod& mod, ProcessingLevel level, QImage* icon)
 {
     ModDetails details;
 
-    QuaZip zip(mod.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(mod.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
-
-    if (zip.setCurrentFile("META-INF/mods.toml")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    if (zip.contains("META-INF/mods.toml")) {
+        auto modsToml = zip.read("META-INF/mods.toml");
+        if (!modsToml)
             return false;
-        }
-
-        details = ReadMCModTOML(file.readAll());
-        file.close();
+        details = ReadMCModTOML(*modsToml);
 
         // to replace ${file.jarVersion} with the actual version, as needed
         if (details.version == "${file.jarVersion}") {
-            if (zip.setCurrentFile("META-INF/MANIFEST.MF")) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    zip.close();
+            if (zip.contains("META-INF/MANIFEST.MF")) {
+                auto manifest = zip.read("META-INF/MANIFEST.MF");
+                if (!manifest)
                     return false;
-                }
 
                 // quick and dirty line-by-line parser
-                auto manifestLines = file.readAll().split('\n');
+                auto manifestLines = manifest->split('\n');
                 QString manifestVersion = "";
                 for (auto& line : manifestLines) {
                     if (QString(line).startsWith("Implementation-Version: ")) {
@@ -502,93 +495,62 @@ bool processZIP(Mod& mod, ProcessingLevel level)
                 }
 
                 details.version = manifestVersion;
-
-                file.close();
             }
         }
-
-        zip.close();
-        mod.setDetails(details);
-
-        return true;
-    } else if (zip.setCurrentFile("mcmod.info")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+    } else if (zip.contains("mcmod.info")) {
+        auto data = zip.read("mcmod.info");
+        if (!data)
             return false;
-        }
-
-        details = ReadMCModInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("quilt.mod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+        details = ReadMCModInfo(*data);
+    } else if (zip.contains("quilt.mod.json")) {
+        auto data = zip.read("quilt.mod.json");
+        if (!data)
             return false;
-        }
-
-        details = ReadQuiltModInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("fabric.mod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+        details = ReadQuiltModInfo(*data);
+    } else if (zip.contains("fabric.mod.json")) {
+        auto data = zip.read("fabric.mod.json");
+        if (!data)
             return false;
-        }
-
-        details = ReadFabricModInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("forgeversion.properties")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
+        details = ReadFabricModInfo(*data);
+    } else if (zip.contains("forgeversion.properties")) {
+        auto data = zip.read("forgeversion.properties");
+        if (!data)
             return false;
-        }
-
-        details = ReadForgeInfo(file.readAll());
-        file.close();
-        zip.close();
-
-        mod.setDetails(details);
-        return true;
-    } else if (zip.setCurrentFile("META-INF/nil/mappings.json")) {
+        details = ReadForgeInfo(*data);
+    } else if (zip.contains("META-INF/nil/mappings.json")) {
         // nilloader uses the filename of the metadata file for the modid, so we can't know the exact filename
         // thankfully, there is a good file to use as a canary so we don't look for nil meta all the time
 
         QString foundNilMeta;
-        for (auto& fname : zip.getFileNameList()) {
+        for (auto& entry : zip.entries()) {
             // nilmods can shade nilloader to be able to run as a standalone agent - which includes nilloader's own meta file
-            if (fname.endsWith(".nilmod.css") && fname != "nilloader.nilmod.css") {
-                foundNilMeta = fname;
+            if (entry.name.endsWith(".nilmod.css") && entry.name != "nilloader.nilmod.css") {
+                foundNilMeta = entry.name;
                 break;
             }
         }
 
-        if (zip.setCurrentFile(foundNilMeta)) {
-            if (!file.open(QIODevice::ReadOnly)) {
-                zip.close();
-                return false;
-            }
-
-            details = ReadNilModInfo(file.readAll(), foundNilMeta);
-            file.close();
-            zip.close();
+        if (foundNilMeta.isEmpty())
+            return false;  // no valid mod found in archive
+        auto data = zip.read(foundNilMeta);
+        if (!data)
+            return false;
+        details = ReadNilModInfo(*data, foundNilMeta);
+    } else {
+        return false;  // no valid mod found in archive
+    }
 
-            mod.setDetails(details);
-            return true;
+    // decode the icon while the archive is still open, instead of opening it again when the icon is first drawn
+    if (icon && level == ProcessingLevel::Full && !details.icon_file.isEmpty()) {
+        if (auto data = zip.read(details.icon_file)) {
+            *icon = QImage::fromData(*data);
+            if (icon->isNull())
+                qWarning() << "Failed to parse mod logo:" << details.icon_file << "from" << mod.fileinfo().filePath();
         }
     }
 
-    zip.close();
-    return false;  // no valid mod found in archive
+    mod.setDetails(details);
+    return true;
 }
 
 bool processFolder(Mod& mod, ProcessingLevel level)
@@ -614,27 +576,14 @@ bool processFolder(Mod& mod, ProcessingLevel level)
 
 bool processLitemod(Mod& mod, ProcessingLevel level)
 {
-    ModDetails details;
-
-    QuaZip zip(mod.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(mod.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
-
-    if (zip.setCurrentFile("litemod.json")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            zip.close();
-            return false;
-        }
-
-        details = ReadLiteModInfo(file.readAll());
-        file.close();
-
-        mod.setDetails(details);
+    if (auto data = zip.read("litemod.json")) {
+        mod.setDetails(ReadLiteModInfo(*data));
         return true;
     }
-    zip.close();
 
     return false;  // no valid litemod.json found in archive
 }
@@ -689,30 +638,17 @@ bool loadIconFile(const Mod& mod)
             }
         }
         case ResourceType::ZIPFILE: {
-            QuaZip zip(mod.fileinfo().filePath());
-            if (!zip.open(QuaZip::mdUnzip))
+            ZipReader zip(mod.fileinfo().filePath());
+            if (!zip.open())
                 return false;
 
-            QuaZipFile file(&zip);
+            auto data = zip.read(mod.iconPath());
+            if (!data)
+                return png_invalid();  // icon missing or unreadable
 
-            if (zip.setCurrentFile(mod.iconPath())) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    qCritical() << "Failed to open file in zip.";
-                    zip.close();
-                    return png_invalid();
-                }
-
-                auto data = file.readAll();
-
-                bool icon_result = ModUtils::processIconPNG(mod, std::move(data));
-
-                file.close();
-                if (!icon_result) {
-                    return png_invalid();  // icon png invalid
-                }
-            } else {
-                return png_invalid();  // could not set icon as current file.
-            }
+            if (!ModUtils::processIconPNG(mod, std::move(*data)))
+                return png_invalid();  // icon png invalid
+            return true;
         }
         case ResourceType::LITEMOD: {
             return false;  // can lightmods even have icons?
@@ -738,7 +674,7 @@ bool LocalModParseTask::abort()
 void LocalModParseTask::executeTask()
 {
     Mod mod{ m_modFile };
-    ModUtils::process(mod, ModUtils::ProcessingLevel::Full);
+    ModUtils::process(mod, ModUtils::ProcessingLevel::Full, &m_result->icon);
 
     m_result->details = mod.details();
 
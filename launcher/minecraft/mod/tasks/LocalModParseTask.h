@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QDebug>
+#include <QImage>
 #include <QObject>
 
 #include "minecraft/mod/Mod.h"
@@ -17,9 +18,10 @@ ModDetails ReadLiteModInfo(QByteArray contents);
 
 enum class ProcessingLevel { Full, BasicInfoOnly };
 
-bool process(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
+/** When given, icon receives the decoded mod icon, read in the same pass as the metadata. */
+bool process(Mod& mod, ProcessingLevel level = ProcessingLevel::Full, QImage* icon = nullptr);
 
-bool processZIP(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
+bool processZIP(Mod& mod, ProcessingLevel level = ProcessingLevel::Full, QImage* icon = nullptr);
 bool processFolder(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
 bool processLitemod(Mod& mod, ProcessingLevel level = ProcessingLevel::Full);
 
@@ -35,6 +37,7 @@ class LocalModParseTask : public Task {
    public:
     struct Result {
         ModDetails details;
+        QImage icon;
     };
     using ResultPtr = std::shared_ptr<Result>;
     ResultPtr result() const { return m_result; }
@@ -20,10 +20,7 @@
 
 #include "FileSystem.h"
 #include "Json.h"
-
-#include <quazip/quazip.h>
-#include <quazip/quazipdir.h>
-#include <quazip/quazipfile.h>
+#include "ZipReader.h"
 
 #include <QCryptographicHash>
 
@@ -108,43 +105,27 @@ bool processZIP(ResourcePack& pack, ProcessingLevel level)
 {
     Q_ASSERT(pack.type() == ResourceType::ZIPFILE);
 
-    QuaZip zip(pack.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(pack.fileinfo().filePath());
+    if (!zip.open())
         return false;  // can't open zip file
 
-    QuaZipFile file(&zip);
-
     auto mcmeta_invalid = [&pack]() {
         qWarning() << "Resource pack at" << pack.fileinfo().filePath() << "does not have a valid pack.mcmeta";
         return false;  // the mcmeta is not optional
     };
 
-    if (zip.setCurrentFile("pack.mcmeta")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            qCritical() << "Failed to open file in zip.";
-            zip.close();
-            return mcmeta_invalid();
-        }
-
-        auto data = file.readAll();
+    auto mcmeta = zip.read("pack.mcmeta");
+    if (!mcmeta)
+        return mcmeta_invalid();  // pack.mcmeta missing or unreadable
 
-        bool mcmeta_result = ResourcePackUtils::processMCMeta(pack, std::move(data));
+    if (!ResourcePackUtils::processMCMeta(pack, std::move(*mcmeta)))
+        return mcmeta_invalid();  // mcmeta invalid
 
-        file.close();
-        if (!mcmeta_result) {
-            return mcmeta_invalid();  // mcmeta invalid
-        }
-    } else {
-        return mcmeta_invalid();  // could not set pack.mcmeta as current file.
-    }
-
-    QuaZipDir zipDir(&zip);
-    if (!zipDir.exists("/assets")) {
+    if (!zip.containsDir("assets")) {
         return false;  // assets dir does not exists at zip root
     }
 
     if (level == ProcessingLevel::BasicInfoOnly) {
-        zip.close();
         return true;  // only need basic info already checked
     }
 
@@ -153,28 +134,13 @@ bool processZIP(ResourcePack& pack, ProcessingLevel level)
         return true;  // the png is optional
     };
 
-    if (zip.setCurrentFile("pack.png")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            qCritical() << "Failed to open file in zip.";
-            zip.close();
-            return png_invalid();
-        }
-
-        auto data = file.readAll();
-
-        bool pack_png_result = ResourcePackUtils::processPackPNG(pack, std::move(data));
+    auto png = zip.read("pack.png");
+    if (!png)
+        return png_invalid();  // pack.png missing or unreadable
 
-        file.close();
-        zip.close();
-        if (!pack_png_result) {
-            return png_invalid();  // pack.png invalid
-        }
-    } else {
-        zip.close();
-        return png_invalid();  // could not set pack.mcmeta as current file.
-    }
+    if (!ResourcePackUtils::processPackPNG(pack, std::move(*png)))
+        return png_invalid();  // pack.png invalid
 
-    zip.close();
     return true;
 }
 
@@ -234,31 +200,17 @@ bool processPackPNG(const ResourcePack& pack)
             }
         }
         case ResourceType::ZIPFILE: {
-            Q_ASSERT(pack.type() == ResourceType::ZIPFILE);
-
-            QuaZip zip(pack.fileinfo().filePath());
-            if (!zip.open(QuaZip::mdUnzip))
+            ZipReader zip(pack.fileinfo().filePath());
+            if (!zip.open())
                 return false;  // can't open zip file
 
-            QuaZipFile file(&zip);
-            if (zip.setCurrentFile("pack.png")) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    qCritical() << "Failed to open file in zip.";
-                    zip.close();
-                    return png_invalid();
-                }
-
-                auto data = file.readAll();
+            auto data = zip.read("pack.png");
+            if (!data)
+                return png_invalid();  // pack.png missing or unreadable
 
-                bool pack_png_result = ResourcePackUtils::processPackPNG(pack, std::move(data));
-
-                file.close();
-                if (!pack_png_result) {
-                    return png_invalid();  // pack.png invalid
-                }
-            } else {
-                return png_invalid();  // could not set pack.mcmeta as current file.
-            }
+            if (!ResourcePackUtils::processPackPNG(pack, std::move(*data)))
+                return png_invalid();  // pack.png invalid
+            return true;
         }
         default:
             qWarning() << "Invalid type for resource pack parse task!";
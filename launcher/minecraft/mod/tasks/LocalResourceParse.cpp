@@ -20,15 +20,13 @@
  */
 
 #include <QObject>
+#include <QtConcurrent>
+
+#include <vector>
 
 #include "LocalResourceParse.h"
 
-#include "LocalDataPackParseTask.h"
-#include "LocalModParseTask.h"
-#include "LocalResourcePackParseTask.h"
-#include "LocalShaderPackParseTask.h"
-#include "LocalTexturePackParseTask.h"
-#include "LocalWorldSaveParseTask.h"
+#include "ZipReader.h"
 
 static const QMap<PackedResourceType, QString> s_packed_type_names = { { PackedResourceType::ResourcePack, QObject::tr("resource pack") },
                                                                        { PackedResourceType::TexturePack, QObject::tr("texture pack") },
@@ -38,38 +36,100 @@ static const QMap<PackedResourceType, QString> s_packed_type_names = { { PackedR
                                                                        { PackedResourceType::Mod, QObject::tr("mod") },
                                                                        { PackedResourceType::UNKNOWN, QObject::tr("unknown") } };
 
+namespace {
+// nilloader uses the name of the metadata file for the mod id, with the mappings as a canary
+bool isNilMod(const ZipReader& zip)
+{
+    if (!zip.contains("META-INF/nil/mappings.json"))
+        return false;
+    // nilmods can shade nilloader to be able to run as a standalone agent - which includes nilloader's own meta file
+    for (auto& entry : zip.entries()) {
+        if (entry.name.endsWith(".nilmod.css") && entry.name != "nilloader.nilmod.css")
+            return true;
+    }
+    return false;
+}
+
+// a world folder with a level.dat, or a saves folder with some of them
+bool isWorldSave(const ZipReader& zip)
+{
+    const bool saves = zip.containsDir("saves");
+    for (auto& entry : zip.entries()) {
+        auto parts = entry.name.split('/');
+        if (saves ? parts.size() == 3 && parts[0] == "saves" && parts[2] == "level.dat" : parts.size() == 2 && parts[1] == "level.dat")
+            return true;
+    }
+    return false;
+}
+
+struct Signature {
+    PackedResourceType type;
+    // an entry that has to be there, if any
+    QString file;
+    // a folder that has to be there, if any
+    QString dir;
+    bool (*check)(const ZipReader&) = nullptr;
+
+    bool matches(const ZipReader& zip) const
+    {
+        return (file.isEmpty() || zip.contains(file)) && (dir.isEmpty() || zip.containsDir(dir)) && (!check || check(zip));
+    }
+};
+
+// checked in order, mods can contain resource and data packs so they must be tested first
+const QList<Signature> s_signatures = {
+    { PackedResourceType::Mod, "META-INF/mods.toml", {} },
+    { PackedResourceType::Mod, "mcmod.info", {} },
+    { PackedResourceType::Mod, "quilt.mod.json", {} },
+    { PackedResourceType::Mod, "fabric.mod.json", {} },
+    { PackedResourceType::Mod, "forgeversion.properties", {} },
+    { PackedResourceType::Mod, "litemod.json", {} },
+    { PackedResourceType::Mod, {}, {}, isNilMod },
+    { PackedResourceType::ResourcePack, "pack.mcmeta", "assets" },
+    { PackedResourceType::TexturePack, "pack.txt", {} },
+    { PackedResourceType::DataPack, "pack.mcmeta", "data" },
+    { PackedResourceType::WorldSave, {}, {}, isWorldSave },
+    { PackedResourceType::ShaderPack, {}, "shaders" },
+};
+}  // namespace
+
 namespace ResourceUtils {
 PackedResourceType identify(QFileInfo file)
 {
-    if (file.exists() && file.isFile()) {
-        if (ModUtils::validate(file)) {
-            // mods can contain resource and data packs so they must be tested first
-            qDebug() << file.fileName() << "is a mod";
-            return PackedResourceType::Mod;
-        } else if (ResourcePackUtils::validate(file)) {
-            qDebug() << file.fileName() << "is a resource pack";
-            return PackedResourceType::ResourcePack;
-        } else if (TexturePackUtils::validate(file)) {
-            qDebug() << file.fileName() << "is a pre 1.6 texture pack";
-            return PackedResourceType::TexturePack;
-        } else if (DataPackUtils::validate(file)) {
-            qDebug() << file.fileName() << "is a data pack";
-            return PackedResourceType::DataPack;
-        } else if (WorldSaveUtils::validate(file)) {
-            qDebug() << file.fileName() << "is a world save";
-            return PackedResourceType::WorldSave;
-        } else if (ShaderPackUtils::validate(file)) {
-            qDebug() << file.fileName() << "is a shader pack";
-            return PackedResourceType::ShaderPack;
-        } else {
-            qDebug() << "Can't Identify" << file.fileName();
-        }
-    } else {
+    if (!file.exists() || !file.isFile()) {
         qDebug() << "Can't find" << file.absolutePath();
+        return PackedResourceType::UNKNOWN;
+    }
+
+    // only the central directory is looked at, and it stays cached for when the resource is parsed later on
+    ZipReader zip(file.filePath());
+    if (zip.open()) {
+        for (auto& signature : s_signatures) {
+            if (signature.matches(zip)) {
+                qDebug() << file.fileName() << "is a" << getPackedTypeName(signature.type);
+                return signature.type;
+            }
+        }
     }
+    qDebug() << "Can't Identify" << file.fileName();
     return PackedResourceType::UNKNOWN;
 }
 
+QList<PackedResourceType> identify(const QList<QFileInfo>& files)
+{
+    std::vector<PackedResourceType> types(files.size(), PackedResourceType::UNKNOWN);
+    QList<int> indexes;
+    for (int i = 0; i < files.size(); i++)
+        indexes.append(i);
+    QtConcurrent::blockingMap(indexes, [&](int index) { types[index] = identify(files[index]); });
+
+    QList<PackedResourceType> result;
+    result.reserve(files.size());
+    for (auto type : types)
+        result.append(type);
+    return result;
+}
+
 QString getPackedTypeName(PackedResourceType type)
 {
     return s_packed_type_names.constFind(type).value();
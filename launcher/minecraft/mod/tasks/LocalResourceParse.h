@@ -25,6 +25,7 @@
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QList>
 #include <QObject>
 
 enum class PackedResourceType { DataPack, ResourcePack, TexturePack, ShaderPack, WorldSave, Mod, UNKNOWN };
@@ -32,6 +33,9 @@ namespace ResourceUtils {
 static const std::set<PackedResourceType> ValidResourceTypes = { PackedResourceType::DataPack,    PackedResourceType::ResourcePack,
                                                                  PackedResourceType::TexturePack, PackedResourceType::ShaderPack,
                                                                  PackedResourceType::WorldSave,   PackedResourceType::Mod };
+/** Identifies a packed resource from the layout of the archive, without parsing any of its metadata. */
 PackedResourceType identify(QFileInfo file);
+/** Identifies many packed resources at once, in parallel. The results are in the same order as the files. */
+QList<PackedResourceType> identify(const QList<QFileInfo>& files);
 QString getPackedTypeName(PackedResourceType type);
 }  // namespace ResourceUtils
@@ -20,9 +20,7 @@
 #include "LocalTexturePackParseTask.h"
 
 #include "FileSystem.h"
-
-#include <quazip/quazip.h>
-#include <quazip/quazipfile.h>
+#include "ZipReader.h"
 
 #include <QCryptographicHash>
 
@@ -91,54 +89,28 @@ bool processZIP(TexturePack& pack, ProcessingLevel level)
 {
     Q_ASSERT(pack.type() == ResourceType::ZIPFILE);
 
-    QuaZip zip(pack.fileinfo().filePath());
-    if (!zip.open(QuaZip::mdUnzip))
+    ZipReader zip(pack.fileinfo().filePath());
+    if (!zip.open())
         return false;
 
-    QuaZipFile file(&zip);
-
-    if (zip.setCurrentFile("pack.txt")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            qCritical() << "Failed to open file in zip.";
-            zip.close();
-            return false;
-        }
-
-        auto data = file.readAll();
-
-        bool packTXT_result = TexturePackUtils::processPackTXT(pack, std::move(data));
-
-        file.close();
-        if (!packTXT_result) {
+    if (zip.contains("pack.txt")) {
+        auto data = zip.read("pack.txt");
+        if (!data || !TexturePackUtils::processPackTXT(pack, std::move(*data))) {
             return false;
         }
     }
 
     if (level == ProcessingLevel::BasicInfoOnly) {
-        zip.close();
         return true;
     }
 
-    if (zip.setCurrentFile("pack.png")) {
-        if (!file.open(QIODevice::ReadOnly)) {
-            qCritical() << "Failed to open file in zip.";
-            zip.close();
-            return false;
-        }
-
-        auto data = file.readAll();
-
-        bool packPNG_result = TexturePackUtils::processPackPNG(pack, std::move(data));
-
-        file.close();
-        zip.close();
-        if (!packPNG_result) {
+    if (zip.contains("pack.png")) {
+        auto data = zip.read("pack.png");
+        if (!data || !TexturePackUtils::processPackPNG(pack, std::move(*data))) {
             return false;
         }
     }
 
-    zip.close();
-
     return true;
 }
 
@@ -188,33 +160,17 @@ bool processPackPNG(const TexturePack& pack)
             }
         }
         case ResourceType::ZIPFILE: {
-            Q_ASSERT(pack.type() == ResourceType::ZIPFILE);
-
-            QuaZip zip(pack.fileinfo().filePath());
-            if (!zip.open(QuaZip::mdUnzip))
+            ZipReader zip(pack.fileinfo().filePath());
+            if (!zip.open())
                 return false;  // can't open zip file
 
-            QuaZipFile file(&zip);
-            if (zip.setCurrentFile("pack.png")) {
-                if (!file.open(QIODevice::ReadOnly)) {
-                    qCritical() << "Failed to open file in zip.";
-                    zip.close();
-                    return png_invalid();
-                }
-
-                auto data = file.readAll();
+            auto data = zip.read("pack.png");
+            if (!data)
+                return png_invalid();  // pack.png missing or unreadable
 
-                bool pack_png_result = TexturePackUtils::processPackPNG(pack, std::move(data));
-
-                file.close();
-                if (!pack_png_result) {
-                    zip.close();
-                    return png_invalid();  // pack.png invalid
-                }
-            } else {
-                zip.close();
-                return png_invalid();  // could not set pack.mcmeta as current file.
-            }
+            if (!TexturePackUtils::processPackPNG(pack, std::move(*data)))
+                return png_invalid();  // pack.png invalid
+            return true;
         }
         default:
             qWarning() << "Invalid type for resource pack parse task!";
@@ -43,6 +43,7 @@ void AssetUpdateTask::executeTask()
     connect(downloadJob.get(), &NetJob::stepProgress, this, &AssetUpdateTask::propagateStepProgress);
 
     qDebug() << m_inst->name() << ": Starting asset index download";
+    downloadJob->setParentTask(this);
     downloadJob->start();
 }
 
@@ -78,6 +79,7 @@ void AssetUpdateTask::assetIndexFinished()
         connect(downloadJob.get(), &NetJob::aborted, this, [this] { emitFailed(tr("Aborted")); });
         connect(downloadJob.get(), &NetJob::progress, this, &AssetUpdateTask::progress);
         connect(downloadJob.get(), &NetJob::stepProgress, this, &AssetUpdateTask::propagateStepProgress);
+        downloadJob->setParentTask(this);
         downloadJob->start();
         return;
     }
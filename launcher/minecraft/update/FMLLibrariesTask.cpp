@@ -71,6 +71,7 @@ void FMLLibrariesTask::executeTask()
     connect(dljob.get(), &NetJob::progress, this, &FMLLibrariesTask::progress);
     connect(dljob.get(), &NetJob::stepProgress, this, &FMLLibrariesTask::propagateStepProgress);
     downloadJob.reset(dljob);
+    downloadJob->setParentTask(this);
     downloadJob->start();
 }
 
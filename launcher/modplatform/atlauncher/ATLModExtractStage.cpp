@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ATLModExtractStage.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMap>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QUrl>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "FileSystem.h"
+#include "ZipReader.h"
+
+namespace ATLauncher {
+
+QString dirForModType(ModType type, const QString& minecraftVersion)
+{
+    switch (type) {
+        case ModType::Forge:
+            // Forge detection happens later on, if it cannot be detected it will
+            // install a jarmod component.
+        case ModType::Jar:
+            return "jarmods";
+        case ModType::Mods:
+            return "mods";
+        case ModType::Flan:
+            return "Flan";
+        case ModType::Dependency:
+            return FS::PathCombine("mods", minecraftVersion);
+        case ModType::Ic2Lib:
+            return FS::PathCombine("mods", "ic2");
+        case ModType::DenLib:
+            return FS::PathCombine("mods", "denlib");
+        case ModType::Coremods:
+            return "coremods";
+        case ModType::Plugins:
+            return "plugins";
+        case ModType::TexturePack:
+            return "texturepacks";
+        case ModType::ResourcePack:
+            return "resourcepacks";
+        case ModType::ShaderPack:
+            return "shaderpacks";
+        default:
+            return {};
+    }
+}
+
+struct ModExtractStage::Planned {
+    std::shared_ptr<ZipReader> zip;
+    // the archive entries to write, and where to
+    QList<QPair<const ZipReader::Entry*, QString>> entries;
+    qint64 bytes = 0;
+
+    QStringList targets() const
+    {
+        QStringList targets;
+        for (const auto& [entry, target] : entries)
+            targets.append(target);
+        return targets;
+    }
+};
+
+ModExtractStage::ModExtractStage(QString minecraftRoot, QString minecraftVersion)
+    : m_minecraftRoot(std::move(minecraftRoot)), m_minecraftVersion(std::move(minecraftVersion))
+{}
+
+bool ModExtractStage::addMod(const VersionMod& mod, const QString& source)
+{
+    switch (mod.type) {
+        case ModType::Extract: {
+            auto folder = mod.extractFolder;
+            while (folder.startsWith('/'))
+                folder.remove(0, 1);
+            addExtract(source, folder, FS::PathCombine(m_minecraftRoot, dirForModType(mod.extractTo, m_minecraftVersion)));
+            return true;
+        }
+        case ModType::TexturePackExtract:
+            addExtract(source, "", FS::PathCombine(m_minecraftRoot, "texturepacks", "extracted"));
+            return true;
+        case ModType::ResourcePackExtract:
+            addExtract(source, "", FS::PathCombine(m_minecraftRoot, "resourcepacks", "extracted"));
+            return true;
+        case ModType::Decomp:
+            addDecompress(source, mod.decompFile,
+                          FS::PathCombine(m_minecraftRoot, dirForModType(mod.decompType, m_minecraftVersion), mod.decompFile));
+            return true;
+        default: {
+            auto dir = dirForModType(mod.type, m_minecraftVersion);
+            if (dir.isNull())
+                return false;
+            addCopy(source, FS::PathCombine(m_minecraftRoot, dir, mod.file));
+            return true;
+        }
+    }
+}
+
+void ModExtractStage::addExtract(const QString& source, const QString& folder, const QString& targetDir)
+{
+    m_operations.append({ Operation::Kind::Extract, source, folder, targetDir });
+}
+
+void ModExtractStage::addDecompress(const QString& source, const QString& file, const QString& targetFile)
+{
+    m_operations.append({ Operation::Kind::Decompress, source, file, targetFile });
+}
+
+void ModExtractStage::addCopy(const QString& source, const QString& targetFile)
+{
+    m_operations.append({ Operation::Kind::Copy, source, QString(), targetFile });
+}
+
+QString ModExtractStage::errorString() const
+{
+    QMutexLocker locker(&m_errorLock);
+    return m_error;
+}
+
+void ModExtractStage::setError(const QString& error)
+{
+    QMutexLocker locker(&m_errorLock);
+    if (m_error.isEmpty())
+        m_error = error;
+}
+
+bool ModExtractStage::plan(const Operation& operation, Planned& planned)
+{
+    if (operation.kind == Operation::Kind::Copy) {
+        planned.bytes = QFileInfo(operation.source).size();
+        return true;
+    }
+
+    planned.zip = std::make_shared<ZipReader>(operation.source);
+    if (!planned.zip->open()) {
+        setError(QString("Could not open archive %1").arg(operation.source));
+        return false;
+    }
+
+    if (operation.kind == Operation::Kind::Decompress) {
+        auto entry = planned.zip->entry(operation.inner);
+        if (!entry) {
+            setError(QString("%1 does not contain %2").arg(operation.source, operation.inner));
+            return false;
+        }
+        planned.entries.append({ entry, operation.target });
+        planned.bytes = entry->size;
+        return true;
+    }
+
+    const auto target_top_dir = QUrl::fromLocalFile(operation.target);
+    for (const auto& entry : planned.zip->entries()) {
+        if (!entry.name.startsWith(operation.inner))
+            continue;
+
+        auto relative_name = QDir::fromNativeSeparators(entry.name.mid(operation.inner.size()));
+        while (relative_name.startsWith('/'))
+            relative_name.remove(0, 1);
+        if (relative_name.isEmpty())
+            continue;
+
+        auto target = FS::PathCombine(operation.target, relative_name);
+        if (!target_top_dir.isParentOf(QUrl::fromLocalFile(target))) {
+            setError(QString("%1 in %2 is outside of the target path %3").arg(entry.name, operation.source, operation.target));
+            return false;
+        }
+        planned.entries.append({ &entry, target });
+        planned.bytes += entry.size;
+    }
+    return true;
+}
+
+bool ModExtractStage::execute(const Operation& operation,
+                              const Planned& planned,
+                              const std::function<bool()>& stopped,
+                              const std::function<void(qint64)>& wrote)
+{
+    if (operation.kind == Operation::Kind::Copy) {
+        if (stopped())
+            return false;
+        // a mod replaces whatever an extracted archive (usually the configs) put in its place
+        if (QFileInfo::exists(operation.target) && !QFile::remove(operation.target)) {
+            setError(QString("Failed to delete %1").arg(operation.target));
+            return false;
+        }
+        FS::copy fileCopyOperation(operation.source, operation.target);
+        if (!fileCopyOperation()) {
+            setError(QString("Failed to copy %1 to %2").arg(operation.source, operation.target));
+            return false;
+        }
+        wrote(planned.bytes);
+        return true;
+    }
+
+    for (const auto& [entry, target] : planned.entries) {
+        if (stopped())
+            return false;
+
+        if (entry->isDir()) {
+            if (!FS::ensureFolderPathExists(target)) {
+                setError(QString("Failed to create folder %1").arg(target));
+                return false;
+            }
+            continue;
+        }
+
+        // streamed, so only a chunk of each entry is in memory at a time
+        QSaveFile file(target);
+        if (!FS::ensureFilePathExists(target) || !file.open(QIODevice::WriteOnly) || !planned.zip->extract(*entry, file) ||
+            !file.commit()) {
+            setError(QString("Failed to extract %1 from %2 to %3").arg(entry->name, operation.source, target));
+            return false;
+        }
+
+        if (operation.kind == Operation::Kind::Extract)
+            QFile::setPermissions(target, QFileDevice::ReadUser | QFileDevice::WriteUser | QFileDevice::ExeUser);
+
+        wrote(entry->size);
+    }
+    return true;
+}
+
+bool ModExtractStage::run(std::function<void(qint64, qint64)> progress, std::function<bool()> cancelled)
+{
+    {
+        QMutexLocker locker(&m_errorLock);
+        m_error.clear();
+    }
+    m_groups.clear();
+
+    const int count = m_operations.size();
+    std::vector<Planned> planned(count);
+    qint64 total = 0;
+    for (int i = 0; i < count; i++) {
+        if (cancelled && cancelled())
+            return false;
+        if (!plan(m_operations[i], planned[i]))
+            return false;
+        total += planned[i].bytes;
+    }
+
+    // operations writing the same file end up in the same group
+    std::vector<int> parents(count);
+    std::iota(parents.begin(), parents.end(), 0);
+    auto find = [&parents](int i) {
+        while (parents[i] != i)
+            i = parents[i] = parents[parents[i]];
+        return i;
+    };
+    QHash<QString, int> writers;
+    for (int i = 0; i < count; i++) {
+        const auto targets = m_operations[i].kind == Operation::Kind::Copy ? QStringList{ m_operations[i].target } : planned[i].targets();
+        for (const auto& target : targets) {
+            const auto key = QDir::cleanPath(target);
+            auto writer = writers.constFind(key);
+            if (writer == writers.constEnd())
+                writers.insert(key, i);
+            else
+                parents[find(i)] = find(*writer);
+        }
+    }
+
+    QMap<int, QList<int>> groups;
+    for (int i = 0; i < count; i++)
+        groups[find(i)].append(i);
+    for (auto& group : groups) {
+        // extracts, then decompressions, then copies, the order the launcher always placed them in
+        std::stable_sort(group.begin(), group.end(), [this](int a, int b) { return m_operations[a].kind < m_operations[b].kind; });
+        m_groups.append(group);
+    }
+
+    qDebug() << "Placing" << count << "mods in" << m_groups.size() << "independent groups," << total << "bytes in total";
+
+    std::atomic_bool failed{ false };
+    std::atomic<qint64> written{ 0 };
+    auto stopped = [&failed, &cancelled] { return failed || (cancelled && cancelled()); };
+    auto wrote = [&written, &progress, total](qint64 bytes) {
+        const qint64 now = written += bytes;
+        if (progress)
+            progress(now, total);
+    };
+
+    QtConcurrent::blockingMap(m_groups, [&](const QList<int>& group) {
+        for (int index : group) {
+            if (!execute(m_operations[index], planned[index], stopped, wrote)) {
+                failed = true;
+                return;
+            }
+        }
+    });
+
+    return !failed;
+}
+
+}  // namespace ATLauncher
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QString>
+
+#include <functional>
+
+#include "ATLPackManifest.h"
+
+namespace ATLauncher {
+
+/**
+ * The folder, relative to the minecraft folder, that mods of the given type are placed in.
+ * Returns a null string for types that aren't placed in a folder of their own (the minecraft folder itself, for extracts).
+ */
+QString dirForModType(ModType type, const QString& minecraftVersion);
+
+/**
+ * Places the downloaded mods of an ATLauncher pack into the instance: extracts archives, decompresses
+ * single files out of archives and copies everything else.
+ *
+ * Before anything is written, every operation is planned down to the files it writes (reading the
+ * central directories of the archives). Operations that write any of the same files run one after another,
+ * extracts first, then decompressions, then copies, everything else runs in parallel.
+ */
+class ModExtractStage {
+   public:
+    struct Operation {
+        enum class Kind { Extract, Decompress, Copy };
+
+        Kind kind;
+        QString source;
+        QString inner;   // Extract: folder in the archive, Decompress: file in the archive
+        QString target;  // Extract: target folder, otherwise the target file
+    };
+
+    ModExtractStage(QString minecraftRoot, QString minecraftVersion);
+
+    /** Queues placing the downloaded file of an extract, decompress or plain mod. Returns false if the mod isn't placed anywhere. */
+    bool addMod(const VersionMod& mod, const QString& source);
+    void addExtract(const QString& source, const QString& folder, const QString& targetDir);
+    void addDecompress(const QString& source, const QString& file, const QString& targetFile);
+    void addCopy(const QString& source, const QString& targetFile);
+
+    const QList<Operation>& operations() const { return m_operations; }
+
+    /**
+     * Runs every queued operation, blocking until they are done.
+     * \param progress Called from the worker threads with the bytes written so far, and in total.
+     * \param cancelled Checked before every file, the stage stops when it returns true.
+     * \return false if an operation failed, see errorString(), or the stage was cancelled.
+     */
+    bool run(std::function<void(qint64, qint64)> progress = {}, std::function<bool()> cancelled = {});
+
+    /** The operations, by index, that had to run one after another in the last run(). */
+    const QList<QList<int>>& groups() const { return m_groups; }
+
+    QString errorString() const;
+
+   private:
+    struct Planned;
+
+    bool plan(const Operation& operation, Planned& planned);
+    bool execute(const Operation& operation,
+                 const Planned& planned,
+                 const std::function<bool()>& stopped,
+                 const std::function<void(qint64)>& wrote);
+    void setError(const QString& error);
+
+    QString m_minecraftRoot;
+    QString m_minecraftVersion;
+    QList<Operation> m_operations;
+    QList<QList<int>> m_groups;
+
+    mutable QMutex m_errorLock;
+    QString m_error;
+};
+
+}  // namespace ATLauncher
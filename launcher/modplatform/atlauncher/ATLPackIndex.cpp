@@ -17,6 +17,7 @@
 
 #include "ATLPackIndex.h"
 
+#include <QDataStream>
 #include <QRegularExpression>
 
 #include "Json.h"
@@ -45,3 +46,63 @@ void ATLauncher::loadIndexedPack(ATLauncher::IndexedPack& m, QJsonObject& obj)
 
     m.safeName = Json::requireString(obj, "name").replace(QRegularExpression("[^A-Za-z0-9]"), "");
 }
+
+QList<PackCatalog::Pack> ATLauncher::parsePackList(const QByteArray& data)
+{
+    QList<PackCatalog::Pack> packs;
+    for (auto packRaw : Json::requireArray(Json::requireDocument(data, "ATLauncher pack list"), "ATLauncher pack list")) {
+        auto packObj = Json::requireObject(packRaw);
+        IndexedPack pack;
+        loadIndexedPack(pack, packObj);
+
+        // ignore packs without a published version
+        if (pack.versions.length() == 0)
+            continue;
+        // only display public packs (for now)
+        if (pack.type != PackType::Public)
+            continue;
+        // ignore "system" packs (Vanilla, Vanilla with Forge, etc)
+        if (pack.system)
+            continue;
+
+        packs.append(toCatalogPack(pack));
+    }
+    return packs;
+}
+
+PackCatalog::Pack ATLauncher::toCatalogPack(const IndexedPack& pack)
+{
+    PackCatalog::Pack entry;
+    entry.id = QString::number(pack.id);
+    entry.name = pack.name;
+    entry.summary = pack.description;
+    entry.gameVersion = pack.versions.isEmpty() ? QString() : pack.versions.first().minecraft;
+    entry.popularity = pack.position;
+
+    QDataStream out(&entry.data, QIODevice::WriteOnly);
+    out << qint32(pack.id) << qint32(pack.position) << pack.name << pack.system << pack.description << pack.safeName
+        << quint32(pack.versions.size());
+    for (auto& version : pack.versions)
+        out << version.version << version.minecraft;
+    return entry;
+}
+
+ATLauncher::IndexedPack ATLauncher::fromCatalogPack(const PackCatalog::Pack& entry)
+{
+    IndexedPack pack;
+    qint32 id = 0;
+    qint32 position = 0;
+    quint32 versions = 0;
+    QDataStream in(entry.data);
+    in >> id >> position >> pack.name >> pack.system >> pack.description >> pack.safeName >> versions;
+    pack.id = id;
+    pack.position = position;
+    // only public packs are kept
+    pack.type = PackType::Public;
+    for (quint32 i = 0; i < versions && in.status() == QDataStream::Ok; i++) {
+        IndexedVersion version;
+        in >> version.version >> version.minecraft;
+        pack.versions.append(version);
+    }
+    return pack;
+}
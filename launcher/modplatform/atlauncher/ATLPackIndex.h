@@ -17,6 +17,7 @@
 #pragma once
 
 #include "ATLPackManifest.h"
+#include "modplatform/helpers/PackCatalog.h"
 
 #include <QMetaType>
 #include <QString>
@@ -42,6 +43,13 @@ struct IndexedPack {
 };
 
 void loadIndexedPack(IndexedPack& m, QJsonObject& obj);
+
+/* The packs of the pack list that are shown to users, as the pack catalog keeps them. Throws a JSONValidationError if
+ * the list is malformed.
+ */
+QList<PackCatalog::Pack> parsePackList(const QByteArray& data);
+PackCatalog::Pack toCatalogPack(const IndexedPack& pack);
+IndexedPack fromCatalogPack(const PackCatalog::Pack& pack);
 }  // namespace ATLauncher
 
 Q_DECLARE_METATYPE(ATLauncher::IndexedPack)
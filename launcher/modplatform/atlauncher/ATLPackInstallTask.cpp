@@ -36,8 +36,6 @@
 
 #include "ATLPackInstallTask.h"
 
-#include <QtConcurrent>
-
 #include <quazip/quazip.h>
 
 #include "FileSystem.h"
@@ -54,7 +52,10 @@
 #include "settings/INISettingsObject.h"
 
 #include "Application.h"
+#include "ATLModExtractStage.h"
 #include "BuildConfig.h"
+#include "StringUtils.h"
+#include "tasks/Executor.h"
 
 namespace ATLauncher {
 
@@ -74,6 +75,10 @@ bool PackInstallTask::abort()
     if (abortable) {
         return jobPtr->abort();
     }
+    if (m_modExtractFuture.isRunning()) {
+        m_modExtractAborted = true;
+        return true;
+    }
     return false;
 }
 
@@ -284,49 +289,16 @@ void PackInstallTask::deleteExistingFiles()
 QString PackInstallTask::getDirForModType(ModType type, QString raw)
 {
     switch (type) {
-        // Mod types that can either be ignored at this stage, or ignored
-        // completely.
-        case ModType::Root:
-        case ModType::Extract:
-        case ModType::Decomp:
-        case ModType::TexturePackExtract:
-        case ModType::ResourcePackExtract:
-        case ModType::MCPC:
-            return Q_NULLPTR;
-        case ModType::Forge:
-            // Forge detection happens later on, if it cannot be detected it will
-            // install a jarmod component.
-        case ModType::Jar:
-            return "jarmods";
-        case ModType::Mods:
-            return "mods";
-        case ModType::Flan:
-            return "Flan";
-        case ModType::Dependency:
-            return FS::PathCombine("mods", m_version.minecraft);
-        case ModType::Ic2Lib:
-            return FS::PathCombine("mods", "ic2");
-        case ModType::DenLib:
-            return FS::PathCombine("mods", "denlib");
-        case ModType::Coremods:
-            return "coremods";
-        case ModType::Plugins:
-            return "plugins";
-        case ModType::TexturePack:
-            return "texturepacks";
-        case ModType::ResourcePack:
-            return "resourcepacks";
-        case ModType::ShaderPack:
-            return "shaderpacks";
         case ModType::Millenaire:
             qWarning() << "Unsupported mod type: " + raw;
             return Q_NULLPTR;
         case ModType::Unknown:
             emitFailed(tr("Unknown mod type: %1").arg(raw));
             return Q_NULLPTR;
+        default:
+            // Mod types that can either be ignored at this stage, or ignored completely, don't have a folder
+            return dirForModType(type, m_version.minecraft);
     }
-
-    return Q_NULLPTR;
 }
 
 QString PackInstallTask::getVersionForLoader(QString uid)
@@ -676,13 +648,8 @@ void PackInstallTask::extractConfigs()
         return;
     }
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    m_extractFuture = QtConcurrent::run(QThreadPool::globalInstance(), QOverload<QString, QString>::of(MMCZip::extractDir), archivePath,
-                                        extractDir.absolutePath() + "/minecraft");
-#else
-    m_extractFuture =
-        QtConcurrent::run(QThreadPool::globalInstance(), MMCZip::extractDir, archivePath, extractDir.absolutePath() + "/minecraft");
-#endif
+    m_extractFuture = Executor::io().run(
+        [archivePath, target = extractDir.absolutePath() + "/minecraft"] { return MMCZip::extractDir(archivePath, target); });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, [&]() { downloadMods(); });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, [&]() { emitAborted(); });
     m_extractFutureWatcher.setFuture(m_extractFuture);
@@ -744,6 +711,10 @@ void PackInstallTask::downloadMods()
         auto cacheName = fileName.completeBaseName() + "-" + mod.md5 + "." + fileName.suffix();
 
         if (mod.type == ModType::Extract || mod.type == ModType::TexturePackExtract || mod.type == ModType::ResourcePackExtract) {
+            if (mod.type == ModType::Extract && mod.extractTo == ModType::Unknown) {
+                emitFailed(tr("Unknown mod type: %1").arg(mod.extractTo_raw));
+                return;
+            }
             auto entry = APPLICATION->metacache()->resolveEntry("ATLauncherPacks", cacheName);
             entry->setStale(true);
             modsToExtract.insert(entry->getFullPath(), mod);
@@ -755,6 +726,10 @@ void PackInstallTask::downloadMods()
             }
             jobPtr->addNetAction(dl);
         } else if (mod.type == ModType::Decomp) {
+            if (mod.decompType == ModType::Unknown) {
+                emitFailed(tr("Unknown mod type: %1").arg(mod.decompType_raw));
+                return;
+            }
             auto entry = APPLICATION->metacache()->resolveEntry("ATLauncherPacks", cacheName);
             entry->setStale(true);
             modsToDecomp.insert(entry->getFullPath(), mod);
@@ -832,106 +807,56 @@ void PackInstallTask::onModsDownloaded()
     qDebug() << "PackInstallTask::onModsDownloaded: " << QThread::currentThreadId();
     jobPtr.reset();
 
-    if (!modsToExtract.empty() || !modsToDecomp.empty() || !modsToCopy.empty()) {
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        m_modExtractFuture =
-            QtConcurrent::run(QThreadPool::globalInstance(), &PackInstallTask::extractMods, this, modsToExtract, modsToDecomp, modsToCopy);
-#else
-        m_modExtractFuture =
-            QtConcurrent::run(QThreadPool::globalInstance(), this, &PackInstallTask::extractMods, modsToExtract, modsToDecomp, modsToCopy);
-#endif
-        connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &PackInstallTask::onModsExtracted);
-        connect(&m_modExtractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, [&]() { emitAborted(); });
-        m_modExtractFutureWatcher.setFuture(m_modExtractFuture);
-    } else {
+    if (modsToExtract.empty() && modsToDecomp.empty() && modsToCopy.empty()) {
         install();
+        return;
     }
+
+    setStatus(tr("Extracting mods..."));
+    auto stage = std::make_shared<ModExtractStage>(FS::PathCombine(QDir(m_stagingPath).absolutePath(), "minecraft"), m_version.minecraft);
+    for (auto iter = modsToExtract.cbegin(); iter != modsToExtract.cend(); iter++)
+        stage->addMod(iter.value(), iter.key());
+    for (auto iter = modsToDecomp.cbegin(); iter != modsToDecomp.cend(); iter++)
+        stage->addMod(iter.value(), iter.key());
+    for (auto iter = modsToCopy.cbegin(); iter != modsToCopy.cend(); iter++)
+        stage->addCopy(iter.key(), iter.value());
+
+    m_modExtractAborted = false;
+    m_modExtractFuture = Executor::io().run([this, stage] {
+        auto progress = [this](qint64 current, qint64 total) {
+            QMetaObject::invokeMethod(
+                this,
+                [this, current, total] {
+                    //: Amount of bytes of the mods placed in the instance, out of the total
+                    setDetails(tr("%1 / %2").arg(StringUtils::humanReadableFileSize(current), StringUtils::humanReadableFileSize(total)));
+                    setProgress(current, total);
+                },
+                Qt::QueuedConnection);
+        };
+        if (stage->run(progress, [this] { return bool(m_modExtractAborted); }))
+            return true;
+        if (!m_modExtractAborted)
+            qWarning() << "Failed to extract mods:" << stage->errorString();
+        return false;
+    });
+    connect(&m_modExtractFutureWatcher, &QFutureWatcher<bool>::finished, this, &PackInstallTask::onModsExtracted);
+    connect(&m_modExtractFutureWatcher, &QFutureWatcher<bool>::canceled, this, [&]() { emitAborted(); });
+    m_modExtractFutureWatcher.setFuture(m_modExtractFuture);
 }
 
 void PackInstallTask::onModsExtracted()
 {
     qDebug() << "PackInstallTask::onModsExtracted: " << QThread::currentThreadId();
-    if (m_modExtractFuture.result()) {
+    setDetails("");
+    if (m_modExtractAborted) {
+        emitAborted();
+    } else if (m_modExtractFuture.result()) {
         install();
     } else {
         emitFailed(tr("Failed to extract mods..."));
     }
 }
 
-bool PackInstallTask::extractMods(const QMap<QString, VersionMod>& toExtract,
-                                  const QMap<QString, VersionMod>& toDecomp,
-                                  const QMap<QString, QString>& toCopy)
-{
-    qDebug() << "PackInstallTask::extractMods: " << QThread::currentThreadId();
-
-    setStatus(tr("Extracting mods..."));
-    for (auto iter = toExtract.begin(); iter != toExtract.end(); iter++) {
-        auto& modPath = iter.key();
-        auto& mod = iter.value();
-
-        QString extractToDir;
-        if (mod.type == ModType::Extract) {
-            extractToDir = getDirForModType(mod.extractTo, mod.extractTo_raw);
-        } else if (mod.type == ModType::TexturePackExtract) {
-            extractToDir = FS::PathCombine("texturepacks", "extracted");
-        } else if (mod.type == ModType::ResourcePackExtract) {
-            extractToDir = FS::PathCombine("resourcepacks", "extracted");
-        }
-
-        QDir extractDir(m_stagingPath);
-        auto extractToPath = FS::PathCombine(extractDir.absolutePath(), "minecraft", extractToDir);
-
-        QString folderToExtract = "";
-        if (mod.type == ModType::Extract) {
-            folderToExtract = mod.extractFolder;
-            folderToExtract.remove(QRegularExpression("^/"));
-        }
-
-        qDebug() << "Extracting " + mod.file + " to " + extractToDir;
-        if (!MMCZip::extractDir(modPath, folderToExtract, extractToPath)) {
-            // assume error
-            return false;
-        }
-    }
-
-    for (auto iter = toDecomp.begin(); iter != toDecomp.end(); iter++) {
-        auto& modPath = iter.key();
-        auto& mod = iter.value();
-        auto extractToDir = getDirForModType(mod.decompType, mod.decompType_raw);
-
-        QDir extractDir(m_stagingPath);
-        auto extractToPath = FS::PathCombine(extractDir.absolutePath(), "minecraft", extractToDir, mod.decompFile);
-
-        qDebug() << "Extracting " + mod.decompFile + " to " + extractToDir;
-        if (!MMCZip::extractFile(modPath, mod.decompFile, extractToPath)) {
-            qWarning() << "Failed to extract" << mod.decompFile;
-            return false;
-        }
-    }
-
-    for (auto iter = toCopy.begin(); iter != toCopy.end(); iter++) {
-        auto& from = iter.key();
-        auto& to = iter.value();
-
-        // If the file already exists, assume the mod is the correct copy - and remove
-        // the copy from the Configs.zip
-        QFileInfo fileInfo(to);
-        if (fileInfo.exists()) {
-            if (!QFile::remove(to)) {
-                qWarning() << "Failed to delete" << to;
-                return false;
-            }
-        }
-
-        FS::copy fileCopyOperation(from, to);
-        if (!fileCopyOperation()) {
-            qWarning() << "Failed to copy" << from << "to" << to;
-            return false;
-        }
-    }
-    return true;
-}
-
 void PackInstallTask::install()
 {
     qDebug() << "PackInstallTask::install: " << QThread::currentThreadId();
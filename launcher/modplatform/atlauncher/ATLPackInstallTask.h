@@ -46,6 +46,7 @@
 #include "net/NetJob.h"
 #include "settings/INISettingsObject.h"
 
+#include <atomic>
 #include <memory>
 #include <optional>
 
@@ -114,9 +115,6 @@ class PackInstallTask : public InstanceTask {
     void installConfigs();
     void extractConfigs();
     void downloadMods();
-    bool extractMods(const QMap<QString, VersionMod>& toExtract,
-                     const QMap<QString, VersionMod>& toDecomp,
-                     const QMap<QString, QString>& toCopy);
     void install();
 
    private:
@@ -147,6 +145,7 @@ class PackInstallTask : public InstanceTask {
 
     QFuture<bool> m_modExtractFuture;
     QFutureWatcher<bool> m_modExtractFutureWatcher;
+    std::atomic_bool m_modExtractAborted{ false };
 };
 
 }  // namespace ATLauncher
@@ -31,17 +31,23 @@ Task::Ptr FlameAPI::matchFingerprints(const QList<uint>& fingerprints, std::shar
     return netJob;
 }
 
-auto FlameAPI::getModFileChangelog(int modId, int fileId) -> QString
+Task::Ptr FlameAPI::getModFileChangelog(int modId, int fileId, std::shared_ptr<QByteArray> response) const
 {
-    QEventLoop lock;
-    QString changelog;
-
     auto netJob = makeShared<NetJob>(QString("Flame::FileChangelog"), APPLICATION->network());
-    auto response = std::make_shared<QByteArray>();
     netJob->addNetAction(Net::Download::makeByteArray(
         QString("https://api.curseforge.com/v1/mods/%1/files/%2/changelog")
             .arg(QString::fromStdString(std::to_string(modId)), QString::fromStdString(std::to_string(fileId))),
         response));
+    return netJob;
+}
+
+auto FlameAPI::getModFileChangelog(int modId, int fileId) -> QString
+{
+    QEventLoop lock;
+    QString changelog;
+
+    auto response = std::make_shared<QByteArray>();
+    auto netJob = getModFileChangelog(modId, fileId, response);
 
     QObject::connect(netJob.get(), &NetJob::succeeded, [&netJob, response, &changelog] {
         QJsonParseError parse_error{};
@@ -13,6 +13,8 @@
 class FlameAPI : public NetworkResourceAPI {
    public:
     auto getModFileChangelog(int modId, int fileId) -> QString;
+    /** The response holds the changelog in its "data" field. */
+    Task::Ptr getModFileChangelog(int modId, int fileId, std::shared_ptr<QByteArray> response) const;
     auto getModDescription(int modId) -> QString;
 
     auto getLatestVersion(VersionSearchArgs&& args) -> ModPlatform::IndexedVersion;
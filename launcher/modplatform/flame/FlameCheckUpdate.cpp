@@ -173,8 +173,8 @@ void FlameCheckUpdate::executeTask()
             }
 
             auto download_task = makeShared<ResourceDownloadTask>(pack, latest_ver, m_mods_folder);
-            m_updatable.emplace_back(pack->name, mod->metadata()->hash, old_version, latest_ver.version,
-                                     api.getModFileChangelog(latest_ver.addonId.toInt(), latest_ver.fileId.toInt()),
+            // the changelog is a request per mod, it's only fetched once it is shown
+            m_updatable.emplace_back(pack->name, mod->metadata()->hash, old_version, latest_ver.version, QString(),
                                      ModPlatform::ResourceProvider::FLAME, download_task);
         }
     }
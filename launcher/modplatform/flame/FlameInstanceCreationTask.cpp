@@ -48,6 +48,7 @@
 #include "minecraft/PackProfile.h"
 
 #include "modplatform/helpers/OverrideUtils.h"
+#include "modplatform/helpers/PackUpdatePlan.h"
 
 #include "settings/INISettingsObject.h"
 
@@ -160,15 +161,17 @@ bool FlameCreationTask::updateInstance()
 
         QDir old_minecraft_dir(inst->gameRoot());
 
-        // We will remove all the previous overrides, to prevent duplicate files!
-        // TODO: Currently 'overrides' will always override the stuff on update. How do we preserve unchanged overrides?
-        // FIXME: We may want to do something about disabled mods.
+        // Mod files are matched by their file ID above, as the manifest has no hashes to go by. The overrides are compared with
+        // what's installed, so the unchanged ones aren't copied over again, and the ones that are gone get removed.
         auto old_overrides = Override::readOverrides("overrides", old_index_folder);
-        for (const auto& entry : old_overrides) {
-            if (entry.isEmpty())
-                continue;
-            qDebug() << "Scheduling" << entry << "for removal";
-            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(entry));
+        QStringList new_override_folders;
+        if (!m_pack.overrides.isEmpty())
+            new_override_folders.append(FS::PathCombine(m_stagingPath, m_pack.overrides));
+
+        m_update_plan = PackUpdate::plan(inst->gameRoot(), {}, {}, old_overrides, new_override_folders);
+        for (const auto& path : m_update_plan->deletes) {
+            qDebug() << "Scheduling" << path << "for removal";
+            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(path));
         }
 
         // Remove remaining old files (we need to do an API request to know which ids are which files...)
@@ -337,6 +340,9 @@ bool FlameCreationTask::createInstance()
                 setError(tr("Could not rename the overrides folder:\n") + m_pack.overrides);
                 return false;
             }
+
+            if (m_instance && m_update_plan)
+                PackUpdate::applyToStaging(*m_update_plan, m_instance.value()->gameRoot(), mcPath);
         } else {
             logWarning(
                 tr("The specified overrides folder (%1) is missing. Maybe the modpack was already used before?").arg(m_pack.overrides));
@@ -571,7 +577,13 @@ void FlameCreationTask::copyBlockedMods(QList<BlockedMod> const& blocked_mods)
     setAbortable(false);
     int i = 0;
     int total = blocked_mods.length();
-    setProgress(i, total);
+    qint64 bytesCopied = 0;
+    qint64 bytesTotal = 0;
+    for (auto const& mod : blocked_mods) {
+        if (mod.matched)
+            bytesTotal += QFileInfo(mod.localPath).size();
+    }
+    setProgress(bytesCopied, bytesTotal);
     for (auto const& mod : blocked_mods) {
         if (!mod.matched) {
             qDebug() << mod.name << "was not matched to a local file, skipping copy";
@@ -584,12 +596,14 @@ void FlameCreationTask::copyBlockedMods(QList<BlockedMod> const& blocked_mods)
 
         qDebug() << "Will try to copy" << mod.localPath << "to" << destPath;
 
-        if (!FS::copy(mod.localPath, destPath)()) {
+        FS::copy modCopy(mod.localPath, destPath);
+        if (!modCopy()) {
             qDebug() << "Copy of" << mod.localPath << "to" << destPath << "Failed";
         }
 
         i++;
-        setProgress(i, total);
+        bytesCopied += modCopy.bytesCopied();
+        setProgress(bytesCopied, bytesTotal);
     }
 
     setAbortable(true);
@@ -598,9 +612,17 @@ void FlameCreationTask::copyBlockedMods(QList<BlockedMod> const& blocked_mods)
 void FlameCreationTask::validateZIPResouces()
 {
     qDebug() << "Validating whether resources stored as .zip are in the right place";
-    for (auto [fileName, targetFolder] : m_ZIP_resources) {
+
+    // identifying only looks at the archive layouts, so all of them can be checked at once
+    QList<QFileInfo> localFiles;
+    for (auto [fileName, targetFolder] : m_ZIP_resources)
+        localFiles.append(QFileInfo(FS::PathCombine(m_stagingPath, "minecraft", targetFolder, fileName)));
+    auto types = ResourceUtils::identify(localFiles);
+
+    for (int i = 0; i < m_ZIP_resources.size(); i++) {
+        auto [fileName, targetFolder] = m_ZIP_resources[i];
         qDebug() << "Checking" << fileName << "...";
-        auto localPath = FS::PathCombine(m_stagingPath, "minecraft", targetFolder, fileName);
+        auto localPath = localFiles[i].filePath();
 
         /// @brief check the target and move the the file
         /// @return path where file can now be found
@@ -629,8 +651,7 @@ void FlameCreationTask::validateZIPResouces()
             }
         };
 
-        QFileInfo localFileInfo(localPath);
-        auto type = ResourceUtils::identify(localFileInfo);
+        auto type = types[i];
 
         QString worldPath;
 
@@ -42,6 +42,7 @@
 #include "minecraft/MinecraftInstance.h"
 
 #include "modplatform/flame/FileResolvingTask.h"
+#include "modplatform/helpers/PackUpdatePlan.h"
 
 #include "net/NetJob.h"
 
@@ -92,4 +93,5 @@ class FlameCreationTask final : public InstanceCreationTask {
     QList<std::pair<QString, QString>> m_ZIP_resources;
 
     std::optional<InstancePtr> m_instance;
+    std::optional<PackUpdate::Plan> m_update_plan;
 };
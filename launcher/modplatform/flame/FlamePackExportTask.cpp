@@ -24,17 +24,20 @@
 #include <QCryptographicHash>
 #include <QFileInfo>
 #include <QMessageBox>
-#include <QtConcurrentRun>
+#include <QtConcurrent>
 #include <algorithm>
 #include <iterator>
 #include <memory>
+#include "Application.h"
 #include "Json.h"
 #include "MMCZip.h"
 #include "minecraft/PackProfile.h"
 #include "minecraft/mod/ModFolderModel.h"
 #include "modplatform/ModIndex.h"
 #include "modplatform/flame/FlameModIndex.h"
+#include "modplatform/helpers/HashCache.h"
 #include "modplatform/helpers/HashUtils.h"
+#include "tasks/Executor.h"
 #include "tasks/Task.h"
 
 const QString FlamePackExportTask::TEMPLATE = "<li><a href=\"{url}\">{name}{authors}</a></li>\n";
@@ -65,6 +68,11 @@ void FlamePackExportTask::executeTask()
 
 bool FlamePackExportTask::abort()
 {
+    if (hashFuture.isRunning()) {
+        // the workers check this before each file, resolveHashes reports the abort once they drained
+        hashingAborted = true;
+        return true;
+    }
     if (task) {
         task->abort();
         emitAborted();
@@ -98,10 +106,16 @@ void FlamePackExportTask::collectHashes()
 {
     setAbortable(true);
     setStatus(tr("Finding file hashes..."));
-    setProgress(1, 5);
-    auto allMods = mcInstance->loaderModList()->allMods();
-    ConcurrentTask::Ptr hashingTask(new ConcurrentTask(this, "MakeHashesTask", 10));
-    task.reset(hashingTask);
+
+    // index the mods once instead of searching the whole list for every file
+    QHash<QString, const Mod*> modsByPath;
+    if (mcInstance) {
+        for (const Mod* mod : mcInstance->loaderModList()->allMods())
+            modsByPath.insert(mod->fileinfo().absoluteFilePath(), mod);
+    }
+
+    QList<FingerprintJob> toHash;
+    qint64 totalBytes = 0;
     for (const QFileInfo& file : files) {
         const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
         // require sensible file types
@@ -112,21 +126,13 @@ void FlamePackExportTask::collectHashes()
 
         if (relative.startsWith("resourcepacks/") &&
             (relative.endsWith(".zip") || relative.endsWith(".zip.disabled"))) {  // is resourcepack
-            auto hashTask = Hashing::createFlameHasher(file.absoluteFilePath());
-            connect(hashTask.get(), &Hashing::Hasher::resultsReady, [this, relative, file](QString hash) {
-                if (m_state == Task::State::Running) {
-                    pendingHashes.insert(hash, { relative, file.absoluteFilePath(), relative.endsWith(".zip") });
-                }
-            });
-            connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
-            hashingTask->addTask(hashTask);
+            toHash.append({ { relative, file.absoluteFilePath(), relative.endsWith(".zip"), false }, file.size(), {} });
+            totalBytes += file.size();
             continue;
         }
 
-        if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
-            modIter != allMods.end()) {
-            const Mod* mod = *modIter;
-            if (!mod || mod->type() == ResourceType::FOLDER) {
+        if (const Mod* mod = modsByPath.value(file.absoluteFilePath()); mod) {
+            if (mod->type() == ResourceType::FOLDER) {
                 continue;
             }
             if (mod->metadata() && mod->metadata()->provider == ModPlatform::ResourceProvider::FLAME) {
@@ -136,39 +142,54 @@ void FlamePackExportTask::collectHashes()
                 continue;
             }
 
-            auto hashTask = Hashing::createFlameHasher(mod->fileinfo().absoluteFilePath());
-            connect(hashTask.get(), &Hashing::Hasher::resultsReady, [this, mod](QString hash) {
-                if (m_state == Task::State::Running) {
-                    pendingHashes.insert(hash, { mod->name(), mod->fileinfo().absoluteFilePath(), mod->enabled(), true });
-                }
-            });
-            connect(hashTask.get(), &Task::failed, this, &FlamePackExportTask::emitFailed);
-            hashingTask->addTask(hashTask);
+            toHash.append({ { mod->name(), mod->fileinfo().absoluteFilePath(), mod->enabled(), true }, file.size(), {} });
+            totalBytes += file.size();
         }
     }
-    auto progressStep = std::make_shared<TaskStepProgress>();
-    connect(hashingTask.get(), &Task::finished, this, [this, progressStep] {
-        progressStep->state = TaskStepState::Succeeded;
-        stepProgress(*progressStep);
-    });
 
-    connect(hashingTask.get(), &Task::succeeded, this, &FlamePackExportTask::makeApiRequest);
-    connect(hashingTask.get(), &Task::failed, this, [this, progressStep](QString reason) {
-        progressStep->state = TaskStepState::Failed;
-        stepProgress(*progressStep);
-        emitFailed(reason);
-    });
-    connect(hashingTask.get(), &Task::stepProgress, this, &FlamePackExportTask::propagateStepProgress);
+    // fingerprint in parallel off the GUI thread; files that didn't change since the last export or update check come from the cache
+    hashingAborted = false;
+    setProgress(0, totalBytes);
+    auto hashCache = APPLICATION->hashCache();
+    hashFuture = Executor::cpu().run([this, toHash, totalBytes, hashCache]() mutable {
+        std::atomic<qint64> doneBytes{ 0 };
 
-    connect(hashingTask.get(), &Task::progress, this, [this, progressStep](qint64 current, qint64 total) {
-        progressStep->update(current, total);
-        stepProgress(*progressStep);
-    });
-    connect(hashingTask.get(), &Task::status, this, [this, progressStep](QString status) {
-        progressStep->status = status;
-        stepProgress(*progressStep);
+        QtConcurrent::blockingMap(toHash, [this, &doneBytes, totalBytes, hashCache](FingerprintJob& job) {
+            if (hashingAborted)
+                return;
+            if (hashCache)
+                job.fingerprint = hashCache->get(job.info.path, "murmur2");
+            if (job.fingerprint.isEmpty()) {
+                job.fingerprint = Hashing::flameFingerprint(job.info.path);
+                if (hashCache && !job.fingerprint.isEmpty())
+                    hashCache->put(job.info.path, "murmur2", job.fingerprint);
+            }
+
+            const qint64 current = doneBytes += job.size;
+            QMetaObject::invokeMethod(this, [this, current, totalBytes] { setProgress(current, totalBytes); }, Qt::QueuedConnection);
+        });
+        return toHash;
     });
-    hashingTask->start();
+    connect(&hashWatcher, &QFutureWatcher<QList<FingerprintJob>>::finished, this, &FlamePackExportTask::resolveHashes,
+            Qt::UniqueConnection);
+    hashWatcher.setFuture(hashFuture);
+}
+
+void FlamePackExportTask::resolveHashes()
+{
+    if (hashingAborted) {
+        emitAborted();
+        return;
+    }
+
+    for (const FingerprintJob& job : hashFuture.result()) {
+        if (job.fingerprint.isEmpty()) {
+            emitFailed(tr("Could not hash %1").arg(job.info.path));
+            return;
+        }
+        pendingHashes.insert(job.fingerprint, job.info);
+    }
+    makeApiRequest();
 }
 
 void FlamePackExportTask::makeApiRequest()
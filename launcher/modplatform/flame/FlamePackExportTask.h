@@ -19,6 +19,11 @@
 
 #pragma once
 
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include <atomic>
+
 #include "BaseInstance.h"
 #include "MMCZip.h"
 #include "minecraft/MinecraftInstance.h"
@@ -66,16 +71,25 @@ class FlamePackExportTask : public Task {
         bool enabled;
         bool isMod;
     };
+    struct FingerprintJob {
+        HashInfo info;
+        qint64 size;
+        QString fingerprint;
+    };
 
     FlameAPI api;
 
     QFileInfoList files;
     QMap<QString, HashInfo> pendingHashes{};
     QMap<QString, ResolvedFile> resolvedFiles{};
+    QFuture<QList<FingerprintJob>> hashFuture;
+    QFutureWatcher<QList<FingerprintJob>> hashWatcher;
+    std::atomic_bool hashingAborted{ false };
     Task::Ptr task;
 
     void collectFiles();
     void collectHashes();
+    void resolveHashes();
     void makeApiRequest();
     void getProjectsInfo();
     void buildZip();
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HashCache.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "FileSystem.h"
+#include "Json.h"
+
+namespace Hashing {
+
+HashCache::HashCache(QString path) : QObject(), m_index_file(path)
+{
+    saveBatchingTimer.setSingleShot(true);
+    saveBatchingTimer.setTimerType(Qt::VeryCoarseTimer);
+
+    connect(&saveBatchingTimer, &QTimer::timeout, this, &HashCache::SaveNow);
+}
+
+HashCache::~HashCache()
+{
+    saveBatchingTimer.stop();
+    SaveNow();
+}
+
+QString HashCache::get(const QString& path, const QString& type)
+{
+    QFileInfo info(path);
+    auto key = info.absoluteFilePath();
+
+    QReadLocker locker(&m_lock);
+    auto it = m_entries.constFind(key);
+    if (it == m_entries.constEnd())
+        return {};
+    if (it->size != info.size() || it->mtime != info.lastModified().toMSecsSinceEpoch())
+        return {};
+    return it->hashes.value(type);
+}
+
+void HashCache::put(const QString& path, const QString& type, const QString& hash)
+{
+    if (hash.isEmpty())
+        return;
+
+    QFileInfo info(path);
+    auto key = info.absoluteFilePath();
+    auto size = info.size();
+    auto mtime = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        QWriteLocker locker(&m_lock);
+        auto& entry = m_entries[key];
+        if (entry.size != size || entry.mtime != mtime) {
+            entry.size = size;
+            entry.mtime = mtime;
+            entry.hashes.clear();
+        }
+        entry.hashes[type] = hash;
+    }
+
+    // the timer lives in our thread, put() may be called from anywhere
+    QMetaObject::invokeMethod(this, &HashCache::SaveEventually, Qt::QueuedConnection);
+}
+
+void HashCache::Load()
+{
+    if (m_index_file.isNull())
+        return;
+
+    QFile index(m_index_file);
+    if (!index.open(QIODevice::ReadOnly))
+        return;
+
+    try {
+        auto root = Json::requireObject(Json::requireDocument(index.readAll()), "HashCache root");
+
+        // check file version first
+        if (Json::ensureString(root, "version") != "1")
+            return;
+
+        QWriteLocker locker(&m_lock);
+        for (auto element : Json::ensureArray(root, "files")) {
+            auto element_obj = Json::ensureObject(element);
+
+            Entry entry;
+            entry.size = Json::ensureDouble(element_obj, "size", -1);
+            entry.mtime = Json::ensureDouble(element_obj, "mtime", -1);
+            auto hashes = Json::ensureObject(element_obj, "hashes");
+            for (auto it = hashes.constBegin(); it != hashes.constEnd(); ++it)
+                entry.hashes.insert(it.key(), it.value().toString());
+
+            m_entries.insert(Json::ensureString(element_obj, "path"), entry);
+        }
+    } catch (const Json::JsonException& e) {
+        qWarning() << "Failed to read hash cache:" << e.cause();
+    }
+}
+
+void HashCache::SaveEventually()
+{
+    // reset the save timer
+    saveBatchingTimer.stop();
+    saveBatchingTimer.start(30000);
+}
+
+void HashCache::SaveNow()
+{
+    if (m_index_file.isNull())
+        return;
+
+    QJsonObject toplevel;
+    Json::writeString(toplevel, "version", "1");
+
+    QJsonArray filesArr;
+    {
+        QReadLocker locker(&m_lock);
+        for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            // forget about files that are gone
+            if (!QFileInfo::exists(it.key()))
+                continue;
+
+            QJsonObject hashes;
+            for (auto hash = it->hashes.constBegin(); hash != it->hashes.constEnd(); ++hash)
+                hashes.insert(hash.key(), hash.value());
+
+            QJsonObject entryObj;
+            Json::writeString(entryObj, "path", it.key());
+            entryObj.insert("size", QJsonValue(double(it->size)));
+            entryObj.insert("mtime", QJsonValue(double(it->mtime)));
+            entryObj.insert("hashes", hashes);
+            filesArr.append(entryObj);
+        }
+    }
+    toplevel.insert("files", filesArr);
+
+    try {
+        Json::write(toplevel, m_index_file);
+    } catch (const Exception& e) {
+        qWarning() << "Failed to write hash cache:" << e.cause();
+    }
+}
+
+}  // namespace Hashing
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QString>
+#include <QTimer>
+
+namespace Hashing {
+
+/**
+ * Persistent cache of file hashes, shared by all instances.
+ *
+ * Entries are keyed by the absolute file path and are only valid as long as the size and
+ * modification time of the file stay the same. Safe to use from worker threads.
+ */
+class HashCache : public QObject {
+    Q_OBJECT
+   public:
+    // supply path to the cache index file
+    HashCache(QString path = QString());
+    ~HashCache() override;
+
+    // get the cached hash of the given type ("sha1", "sha512", "murmur2", ...), or a null string if the file changed or is unknown
+    QString get(const QString& path, const QString& type);
+    void put(const QString& path, const QString& type, const QString& hash);
+
+    // (re)start a timer that calls SaveNow later.
+    void SaveEventually();
+    void Load();
+
+   public slots:
+    void SaveNow();
+
+   private:
+    struct Entry {
+        qint64 size = -1;
+        qint64 mtime = -1;
+        QHash<QString, QString> hashes;
+    };
+
+    QHash<QString, Entry> m_entries;
+    QReadWriteLock m_lock;
+    QString m_index_file;
+    QTimer saveBatchingTimer;
+};
+
+}  // namespace Hashing
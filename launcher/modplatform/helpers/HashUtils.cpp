@@ -2,9 +2,15 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QHash>
 
+#include <memory>
+#include <vector>
+
+#include "Application.h"
 #include "FileSystem.h"
 #include "StringUtils.h"
+#include "modplatform/helpers/HashCache.h"
 
 #include <MurmurHash2.h>
 
@@ -12,6 +18,35 @@ namespace Hashing {
 
 static ModPlatform::ProviderCapabilities ProviderCaps;
 
+QStringList hashFile(const QString& file_path, const QList<QCryptographicHash::Algorithm>& algorithms)
+{
+    QFile file(file_path);
+    if (!file.open(QFile::ReadOnly)) {
+        qWarning() << "Could not open" << file_path << "for hashing:" << file.errorString();
+        return {};
+    }
+
+    std::vector<std::unique_ptr<QCryptographicHash>> hashes;
+    for (auto algorithm : algorithms)
+        hashes.push_back(std::make_unique<QCryptographicHash>(algorithm));
+
+    QByteArray buffer(1 * MiB, Qt::Uninitialized);
+    qint64 read;
+    while ((read = file.read(buffer.data(), buffer.size())) > 0) {
+        for (auto& hash : hashes)
+            hash->addData(buffer.constData(), read);
+    }
+    if (read < 0) {
+        qWarning() << "Could not read" << file_path << "for hashing:" << file.errorString();
+        return {};
+    }
+
+    QStringList result;
+    for (auto& hash : hashes)
+        result.append(hash->result().toHex());
+    return result;
+}
+
 Hasher::Ptr createHasher(QString file_path, ModPlatform::ResourceProvider provider)
 {
     switch (provider) {
@@ -50,22 +85,8 @@ Hasher::Ptr createBlockedModHasher(QString file_path, ModPlatform::ResourceProvi
 
 void ModrinthHasher::executeTask()
 {
-    QFile file(m_path);
-
-    try {
-        file.open(QFile::ReadOnly);
-    } catch (FS::FileSystemException& e) {
-        qCritical() << QString("Failed to open JAR file in %1").arg(m_path);
-        qCritical() << QString("Reason: ") << e.cause();
-
-        emitFailed("Failed to open file for hashing.");
-        return;
-    }
-
     auto hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
-    m_hash = ProviderCaps.hash(ModPlatform::ResourceProvider::MODRINTH, &file, hash_type);
-
-    file.close();
+    m_hash = cachedHash(m_path, hash_type);
 
     if (m_hash.isEmpty()) {
         emitFailed("Empty hash!");
@@ -75,15 +96,51 @@ void ModrinthHasher::executeTask()
     }
 }
 
-void FlameHasher::executeTask()
+QString flameFingerprint(const QString& file_path)
 {
     // CF-specific
     auto should_filter_out = [](char c) { return (c == 9 || c == 10 || c == 13 || c == 32); };
 
-    std::ifstream file_stream(StringUtils::toStdString(m_path).c_str(), std::ifstream::binary);
-    // TODO: This is very heavy work, but apparently QtConcurrent can't use move semantics, so we can't boop this to another thread.
-    // How do we make this non-blocking then?
-    m_hash = QString::number(MurmurHash2(std::move(file_stream), 4 * MiB, should_filter_out));
+    std::ifstream file_stream(StringUtils::toStdString(file_path).c_str(), std::ifstream::binary);
+    if (!file_stream.is_open())
+        return {};
+    return QString::number(MurmurHash2(std::move(file_stream), 4 * MiB, should_filter_out));
+}
+
+QString cachedHash(const QString& file_path, const QString& type)
+{
+    auto hashCache = APPLICATION->hashCache();
+    if (hashCache) {
+        if (auto hash = hashCache->get(file_path, type); !hash.isEmpty())
+            return hash;
+    }
+
+    QString hash;
+    if (type == "murmur2") {
+        hash = flameFingerprint(file_path);
+    } else {
+        static const QHash<QString, QCryptographicHash::Algorithm> algorithms = { { "md5", QCryptographicHash::Md5 },
+                                                                                  { "sha1", QCryptographicHash::Sha1 },
+                                                                                  { "sha256", QCryptographicHash::Sha256 },
+                                                                                  { "sha512", QCryptographicHash::Sha512 } };
+        auto algorithm = algorithms.constFind(type);
+        if (algorithm == algorithms.constEnd()) {
+            qWarning() << "Unknown hash type" << type;
+            return {};
+        }
+        auto hashes = hashFile(file_path, { *algorithm });
+        if (!hashes.isEmpty())
+            hash = hashes.first();
+    }
+
+    if (hashCache && !hash.isEmpty())
+        hashCache->put(file_path, type, hash);
+    return hash;
+}
+
+void FlameHasher::executeTask()
+{
+    m_hash = cachedHash(m_path, "murmur2");
 
     if (m_hash.isEmpty()) {
         emitFailed("Empty hash!");
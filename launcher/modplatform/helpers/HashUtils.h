@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QCryptographicHash>
 #include <QString>
 
 #include "modplatform/ModIndex.h"
@@ -58,6 +59,25 @@ class BlockedModHasher : public Hasher {
     QString hash_type;
 };
 
+/**
+ * Reads the file once, in fixed size chunks, feeding every requested algorithm.
+ * Returns the hex encoded digests in the order of the algorithms, or an empty list if the file could not be read.
+ */
+QStringList hashFile(const QString& file_path, const QList<QCryptographicHash::Algorithm>& algorithms);
+
+/**
+ * Computes the CurseForge fingerprint of a file (murmur2 over the file with whitespace bytes removed).
+ * Safe to call from any thread. Returns an empty string if the file could not be read.
+ */
+QString flameFingerprint(const QString& file_path);
+
+/**
+ * Returns the hash of the given type ("md5", "sha1", "sha256", "sha512" or "murmur2"), taking it from the shared
+ * hash cache when the file didn't change since it was last hashed, and storing it there otherwise.
+ * Safe to call from any thread. Returns an empty string if the file could not be read.
+ */
+QString cachedHash(const QString& file_path, const QString& type);
+
 Hasher::Ptr createHasher(QString file_path, ModPlatform::ResourceProvider provider);
 Hasher::Ptr createFlameHasher(QString file_path);
 Hasher::Ptr createModrinthHasher(QString file_path);
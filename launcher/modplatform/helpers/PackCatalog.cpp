@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PackCatalog.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+#include "Exception.h"
+#include "FileSystem.h"
+
+namespace {
+const quint32 catalogMagic = 0x50434154;  // "PCAT"
+const quint32 catalogVersion = 1;
+constexpr QDataStream::Version catalogStreamVersion = QDataStream::Qt_5_12;
+}  // namespace
+
+PackCatalog::PackCatalog(const QString& indexFile) : m_index_file(indexFile) {}
+
+QStringList PackCatalog::tokenize(const QString& text)
+{
+    QStringList tokens;
+    QString token;
+    for (auto c : text.toCaseFolded()) {
+        if (c.isLetterOrNumber()) {
+            token.append(c);
+        } else if (!token.isEmpty()) {
+            tokens.append(token);
+            token.clear();
+        }
+    }
+    if (!token.isEmpty())
+        tokens.append(token);
+    tokens.sort();
+    tokens.removeDuplicates();
+    return tokens;
+}
+
+bool PackCatalog::load()
+{
+    QFile file(m_index_file);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    const auto data = file.readAll();
+    file.close();
+
+    QDataStream in(data);
+    in.setVersion(catalogStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString source;
+    quint32 count = 0;
+    in >> magic >> version >> source >> count;
+    if (in.status() != QDataStream::Ok || magic != catalogMagic || version != catalogVersion)
+        return false;
+
+    QList<Pack> packs;
+    // the count is only as trustworthy as the file
+    packs.reserve(int(qMin(count, quint32(100000))));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        Pack pack;
+        in >> pack.id >> pack.name >> pack.author >> pack.summary >> pack.gameVersion >> pack.popularity >> pack.tokens >> pack.data;
+        packs.append(pack);
+    }
+    if (in.status() != QDataStream::Ok || !in.atEnd()) {
+        qWarning() << "Ignoring the broken pack catalog" << m_index_file;
+        return false;
+    }
+
+    m_source = source;
+    setPacks(packs);
+    m_loaded = true;
+    return true;
+}
+
+bool PackCatalog::update(const QString& sourceFile, const QString& source, const Parser& parse)
+{
+    if (m_loaded && !source.isEmpty() && source == m_source)
+        return false;
+
+    QList<Pack> packs;
+    try {
+        packs = parse(FS::read(sourceFile));
+    } catch (const Exception& e) {
+        qWarning() << "Couldn't read the pack list" << sourceFile << ":" << e.cause();
+        return false;
+    }
+
+    // a different list may have the same packs with other details
+    for (auto& pack : packs)
+        pack.tokens.clear();
+    m_source = source;
+    setPacks(packs);
+    m_loaded = true;
+    save();
+    return true;
+}
+
+bool PackCatalog::merge(QList<Pack> packs)
+{
+    if (packs.isEmpty())
+        return false;
+
+    QHash<QString, int> positions;
+    positions.reserve(m_packs.size());
+    for (int i = 0; i < m_packs.size(); i++)
+        positions.insert(m_packs[i].id, i);
+
+    auto same = [](const Pack& a, const Pack& b) {
+        return a.name == b.name && a.author == b.author && a.summary == b.summary && a.gameVersion == b.gameVersion &&
+               a.popularity == b.popularity && a.data == b.data;
+    };
+
+    auto merged = m_packs;
+    bool changed = false;
+    for (auto& pack : packs) {
+        pack.tokens.clear();
+        auto position = positions.constFind(pack.id);
+        if (position == positions.constEnd()) {
+            positions.insert(pack.id, merged.size());
+            merged.append(pack);
+            changed = true;
+        } else if (!same(merged[*position], pack)) {
+            merged[*position] = pack;
+            changed = true;
+        }
+    }
+    if (!changed)
+        return false;
+
+    setPacks(merged);
+    m_loaded = true;
+    save();
+    return true;
+}
+
+void PackCatalog::setPacks(QList<Pack> packs)
+{
+    QHash<QString, QVector<int>> postings;
+    for (int i = 0; i < packs.size(); i++) {
+        auto& pack = packs[i];
+        if (pack.tokens.isEmpty())
+            pack.tokens = tokenize(pack.name + ' ' + pack.author + ' ' + pack.summary);
+        // the tokens of a pack are unique, and the packs are visited in order, so the postings end up sorted
+        for (auto& token : pack.tokens)
+            postings[token].append(i);
+    }
+
+    m_packs = packs;
+    m_names.clear();
+    m_names.reserve(m_packs.size());
+    for (auto& pack : m_packs)
+        m_names.append(pack.name.toCaseFolded());
+    m_words = postings.keys();
+    m_words.sort();
+    m_postings.clear();
+    m_postings.reserve(m_words.size());
+    for (auto& word : m_words)
+        m_postings.append(postings.value(word));
+}
+
+QVector<int> PackCatalog::search(const QString& query) const
+{
+    QVector<int> result;
+    auto terms = tokenize(query);
+    if (terms.isEmpty()) {
+        result.resize(m_packs.size());
+        std::iota(result.begin(), result.end(), 0);
+        return result;
+    }
+
+    for (int t = 0; t < terms.size(); t++) {
+        // the words starting with the term are next to each other
+        QVector<int> matches;
+        auto word = std::lower_bound(m_words.begin(), m_words.end(), terms[t]);
+        for (auto it = word; it != m_words.end() && it->startsWith(terms[t]); ++it)
+            matches.append(m_postings[int(std::distance(m_words.begin(), it))]);
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+        if (t == 0) {
+            result.swap(matches);
+        } else {
+            QVector<int> both;
+            std::set_intersection(result.begin(), result.end(), matches.begin(), matches.end(), std::back_inserter(both));
+            result.swap(both);
+        }
+        if (result.isEmpty())
+            break;
+    }
+
+    // like the platforms' own search, a name that has the query anywhere in it matches too, as "factory" does "SkyFactory"
+    const auto needle = query.trimmed().toCaseFolded();
+    QVector<int> named;
+    for (int i = 0; i < m_names.size(); i++) {
+        if (m_names[i].contains(needle))
+            named.append(i);
+    }
+    if (!named.isEmpty()) {
+        QVector<int> either;
+        std::set_union(result.begin(), result.end(), named.begin(), named.end(), std::back_inserter(either));
+        result.swap(either);
+    }
+    return result;
+}
+
+bool PackCatalog::save() const
+{
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(catalogStreamVersion);
+        out << catalogMagic << catalogVersion << m_source << quint32(m_packs.size());
+        for (auto& pack : m_packs)
+            out << pack.id << pack.name << pack.author << pack.summary << pack.gameVersion << pack.popularity << pack.tokens << pack.data;
+    }
+    try {
+        FS::write(m_index_file, data);
+        return true;
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Couldn't save the pack catalog" << m_index_file << ":" << e.cause();
+        return false;
+    }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+/**
+ * A local copy of the modpack list of a platform, for browsing and searching it without asking the platform again.
+ *
+ * The catalog is kept in a compact binary index file, with the search terms of every pack already split into words, so
+ * loading it doesn't parse the platform's own format and searching mostly looks up words instead of going through the
+ * pack details.
+ * What the platform needs to show and install a pack is kept alongside, in whatever form it likes.
+ */
+class PackCatalog {
+   public:
+    struct Pack {
+        // unique within the catalog
+        QString id;
+        QString name;
+        QString author;
+        QString summary;
+        // the game version of the latest version of the pack, for sorting
+        QString gameVersion;
+        // whatever order the platform ranks its packs in
+        qint64 popularity = 0;
+        // the platform's own details of the pack
+        QByteArray data;
+
+        // filled in by the catalog
+        QStringList tokens;
+    };
+
+    /** Reads the packs of the platform's list. Throws an Exception if it's malformed. */
+    using Parser = std::function<QList<Pack>(const QByteArray& source)>;
+
+    explicit PackCatalog(const QString& indexFile);
+
+    /** Reads the index file. Returns false if there's none, or it can't be used. */
+    bool load();
+    bool isLoaded() const { return m_loaded; }
+
+    /** Identifies what the catalog was made from, like the checksum of the platform's list. */
+    QString source() const { return m_source; }
+
+    /** Makes the catalog from the platform's list in `sourceFile`, unless it was made from that already.
+     *  Returns whether the packs changed.
+     */
+    bool update(const QString& sourceFile, const QString& source, const Parser& parse);
+
+    /** Adds packs to the catalog, replacing the ones with the same ids. Returns whether the packs changed. */
+    bool merge(QList<Pack> packs);
+
+    const QList<Pack>& packs() const { return m_packs; }
+
+    /** The positions of the packs that have a word starting with each word of the query, or whose name contains the
+     *  whole query, in catalog order.
+     */
+    QVector<int> search(const QString& query) const;
+
+    /** The words of some text as the catalog searches them. */
+    static QStringList tokenize(const QString& text);
+
+   private:
+    void setPacks(QList<Pack> packs);
+    bool save() const;
+
+   private:
+    QString m_index_file;
+    QString m_source;
+    bool m_loaded = false;
+    QList<Pack> m_packs;
+
+    // the names of the packs, case folded
+    QStringList m_names;
+    // every word of every pack, sorted, and which packs have it
+    QStringList m_words;
+    QVector<QVector<int>> m_postings;
+};
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PackUpdatePlan.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QUrl>
+
+#include <cstring>
+
+#include "FileSystem.h"
+
+namespace PackUpdate {
+
+namespace {
+// the launcher disables mods by renaming them, which shouldn't make them look uninstalled
+const QString disabledSuffix = ".disabled";
+
+bool isInstalled(const QDir& root, const QString& path)
+{
+    return QFileInfo::exists(root.absoluteFilePath(path)) || QFileInfo::exists(root.absoluteFilePath(path + disabledSuffix));
+}
+
+bool sameContents(const QString& a, const QString& b)
+{
+    QFile first(a);
+    QFile second(b);
+    if (first.size() != second.size() || !first.open(QIODevice::ReadOnly) || !second.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char firstBuffer[64 * 1024];
+    char secondBuffer[64 * 1024];
+    for (;;) {
+        auto length = first.read(firstBuffer, sizeof(firstBuffer));
+        if (length < 0 || second.read(secondBuffer, length) != length) {
+            return false;
+        }
+        if (length == 0) {
+            return true;
+        }
+        if (std::memcmp(firstBuffer, secondBuffer, length) != 0) {
+            return false;
+        }
+    }
+}
+
+bool isInside(const QString& root, const QString& path)
+{
+    return QUrl::fromLocalFile(root).isParentOf(QUrl::fromLocalFile(path));
+}
+}  // namespace
+
+Plan plan(const QString& gameRoot,
+          const QList<File>& oldFiles,
+          const QList<File>& newFiles,
+          const QStringList& oldOverrides,
+          const QStringList& newOverrideFolders)
+{
+    QDir root(gameRoot);
+    Plan result;
+
+    // where the old files are, and which of them are still around to copy from
+    QHash<QString, QString> oldByPath;
+    QHash<QString, QString> oldByHash;
+    oldByPath.reserve(oldFiles.size());
+    oldByHash.reserve(oldFiles.size());
+    for (const auto& file : oldFiles) {
+        if (file.path.isEmpty()) {
+            continue;
+        }
+        auto path = QDir::cleanPath(file.path);
+        oldByPath.insert(path, file.hash);
+        if (!file.hash.isEmpty() && !oldByHash.contains(file.hash) && QFileInfo::exists(root.absoluteFilePath(path))) {
+            oldByHash.insert(file.hash, path);
+        }
+    }
+
+    // later folders win, just like when they're applied
+    QHash<QString, QString> stagedOverrides;
+    for (const auto& folder : newOverrideFolders) {
+        QDir dir(folder);
+        QDirIterator it(folder, QDir::Files | QDir::Hidden | QDir::System, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            auto path = it.next();
+            stagedOverrides.insert(dir.relativeFilePath(path), path);
+        }
+    }
+
+    QSet<QString> newPaths;
+    newPaths.reserve(newFiles.size());
+    for (const auto& file : newFiles) {
+        auto path = QDir::cleanPath(file.path);
+        newPaths.insert(path);
+
+        auto old = oldByPath.constFind(path);
+        if (old != oldByPath.constEnd() && *old == file.hash && isInstalled(root, path)) {
+            result.keep.append(path);
+            continue;
+        }
+        auto source = oldByHash.value(file.hash);
+        if (!source.isEmpty() && source != path) {
+            result.copies.append({ source, path });
+            continue;
+        }
+        if (QFileInfo::exists(root.absoluteFilePath(path))) {
+            result.overwrites.append({ path, file.hash });
+        } else {
+            result.downloads.append({ path, file.hash });
+        }
+    }
+
+    for (auto it = stagedOverrides.constBegin(); it != stagedOverrides.constEnd(); ++it) {
+        if (sameContents(it.value(), root.absoluteFilePath(it.key()))) {
+            result.unchangedOverrides.append(it.key());
+        }
+    }
+
+    QSet<QString> deletes;
+    auto scheduleRemoval = [&](const QString& entry) {
+        if (entry.isEmpty()) {
+            return;
+        }
+        auto path = QDir::cleanPath(entry);
+        if (newPaths.contains(path) || stagedOverrides.contains(path) || deletes.contains(path)) {
+            return;
+        }
+        deletes.insert(path);
+        if (QFileInfo::exists(root.absoluteFilePath(path))) {
+            result.deletes.append(path);
+        }
+        if (QFileInfo::exists(root.absoluteFilePath(path + disabledSuffix))) {
+            result.deletes.append(path + disabledSuffix);
+        }
+    };
+    for (const auto& file : oldFiles) {
+        scheduleRemoval(file.path);
+    }
+    for (const auto& entry : oldOverrides) {
+        scheduleRemoval(entry);
+    }
+
+    qDebug() << "Pack update:" << result.keep.size() << "kept," << result.copies.size() << "copied," << result.downloads.size()
+             << "new," << result.overwrites.size() << "replaced," << result.unchangedOverrides.size() << "unchanged overrides,"
+             << result.deletes.size() << "removed";
+    return result;
+}
+
+QStringList applyToStaging(const Plan& plan, const QString& gameRoot, const QString& stagedGameRoot)
+{
+    QDir root(gameRoot);
+    QDir staged(stagedGameRoot);
+
+    for (const auto& path : plan.unchangedOverrides) {
+        QFile::remove(staged.absoluteFilePath(path));
+    }
+
+    QStringList missing;
+    for (const auto& copy : plan.copies) {
+        auto source = QDir::cleanPath(root.absoluteFilePath(copy.from));
+        auto target = QDir::cleanPath(staged.absoluteFilePath(copy.to));
+        if (!isInside(gameRoot, source) || !isInside(stagedGameRoot, target)) {
+            missing.append(copy.to);
+            continue;
+        }
+        if (QFile::exists(target)) {
+            QFile::remove(target);
+        }
+        if (!FS::ensureFilePathExists(target) || !QFile::copy(source, target)) {
+            qWarning() << "Couldn't copy" << copy.from << "to" << copy.to << "for the update, downloading it instead";
+            missing.append(copy.to);
+        }
+    }
+    return missing;
+}
+
+}  // namespace PackUpdate
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QList>
+#include <QStringList>
+
+/**
+ * Working out what updating an installed modpack to another version actually takes.
+ *
+ * Both manifests are indexed by path and by contents, so that files which didn't change are kept, files which only
+ * moved are copied from where the instance already has them, and only what's really new gets downloaded.
+ */
+namespace PackUpdate {
+
+struct File {
+    // relative to the game folder
+    QString path;
+    // anything that identifies the contents, compared as-is
+    QString hash;
+};
+
+struct Copy {
+    QString from;
+    QString to;
+};
+
+struct Plan {
+    // files of the new version that are already installed where they belong
+    QStringList keep;
+    // files the instance has, but at another path
+    QList<Copy> copies;
+    // files that need to be downloaded
+    QList<File> downloads;
+    // files that need to be downloaded, replacing a different file at the same path
+    QList<File> overwrites;
+    // staged overrides that are identical to the installed files
+    QStringList unchangedOverrides;
+    // installed files that aren't part of the new version
+    QStringList deletes;
+};
+
+/** Plans the update of the instance game folder at `gameRoot`.
+ *
+ *  `newOverrideFolders` are the staged override folders of the new version, later ones taking precedence.
+ *  Nothing is changed on disk.
+ */
+Plan plan(const QString& gameRoot,
+          const QList<File>& oldFiles,
+          const QList<File>& newFiles,
+          const QStringList& oldOverrides,
+          const QStringList& newOverrideFolders);
+
+/** Carries out the part of the plan that happens in the staged game folder: the files the instance already has are
+ *  copied over, and the overrides that wouldn't change anything are dropped so they aren't copied back in.
+ *
+ *  Returns the paths of the copies that couldn't be made, which need to be downloaded after all.
+ */
+QStringList applyToStaging(const Plan& plan, const QString& gameRoot, const QString& stagedGameRoot);
+
+}  // namespace PackUpdate
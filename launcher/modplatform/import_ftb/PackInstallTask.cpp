@@ -18,8 +18,6 @@
 
 #include "PackInstallTask.h"
 
-#include <QtConcurrent>
-
 #include "BaseInstance.h"
 #include "FileSystem.h"
 #include "minecraft/MinecraftInstance.h"
@@ -27,6 +25,7 @@
 #include "modplatform/ResourceAPI.h"
 #include "modplatform/import_ftb/PackHelpers.h"
 #include "settings/INISettingsObject.h"
+#include "tasks/Executor.h"
 
 namespace FTBImportAPP {
 
@@ -36,7 +35,7 @@ void PackInstallTask::executeTask()
     setAbortable(false);
     progress(1, 2);
 
-    m_copyFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this] {
+    m_copyFuture = Executor::io().run([this] {
         FS::copy folderCopy(m_pack.path, FS::PathCombine(m_stagingPath, ".minecraft"));
         folderCopy.followSymlinks(true);
         return folderCopy();
@@ -36,26 +36,70 @@
 #include "PackFetchTask.h"
 #include "PrivatePackManager.h"
 
+#include <QDataStream>
 #include <QDomDocument>
+#include <QFile>
 #include "Application.h"
 #include "BuildConfig.h"
+#include "Exception.h"
+#include "FileSystem.h"
 
 namespace LegacyFTB {
 
+static PackCatalog::Pack toCatalogPack(const Modpack& modpack)
+{
+    PackCatalog::Pack pack;
+    pack.id = modpack.dir;
+    pack.name = modpack.name;
+    pack.author = modpack.author;
+    pack.summary = modpack.description;
+    pack.gameVersion = modpack.mcVersion;
+
+    QDataStream out(&pack.data, QIODevice::WriteOnly);
+    out << modpack.name << modpack.description << modpack.author << modpack.oldVersions << modpack.currentVersion << modpack.mcVersion
+        << modpack.mods << modpack.logo << modpack.dir << modpack.file << modpack.bugged << modpack.broken;
+    return pack;
+}
+
+static ModpackList packsOf(const PackCatalog& catalog, PackType packType)
+{
+    ModpackList list;
+    list.reserve(catalog.packs().size());
+    for (auto& pack : catalog.packs()) {
+        Modpack modpack;
+        QDataStream in(pack.data);
+        in >> modpack.name >> modpack.description >> modpack.author >> modpack.oldVersions >> modpack.currentVersion >> modpack.mcVersion >>
+            modpack.mods >> modpack.logo >> modpack.dir >> modpack.file >> modpack.bugged >> modpack.broken;
+        modpack.type = packType;
+        list.append(modpack);
+    }
+    return list;
+}
+
+PackFetchTask::PackFetchTask(shared_qobject_ptr<QNetworkAccessManager> network)
+    : QObject(nullptr)
+    , m_network(network)
+    , m_publicCatalog(FS::PathCombine(APPLICATION->metacache()->getBasePath("FTBPacks"), "modpacks.catalog"))
+    , m_thirdPartyCatalog(FS::PathCombine(APPLICATION->metacache()->getBasePath("FTBPacks"), "thirdparty.catalog"))
+{}
+
 void PackFetchTask::fetch()
 {
-    publicPacks.clear();
-    thirdPartyPacks.clear();
+    m_shown = false;
+    if ((m_publicCatalog.isLoaded() || m_publicCatalog.load()) && (m_thirdPartyCatalog.isLoaded() || m_thirdPartyCatalog.load()))
+        emitCatalogPacks();
 
     jobPtr.reset(new NetJob("LegacyFTB::ModpackFetch", m_network));
 
     QUrl publicPacksUrl = QUrl(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "static/modpacks.xml");
     qDebug() << "Downloading public version info from" << publicPacksUrl.toString();
-    jobPtr->addNetAction(Net::Download::makeByteArray(publicPacksUrl, publicModpacksXmlFileData));
+    m_publicEntry = APPLICATION->metacache()->resolveEntry("FTBPacks", "modpacks.xml");
+    jobPtr->addNetAction(Net::Download::makeCached(publicPacksUrl, m_publicEntry));
 
     QUrl thirdPartyUrl = QUrl(BuildConfig.LEGACY_FTB_CDN_BASE_URL + "static/thirdparty.xml");
     qDebug() << "Downloading thirdparty version info from" << thirdPartyUrl.toString();
-    jobPtr->addNetAction(Net::Download::makeByteArray(thirdPartyUrl, thirdPartyModpacksXmlFileData));
+    m_thirdPartyEntry = APPLICATION->metacache()->resolveEntry("FTBPacks", "thirdparty.xml");
+    jobPtr->addNetAction(Net::Download::makeCached(thirdPartyUrl, m_thirdPartyEntry));
 
     QObject::connect(jobPtr.get(), &NetJob::succeeded, this, &PackFetchTask::fileDownloadFinished);
     QObject::connect(jobPtr.get(), &NetJob::failed, this, &PackFetchTask::fileDownloadFailed);
@@ -108,23 +152,59 @@ void PackFetchTask::fileDownloadFinished()
 {
     jobPtr.reset();
 
+    bool changed = updateCatalogs();
+
     QStringList failedLists;
 
-    if (!parseAndAddPacks(*publicModpacksXmlFileData, PackType::Public, publicPacks)) {
+    if (!m_publicCatalog.isLoaded()) {
         failedLists.append(tr("Public Packs"));
     }
 
-    if (!parseAndAddPacks(*thirdPartyModpacksXmlFileData, PackType::ThirdParty, thirdPartyPacks)) {
+    if (!m_thirdPartyCatalog.isLoaded()) {
         failedLists.append(tr("Third Party Packs"));
     }
 
     if (failedLists.size() > 0) {
         emit failed(tr("Failed to download some pack lists: %1").arg(failedLists.join("\n- ")));
-    } else {
-        emit finished(publicPacks, thirdPartyPacks);
+    } else if (changed || !m_shown) {
+        emitCatalogPacks();
     }
 }
 
+PackCatalog::Parser PackFetchTask::catalogParser(PackType packType)
+{
+    return [this, packType](const QByteArray& data) {
+        QByteArray xml = data;
+        ModpackList modpacks;
+        if (!parseAndAddPacks(xml, packType, modpacks))
+            throw Exception(tr("The pack list is malformed."));
+
+        QList<PackCatalog::Pack> packs;
+        packs.reserve(modpacks.size());
+        for (auto& modpack : modpacks)
+            packs.append(toCatalogPack(modpack));
+        return packs;
+    };
+}
+
+bool PackFetchTask::updateCatalogs()
+{
+    // the lists we have are kept if the new ones can't be read
+    bool changed = false;
+    if (QFile::exists(m_publicEntry->getFullPath()))
+        changed |= m_publicCatalog.update(m_publicEntry->getFullPath(), m_publicEntry->getMD5Sum(), catalogParser(PackType::Public));
+    if (QFile::exists(m_thirdPartyEntry->getFullPath()))
+        changed |= m_thirdPartyCatalog.update(m_thirdPartyEntry->getFullPath(), m_thirdPartyEntry->getMD5Sum(),
+                                              catalogParser(PackType::ThirdParty));
+    return changed;
+}
+
+void PackFetchTask::emitCatalogPacks()
+{
+    m_shown = true;
+    emit finished(packsOf(m_publicCatalog, PackType::Public), packsOf(m_thirdPartyCatalog, PackType::ThirdParty));
+}
+
 bool PackFetchTask::parseAndAddPacks(QByteArray& data, PackType packType, ModpackList& list)
 {
     QDomDocument doc;
@@ -189,7 +269,17 @@ bool PackFetchTask::parseAndAddPacks(QByteArray& data, PackType packType, Modpac
 
 void PackFetchTask::fileDownloadFailed(QString reason)
 {
+    jobPtr.reset();
     qWarning() << "Fetching FTBPacks failed:" << reason;
+    if (m_shown)
+        return;
+
+    // the lists from the last time we could get them are better than none
+    updateCatalogs();
+    if (m_publicCatalog.isLoaded() && m_thirdPartyCatalog.isLoaded()) {
+        emitCatalogPacks();
+        return;
+    }
     emit failed(reason);
 }
 
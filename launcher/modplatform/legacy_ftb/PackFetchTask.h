@@ -5,6 +5,8 @@
 #include <QTemporaryDir>
 #include <memory>
 #include "PackHelpers.h"
+#include "modplatform/helpers/PackCatalog.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 
 namespace LegacyFTB {
@@ -13,9 +15,10 @@ class PackFetchTask : public QObject {
     Q_OBJECT
 
    public:
-    PackFetchTask(shared_qobject_ptr<QNetworkAccessManager> network) : QObject(nullptr), m_network(network){};
+    PackFetchTask(shared_qobject_ptr<QNetworkAccessManager> network);
     virtual ~PackFetchTask() = default;
 
+    /** Emits `finished` right away with the packs of the last fetch if there are any, and again if the lists changed. */
     void fetch();
     void fetchPrivate(const QStringList& toFetch);
 
@@ -23,12 +26,17 @@ class PackFetchTask : public QObject {
     shared_qobject_ptr<QNetworkAccessManager> m_network;
     NetJob::Ptr jobPtr;
 
-    std::shared_ptr<QByteArray> publicModpacksXmlFileData = std::make_shared<QByteArray>();
-    std::shared_ptr<QByteArray> thirdPartyModpacksXmlFileData = std::make_shared<QByteArray>();
+    PackCatalog m_publicCatalog;
+    PackCatalog m_thirdPartyCatalog;
+    MetaEntryPtr m_publicEntry;
+    MetaEntryPtr m_thirdPartyEntry;
+    // whether `finished` was emitted for the current fetch
+    bool m_shown = false;
 
     bool parseAndAddPacks(QByteArray& data, PackType packType, ModpackList& list);
-    ModpackList publicPacks;
-    ModpackList thirdPartyPacks;
+    PackCatalog::Parser catalogParser(PackType packType);
+    bool updateCatalogs();
+    void emitCatalogPacks();
 
    protected slots:
     void fileDownloadFinished();
@@ -35,8 +35,6 @@
 
 #include "PackInstallTask.h"
 
-#include <QtConcurrent>
-
 #include "BaseInstance.h"
 #include "FileSystem.h"
 #include "MMCZip.h"
@@ -47,6 +45,7 @@
 
 #include "Application.h"
 #include "BuildConfig.h"
+#include "tasks/Executor.h"
 
 namespace LegacyFTB {
 
@@ -104,13 +103,8 @@ void PackInstallTask::unzip()
         return;
     }
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    m_extractFuture = QtConcurrent::run(QThreadPool::globalInstance(), QOverload<QString, QString>::of(MMCZip::extractDir), archivePath,
-                                        extractDir.absolutePath() + "/unzip");
-#else
-    m_extractFuture =
-        QtConcurrent::run(QThreadPool::globalInstance(), MMCZip::extractDir, archivePath, extractDir.absolutePath() + "/unzip");
-#endif
+    m_extractFuture = Executor::io().run(
+        [archivePath, target = extractDir.absolutePath() + "/unzip"] { return MMCZip::extractDir(archivePath, target); });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &PackInstallTask::onUnzipFinished);
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, &PackInstallTask::onUnzipCanceled);
     m_extractFutureWatcher.setFuture(m_extractFuture);
@@ -2,6 +2,8 @@
 #include "ModrinthAPI.h"
 #include "ModrinthPackIndex.h"
 
+#include <QtConcurrent>
+
 #include "Json.h"
 
 #include "ResourceDownloadTask.h"
@@ -12,14 +14,18 @@
 
 #include "minecraft/mod/ModFolderModel.h"
 #include "minecraft/mod/ResourceFolderModel.h"
+#include "tasks/Executor.h"
 
 static ModrinthAPI api;
 static ModPlatform::ProviderCapabilities ProviderCaps;
 
 bool ModrinthCheckUpdate::abort()
 {
-    if (m_net_job)
-        return m_net_job->abort();
+    *m_aborted = true;
+    if (m_hash_future.isRunning())
+        return true;
+    if (m_job)
+        return m_job->abort();
     return true;
 }
 
@@ -33,153 +39,190 @@ void ModrinthCheckUpdate::executeTask()
     setStatus(tr("Preparing mods for Modrinth..."));
     setProgress(0, 3);
 
-    QHash<QString, Mod*> mappings;
-
-    // Create all hashes
-    QStringList hashes;
-    auto best_hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
+    m_mappings.clear();
+    m_failure_reason.clear();
+    *m_aborted = false;
+    m_hash_type = ProviderCaps.hashType(ModPlatform::ResourceProvider::MODRINTH).first();
 
-    ConcurrentTask hashing_task(this, "MakeModrinthHashesTask", 10);
+    QList<PendingHash> to_hash;
     for (auto* mod : m_mods) {
         if (!mod->enabled()) {
             emit checkFailed(mod, tr("Disabled mods won't be updated, to prevent mod duplication issues!"));
             continue;
         }
 
-        auto hash = mod->metadata()->hash;
-
         // Sadly the API can only handle one hash type per call, se we
         // need to generate a new hash if the current one is innadequate
         // (though it will rarely happen, if at all)
-        if (mod->metadata()->hash_format != best_hash_type) {
-            auto hash_task = Hashing::createModrinthHasher(mod->fileinfo().absoluteFilePath());
-            connect(hash_task.get(), &Hashing::Hasher::resultsReady, [&hashes, &mappings, mod](QString hash) {
-                hashes.append(hash);
-                mappings.insert(hash, mod);
-            });
-            connect(hash_task.get(), &Task::failed, [this] { failed("Failed to generate hash"); });
-            hashing_task.addTask(hash_task);
-        } else {
-            hashes.append(hash);
-            mappings.insert(hash, mod);
-        }
+        if (mod->metadata()->hash_format == m_hash_type)
+            m_mappings.insert(mod->metadata()->hash, mod);
+        else
+            to_hash.append({ mod, mod->fileinfo().absoluteFilePath(), {} });
     }
 
-    QEventLoop loop;
-    connect(&hashing_task, &Task::finished, [&loop] { loop.quit(); });
-    hashing_task.start();
-    loop.exec();
-
-    auto response = std::make_shared<QByteArray>();
-    auto job = api.latestVersions(hashes, best_hash_type, m_game_versions, m_loaders, response);
-
-    QEventLoop lock;
-
-    connect(job.get(), &Task::succeeded, this, [this, response, &mappings, best_hash_type, job] {
-        QJsonParseError parse_error{};
-        QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-        if (parse_error.error != QJsonParseError::NoError) {
-            qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at " << parse_error.offset
-                       << " reason: " << parse_error.errorString();
-            qWarning() << *response;
+    if (to_hash.isEmpty()) {
+        checkVersions();
+        return;
+    }
 
-            failed(parse_error.errorString());
+    // hash off the GUI thread, the shared hash cache makes this free for mods hashed by a previous check or export
+    m_hash_future = Executor::cpu().run([to_hash, hash_type = m_hash_type, aborted = m_aborted]() mutable {
+        QtConcurrent::blockingMap(to_hash, [&hash_type, &aborted](PendingHash& pending) {
+            if (!*aborted)
+                pending.hash = Hashing::cachedHash(pending.path, hash_type);
+        });
+        return to_hash;
+    });
+    connect(&m_hash_watcher, &QFutureWatcher<QList<PendingHash>>::finished, this, [this] {
+        if (*m_aborted) {
+            emitAborted();
             return;
         }
+        for (auto& pending : m_hash_future.result()) {
+            if (pending.hash.isEmpty()) {
+                emit checkFailed(pending.mod, tr("Failed to generate hash"));
+                continue;
+            }
+            m_mappings.insert(pending.hash, pending.mod);
+        }
+        checkVersions();
+    });
+    m_hash_watcher.setFuture(m_hash_future);
+}
 
-        setStatus(tr("Parsing the API response from Modrinth..."));
-        setProgress(2, 3);
+void ModrinthCheckUpdate::checkVersions()
+{
+    if (m_mappings.isEmpty()) {
+        emitSucceeded();
+        return;
+    }
 
-        try {
-            for (auto hash : mappings.keys()) {
-                auto project_obj = doc[hash].toObject();
+    setStatus(tr("Waiting for the API response from Modrinth..."));
+    setProgress(1, 3);
 
-                // If the returned project is empty, but we have Modrinth metadata,
-                // it means this specific version is not available
-                if (project_obj.isEmpty()) {
-                    qDebug() << "Mod " << mappings.find(hash).value()->name() << " got an empty response.";
-                    qDebug() << "Hash: " << hash;
+    // very large sets are split, so no single request gets too big and the chunks are requested in parallel
+    auto job = makeShared<ConcurrentTask>(nullptr, "ModrinthCheckUpdate", 4);
+    auto hashes = m_mappings.keys();
+    for (int i = 0; i < hashes.size(); i += HASHES_PER_REQUEST) {
+        auto chunk = hashes.mid(i, HASHES_PER_REQUEST);
+        auto response = std::make_shared<QByteArray>();
+        auto chunk_job = api.latestVersions(chunk, m_hash_type, m_game_versions, m_loaders, response);
+        connect(chunk_job.get(), &Task::succeeded, this, [this, response, chunk] { parseResponse(*response, chunk); });
+        connect(chunk_job.get(), &Task::failed, this, [this, chunk](QString reason) {
+            // the updates of the other chunks are still reported, these mods just weren't checked
+            for (auto& hash : chunk)
+                emit checkFailed(m_mappings.value(hash), tr("Couldn't get the latest version from Modrinth: %1").arg(reason));
+            m_failure_reason = reason;
+        });
+        job->addTask(chunk_job);
+    }
 
-                    emit checkFailed(
-                        mappings.find(hash).value(),
-                        tr("No valid version found for this mod. It's probably unavailable for the current game version / mod loader."));
+    connect(job.get(), &Task::finished, this, [this] {
+        if (*m_aborted)
+            emitAborted();
+        else if (m_failure_reason.isEmpty())
+            emitSucceeded();
+        else
+            emitFailed(m_failure_reason);
+    });
 
-                    continue;
-                }
+    m_job = job;
+    job->start();
+}
 
-                // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
-                // so we may want to filter it
-                QString loader_filter;
-                if (m_loaders.has_value()) {
-                    static auto flags = { ResourceAPI::ModLoaderType::Forge, ResourceAPI::ModLoaderType::Fabric,
-                                          ResourceAPI::ModLoaderType::Quilt };
-                    for (auto flag : flags) {
-                        if (m_loaders.value().testFlag(flag)) {
-                            loader_filter = api.getModLoaderString(flag);
-                            break;
-                        }
-                    }
-                }
+void ModrinthCheckUpdate::parseResponse(const QByteArray& response, const QStringList& hashes)
+{
+    QJsonParseError parse_error{};
+    QJsonDocument doc = QJsonDocument::fromJson(response, &parse_error);
+    if (parse_error.error != QJsonParseError::NoError) {
+        qWarning() << "Error while parsing JSON response from ModrinthCheckUpdate at " << parse_error.offset
+                   << " reason: " << parse_error.errorString();
+        qWarning() << response;
+
+        m_failure_reason = parse_error.errorString();
+        return;
+    }
 
-                // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
-                // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
-                // loader_filter
-                // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
-                // Such is the pain of having arbitrary files for a given version .-.
+    setStatus(tr("Parsing the API response from Modrinth..."));
+    setProgress(2, 3);
 
-                auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, best_hash_type, loader_filter);
-                if (project_ver.downloadUrl.isEmpty()) {
-                    qCritical() << "Modrinth mod without download url!";
-                    qCritical() << project_ver.fileName;
+    try {
+        for (auto& hash : hashes) {
+            auto project_obj = doc[hash].toObject();
 
-                    emit checkFailed(mappings.find(hash).value(), tr("Mod has an empty download URL"));
+            // If the returned project is empty, but we have Modrinth metadata,
+            // it means this specific version is not available
+            if (project_obj.isEmpty()) {
+                qDebug() << "Mod " << m_mappings.find(hash).value()->name() << " got an empty response.";
+                qDebug() << "Hash: " << hash;
 
-                    continue;
-                }
+                emit checkFailed(
+                    m_mappings.find(hash).value(),
+                    tr("No valid version found for this mod. It's probably unavailable for the current game version / mod loader."));
 
-                auto mod_iter = mappings.find(hash);
-                if (mod_iter == mappings.end()) {
-                    qCritical() << "Failed to remap mod from Modrinth!";
-                    continue;
-                }
-                auto mod = *mod_iter;
-
-                auto key = project_ver.hash;
-                if ((key != hash && project_ver.is_preferred) || (mod->status() == ModStatus::NotInstalled)) {
-                    if (mod->version() == project_ver.version_number)
-                        continue;
-
-                    // Fake pack with the necessary info to pass to the download task :)
-                    auto pack = std::make_shared<ModPlatform::IndexedPack>();
-                    pack->name = mod->name();
-                    pack->slug = mod->metadata()->slug;
-                    pack->addonId = mod->metadata()->project_id;
-                    pack->websiteUrl = mod->homeurl();
-                    for (auto& author : mod->authors())
-                        pack->authors.append({ author });
-                    pack->description = mod->description();
-                    pack->provider = ModPlatform::ResourceProvider::MODRINTH;
-
-                    auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_mods_folder);
-
-                    m_updatable.emplace_back(pack->name, hash, mod->version(), project_ver.version_number, project_ver.changelog,
-                                             ModPlatform::ResourceProvider::MODRINTH, download_task);
+                continue;
+            }
+
+            // Sometimes a version may have multiple files, one with "forge" and one with "fabric",
+            // so we may want to filter it
+            QString loader_filter;
+            if (m_loaders.has_value()) {
+                static auto flags = { ResourceAPI::ModLoaderType::Forge, ResourceAPI::ModLoaderType::Fabric,
+                                      ResourceAPI::ModLoaderType::Quilt };
+                for (auto flag : flags) {
+                    if (m_loaders.value().testFlag(flag)) {
+                        loader_filter = api.getModLoaderString(flag);
+                        break;
+                    }
                 }
             }
-        } catch (Json::JsonException& e) {
-            failed(e.cause() + " : " + e.what());
-        }
-    });
 
-    connect(job.get(), &Task::finished, &lock, &QEventLoop::quit);
+            // Currently, we rely on a couple heuristics to determine whether an update is actually available or not:
+            // - The file needs to be preferred: It is either the primary file, or the one found via (explicit) usage of the
+            // loader_filter
+            // - The version reported by the JAR is different from the version reported by the indexed version (it's usually the case)
+            // Such is the pain of having arbitrary files for a given version .-.
 
-    setStatus(tr("Waiting for the API response from Modrinth..."));
-    setProgress(1, 3);
+            auto project_ver = Modrinth::loadIndexedPackVersion(project_obj, m_hash_type, loader_filter);
+            if (project_ver.downloadUrl.isEmpty()) {
+                qCritical() << "Modrinth mod without download url!";
+                qCritical() << project_ver.fileName;
 
-    m_net_job = qSharedPointerObjectCast<NetJob, Task>(job);
-    job->start();
+                emit checkFailed(m_mappings.find(hash).value(), tr("Mod has an empty download URL"));
 
-    lock.exec();
+                continue;
+            }
+
+            auto mod_iter = m_mappings.find(hash);
+            if (mod_iter == m_mappings.end()) {
+                qCritical() << "Failed to remap mod from Modrinth!";
+                continue;
+            }
+            auto mod = *mod_iter;
 
-    emitSucceeded();
+            auto key = project_ver.hash;
+            if ((key != hash && project_ver.is_preferred) || (mod->status() == ModStatus::NotInstalled)) {
+                if (mod->version() == project_ver.version_number)
+                    continue;
+
+                // Fake pack with the necessary info to pass to the download task :)
+                auto pack = std::make_shared<ModPlatform::IndexedPack>();
+                pack->name = mod->name();
+                pack->slug = mod->metadata()->slug;
+                pack->addonId = mod->metadata()->project_id;
+                pack->websiteUrl = mod->homeurl();
+                for (auto& author : mod->authors())
+                    pack->authors.append({ author });
+                pack->description = mod->description();
+                pack->provider = ModPlatform::ResourceProvider::MODRINTH;
+
+                auto download_task = makeShared<ResourceDownloadTask>(pack, project_ver, m_mods_folder);
+
+                m_updatable.emplace_back(pack->name, hash, mod->version(), project_ver.version_number, project_ver.changelog,
+                                         ModPlatform::ResourceProvider::MODRINTH, download_task);
+            }
+        }
+    } catch (Json::JsonException& e) {
+        m_failure_reason = e.cause() + " : " + e.what();
+    }
 }
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <QFuture>
+#include <QFutureWatcher>
+
+#include <atomic>
+#include <memory>
+
 #include "Application.h"
 #include "modplatform/CheckUpdateTask.h"
 #include "net/NetJob.h"
@@ -22,5 +28,24 @@ class ModrinthCheckUpdate : public CheckUpdateTask {
     void executeTask() override;
 
    private:
-    NetJob::Ptr m_net_job = nullptr;
+    // the API gets slow with huge bodies, larger sets are split into several requests
+    static constexpr int HASHES_PER_REQUEST = 500;
+
+    struct PendingHash {
+        Mod* mod;
+        QString path;
+        QString hash;
+    };
+
+    void checkVersions();
+    void parseResponse(const QByteArray& response, const QStringList& hashes);
+
+    QString m_hash_type;
+    QHash<QString, Mod*> m_mappings;
+    QFuture<QList<PendingHash>> m_hash_future;
+    QFutureWatcher<QList<PendingHash>> m_hash_watcher;
+    QString m_failure_reason;
+    // shared with the hashing, which checks it between files
+    std::shared_ptr<std::atomic_bool> m_aborted = std::make_shared<std::atomic_bool>(false);
+    Task::Ptr m_job = nullptr;
 };
@@ -8,6 +8,7 @@
 #include "minecraft/PackProfile.h"
 
 #include "modplatform/helpers/OverrideUtils.h"
+#include "modplatform/helpers/PackUpdatePlan.h"
 
 #include "net/ChecksumValidator.h"
 
@@ -18,6 +19,8 @@
 
 #include <QAbstractButton>
 
+#include <algorithm>
+
 bool ModrinthCreationTask::abort()
 {
     if (!canAbort())
@@ -77,59 +80,27 @@ bool ModrinthCreationTask::updateInstance()
         std::vector<Modrinth::File> old_files;
         parseManifest(old_index_path, old_files, false, false);
 
-        // Let's remove all duplicated, identical resources!
-        auto files_iterator = m_files.begin();
-    begin:
-        while (files_iterator != m_files.end()) {
-            auto const& file = *files_iterator;
-
-            auto old_files_iterator = old_files.begin();
-            while (old_files_iterator != old_files.end()) {
-                auto const& old_file = *old_files_iterator;
-
-                if (old_file.hash == file.hash) {
-                    qDebug() << "Removed file at" << file.path << "from list of downloads";
-                    files_iterator = m_files.erase(files_iterator);
-                    old_files_iterator = old_files.erase(old_files_iterator);
-                    goto begin;  // Sorry :c
-                }
-
-                old_files_iterator++;
+        auto toPlan = [](const std::vector<Modrinth::File>& files) {
+            QList<PackUpdate::File> entries;
+            entries.reserve(int(files.size()));
+            for (auto const& file : files) {
+                entries.append({ file.path, QString::number(int(file.hashAlgorithm)) + ':' + QString::fromLatin1(file.hash) });
             }
+            return entries;
+        };
 
-            files_iterator++;
-        }
-
-        QDir old_minecraft_dir(inst->gameRoot());
-
-        // Some files were removed from the old version, and some will be downloaded in an updated version,
-        // so we're fine removing them!
-        if (!old_files.empty()) {
-            for (auto const& file : old_files) {
-                if (file.path.isEmpty())
-                    continue;
-                qDebug() << "Scheduling" << file.path << "for removal";
-                m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(file.path));
-            }
-        }
-
-        // We will remove all the previous overrides, to prevent duplicate files!
-        // TODO: Currently 'overrides' will always override the stuff on update. How do we preserve unchanged overrides?
-        // FIXME: We may want to do something about disabled mods.
+        // Overrides are compared with what's installed, so the unchanged ones aren't copied over again
+        // FIXME: Overrides that were changed by the user are still replaced by the pack's version.
         auto old_overrides = Override::readOverrides("overrides", old_index_folder);
-        for (const auto& entry : old_overrides) {
-            if (entry.isEmpty())
-                continue;
-            qDebug() << "Scheduling" << entry << "for removal";
-            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(entry));
-        }
+        old_overrides.append(Override::readOverrides("client-overrides", old_index_folder));
+        QStringList new_override_folders{ FS::PathCombine(m_stagingPath, "overrides"), FS::PathCombine(m_stagingPath, "client-overrides") };
 
-        auto old_client_overrides = Override::readOverrides("client-overrides", old_index_folder);
-        for (const auto& entry : old_overrides) {
-            if (entry.isEmpty())
-                continue;
-            qDebug() << "Scheduling" << entry << "for removal";
-            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(entry));
+        m_update_plan = PackUpdate::plan(inst->gameRoot(), toPlan(old_files), toPlan(m_files), old_overrides, new_override_folders);
+
+        QDir old_minecraft_dir(inst->gameRoot());
+        for (auto const& path : m_update_plan->deletes) {
+            qDebug() << "Scheduling" << path << "for removal";
+            m_files_to_remove.append(old_minecraft_dir.absoluteFilePath(path));
         }
     } else {
         // We don't have an old index file, so we may duplicate stuff!
@@ -228,6 +199,20 @@ bool ModrinthCreationTask::createInstance()
     auto root_modpack_path = FS::PathCombine(m_stagingPath, ".minecraft");
     auto root_modpack_url = QUrl::fromLocalFile(root_modpack_path);
 
+    // Reuse what the instance we're updating already has, and only download the rest
+    if (m_instance && m_update_plan) {
+        auto missing = PackUpdate::applyToStaging(*m_update_plan, m_instance.value()->gameRoot(), root_modpack_path);
+
+        QSet<QString> in_place(m_update_plan->keep.begin(), m_update_plan->keep.end());
+        for (auto const& copy : m_update_plan->copies) {
+            if (!missing.contains(copy.to))
+                in_place.insert(copy.to);
+        }
+        m_files.erase(std::remove_if(m_files.begin(), m_files.end(),
+                                     [&in_place](const Modrinth::File& file) { return in_place.contains(QDir::cleanPath(file.path)); }),
+                      m_files.end());
+    }
+
     for (auto file : m_files) {
         auto file_path = FS::PathCombine(root_modpack_path, file.path);
         if (!root_modpack_url.isParentOf(QUrl::fromLocalFile(file_path))) {
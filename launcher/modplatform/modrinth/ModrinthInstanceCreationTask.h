@@ -6,6 +6,7 @@
 
 #include "minecraft/MinecraftInstance.h"
 
+#include "modplatform/helpers/PackUpdatePlan.h"
 #include "modplatform/modrinth/ModrinthPackManifest.h"
 
 #include "net/NetJob.h"
@@ -46,4 +47,5 @@ class ModrinthCreationTask final : public InstanceCreationTask {
     NetJob::Ptr m_files_job;
 
     std::optional<InstancePtr> m_instance;
+    std::optional<PackUpdate::Plan> m_update_plan;
 };
@@ -21,11 +21,15 @@
 #include <QCryptographicHash>
 #include <QFileInfo>
 #include <QMessageBox>
-#include <QtConcurrentRun>
+#include <QtConcurrent>
+#include "Application.h"
 #include "Json.h"
 #include "MMCZip.h"
 #include "minecraft/PackProfile.h"
 #include "minecraft/mod/ModFolderModel.h"
+#include "modplatform/helpers/HashCache.h"
+#include "modplatform/helpers/HashUtils.h"
+#include "tasks/Executor.h"
 
 const QStringList ModrinthPackExportTask::PREFIXES({ "mods/", "coremods/", "resourcepacks/", "texturepacks/", "shaderpacks/" });
 const QStringList ModrinthPackExportTask::FILE_EXTENSIONS({ "jar", "litemod", "zip" });
@@ -87,9 +91,9 @@ void ModrinthPackExportTask::collectFiles()
 void ModrinthPackExportTask::collectHashes()
 {
     setStatus(tr("Finding file hashes..."));
-    for (const QFileInfo& file : files) {
-        QCoreApplication::processEvents();
 
+    QList<HashedFile> toHash;
+    for (const QFileInfo& file : files) {
         const QString relative = gameRoot.relativeFilePath(file.absoluteFilePath());
         // require sensible file types
         if (!std::any_of(PREFIXES.begin(), PREFIXES.end(), [&relative](const QString& prefix) { return relative.startsWith(prefix); }))
@@ -99,46 +103,73 @@ void ModrinthPackExportTask::collectHashes()
             }))
             continue;
 
-        QCryptographicHash sha512(QCryptographicHash::Algorithm::Sha512);
+        toHash.append({ file.absoluteFilePath(), relative });
+    }
 
-        QFile openFile(file.absoluteFilePath());
-        if (!openFile.open(QFile::ReadOnly)) {
-            qWarning() << "Could not open" << file << "for hashing";
-            continue;
-        }
+    // hash in parallel off the GUI thread, reusing hashes from previous exports/update checks when the file didn't change
+    auto hashCache = APPLICATION->hashCache();
+    hashFuture = Executor::cpu().run([this, toHash, hashCache]() mutable {
+        std::atomic_int done{ 0 };
+        const qint64 total = toHash.size();
 
-        const QByteArray data = openFile.readAll();
-        if (openFile.error() != QFileDevice::NoError) {
-            qWarning() << "Could not read" << file;
+        QtConcurrent::blockingMap(toHash, [this, &done, total, hashCache](HashedFile& file) {
+            if (hashCache) {
+                file.sha1 = hashCache->get(file.path, "sha1");
+                file.sha512 = hashCache->get(file.path, "sha512");
+            }
+            if (file.sha1.isEmpty() || file.sha512.isEmpty()) {
+                auto hashes = Hashing::hashFile(file.path, { QCryptographicHash::Sha1, QCryptographicHash::Sha512 });
+                if (hashes.size() == 2) {
+                    file.sha1 = hashes[0];
+                    file.sha512 = hashes[1];
+                    if (hashCache) {
+                        hashCache->put(file.path, "sha1", file.sha1);
+                        hashCache->put(file.path, "sha512", file.sha512);
+                    }
+                }
+            }
+            file.size = QFileInfo(file.path).size();
+
+            const int current = ++done;
+            QMetaObject::invokeMethod(this, [this, current, total] { setProgress(current, total); }, Qt::QueuedConnection);
+        });
+        return toHash;
+    });
+    connect(&hashWatcher, &QFutureWatcher<QList<HashedFile>>::finished, this, &ModrinthPackExportTask::resolveHashes);
+    hashWatcher.setFuture(hashFuture);
+}
+
+void ModrinthPackExportTask::resolveHashes()
+{
+    // index the mods once instead of searching the whole list for every file
+    QHash<QString, const Mod*> modsByPath;
+    if (mcInstance) {
+        for (const Mod* mod : mcInstance->loaderModList()->allMods())
+            modsByPath.insert(mod->fileinfo().absoluteFilePath(), mod);
+    }
+
+    for (const HashedFile& file : hashFuture.result()) {
+        if (file.sha512.isEmpty()) {
+            qWarning() << "Could not hash" << file.path;
             continue;
         }
-        sha512.addData(data);
-
-        auto allMods = mcInstance->loaderModList()->allMods();
-        if (auto modIter = std::find_if(allMods.begin(), allMods.end(), [&file](Mod* mod) { return mod->fileinfo() == file; });
-            modIter != allMods.end()) {
-            const Mod* mod = *modIter;
-            if (mod->metadata() != nullptr) {
-                QUrl& url = mod->metadata()->url;
-                // ensure the url is permitted on modrinth.com
-                if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
-                    qDebug() << "Resolving" << relative << "from index";
-
-                    QCryptographicHash sha1(QCryptographicHash::Algorithm::Sha1);
-                    sha1.addData(data);
-
-                    ResolvedFile resolvedFile{ sha1.result().toHex(), sha512.result().toHex(), url.toEncoded(), openFile.size() };
-                    resolvedFiles[relative] = resolvedFile;
-
-                    // nice! we've managed to resolve based on local metadata!
-                    // no need to enqueue it
-                    continue;
-                }
+
+        if (const Mod* mod = modsByPath.value(file.path); mod && mod->metadata() != nullptr) {
+            QUrl& url = mod->metadata()->url;
+            // ensure the url is permitted on modrinth.com
+            if (!url.isEmpty() && BuildConfig.MODRINTH_MRPACK_HOSTS.contains(url.host())) {
+                qDebug() << "Resolving" << file.relative << "from index";
+
+                resolvedFiles[file.relative] = ResolvedFile{ file.sha1, file.sha512, url.toEncoded(), file.size };
+
+                // nice! we've managed to resolve based on local metadata!
+                // no need to enqueue it
+                continue;
             }
         }
 
-        qDebug() << "Enqueueing" << relative << "for Modrinth query";
-        pendingHashes[relative] = sha512.result().toHex();
+        qDebug() << "Enqueueing" << file.relative << "for Modrinth query";
+        pendingHashes[file.relative] = file.sha512;
     }
 
     setAbortable(true);
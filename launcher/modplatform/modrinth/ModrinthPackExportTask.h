@@ -45,6 +45,12 @@ class ModrinthPackExportTask : public Task {
         qint64 size;
     };
 
+    struct HashedFile {
+        QString path, relative;
+        QString sha1, sha512;
+        qint64 size = 0;
+    };
+
     static const QStringList PREFIXES;
     static const QStringList FILE_EXTENSIONS;
 
@@ -60,10 +66,13 @@ class ModrinthPackExportTask : public Task {
     QFileInfoList files;
     QMap<QString, QString> pendingHashes;
     QMap<QString, ResolvedFile> resolvedFiles;
+    QFuture<QList<HashedFile>> hashFuture;
+    QFutureWatcher<QList<HashedFile>> hashWatcher;
     Task::Ptr task;
 
     void collectFiles();
     void collectHashes();
+    void resolveHashes();
     void makeApiRequest();
     void parseApiResponse(const std::shared_ptr<QByteArray> response);
     void buildZip();
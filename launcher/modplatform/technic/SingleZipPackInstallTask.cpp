@@ -15,13 +15,12 @@
 
 #include "SingleZipPackInstallTask.h"
 
-#include <QtConcurrent>
-
 #include "FileSystem.h"
 #include "MMCZip.h"
 #include "TechnicPackProcessor.h"
 
 #include "Application.h"
+#include "tasks/Executor.h"
 
 Technic::SingleZipPackInstallTask::SingleZipPackInstallTask(const QUrl& sourceUrl, const QString& minecraftVersion)
 {
@@ -69,8 +68,8 @@ void Technic::SingleZipPackInstallTask::downloadSucceeded()
         emitFailed(tr("Unable to open supplied modpack zip file."));
         return;
     }
-    m_extractFuture =
-        QtConcurrent::run(QThreadPool::globalInstance(), MMCZip::extractSubDir, m_packZip.get(), QString(""), extractDir.absolutePath());
+    m_extractFuture = Executor::io().run(
+        [zip = m_packZip.get(), target = extractDir.absolutePath()] { return MMCZip::extractSubDir(zip, QString(""), target); });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &Technic::SingleZipPackInstallTask::extractFinished);
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, &Technic::SingleZipPackInstallTask::extractAborted);
     m_extractFutureWatcher.setFuture(m_extractFuture);
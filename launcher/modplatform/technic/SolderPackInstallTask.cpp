@@ -38,11 +38,12 @@
 #include <FileSystem.h>
 #include <Json.h>
 #include <MMCZip.h>
-#include <QtConcurrentRun>
 
+#include "Application.h"
 #include "SolderPackManifest.h"
 #include "TechnicPackProcessor.h"
 #include "net/ChecksumValidator.h"
+#include "tasks/Executor.h"
 
 Technic::SolderPackInstallTask::SolderPackInstallTask(shared_qobject_ptr<QNetworkAccessManager> network,
                                                       const QUrl& solderUrl,
@@ -62,6 +63,10 @@ bool Technic::SolderPackInstallTask::abort()
     if (m_abortable) {
         return m_filesNetJob->abort();
     }
+    if (m_extractFuture.isRunning()) {
+        m_extractAborted = true;
+        return true;
+    }
     return false;
 }
 
@@ -107,22 +112,35 @@ void Technic::SolderPackInstallTask::fileListSucceeded()
 
     m_filesNetJob.reset(new NetJob(tr("Downloading modpack"), m_network));
 
+    m_archives.clear();
+    QSet<QString> cachedHashes;
     int i = 0;
     for (const auto& mod : build.mods) {
-        auto path = FS::PathCombine(m_outputDir.path(), QString("%1").arg(i));
-
-        auto dl = Net::Download::makeFile(mod.url, path);
+        Net::Download::Ptr dl;
         if (!mod.md5.isEmpty()) {
+            // the same mod zips are shared by every build of a pack (and often by other packs), keep them around by their hash
+            auto md5 = mod.md5.toLower();
+            auto entry = APPLICATION->metacache()->resolveEntry("TechnicPacks", QString("solder/%1.zip").arg(md5));
+            m_archives.append(entry->getFullPath());
+            // builds sometimes list the same zip twice, only download it once
+            if (cachedHashes.contains(md5)) {
+                i++;
+                continue;
+            }
+            cachedHashes.insert(md5);
+            dl = Net::Download::makeCached(mod.url, entry, Net::Download::Option::MakeEternal);
             auto rawMd5 = QByteArray::fromHex(mod.md5.toLatin1());
             dl->addValidator(new Net::ChecksumValidator(QCryptographicHash::Md5, rawMd5));
+        } else {
+            auto path = FS::PathCombine(m_outputDir.path(), QString("%1").arg(i));
+            dl = Net::Download::makeFile(mod.url, path);
+            m_archives.append(path);
         }
         m_filesNetJob->addNetAction(dl);
 
         i++;
     }
 
-    m_modCount = build.mods.size();
-
     connect(m_filesNetJob.get(), &NetJob::succeeded, this, &Technic::SolderPackInstallTask::downloadSucceeded);
     connect(m_filesNetJob.get(), &NetJob::progress, this, &Technic::SolderPackInstallTask::downloadProgressChanged);
     connect(m_filesNetJob.get(), &NetJob::stepProgress, this, &Technic::SolderPackInstallTask::propagateStepProgress);
@@ -137,19 +155,17 @@ void Technic::SolderPackInstallTask::downloadSucceeded()
 
     setStatus(tr("Extracting modpack"));
     m_filesNetJob.reset();
-    m_extractFuture = QtConcurrent::run([this]() {
-        int i = 0;
+    m_extractAborted = false;
+    m_extractFuture = Executor::io().run([this]() {
         QString extractDir = FS::PathCombine(m_stagingPath, ".minecraft");
         FS::ensureFolderPathExists(extractDir);
 
-        while (m_modCount > i) {
-            auto path = FS::PathCombine(m_outputDir.path(), QString("%1").arg(i));
-            if (!MMCZip::extractDir(path, extractDir)) {
-                return false;
-            }
-            i++;
-        }
-        return true;
+        // later mods overwrite the files of earlier ones, the same as extracting them one after another
+        auto progress = [this](qint64 current, qint64 total) {
+            QMetaObject::invokeMethod(
+                this, [this, current, total] { setProgress(total + current, 2 * total); }, Qt::QueuedConnection);
+        };
+        return MMCZip::extractOverlay(m_archives, extractDir, progress, [this] { return bool(m_extractAborted); }).has_value();
     });
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::finished, this, &Technic::SolderPackInstallTask::extractFinished);
     connect(&m_extractFutureWatcher, &QFutureWatcher<QStringList>::canceled, this, &Technic::SolderPackInstallTask::extractAborted);
@@ -177,34 +193,14 @@ void Technic::SolderPackInstallTask::downloadAborted()
 
 void Technic::SolderPackInstallTask::extractFinished()
 {
+    if (m_extractAborted) {
+        emitAborted();
+        return;
+    }
     if (!m_extractFuture.result()) {
         emitFailed(tr("Failed to extract modpack"));
         return;
     }
-    QDir extractDir(m_stagingPath);
-
-    qDebug() << "Fixing permissions for extracted pack files...";
-    QDirIterator it(extractDir, QDirIterator::Subdirectories);
-    while (it.hasNext()) {
-        auto filepath = it.next();
-        QFileInfo file(filepath);
-        auto permissions = QFile::permissions(filepath);
-        auto origPermissions = permissions;
-        if (file.isDir()) {
-            // Folder +rwx for current user
-            permissions |= QFileDevice::Permission::ReadUser | QFileDevice::Permission::WriteUser | QFileDevice::Permission::ExeUser;
-        } else {
-            // File +rw for current user
-            permissions |= QFileDevice::Permission::ReadUser | QFileDevice::Permission::WriteUser;
-        }
-        if (origPermissions != permissions) {
-            if (!QFile::setPermissions(filepath, permissions)) {
-                logWarning(tr("Could not fix permissions for %1").arg(filepath));
-            } else {
-                qDebug() << "Fixed" << filepath;
-            }
-        }
-    }
 
     auto packProcessor = makeShared<Technic::TechnicPackProcessor>();
     connect(packProcessor.get(), &Technic::TechnicPackProcessor::succeeded, this, &Technic::SolderPackInstallTask::emitSucceeded);
@@ -40,6 +40,7 @@
 #include <tasks/Task.h>
 
 #include <QUrl>
+#include <atomic>
 #include <memory>
 
 namespace Technic {
@@ -80,7 +81,8 @@ class SolderPackInstallTask : public InstanceTask {
     QString m_minecraftVersion;
     std::shared_ptr<QByteArray> m_response = std::make_shared<QByteArray>();
     QTemporaryDir m_outputDir;
-    int m_modCount;
+    QStringList m_archives;
+    std::atomic_bool m_extractAborted{ false };
     QFuture<bool> m_extractFuture;
     QFutureWatcher<bool> m_extractFutureWatcher;
 };
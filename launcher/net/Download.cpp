@@ -303,6 +303,7 @@ void Download::downloadFinished()
     auto data = m_reply->readAll();
     if (data.size()) {
         qCDebug(taskDownloadLogC) << getUid().toString() << "Writing extra" << data.size() << "bytes";
+        addBytesDownloaded(data.size());
         m_state = m_sink->write(data);
     }
 
@@ -325,6 +326,7 @@ void Download::downloadReadyRead()
 {
     if (m_state == State::Running) {
         auto data = m_reply->readAll();
+        addBytesDownloaded(data.size());
         m_state = m_sink->write(data);
         if (m_state == State::Failed) {
             qCCritical(taskDownloadLogC) << getUid().toString() << "Failed to process response chunk";
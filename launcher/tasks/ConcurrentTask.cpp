@@ -127,6 +127,7 @@ void ConcurrentTask::startNext()
         return;
 
     Task::Ptr next = m_queue.dequeue();
+    next->setParentTask(this);
 
     connect(next.get(), &Task::succeeded, this, [this, next]() { subTaskSucceeded(next); });
     connect(next.get(), &Task::failed, this, [this, next](QString msg) { subTaskFailed(next, msg); });
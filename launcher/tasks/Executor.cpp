@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "Executor.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+
+CancellationToken::CancellationToken() : d(std::make_shared<State>()) {}
+
+void CancellationToken::cancel()
+{
+    d->cancelled = true;
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return d->cancelled;
+}
+
+int CancellationToken::pending() const
+{
+    return d->pending;
+}
+
+void CancellationToken::waitForFinished() const
+{
+    // running jobs may be waiting on queued calls to the thread we're blocking
+    while (d->pending > 0) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+}
+
+class ExecutorJob : public QRunnable {
+   public:
+    ExecutorJob(Executor* executor, std::function<void()> job, std::function<void()> onCancel, CancellationToken token)
+        : m_executor(executor), m_job(std::move(job)), m_onCancel(std::move(onCancel)), m_token(std::move(token))
+    {
+        m_queued.start();
+    }
+
+    void run() override
+    {
+        if (m_token.isCancelled()) {
+            if (m_onCancel)
+                m_onCancel();
+            m_executor->jobCancelled();
+        } else {
+            m_executor->jobStarted(m_queued.nsecsElapsed());
+            QElapsedTimer running;
+            running.start();
+            m_job();
+            m_executor->jobFinished(running.nsecsElapsed());
+        }
+        m_token.d->pending--;
+    }
+
+   private:
+    Executor* m_executor;
+    std::function<void()> m_job;
+    std::function<void()> m_onCancel;
+    CancellationToken m_token;
+    QElapsedTimer m_queued;
+};
+
+Executor::Executor(QString name, int maxThreads) : m_name(std::move(name)), m_ownedPool(new QThreadPool), m_pool(m_ownedPool.get())
+{
+    m_pool->setMaxThreadCount(qMax(1, maxThreads));
+    m_pool->setObjectName(m_name);
+}
+
+Executor::Executor(QString name, QThreadPool* pool) : m_name(std::move(name)), m_pool(pool) {}
+
+Executor::~Executor()
+{
+    if (m_ownedPool) {
+        m_ownedPool->clear();
+        m_ownedPool->waitForDone();
+    }
+}
+
+Executor& Executor::io()
+{
+    static Executor executor("IO", qMax(4, QThread::idealThreadCount()));
+    return executor;
+}
+
+Executor& Executor::cpu()
+{
+    static Executor executor("CPU", QThreadPool::globalInstance());
+    return executor;
+}
+
+Executor& Executor::interactive()
+{
+    static Executor executor("Interactive", qMax(2, QThread::idealThreadCount() / 2));
+    return executor;
+}
+
+QList<Executor::Metrics> Executor::allMetrics()
+{
+    return { io().metrics(), cpu().metrics(), interactive().metrics() };
+}
+
+Executor::Metrics Executor::metrics() const
+{
+    Metrics metrics;
+    metrics.name = m_name;
+    metrics.maxThreads = m_pool->maxThreadCount();
+    metrics.activeThreads = m_pool->activeThreadCount();
+    metrics.submitted = m_submitted;
+    metrics.completed = m_completed;
+    metrics.cancelled = m_cancelled;
+    metrics.queued = int(metrics.submitted - m_started - metrics.cancelled);
+    if (const qint64 started = m_started; started > 0)
+        metrics.averageWaitMs = double(m_totalWaitNs) / started / 1e6;
+    if (metrics.completed > 0)
+        metrics.averageRunMs = double(m_totalRunNs) / metrics.completed / 1e6;
+    metrics.maxWaitMs = m_maxWaitNs / 1000000;
+    return metrics;
+}
+
+void Executor::start(QRunnable* runnable, Priority priority, CancellationToken token)
+{
+    const bool autoDelete = runnable->autoDelete();
+    submit(
+        [runnable, autoDelete] {
+            runnable->run();
+            if (autoDelete)
+                delete runnable;
+        },
+        [runnable, autoDelete] {
+            if (autoDelete)
+                delete runnable;
+        },
+        priority, std::move(token));
+}
+
+void Executor::submit(std::function<void()> job, std::function<void()> onCancel, Priority priority, CancellationToken token)
+{
+    m_submitted++;
+    token.d->pending++;
+    m_pool->start(new ExecutorJob(this, std::move(job), std::move(onCancel), std::move(token)), static_cast<int>(priority));
+}
+
+void Executor::jobStarted(qint64 waitNs)
+{
+    m_started++;
+    m_totalWaitNs += waitNs;
+    qint64 max = m_maxWaitNs;
+    while (waitNs > max && !m_maxWaitNs.compare_exchange_weak(max, waitNs)) {
+    }
+}
+
+void Executor::jobFinished(qint64 runNs)
+{
+    m_totalRunNs += runNs;
+    m_completed++;
+}
+
+void Executor::jobCancelled()
+{
+    m_cancelled++;
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QFuture>
+#include <QFutureInterface>
+#include <QList>
+#include <QRunnable>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+/**
+ * Shared by an owner and every job it submits, so the owner can cancel the jobs that didn't start yet
+ * and wait for the ones already running, without waiting on anyone else's work.
+ */
+class CancellationToken {
+   public:
+    CancellationToken();
+
+    void cancel();
+    bool isCancelled() const;
+
+    /** Number of jobs submitted with this token that haven't finished yet. */
+    int pending() const;
+
+    /** Blocks until every job submitted with this token finished, processing events in the meantime. */
+    void waitForFinished() const;
+
+   private:
+    friend class Executor;
+    friend class ExecutorJob;
+
+    struct State {
+        std::atomic_bool cancelled{ false };
+        std::atomic_int pending{ 0 };
+    };
+    std::shared_ptr<State> d;
+};
+
+/**
+ * A named, bounded thread pool for one kind of work.
+ *
+ * - io():          file copies, archive extraction and exports. Long running, mostly waiting on the disk.
+ * - cpu():         hashing and other number crunching. Wraps the global pool, which QtConcurrent's map functions use too.
+ * - interactive(): folder scans and parsing whose results are waited on by the UI.
+ *
+ * Keeping them apart means a long export can't starve the mod list of threads.
+ */
+class Executor {
+   public:
+    enum class Priority { Low = 0, Normal = 5, High = 10 };
+
+    struct Metrics {
+        QString name;
+        int maxThreads = 0;
+        int activeThreads = 0;
+        int queued = 0;
+        qint64 submitted = 0;
+        qint64 completed = 0;
+        qint64 cancelled = 0;
+        double averageWaitMs = 0;
+        qint64 maxWaitMs = 0;
+        double averageRunMs = 0;
+    };
+
+    /** Creates an executor with its own pool of at most maxThreads threads. */
+    Executor(QString name, int maxThreads);
+    /** Creates an executor on top of an existing pool, which it doesn't own. */
+    Executor(QString name, QThreadPool* pool);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    static Executor& io();
+    static Executor& cpu();
+    static Executor& interactive();
+    static QList<Metrics> allMetrics();
+
+    const QString& name() const { return m_name; }
+    QThreadPool* pool() const { return m_pool; }
+    Metrics metrics() const;
+
+    /**
+     * Runs the runnable (e.g. a Task) on this executor. It is not run at all if the token gets cancelled before a thread
+     * picks it up. Runnables with autoDelete() set are deleted afterwards, like QThreadPool does.
+     */
+    void start(QRunnable* runnable, Priority priority = Priority::Normal, CancellationToken token = {});
+
+    /**
+     * Runs the function on this executor and returns a future for its result.
+     * If the token gets cancelled before the function started, the future is cancelled instead.
+     */
+    template <typename Function>
+    auto run(Function function, Priority priority = Priority::Normal, CancellationToken token = {})
+        -> QFuture<std::invoke_result_t<Function>>
+    {
+        using Result = std::invoke_result_t<Function>;
+        auto futureInterface = std::make_shared<QFutureInterface<Result>>();
+        futureInterface->reportStarted();
+        auto future = futureInterface->future();
+
+        submit(
+            [futureInterface, function = std::move(function)]() mutable {
+                if constexpr (std::is_void_v<Result>) {
+                    function();
+                } else {
+                    futureInterface->reportResult(function());
+                }
+                futureInterface->reportFinished();
+            },
+            [futureInterface] {
+                futureInterface->cancel();
+                futureInterface->reportFinished();
+            },
+            priority, std::move(token));
+        return future;
+    }
+
+   private:
+    friend class ExecutorJob;
+
+    void submit(std::function<void()> job, std::function<void()> onCancel, Priority priority, CancellationToken token);
+
+    void jobStarted(qint64 waitNs);
+    void jobFinished(qint64 runNs);
+    void jobCancelled();
+
+    QString m_name;
+    std::unique_ptr<QThreadPool> m_ownedPool;
+    QThreadPool* m_pool;
+
+    std::atomic<qint64> m_submitted{ 0 };
+    std::atomic<qint64> m_started{ 0 };
+    std::atomic<qint64> m_completed{ 0 };
+    std::atomic<qint64> m_cancelled{ 0 };
+    std::atomic<qint64> m_totalWaitNs{ 0 };
+    std::atomic<qint64> m_maxWaitNs{ 0 };
+    std::atomic<qint64> m_totalRunNs{ 0 };
+};
@@ -37,6 +37,9 @@
 #include "Task.h"
 
 #include <QDebug>
+#include <QThread>
+
+#include "TaskTrace.h"
 
 Q_LOGGING_CATEGORY(taskLogC, "launcher.task")
 
@@ -44,6 +47,17 @@ Task::Task(QObject* parent, bool show_debug) : QObject(parent), m_show_debug(sho
 {
     m_uid = QUuid::createUuid();
     setAutoDelete(false);
+
+    // some tasks emit these directly instead of going through emitSucceeded() and friends
+    connect(this, &Task::succeeded, this, [this] { recordFinished("succeeded"); }, Qt::DirectConnection);
+    connect(this, &Task::failed, this, [this](QString reason) { recordFinished("failed", reason); }, Qt::DirectConnection);
+    connect(this, &Task::aborted, this, [this] { recordFinished("aborted"); }, Qt::DirectConnection);
+}
+
+void Task::setParentTask(Task* parent)
+{
+    m_parent_uid = parent ? parent->m_uid : QUuid();
+    m_root_uid = parent ? parent->rootTaskUid() : QUuid();
 }
 
 void Task::setStatus(const QString& new_status)
@@ -102,6 +116,17 @@ void Task::start()
         }
     }
     // NOTE: only fall through to here in end states
+    if (m_parent_uid.isNull()) {
+        if (auto parent_task = qobject_cast<Task*>(parent()))
+            setParentTask(parent_task);
+    }
+    m_started_at = TaskTrace::now();
+    m_finished_at = -1;
+    m_started_on = reinterpret_cast<quintptr>(QThread::currentThreadId());
+    m_bytes_read = 0;
+    m_bytes_written = 0;
+    m_bytes_downloaded = 0;
+
     m_state = State::Running;
     emit started();
     executeTask();
@@ -150,6 +175,31 @@ void Task::emitSucceeded()
     emit finished();
 }
 
+void Task::recordFinished(const QString& state, const QString& reason)
+{
+    m_finished_at = TaskTrace::now();
+
+    auto& trace = TaskTrace::instance();
+    if (!trace.isEnabled() || m_started_at < 0)
+        return;
+
+    TaskTrace::Event event;
+    event.uid = m_uid;
+    event.parent = m_parent_uid;
+    event.root = rootTaskUid();
+    event.className = metaObject()->className();
+    event.name = objectName().isEmpty() ? event.className : objectName();
+    event.state = state;
+    event.failReason = reason;
+    event.start = m_started_at;
+    event.end = m_finished_at;
+    event.thread = m_started_on;
+    event.bytesRead = m_bytes_read;
+    event.bytesWritten = m_bytes_written;
+    event.bytesDownloaded = m_bytes_downloaded;
+    trace.record(std::move(event));
+}
+
 void Task::propagateStepProgress(TaskStepProgress const& task_progress)
 {
     emit stepProgress(task_progress);
@@ -40,6 +40,8 @@
 #include <QRunnable>
 #include <QUuid>
 
+#include <atomic>
+
 #include "QObjectPtr.h"
 
 Q_DECLARE_LOGGING_CATEGORY(taskLogC)
@@ -119,11 +121,35 @@ class Task : public QObject, public QRunnable {
 
     QUuid getUid() { return m_uid; }
 
+    /*!
+     * The task that started this one, if any. Only used to nest it below its parent in the task trace.
+     */
+    void setParentTask(Task* parent);
+    QUuid parentTaskUid() const { return m_parent_uid; }
+    QUuid rootTaskUid() const { return m_root_uid.isNull() ? m_uid : m_root_uid; }
+
+    /*!
+     * When the task last started and finished, in microseconds on the TaskTrace clock, or -1 if it didn't (yet).
+     */
+    qint64 startedAt() const { return m_started_at; }
+    qint64 finishedAt() const { return m_finished_at; }
+
+    /*!
+     * I/O done by the task itself (not by its subtasks) since it last started. Safe to call from any thread.
+     */
+    void addBytesRead(qint64 bytes) { m_bytes_read += bytes; }
+    void addBytesWritten(qint64 bytes) { m_bytes_written += bytes; }
+    void addBytesDownloaded(qint64 bytes) { m_bytes_downloaded += bytes; }
+    qint64 bytesRead() const { return m_bytes_read; }
+    qint64 bytesWritten() const { return m_bytes_written; }
+    qint64 bytesDownloaded() const { return m_bytes_downloaded; }
+
    protected:
     void logWarning(const QString& line);
 
    private:
     QString describe();
+    void recordFinished(const QString& state, const QString& reason = {});
 
    signals:
     void started();
@@ -179,8 +205,8 @@ class Task : public QObject, public QRunnable {
     QString m_failReason = "";
     QString m_status;
     QString m_details;
-    int m_progress = 0;
-    int m_progressTotal = 100;
+    qint64 m_progress = 0;
+    qint64 m_progressTotal = 100;
 
     // TODO: Nuke in favor of QLoggingCategory
     bool m_show_debug = true;
@@ -189,4 +215,13 @@ class Task : public QObject, public QRunnable {
     // Change using setAbortStatus
     bool m_can_abort = false;
     QUuid m_uid;
+
+    QUuid m_parent_uid;
+    QUuid m_root_uid;
+    qint64 m_started_at = -1;
+    qint64 m_finished_at = -1;
+    quintptr m_started_on = 0;
+    std::atomic<qint64> m_bytes_read{ 0 };
+    std::atomic<qint64> m_bytes_written{ 0 };
+    std::atomic<qint64> m_bytes_downloaded{ 0 };
 };
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TaskTrace.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+#include "FileSystem.h"
+
+TaskTrace& TaskTrace::instance()
+{
+    static TaskTrace trace;
+    return trace;
+}
+
+qint64 TaskTrace::now()
+{
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.nsecsElapsed() / 1000;
+}
+
+void TaskTrace::record(Event event)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_events.size() >= MAX_EVENTS) {
+        m_dropped++;
+        return;
+    }
+    m_events.append(std::move(event));
+}
+
+QList<TaskTrace::Event> TaskTrace::events() const
+{
+    QMutexLocker locker(&m_lock);
+    return m_events;
+}
+
+void TaskTrace::clear()
+{
+    QMutexLocker locker(&m_lock);
+    m_events.clear();
+    m_dropped = 0;
+}
+
+QByteArray TaskTrace::toJson() const
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    QJsonObject processName;
+    processName["ph"] = "M";
+    processName["name"] = "process_name";
+    processName["pid"] = pid;
+    processName["args"] = QJsonObject{ { "name", QCoreApplication::applicationName() } };
+    traceEvents.append(processName);
+
+    qint64 dropped;
+    const auto recorded = [this, &dropped] {
+        QMutexLocker locker(&m_lock);
+        dropped = m_dropped;
+        return m_events;
+    }();
+
+    for (const auto& event : recorded) {
+        // nestable async events: everything sharing an id ends up on one track, nested by time
+        QJsonObject begin;
+        begin["ph"] = "b";
+        begin["cat"] = "task";
+        begin["name"] = event.name;
+        begin["id"] = event.root.toString(QUuid::WithoutBraces);
+        begin["pid"] = pid;
+        begin["tid"] = qint64(event.thread);
+        begin["ts"] = event.start;
+
+        QJsonObject args;
+        args["uid"] = event.uid.toString(QUuid::WithoutBraces);
+        if (!event.parent.isNull())
+            args["parent"] = event.parent.toString(QUuid::WithoutBraces);
+        args["class"] = event.className;
+        args["state"] = event.state;
+        if (!event.failReason.isEmpty())
+            args["failReason"] = event.failReason;
+        args["bytesRead"] = event.bytesRead;
+        args["bytesWritten"] = event.bytesWritten;
+        args["bytesDownloaded"] = event.bytesDownloaded;
+        begin["args"] = args;
+
+        QJsonObject end = begin;
+        end["ph"] = "e";
+        end["ts"] = event.end;
+        end.remove("args");
+
+        traceEvents.append(begin);
+        traceEvents.append(end);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+    if (dropped > 0)
+        root["otherData"] = QJsonObject{ { "droppedEvents", dropped } };
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool TaskTrace::save(const QString& path) const
+{
+    try {
+        FS::write(path, toJson());
+    } catch (const FS::FileSystemException& e) {
+        qWarning() << "Could not write the task trace to" << path << ":" << e.cause();
+        return false;
+    }
+    qDebug() << "Wrote the task trace to" << path;
+    return true;
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: GPL-3.0-only
+/*
+ *  Prism Launcher - Minecraft Launcher
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, version 3.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QUuid>
+
+#include <atomic>
+
+/**
+ * Collects the timing and I/O counters of every finished Task while enabled, and writes them out
+ * in the Chrome trace event format (load it in chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Every task tree ends up on its own track, with the subtasks nested below the task that ran them.
+ */
+class TaskTrace {
+   public:
+    struct Event {
+        QUuid uid;
+        QUuid parent;
+        QUuid root;
+        QString name;
+        QString className;
+        QString state;
+        QString failReason;
+        qint64 start = 0;  // microseconds, see now()
+        qint64 end = 0;
+        quintptr thread = 0;
+        qint64 bytesRead = 0;
+        qint64 bytesWritten = 0;
+        qint64 bytesDownloaded = 0;
+    };
+
+    static TaskTrace& instance();
+
+    /** Microseconds on a monotonic clock shared by every task timestamp. */
+    static qint64 now();
+
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    void record(Event event);
+    QList<Event> events() const;
+    void clear();
+
+    QByteArray toJson() const;
+    bool save(const QString& path) const;
+
+   private:
+    TaskTrace() = default;
+
+    // a long session downloading thousands of files shouldn't grow without bounds
+    static constexpr int MAX_EVENTS = 500000;
+
+    std::atomic_bool m_enabled{ false };
+    mutable QMutex m_lock;
+    QList<Event> m_events;
+    qint64 m_dropped = 0;
+};
@@ -0,0 +1,333 @@
+#include "POCatalog.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QHash>
+#include <QVector>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+const char magic[8] = { 'P', 'R', 'I', 'S', 'M', 'P', 'O', 'C' };
+const quint32 formatVersion = 1;
+const quint32 emptySlot = 0xFFFFFFFF;
+const quint32 fuzzyFlag = 1;
+// separates the parts of a key, and can't be part of a context or source text
+const char separator = '\x04';
+enum KeyKind : char { Plain = 1, Disambiguated = 2 };
+
+// FNV-1a, finished with the murmur3 mix so the low bits are usable for the modulo
+class Hasher {
+   public:
+    explicit Hasher(quint32 seed) : m_hash(2166136261u ^ (seed * 0x9e3779b9u)) {}
+
+    void add(char c) { m_hash = (m_hash ^ uchar(c)) * 16777619u; }
+    void add(const char* str)
+    {
+        while (*str)
+            add(*str++);
+    }
+    void add(const QByteArray& bytes)
+    {
+        for (char c : bytes)
+            add(c);
+    }
+
+    quint32 result() const
+    {
+        quint32 h = m_hash;
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+   private:
+    quint32 m_hash;
+};
+
+quint32 hashKey(const QByteArray& key, quint32 seed)
+{
+    Hasher hasher(seed);
+    hasher.add(key);
+    return hasher.result();
+}
+
+QByteArray plainKey(const POCatalog::Message& message)
+{
+    return char(Plain) + message.context + separator + message.id;
+}
+
+QByteArray disambiguatedKey(const POCatalog::Message& message)
+{
+    return char(Disambiguated) + message.context + separator + message.id + separator + message.disambiguation;
+}
+
+// matches the key in the pool against its parts without putting them together
+bool keyMatches(const char* key, quint32 length, char kind, const char* context, const char* sourceText, const char* disambiguation)
+{
+    const char* end = key + length;
+    auto match = [&key, end](const char* str) {
+        while (*str) {
+            if (key == end || *key != *str)
+                return false;
+            key++;
+            str++;
+        }
+        return true;
+    };
+    auto matchChar = [&key, end](char c) {
+        if (key == end || *key != c)
+            return false;
+        key++;
+        return true;
+    };
+
+    if (!matchChar(kind) || !match(context) || !matchChar(separator) || !match(sourceText))
+        return false;
+    if (disambiguation && (!matchChar(separator) || !match(disambiguation)))
+        return false;
+    return key == end;
+}
+}  // namespace
+
+struct POCatalog::Header {
+    char magic[8];
+    quint32 version;
+    quint32 keyCount;
+    quint32 bucketCount;
+    quint32 slotCount;
+    //! size of the translation pool, in UTF-16 code units
+    quint32 textUnits;
+    //! size of the key pool, in bytes
+    quint32 keyBytes;
+    qint64 sourceSize;
+    //! in milliseconds since the epoch
+    qint64 sourceModified;
+};
+
+struct POCatalog::Slot {
+    quint32 keyOffset;
+    quint32 keyLength;
+    quint32 textOffset;
+    quint32 textLength;
+    quint32 flags;
+};
+
+QByteArray POCatalog::build(const QList<Message>& messages, qint64 sourceSize, qint64 sourceModified)
+{
+    // every key once, with the message that came last for it
+    QList<QByteArray> keys;
+    QList<int> messageOfKey;
+    QHash<QByteArray, int> known;
+    auto addKey = [&](const QByteArray& key, int message) {
+        auto it = known.find(key);
+        if (it != known.end()) {
+            messageOfKey[*it] = message;
+            return;
+        }
+        known.insert(key, keys.size());
+        keys.append(key);
+        messageOfKey.append(message);
+    };
+    for (int i = 0; i < messages.size(); i++) {
+        addKey(plainKey(messages.at(i)), i);
+        if (!messages.at(i).disambiguation.isEmpty())
+            addKey(disambiguatedKey(messages.at(i)), i);
+    }
+
+    // hash and displace: the keys are grouped into buckets by a first hash, then every bucket, largest first, looks for a seed
+    // that puts all its keys into free slots
+    const quint32 keyCount = keys.size();
+    const quint32 bucketCount = std::max<quint32>(1, (keyCount + 3) / 4);
+    const quint32 slotCount = std::max<quint32>(1, keyCount + keyCount / 4);
+
+    QVector<QVector<int>> buckets(bucketCount);
+    for (quint32 k = 0; k < keyCount; k++) {
+        buckets[hashKey(keys.at(k), 0) % bucketCount].append(k);
+    }
+    QVector<quint32> order(bucketCount);
+    for (quint32 b = 0; b < bucketCount; b++)
+        order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&buckets](quint32 a, quint32 b) { return buckets[a].size() > buckets[b].size(); });
+
+    QVector<quint32> seeds(bucketCount, 0);
+    QVector<int> keyOfSlot(slotCount, -1);
+    QVector<quint32> taken;
+    for (auto bucket : order) {
+        const auto& members = buckets.at(bucket);
+        if (members.isEmpty())
+            break;
+        bool placed = false;
+        for (quint32 seed = 1; seed < (1u << 24) && !placed; seed++) {
+            taken.clear();
+            placed = true;
+            for (int k : members) {
+                auto slot = hashKey(keys.at(k), seed) % slotCount;
+                if (keyOfSlot.at(slot) != -1 || taken.contains(slot)) {
+                    placed = false;
+                    break;
+                }
+                taken.append(slot);
+            }
+            if (placed) {
+                seeds[bucket] = seed;
+                for (int i = 0; i < members.size(); i++)
+                    keyOfSlot[taken.at(i)] = members.at(i);
+            }
+        }
+        if (!placed)
+            return {};
+    }
+
+    // the pools, with the translation shared between both keys of a message
+    QString texts;
+    QByteArray keyPool;
+    QVector<Slot> table(slotCount, Slot{ emptySlot, 0, 0, 0, 0 });
+    QHash<int, quint32> textOffsets;
+    for (quint32 s = 0; s < slotCount; s++) {
+        const int k = keyOfSlot.at(s);
+        if (k == -1)
+            continue;
+        const auto& message = messages.at(messageOfKey.at(k));
+        auto textOffset = textOffsets.find(messageOfKey.at(k));
+        if (textOffset == textOffsets.end()) {
+            textOffset = textOffsets.insert(messageOfKey.at(k), texts.size());
+            texts += message.text;
+        }
+        table[s] = Slot{ quint32(keyPool.size()), quint32(keys.at(k).size()), *textOffset, quint32(message.text.size()),
+                         message.fuzzy ? fuzzyFlag : 0 };
+        keyPool += keys.at(k);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.keyCount = keyCount;
+    header.bucketCount = bucketCount;
+    header.slotCount = slotCount;
+    header.textUnits = texts.size();
+    header.keyBytes = keyPool.size();
+    header.sourceSize = sourceSize;
+    header.sourceModified = sourceModified;
+
+    QByteArray out;
+    out.reserve(sizeof(Header) + bucketCount * sizeof(quint32) + slotCount * sizeof(Slot) + texts.size() * 2 + keyPool.size());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.append(reinterpret_cast<const char*>(seeds.constData()), bucketCount * sizeof(quint32));
+    out.append(reinterpret_cast<const char*>(table.constData()), slotCount * sizeof(Slot));
+    out.append(reinterpret_cast<const char*>(texts.constData()), texts.size() * 2);
+    out.append(keyPool);
+    return out;
+}
+
+bool POCatalog::open(const QString& filename)
+{
+    setData(nullptr, 0);
+    m_buffer.clear();
+    m_file.reset(new QFile(filename));
+    if (!m_file->open(QFile::ReadOnly)) {
+        m_file.reset();
+        return false;
+    }
+    auto data = m_file->map(0, m_file->size());
+    if (!data || !setData(data, m_file->size())) {
+        m_file.reset();
+        return false;
+    }
+    return true;
+}
+
+bool POCatalog::open(const QByteArray& data)
+{
+    setData(nullptr, 0);
+    m_file.reset();
+    m_buffer = data;
+    if (!setData(reinterpret_cast<const uchar*>(m_buffer.constData()), m_buffer.size())) {
+        m_buffer.clear();
+        return false;
+    }
+    return true;
+}
+
+bool POCatalog::setData(const uchar* data, qint64 size)
+{
+    static_assert(sizeof(Header) == 48, "the catalog header has a fixed layout");
+    static_assert(sizeof(Slot) == 20, "catalog slots have a fixed layout");
+
+    m_header = nullptr;
+    m_seeds = nullptr;
+    m_slots = nullptr;
+    m_texts = nullptr;
+    m_keys = nullptr;
+    if (!data || size < qint64(sizeof(Header)))
+        return false;
+
+    auto header = reinterpret_cast<const Header*>(data);
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != formatVersion)
+        return false;
+    if (header->bucketCount == 0 || header->slotCount == 0)
+        return false;
+    const qint64 seedsAt = sizeof(Header);
+    const qint64 slotsAt = seedsAt + qint64(header->bucketCount) * sizeof(quint32);
+    const qint64 textsAt = slotsAt + qint64(header->slotCount) * sizeof(Slot);
+    const qint64 keysAt = textsAt + qint64(header->textUnits) * 2;
+    if (keysAt + header->keyBytes != size)
+        return false;
+
+    m_header = header;
+    m_seeds = reinterpret_cast<const quint32*>(data + seedsAt);
+    m_slots = reinterpret_cast<const Slot*>(data + slotsAt);
+    m_texts = reinterpret_cast<const QChar*>(data + textsAt);
+    m_keys = reinterpret_cast<const char*>(data + keysAt);
+    return true;
+}
+
+int POCatalog::size() const
+{
+    return m_header ? m_header->keyCount : 0;
+}
+
+bool POCatalog::isUpToDate(const QString& sourceFile) const
+{
+    if (!m_header)
+        return false;
+    QFileInfo info(sourceFile);
+    return info.exists() && info.size() == m_header->sourceSize && info.lastModified().toMSecsSinceEpoch() == m_header->sourceModified;
+}
+
+POCatalog::Translation POCatalog::find(const char* context, const char* sourceText, const char* disambiguation) const
+{
+    if (!m_header || !sourceText)
+        return {};
+    if (!context)
+        context = "";
+    const char kind = disambiguation ? Disambiguated : Plain;
+
+    auto hash = [&](quint32 seed) {
+        Hasher hasher(seed);
+        hasher.add(kind);
+        hasher.add(context);
+        hasher.add(separator);
+        hasher.add(sourceText);
+        if (disambiguation) {
+            hasher.add(separator);
+            hasher.add(disambiguation);
+        }
+        return hasher.result();
+    };
+
+    const auto bucket = hash(0) % m_header->bucketCount;
+    const auto& slot = m_slots[hash(m_seeds[bucket]) % m_header->slotCount];
+    if (slot.keyOffset == emptySlot)
+        return {};
+    // a damaged file shouldn't make us read past its end
+    if (quint64(slot.keyOffset) + slot.keyLength > m_header->keyBytes || quint64(slot.textOffset) + slot.textLength > m_header->textUnits)
+        return {};
+    if (!keyMatches(m_keys + slot.keyOffset, slot.keyLength, kind, context, sourceText, disambiguation))
+        return {};
+    return { m_texts + slot.textOffset, int(slot.textLength), (slot.flags & fuzzyFlag) != 0 };
+}
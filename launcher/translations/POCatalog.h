@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+
+#include <memory>
+
+/**
+ * A compiled form of a .po file, which can be mapped into memory and looked up in without parsing or allocating anything.
+ *
+ * The file is a header, followed by a perfect hash table over all the message keys and the pools the keys (as UTF-8) and
+ * the translations (as UTF-16, ready to become a QString) point into. Every message is stored under its context and
+ * source text, and, if it has one, additionally under its context, source text and disambiguation.
+ */
+class POCatalog {
+   public:
+    struct Message {
+        QByteArray context;
+        QByteArray id;
+        QByteArray disambiguation;
+        QString text;
+        bool fuzzy = false;
+    };
+
+    struct Translation {
+        const QChar* text = nullptr;
+        int length = 0;
+        bool fuzzy = false;
+
+        bool found() const { return text != nullptr; }
+    };
+
+    //! Builds a catalog out of the messages, later messages with the same key replacing earlier ones.
+    //! The size and modification time of the source file are stored with it, to tell when it's outdated.
+    static QByteArray build(const QList<Message>& messages, qint64 sourceSize = 0, qint64 sourceModified = 0);
+
+    //! Maps a catalog file. Fails if it isn't a valid catalog.
+    bool open(const QString& filename);
+    //! Uses a catalog that's in memory.
+    bool open(const QByteArray& data);
+
+    bool isValid() const { return m_header != nullptr; }
+    int size() const;
+    //! Whether the catalog was built from the given file in its current state.
+    bool isUpToDate(const QString& sourceFile) const;
+
+    Translation find(const char* context, const char* sourceText, const char* disambiguation = nullptr) const;
+
+   private:
+    bool setData(const uchar* data, qint64 size);
+
+    struct Header;
+    struct Slot;
+
+    std::unique_ptr<QFile> m_file;
+    QByteArray m_buffer;
+
+    const Header* m_header = nullptr;
+    const quint32* m_seeds = nullptr;
+    const Slot* m_slots = nullptr;
+    const QChar* m_texts = nullptr;
+    const char* m_keys = nullptr;
+};
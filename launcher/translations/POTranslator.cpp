@@ -1,20 +1,22 @@
 #include "POTranslator.h"
 
+#include <QDateTime>
 #include <QDebug>
-#include "FileSystem.h"
+#include <QFileInfo>
 
-struct POEntry {
-    QString text;
-    bool fuzzy;
-};
+#include <mutex>
+
+#include "FileSystem.h"
+#include "POCatalog.h"
 
 struct POTranslatorPrivate {
     QString filename;
-    QHash<QByteArray, POEntry> mapping;
-    QHash<QByteArray, POEntry> mapping_disambiguatrion;
-    bool loaded = false;
+    QString catalogFile;
+    POCatalog catalog;
+    std::once_flag loadFlag;
 
-    void reload();
+    void load();
+    bool parse(QList<POCatalog::Message>& messages);
 };
 
 class ParserArray : public QByteArray {
@@ -129,12 +131,37 @@ class ParserArray : public QByteArray {
     }
 };
 
-void POTranslatorPrivate::reload()
+void POTranslatorPrivate::load()
+{
+    if (!catalogFile.isEmpty() && catalog.open(catalogFile) && catalog.isUpToDate(filename)) {
+        return;
+    }
+
+    QList<POCatalog::Message> messages;
+    if (!parse(messages)) {
+        catalog = POCatalog();
+        return;
+    }
+    QFileInfo info(filename);
+    auto data = POCatalog::build(messages, info.size(), info.lastModified().toMSecsSinceEpoch());
+    if (!catalogFile.isEmpty()) {
+        try {
+            FS::write(catalogFile, data);
+        } catch (const FS::FileSystemException& e) {
+            qWarning() << "Failed to save the compiled translation catalog:" << e.cause();
+        }
+    }
+    if (!catalog.open(data)) {
+        qDebug() << "Failed to compile PO file:" << filename;
+    }
+}
+
+bool POTranslatorPrivate::parse(QList<POCatalog::Message>& messages)
 {
     QFile file(filename);
     if (!file.open(QFile::OpenMode::enum_type::ReadOnly | QFile::OpenMode::enum_type::Text)) {
         qDebug() << "Failed to open PO file:" << filename;
-        return;
+        return false;
     }
 
     QByteArray context;
@@ -147,18 +174,10 @@ void POTranslatorPrivate::reload()
     enum class Mode { First, MessageContext, MessageId, MessageString } mode = Mode::First;
 
     int lineNumber = 0;
-    QHash<QByteArray, POEntry> newMapping;
-    QHash<QByteArray, POEntry> newMapping_disambiguation;
     auto endEntry = [&]() {
-        auto strStr = QString::fromUtf8(str);
         // NOTE: PO header has empty id. We skip it.
         if (!id.isEmpty()) {
-            auto normalKey = context + "|" + id;
-            newMapping.insert(normalKey, { strStr, fuzzy });
-            if (!disambiguation.isEmpty()) {
-                auto disambiguationKey = context + "|" + id + "@" + disambiguation;
-                newMapping_disambiguation.insert(disambiguationKey, { strStr, fuzzy });
-            }
+            messages.append({ context, id, disambiguation, QString::fromUtf8(str), fuzzy });
         }
         context.clear();
         disambiguation.clear();
@@ -189,7 +208,7 @@ void POTranslatorPrivate::reload()
             switch (mode) {
                 case Mode::First:
                     qDebug() << "Unexpected escaped string during initial state... line:" << lineNumber;
-                    return;
+                    return false;
                 case Mode::MessageString:
                     out = &str;
                     break;
@@ -202,7 +221,7 @@ void POTranslatorPrivate::reload()
             }
             if (!line.chompString(*out)) {
                 qDebug() << "Badly formatted string on line:" << lineNumber;
-                return;
+                return false;
             }
         } else if (line.chomp("msgctxt ", 8)) {
             switch (mode) {
@@ -214,7 +233,7 @@ void POTranslatorPrivate::reload()
                 case Mode::MessageContext:
                 case Mode::MessageId:
                     qDebug() << "Unexpected msgctxt line:" << lineNumber;
-                    return;
+                    return false;
             }
             if (line.chompString(context)) {
                 auto parts = context.split('|');
@@ -234,7 +253,7 @@ void POTranslatorPrivate::reload()
                     break;
                 case Mode::MessageId:
                     qDebug() << "Unexpected msgid line:" << lineNumber;
-                    return;
+                    return false;
             }
             if (line.chompString(id)) {
                 mode = Mode::MessageId;
@@ -245,7 +264,7 @@ void POTranslatorPrivate::reload()
                 case Mode::MessageString:
                 case Mode::MessageContext:
                     qDebug() << "Unexpected msgstr line:" << lineNumber;
-                    return;
+                    return false;
                 case Mode::MessageId:
                     break;
             }
@@ -258,16 +277,14 @@ void POTranslatorPrivate::reload()
         lineNumber++;
     }
     endEntry();
-    mapping = std::move(newMapping);
-    mapping_disambiguatrion = std::move(newMapping_disambiguation);
-    loaded = true;
+    return true;
 }
 
-POTranslator::POTranslator(const QString& filename, QObject* parent) : QTranslator(parent)
+POTranslator::POTranslator(const QString& filename, const QString& catalogFile, QObject* parent) : QTranslator(parent)
 {
     d = new POTranslatorPrivate;
     d->filename = filename;
-    d->reload();
+    d->catalogFile = catalogFile;
 }
 
 POTranslator::~POTranslator()
@@ -277,36 +294,30 @@ POTranslator::~POTranslator()
 
 QString POTranslator::translate(const char* context, const char* sourceText, const char* disambiguation, int n) const
 {
+    std::call_once(d->loadFlag, [this] { d->load(); });
+
+    POCatalog::Translation entry;
     if (disambiguation) {
-        auto disambiguationKey = QByteArray(context) + "|" + QByteArray(sourceText) + "@" + QByteArray(disambiguation);
-        auto iter = d->mapping_disambiguatrion.find(disambiguationKey);
-        if (iter != d->mapping_disambiguatrion.end()) {
-            auto& entry = *iter;
-            if (entry.text.isEmpty()) {
-                qDebug() << "Translation entry has no content:" << disambiguationKey;
-            }
-            if (entry.fuzzy) {
-                qDebug() << "Translation entry is fuzzy:" << disambiguationKey << "->" << entry.text;
-            }
-            return entry.text;
-        }
+        entry = d->catalog.find(context, sourceText, disambiguation);
     }
-    auto key = QByteArray(context) + "|" + QByteArray(sourceText);
-    auto iter = d->mapping.find(key);
-    if (iter != d->mapping.end()) {
-        auto& entry = *iter;
-        if (entry.text.isEmpty()) {
-            qDebug() << "Translation entry has no content:" << key;
-        }
-        if (entry.fuzzy) {
-            qDebug() << "Translation entry is fuzzy:" << key << "->" << entry.text;
-        }
-        return entry.text;
+    if (!entry.found()) {
+        entry = d->catalog.find(context, sourceText);
+    }
+    if (!entry.found()) {
+        return QString();
+    }
+    QString text(entry.text, entry.length);
+    if (text.isEmpty()) {
+        qDebug() << "Translation entry has no content:" << context << sourceText << disambiguation;
+    }
+    if (entry.fuzzy) {
+        qDebug() << "Translation entry is fuzzy:" << context << sourceText << disambiguation << "->" << text;
     }
-    return QString();
+    return text;
 }
 
 bool POTranslator::isEmpty() const
 {
-    return !d->loaded;
+    std::call_once(d->loadFlag, [this] { d->load(); });
+    return !d->catalog.isValid();
 }
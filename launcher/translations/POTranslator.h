@@ -4,10 +4,16 @@
 
 struct POTranslatorPrivate;
 
+/**
+ * Translates with the messages of a .po file.
+ *
+ * The file is compiled into a POCatalog the first time a translation is needed. If a catalog file is given, the compiled
+ * catalog is kept there and mapped directly on later runs, for as long as the .po file doesn't change.
+ */
 class POTranslator : public QTranslator {
     Q_OBJECT
    public:
-    explicit POTranslator(const QString& filename, QObject* parent = nullptr);
+    explicit POTranslator(const QString& filename, const QString& catalogFile = QString(), QObject* parent = nullptr);
     virtual ~POTranslator();
     QString translate(const char* context, const char* sourceText, const char* disambiguation, int n) const override;
     bool isEmpty() const override;
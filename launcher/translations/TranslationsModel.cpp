@@ -46,6 +46,7 @@
 
 #include "BuildConfig.h"
 #include "FileSystem.h"
+#include "FileWatchService.h"
 #include "Json.h"
 #include "net/ChecksumValidator.h"
 #include "net/NetJob.h"
@@ -166,7 +167,7 @@ struct TranslationsModel::Private {
     QString m_nextDownload;
 
     std::unique_ptr<POTranslator> m_po_translator;
-    QFileSystemWatcher* watcher;
+    FileWatch* watch;
 
     const QString m_system_locale = QLocale::system().name();
     const QString m_system_language = m_system_locale.split('_').front();
@@ -181,9 +182,8 @@ TranslationsModel::TranslationsModel(QString path, QObject* parent) : QAbstractL
     FS::ensureFolderPathExists(path);
     reloadLocalFiles();
 
-    d->watcher = new QFileSystemWatcher(this);
-    connect(d->watcher, &QFileSystemWatcher::directoryChanged, this, &TranslationsModel::translationDirChanged);
-    d->watcher->addPath(d->m_dir.canonicalPath());
+    d->watch = FileWatchService::instance()->watch(d->m_dir.canonicalPath(), false, this);
+    connect(d->watch, &FileWatch::changed, this, [this] { translationDirChanged(d->watch->path()); });
 }
 
 TranslationsModel::~TranslationsModel() {}
@@ -493,7 +493,9 @@ bool TranslationsModel::selectLanguage(QString key)
 
     if (langPtr->localFileType == FileType::PO) {
         qDebug() << "Loading Application Language File for" << langCode.toLocal8Bit().constData() << "...";
-        auto poTranslator = new POTranslator(FS::PathCombine(d->m_dir.path(), langCode + ".po"));
+        // the compiled catalog is kept out of the translations folder, so writing it doesn't set off the watcher
+        auto poTranslator =
+            new POTranslator(FS::PathCombine(d->m_dir.path(), langCode + ".po"), FS::PathCombine("cache", "translations", langCode + ".poc"));
         if (!poTranslator->isEmpty()) {
             if (!QCoreApplication::installTranslator(poTranslator)) {
                 delete poTranslator;
@@ -15,6 +15,7 @@
 #include "minecraft/PackProfile.h"
 
 #include "modplatform/EnsureMetadataTask.h"
+#include "modplatform/flame/FlameAPI.h"
 #include "modplatform/flame/FlameCheckUpdate.h"
 #include "modplatform/modrinth/ModrinthCheckUpdate.h"
 
@@ -387,6 +388,34 @@ void ModUpdateDialog::appendMod(CheckUpdateTask::UpdatableMod const& info)
 
     ui->modTreeWidget->setItemWidget(changelog, 0, changelog_area);
 
+    // CurseForge changelogs need a request per mod, so they're only fetched once the user looks at them
+    if (info.provider == ModPlatform::ResourceProvider::FLAME && info.changelog.isEmpty() && info.download) {
+        changelog_area->setPlainText(tr("Loading changelog..."));
+
+        const auto& version = info.download->getVersion();
+        const int addon_id = version.addonId.toInt();
+        const int file_id = version.fileId.toInt();
+        auto requested = std::make_shared<bool>(false);
+        connect(ui->modTreeWidget, &QTreeWidget::itemExpanded, changelog_area,
+                [this, changelog_item, changelog_area, addon_id, file_id, requested](QTreeWidgetItem* expanded) {
+                    if (expanded != changelog_item || *requested)
+                        return;
+                    *requested = true;
+
+                    auto response = std::make_shared<QByteArray>();
+                    auto job = FlameAPI().getModFileChangelog(addon_id, file_id, response);
+                    connect(job.get(), &Task::succeeded, changelog_area, [changelog_area, response] {
+                        auto doc = QJsonDocument::fromJson(*response);
+                        changelog_area->setHtml(Json::ensureString(doc.object(), "data"));
+                    });
+                    connect(job.get(), &Task::failed, changelog_area, [this, changelog_area](QString reason) {
+                        changelog_area->setPlainText(tr("Could not load the changelog: %1").arg(reason));
+                    });
+                    m_changelog_jobs.append(job);
+                    job->start();
+                });
+    }
+
     ui->modTreeWidget->addTopLevelItem(item_top);
 }
 
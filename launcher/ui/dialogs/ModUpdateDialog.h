@@ -57,6 +57,7 @@ class ModUpdateDialog final : public ReviewMessageBox {
     QList<std::tuple<Mod*, QString, QUrl>> m_failed_check_update;
 
     QHash<QString, ResourceDownloadTask::Ptr> m_tasks;
+    QList<Task::Ptr> m_changelog_jobs;
     BaseInstance* m_instance;
 
     bool m_no_updates = false;
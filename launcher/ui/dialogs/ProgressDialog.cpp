@@ -256,6 +256,11 @@ void ProgressDialog::changeStepProgress(TaskStepProgress const& task_progress)
 
 void ProgressDialog::changeProgress(qint64 current, qint64 total)
 {
+    // QProgressBar is int based, scale down byte sized progress so it doesn't overflow
+    while (total > std::numeric_limits<int>::max()) {
+        current >>= 10;
+        total >>= 10;
+    }
     ui->globalProgressBar->setMaximum(total);
     ui->globalProgressBar->setValue(current);
 }
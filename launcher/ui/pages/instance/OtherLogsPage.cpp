@@ -154,17 +154,36 @@ void OtherLogsPage::on_btnReload_clicked()
                             "for large files.")
                              .arg(file.fileName()));
         };
-        if (file.size() > (1024ll * 1024ll * 12ll)) {
+        const bool compressed = file.fileName().endsWith(".gz");
+        if (!compressed && file.size() > (1024ll * 1024ll * 12ll)) {
             showTooBig();
             return;
         }
         QString content;
-        if (file.fileName().endsWith(".gz")) {
-            QByteArray temp;
-            if (!GZip::unzip(file.readAll(), temp)) {
+        if (compressed) {
+            // inflated a buffer at a time, so a huge log is given up on without inflating all of it
+            GZipReader uncompressed(&file);
+            if (!uncompressed.open(QIODevice::ReadOnly)) {
                 setPlainText(tr("The file (%1) is not readable.").arg(file.fileName()));
                 return;
             }
+            QByteArray temp;
+            char buffer[64 * 1024];
+            for (;;) {
+                auto length = uncompressed.read(buffer, sizeof(buffer));
+                if (length < 0) {
+                    setPlainText(tr("The file (%1) is not readable.").arg(file.fileName()));
+                    return;
+                }
+                if (length == 0) {
+                    break;
+                }
+                if (temp.size() + length >= 50000000ll) {
+                    showTooBig();
+                    return;
+                }
+                temp.append(buffer, length);
+            }
             content = QString::fromUtf8(temp);
         } else {
             content = QString::fromUtf8(file.readAll());
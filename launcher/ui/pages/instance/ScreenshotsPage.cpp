@@ -40,9 +40,11 @@
 #include "ui_ScreenshotsPage.h"
 
 #include <QClipboard>
+#include <QCryptographicHash>
 #include <QEvent>
 #include <QFileIconProvider>
 #include <QFileSystemModel>
+#include <QImageReader>
 #include <QKeyEvent>
 #include <QLineEdit>
 #include <QMap>
@@ -50,9 +52,11 @@
 #include <QModelIndex>
 #include <QMutableListIterator>
 #include <QPainter>
-#include <QRegularExpression>
+#include <QSaveFile>
 #include <QSet>
 #include <QStyledItemDelegate>
+#include <QThread>
+#include <QUrl>
 
 #include <Application.h>
 
@@ -97,17 +101,21 @@ class ThumbnailRunnable : public QRunnable {
             return;
         if (!m_cache->stale(m_path))
             return;
-        QImage image(m_path);
-        if (image.isNull()) {
-            m_resultEmitter.emitResultsFailed(m_path);
-            qDebug() << "Error loading screenshot: " + m_path + ". Perhaps too large?";
-            return;
+        QImage small = loadStoredThumbnail(info);
+        if (small.isNull()) {
+            // let the decoder scale down while reading, instead of decoding the full size screenshot first
+            QImageReader reader(m_path);
+            QSize size = reader.size();
+            if (size.isValid())
+                reader.setScaledSize(size.scaled(256, 256, Qt::KeepAspectRatio));
+            small = reader.read();
+            if (small.isNull()) {
+                m_resultEmitter.emitResultsFailed(m_path);
+                qDebug() << "Error loading screenshot: " + m_path + ". Perhaps too large?" << reader.errorString();
+                return;
+            }
+            storeThumbnail(info, small);
         }
-        QImage small;
-        if (image.width() > image.height())
-            small = image.scaledToWidth(512).scaledToWidth(256, Qt::SmoothTransformation);
-        else
-            small = image.scaledToHeight(512).scaledToHeight(256, Qt::SmoothTransformation);
         QPoint offset((256 - small.width()) / 2, (256 - small.height()) / 2);
         QImage square(QSize(256, 256), QImage::Format_ARGB32);
         square.fill(Qt::transparent);
@@ -120,6 +128,42 @@ class ThumbnailRunnable : public QRunnable {
         m_cache->add(m_path, icon);
         m_resultEmitter.emitResultsReady(m_path);
     }
+
+    // Thumbnails are stored on disk following the layout of the freedesktop.org thumbnail spec:
+    // cache/thumbnails/large/<md5 of the file URI>.png, with the URI, mtime and size of the original stored in the PNG.
+    static QString thumbnailPath(const QString& uri)
+    {
+        auto hash = QCryptographicHash::hash(uri.toUtf8(), QCryptographicHash::Md5).toHex();
+        return FS::PathCombine(QDir("cache/thumbnails/large").absolutePath(), hash + ".png");
+    }
+    static QImage loadStoredThumbnail(const QFileInfo& info)
+    {
+        auto uri = QUrl::fromLocalFile(info.absoluteFilePath()).toString(QUrl::FullyEncoded);
+        QImageReader reader(thumbnailPath(uri));
+        if (!reader.canRead())
+            return {};
+        if (reader.text("Thumb::URI") != uri || reader.text("Thumb::MTime") != QString::number(info.lastModified().toSecsSinceEpoch()) ||
+            reader.text("Thumb::Size") != QString::number(info.size()))
+            return {};
+        return reader.read();
+    }
+    static void storeThumbnail(const QFileInfo& info, QImage thumbnail)
+    {
+        auto uri = QUrl::fromLocalFile(info.absoluteFilePath()).toString(QUrl::FullyEncoded);
+        thumbnail.setText("Thumb::URI", uri);
+        thumbnail.setText("Thumb::MTime", QString::number(info.lastModified().toSecsSinceEpoch()));
+        thumbnail.setText("Thumb::Size", QString::number(info.size()));
+        thumbnail.setText("Software", BuildConfig.LAUNCHER_DISPLAYNAME);
+
+        auto path = thumbnailPath(uri);
+        if (!FS::ensureFilePathExists(path))
+            return;
+        // write atomically, so other threads never see a partial thumbnail
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly) || !thumbnail.save(&file, "PNG") || !file.commit())
+            qWarning() << "Failed to store thumbnail of" << info.filePath() << "in" << path;
+    }
+
     QString m_path;
     SharedIconCachePtr m_cache;
     ThumbnailingResult m_resultEmitter;
@@ -132,7 +176,8 @@ class FilterModel : public QIdentityProxyModel {
    public:
     explicit FilterModel(QObject* parent = 0) : QIdentityProxyModel(parent)
     {
-        m_thumbnailingPool.setMaxThreadCount(4);
+        // decoding is memory hungry, leave some cores for everything else
+        m_thumbnailingPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
         m_thumbnailCache = std::make_shared<SharedIconCache>();
         m_thumbnailCache->add("placeholder", APPLICATION->getThemedIcon("screenshot-placeholder"));
         connect(&watcher, SIGNAL(fileChanged(QString)), SLOT(fileChanged(QString)));
@@ -149,8 +194,10 @@ class FilterModel : public QIdentityProxyModel {
         if (!model)
             return QVariant();
         if (role == Qt::DisplayRole || role == Qt::EditRole) {
-            QVariant result = sourceModel()->data(mapToSource(proxyIndex), role);
-            return result.toString().remove(QRegularExpression("\\.png$"));
+            QString name = sourceModel()->data(mapToSource(proxyIndex), role).toString();
+            if (name.endsWith(".png"))
+                name.chop(4);
+            return name;
         }
         if (role == Qt::DecorationRole) {
             QVariant result = sourceModel()->data(mapToSource(proxyIndex), QFileSystemModel::FilePathRole);
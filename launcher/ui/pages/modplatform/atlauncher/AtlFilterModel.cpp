@@ -21,6 +21,7 @@
 #include <Version.h>
 #include <modplatform/atlauncher/ATLPackIndex.h>
 
+#include "AtlListModel.h"
 #include "StringUtils.h"
 
 namespace Atl {
@@ -59,31 +60,55 @@ FilterModel::Sorting FilterModel::getCurrentSorting()
 void FilterModel::setSearchTerm(const QString term)
 {
     searchTerm = term.trimmed();
+    updateMatches();
     invalidate();
 }
 
-bool FilterModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
+void FilterModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+    if (m_list)
+        disconnect(m_list, nullptr, this, nullptr);
+    m_list = qobject_cast<ListModel*>(sourceModel);
+    // before the proxy itself hears of the reset, so it filters with the matches of the new packs
+    if (m_list)
+        connect(m_list, &ListModel::modelReset, this, &FilterModel::updateMatches);
+    updateMatches();
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+}
+
+void FilterModel::updateMatches()
+{
+    m_matches.clear();
+    if (!m_list || searchTerm.isEmpty())
+        return;
+
+    m_matches.fill(false, m_list->rowCount({}));
+    for (auto row : m_list->search(searchTerm)) {
+        if (row < m_matches.size())
+            m_matches[row] = true;
+    }
+}
+
+bool FilterModel::filterAcceptsRow(int sourceRow, [[maybe_unused]] const QModelIndex& sourceParent) const
 {
     if (searchTerm.isEmpty()) {
         return true;
     }
-
-    QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
-    ATLauncher::IndexedPack pack = sourceModel()->data(index, Qt::UserRole).value<ATLauncher::IndexedPack>();
-    return pack.name.contains(searchTerm, Qt::CaseInsensitive);
+    return sourceRow < m_matches.size() && m_matches[sourceRow];
 }
 
 bool FilterModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    ATLauncher::IndexedPack leftPack = sourceModel()->data(left, Qt::UserRole).value<ATLauncher::IndexedPack>();
-    ATLauncher::IndexedPack rightPack = sourceModel()->data(right, Qt::UserRole).value<ATLauncher::IndexedPack>();
+    if (!m_list)
+        return false;
+
+    const auto& leftPack = m_list->at(left.row());
+    const auto& rightPack = m_list->at(right.row());
 
     if (currentSorting == ByPopularity) {
         return leftPack.position > rightPack.position;
     } else if (currentSorting == ByGameVersion) {
-        Version lv(leftPack.versions.at(0).minecraft);
-        Version rv(rightPack.versions.at(0).minecraft);
-        return lv < rv;
+        return m_list->gameVersion(left.row()) < m_list->gameVersion(right.row());
     } else if (currentSorting == ByName) {
         return StringUtils::naturalCompare(leftPack.name, rightPack.name, Qt::CaseSensitive) >= 0;
     }
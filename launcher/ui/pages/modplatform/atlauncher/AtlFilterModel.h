@@ -20,6 +20,8 @@
 
 namespace Atl {
 
+class ListModel;
+
 class FilterModel : public QSortFilterProxyModel {
     Q_OBJECT
    public:
@@ -34,15 +36,23 @@ class FilterModel : public QSortFilterProxyModel {
     void setSorting(Sorting sorting);
     Sorting getCurrentSorting();
     void setSearchTerm(QString term);
+    void setSourceModel(QAbstractItemModel* sourceModel) override;
 
    protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
+   private:
+    void updateMatches();
+
    private:
     QMap<QString, Sorting> sortings;
     Sorting currentSorting;
     QString searchTerm;
+
+    ListModel* m_list = nullptr;
+    // whether each source row matches the search term
+    QVector<bool> m_matches;
 };
 
 }  // namespace Atl
@@ -18,11 +18,16 @@
 
 #include <Application.h>
 #include <BuildConfig.h>
-#include <Json.h>
+#include <FileSystem.h>
+
+#include <QFile>
 
 namespace Atl {
 
-ListModel::ListModel(QObject* parent) : QAbstractListModel(parent) {}
+ListModel::ListModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_catalog(FS::PathCombine(APPLICATION->metacache()->getBasePath("ATLauncherPacks"), "packsnew.catalog"))
+{}
 
 ListModel::~ListModel() {}
 
@@ -69,13 +74,14 @@ QVariant ListModel::data(const QModelIndex& index, int role) const
 
 void ListModel::request()
 {
-    beginResetModel();
-    modpacks.clear();
-    endResetModel();
+    // show what we know right away, and only touch the list again if the platform's changed
+    if (!m_catalog.isLoaded() && m_catalog.load())
+        setCatalogPacks();
 
     auto netJob = makeShared<NetJob>("Atl::Request", APPLICATION->network());
     auto url = QString(BuildConfig.ATL_DOWNLOAD_SERVER_URL + "launcher/json/packsnew.json");
-    netJob->addNetAction(Net::Download::makeByteArray(QUrl(url), response));
+    m_entry = APPLICATION->metacache()->resolveEntry("ATLauncherPacks", "packsnew.json");
+    netJob->addNetAction(Net::Download::makeCached(QUrl(url), m_entry));
     jobPtr = netJob;
     jobPtr->start();
 
@@ -87,51 +93,34 @@ void ListModel::requestFinished()
 {
     jobPtr.reset();
 
-    QJsonParseError parse_error;
-    QJsonDocument doc = QJsonDocument::fromJson(*response, &parse_error);
-    if (parse_error.error != QJsonParseError::NoError) {
-        qWarning() << "Error while parsing JSON response from ATL at " << parse_error.offset << " reason: " << parse_error.errorString();
-        qWarning() << *response;
-        return;
-    }
-
-    QList<ATLauncher::IndexedPack> newList;
-
-    auto packs = doc.array();
-    for (auto packRaw : packs) {
-        auto packObj = packRaw.toObject();
-
-        ATLauncher::IndexedPack pack;
+    if (m_catalog.update(m_entry->getFullPath(), m_entry->getMD5Sum(), ATLauncher::parsePackList))
+        setCatalogPacks();
+}
 
-        try {
-            ATLauncher::loadIndexedPack(pack, packObj);
-        } catch (const JSONValidationError& e) {
-            qDebug() << QString::fromUtf8(*response);
-            qWarning() << "Error while reading pack manifest from ATLauncher: " << e.cause();
-            return;
-        }
+void ListModel::requestFailed(QString reason)
+{
+    jobPtr.reset();
+    qWarning() << "Couldn't get the pack list from ATLauncher:" << reason;
 
-        // ignore packs without a published version
-        if (pack.versions.length() == 0)
-            continue;
-        // only display public packs (for now)
-        if (pack.type != ATLauncher::PackType::Public)
-            continue;
-        // ignore "system" packs (Vanilla, Vanilla with Forge, etc)
-        if (pack.system)
-            continue;
-
-        newList.append(pack);
+    // a list we downloaded before is better than none
+    if (!m_catalog.isLoaded() && QFile::exists(m_entry->getFullPath())) {
+        if (m_catalog.update(m_entry->getFullPath(), m_entry->getMD5Sum(), ATLauncher::parsePackList))
+            setCatalogPacks();
     }
-
-    beginInsertRows(QModelIndex(), modpacks.size(), modpacks.size() + newList.size() - 1);
-    modpacks.append(newList);
-    endInsertRows();
 }
 
-void ListModel::requestFailed(QString reason)
+void ListModel::setCatalogPacks()
 {
-    jobPtr.reset();
+    beginResetModel();
+    modpacks.clear();
+    m_gameVersions.clear();
+    modpacks.reserve(m_catalog.packs().size());
+    m_gameVersions.reserve(m_catalog.packs().size());
+    for (auto& pack : m_catalog.packs()) {
+        modpacks.append(ATLauncher::fromCatalogPack(pack));
+        m_gameVersions.append(Version(pack.gameVersion));
+    }
+    endResetModel();
 }
 
 void ListModel::getLogo(const QString& logo, const QString& logoUrl, LogoCallback callback)
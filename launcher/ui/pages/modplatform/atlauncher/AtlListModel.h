@@ -20,6 +20,9 @@
 
 #include <modplatform/atlauncher/ATLPackIndex.h>
 #include <QIcon>
+#include "Version.h"
+#include "modplatform/helpers/PackCatalog.h"
+#include "net/HttpMetaCache.h"
 #include "net/NetJob.h"
 
 namespace Atl {
@@ -40,6 +43,12 @@ class ListModel : public QAbstractListModel {
 
     void request();
 
+    /** The rows of the packs matching the search term, in order. */
+    QVector<int> search(const QString& term) const { return m_catalog.search(term); }
+    const ATLauncher::IndexedPack& at(int row) const { return modpacks.at(row); }
+    /** The game version of the latest version of the pack in that row. */
+    const Version& gameVersion(int row) const { return m_gameVersions.at(row); }
+
     void getLogo(const QString& logo, const QString& logoUrl, LogoCallback callback);
 
    private slots:
@@ -51,9 +60,12 @@ class ListModel : public QAbstractListModel {
 
    private:
     void requestLogo(QString file, QString url);
+    void setCatalogPacks();
 
    private:
     QList<ATLauncher::IndexedPack> modpacks;
+    QVector<Version> m_gameVersions;
+    PackCatalog m_catalog;
 
     QStringList m_failedLogos;
     QStringList m_loadingLogos;
@@ -61,7 +73,7 @@ class ListModel : public QAbstractListModel {
     QMap<QString, LogoCallback> waitingCallbacks;
 
     NetJob::Ptr jobPtr;
-    std::shared_ptr<QByteArray> response = std::make_shared<QByteArray>();
+    MetaEntryPtr m_entry;
 };
 
 }  // namespace Atl
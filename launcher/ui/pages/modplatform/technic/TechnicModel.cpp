@@ -36,11 +36,38 @@
 #include "TechnicModel.h"
 #include "Application.h"
 #include "BuildConfig.h"
+#include "FileSystem.h"
 #include "Json.h"
 
+#include <QDataStream>
 #include <QIcon>
 
-Technic::ListModel::ListModel(QObject* parent) : QAbstractListModel(parent) {}
+static PackCatalog::Pack toCatalogPack(const Technic::Modpack& modpack)
+{
+    PackCatalog::Pack pack;
+    pack.id = modpack.slug;
+    pack.name = modpack.name;
+    pack.author = modpack.author;
+    pack.summary = modpack.description;
+    pack.gameVersion = modpack.minecraftVersion;
+
+    QDataStream out(&pack.data, QIODevice::WriteOnly);
+    out << modpack.slug << modpack.name << modpack.logoUrl << modpack.logoName;
+    return pack;
+}
+
+static Technic::Modpack fromCatalogPack(const PackCatalog::Pack& pack)
+{
+    Technic::Modpack modpack;
+    QDataStream in(pack.data);
+    in >> modpack.slug >> modpack.name >> modpack.logoUrl >> modpack.logoName;
+    modpack.broken = false;
+    return modpack;
+}
+
+Technic::ListModel::ListModel(QObject* parent)
+    : QAbstractListModel(parent), m_catalog(FS::PathCombine(APPLICATION->metacache()->getBasePath("TechnicPacks"), "packs.catalog"))
+{}
 
 Technic::ListModel::~ListModel() {}
 
@@ -90,14 +117,27 @@ void Technic::ListModel::searchWithTerm(const QString& term)
         searchState = ResetRequested;
         return;
     } else {
-        beginResetModel();
-        modpacks.clear();
-        endResetModel();
+        showCatalogMatches();
         searchState = None;
     }
     performSearch();
 }
 
+void Technic::ListModel::showCatalogMatches()
+{
+    if (!m_catalog.isLoaded())
+        m_catalog.load();
+
+    beginResetModel();
+    modpacks.clear();
+    // what Technic shows without a search term, and a link to a pack, are up to Technic
+    if (!currentSearchTerm.isEmpty() && !currentSearchTerm.startsWith("http://") && !currentSearchTerm.startsWith("https://")) {
+        for (auto row : m_catalog.search(currentSearchTerm))
+            modpacks.append(fromCatalogPack(m_catalog.packs().at(row)));
+    }
+    endResetModel();
+}
+
 void Technic::ListModel::performSearch()
 {
     auto netJob = makeShared<NetJob>("Technic::Search", APPLICATION->network());
@@ -196,13 +236,15 @@ void Technic::ListModel::searchRequestFinished()
     }
     searchState = Finished;
 
-    // When you have a Qt build with assertions turned on, proceeding here will abort the application
-    if (newList.size() == 0)
-        return;
+    QList<PackCatalog::Pack> seen;
+    for (auto& pack : newList)
+        seen.append(toCatalogPack(pack));
+    m_catalog.merge(seen);
 
-    beginInsertRows(QModelIndex(), modpacks.size(), modpacks.size() + newList.size() - 1);
-    modpacks.append(newList);
-    endInsertRows();
+    // Technic's results replace the ones we found ourselves
+    beginResetModel();
+    modpacks = newList;
+    endResetModel();
 }
 
 void Technic::ListModel::getLogo(const QString& logo, const QString& logoUrl, Technic::LogoCallback callback)
@@ -219,9 +261,7 @@ void Technic::ListModel::searchRequestFailed()
     jobPtr.reset();
 
     if (searchState == ResetRequested) {
-        beginResetModel();
-        modpacks.clear();
-        endResetModel();
+        showCatalogMatches();
 
         performSearch();
     } else {
@@ -38,6 +38,7 @@
 #include <QModelIndex>
 
 #include "TechnicData.h"
+#include "modplatform/helpers/PackCatalog.h"
 #include "net/NetJob.h"
 
 namespace Technic {
@@ -68,9 +69,12 @@ class ListModel : public QAbstractListModel {
    private:
     void performSearch();
     void requestLogo(QString logo, QString url);
+    void showCatalogMatches();
 
    private:
     QList<Modpack> modpacks;
+    // every pack we've seen in search results, to search without Technic
+    PackCatalog m_catalog;
     QStringList m_failedLogos;
     QStringList m_loadingLogos;
     QMap<QString, QIcon> m_logoMap;
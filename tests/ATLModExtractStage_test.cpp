@@ -0,0 +1,157 @@
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+
+#include <FileSystem.h>
+#include <modplatform/atlauncher/ATLModExtractStage.h>
+#include <modplatform/atlauncher/ATLPackManifest.h>
+
+#include "TestZip.h"
+
+#include <atomic>
+
+class ATLModExtractStageTest : public QObject {
+    Q_OBJECT
+
+    static constexpr int PLAIN_MODS = 300;
+    static constexpr int EXTRACT_MODS = 40;
+    static constexpr int DECOMP_MODS = 40;
+
+    static QJsonObject makeMod(const QString& name, const QString& type)
+    {
+        return { { "name", name },         { "version", "1.0" }, { "url", "https://example.invalid/" + name },
+                 { "file", name + ".jar" }, { "download", "direct" }, { "type", type },
+                 { "client", true } };
+    }
+
+    /* An ATLauncher manifest with a few hundred mods, every kind of them, whose downloads are in the given folder. */
+    static ATLauncher::PackVersion createPack(const QString& downloads)
+    {
+        QJsonArray mods;
+
+        // the configs of every mod, including an outdated copy of the first mod
+        auto configs = makeMod("Configs", "extract");
+        configs["extractTo"] = "root";
+        mods.append(configs);
+
+        for (int i = 0; i < PLAIN_MODS; i++)
+            mods.append(makeMod(QString("mod%1").arg(i), "mods"));
+        for (int i = 0; i < EXTRACT_MODS; i++) {
+            auto extract = makeMod(QString("extract%1").arg(i), "extract");
+            extract["extractTo"] = "mods";
+            extract["extractFolder"] = "%s%payload";
+            mods.append(extract);
+        }
+        for (int i = 0; i < DECOMP_MODS; i++) {
+            auto decomp = makeMod(QString("decomp%1").arg(i), "decomp");
+            decomp["decompType"] = "coremods";
+            decomp["decompFile"] = QString("core%1.jar").arg(i);
+            mods.append(decomp);
+        }
+
+        QJsonObject manifest{ { "version", "1.0.0" }, { "minecraft", "1.12.2" }, { "mods", mods } };
+        ATLauncher::PackVersion version;
+        ATLauncher::loadVersion(version, manifest);
+
+        for (const auto& mod : version.mods) {
+            const auto path = FS::PathCombine(downloads, mod.file);
+            if (mod.type == ATLauncher::ModType::Mods) {
+                FS::write(path, mod.name.toUtf8());
+            } else if (mod.name == "Configs") {
+                QList<QPair<QString, QByteArray>> files{ { "config/", "" }, { "mods/mod0.jar", "outdated" } };
+                for (int i = 0; i < PLAIN_MODS; i++)
+                    files.append({ QString("config/mod%1.cfg").arg(i), QByteArray(64, 'c') });
+                writeZip(path, files);
+            } else if (mod.type == ATLauncher::ModType::Extract) {
+                writeZip(path, { { "payload/" + mod.name + ".jar", mod.name.toUtf8() }, { "ignored.txt", "not extracted" } });
+            } else {
+                writeZip(path, { { mod.decompFile, mod.name.toUtf8() }, { "other.jar", "not decompressed" } });
+            }
+        }
+        return version;
+    }
+
+   private slots:
+    void test_manyMods()
+    {
+        QTemporaryDir tempDir;
+        const auto downloads = FS::PathCombine(tempDir.path(), "downloads");
+        const auto minecraft = FS::PathCombine(tempDir.path(), "minecraft");
+        QVERIFY(FS::ensureFolderPathExists(downloads));
+
+        auto version = createPack(downloads);
+        QCOMPARE(version.mods.size(), 1 + PLAIN_MODS + EXTRACT_MODS + DECOMP_MODS);
+
+        ATLauncher::ModExtractStage stage(minecraft, version.minecraft);
+        for (const auto& mod : version.mods)
+            QVERIFY(stage.addMod(mod, FS::PathCombine(downloads, mod.file)));
+
+        std::atomic<qint64> lastProgress{ 0 }, progressTotal{ -1 };
+        QVERIFY(stage.run([&](qint64 current, qint64 total) {
+            qint64 last = lastProgress;
+            while (current > last && !lastProgress.compare_exchange_weak(last, current)) {
+            }
+            progressTotal = total;
+        }));
+        QVERIFY2(stage.errorString().isEmpty(), qPrintable(stage.errorString()));
+
+        for (int i = 0; i < PLAIN_MODS; i++) {
+            QCOMPARE(readFile(FS::PathCombine(minecraft, "mods", QString("mod%1.jar").arg(i))), QString("mod%1").arg(i).toUtf8());
+            QCOMPARE(readFile(FS::PathCombine(minecraft, "config", QString("mod%1.cfg").arg(i))), QByteArray(64, 'c'));
+        }
+        for (int i = 0; i < EXTRACT_MODS; i++)
+            QCOMPARE(readFile(FS::PathCombine(minecraft, "mods", QString("extract%1.jar").arg(i))), QString("extract%1").arg(i).toUtf8());
+        for (int i = 0; i < DECOMP_MODS; i++)
+            QCOMPARE(readFile(FS::PathCombine(minecraft, "coremods", QString("core%1.jar").arg(i))), QString("decomp%1").arg(i).toUtf8());
+        QVERIFY(!QFile::exists(FS::PathCombine(minecraft, "ignored.txt")));
+        QVERIFY(!QFile::exists(FS::PathCombine(minecraft, "coremods", "other.jar")));
+        QCOMPARE(lastProgress.load(), progressTotal.load());
+
+        // only the configs and the mod they contain an old copy of have to wait for each other
+        QCOMPARE(stage.groups().size(), version.mods.size() - 1);
+        for (const auto& group : stage.groups()) {
+            if (group.size() == 1)
+                continue;
+            QCOMPARE(group.size(), 2);
+            QCOMPARE(stage.operations()[group[0]].kind, ATLauncher::ModExtractStage::Operation::Kind::Extract);
+            QCOMPARE(stage.operations()[group[1]].kind, ATLauncher::ModExtractStage::Operation::Kind::Copy);
+        }
+        // and the mod itself wins over the copy in the configs
+        QCOMPARE(readFile(FS::PathCombine(minecraft, "mods", "mod0.jar")), QByteArray("mod0"));
+    }
+
+    void test_cancel()
+    {
+        QTemporaryDir tempDir;
+        const auto downloads = FS::PathCombine(tempDir.path(), "downloads");
+        const auto minecraft = FS::PathCombine(tempDir.path(), "minecraft");
+        QVERIFY(FS::ensureFolderPathExists(downloads));
+
+        auto version = createPack(downloads);
+        ATLauncher::ModExtractStage stage(minecraft, version.minecraft);
+        for (const auto& mod : version.mods)
+            stage.addMod(mod, FS::PathCombine(downloads, mod.file));
+
+        std::atomic_int files{ 0 };
+        QVERIFY(!stage.run([&files](qint64, qint64) { files++; }, [&files] { return files >= 10; }));
+        QVERIFY(stage.errorString().isEmpty());
+        QVERIFY(files < 10 + QThread::idealThreadCount());
+    }
+
+    void test_missingArchive()
+    {
+        QTemporaryDir tempDir;
+        ATLauncher::ModExtractStage stage(tempDir.path(), "1.12.2");
+        stage.addExtract(FS::PathCombine(tempDir.path(), "missing.zip"), "", tempDir.path());
+        QVERIFY(!stage.run());
+        QVERIFY(!stage.errorString().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(ATLModExtractStageTest)
+
+#include "ATLModExtractStage_test.moc"
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+/* A pack list like ATLauncher's, of `count` packs named after some words. Every tenth pack is one that isn't shown. */
+inline QByteArray makePackList(int count)
+{
+    static const QStringList words{ "sky",    "factory", "tech",  "magic", "block", "ultimate", "vanilla", "plus",
+                                    "origin", "quest",   "craft", "world", "star",  "galaxy",   "island",  "Über" };
+    QJsonArray packs;
+    for (int i = 0; i < count; i++) {
+        auto word = [&](int n) { return words[(i * 7 + n * 13 + i / words.size()) % words.size()]; };
+        QJsonObject pack{
+            { "id", i },
+            { "position", count - i },
+            { "name", QString("%1 %2 %3").arg(word(0), word(1)).arg(i) },
+            { "type", i % 10 == 3 ? "private" : "public" },
+            { "system", i % 10 == 5 },
+            { "description", QString("A %1 pack about %2-%3.").arg(word(2), word(3), word(4)) },
+            { "versions", i % 10 == 7 ? QJsonArray{}
+                                      : QJsonArray{ QJsonObject{ { "version", QString("1.%1").arg(i % 4) },
+                                                                 { "minecraft", QString("1.%1.2").arg(7 + i % 14) } } } },
+        };
+        packs.append(pack);
+    }
+    return QJsonDocument(packs).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,130 @@
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/AssetsUtils.h>
+
+#include "DataDir.h"
+
+class AssetsUtilsTest : public QObject {
+    Q_OBJECT
+
+    // stores the object and returns its hash
+    QString addObject(const QByteArray& data)
+    {
+        auto hash = QString(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex());
+        FS::write(QString("assets/objects/%1/%2").arg(hash.left(2), hash), data);
+        return hash;
+    }
+
+    void writeIndex(const QString& id, const QMap<QString, QByteArray>& files, bool isVirtual, bool storeObjects = true)
+    {
+        QJsonObject objects;
+        for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+            auto hash = storeObjects ? addObject(it.value())
+                                     : QString(QCryptographicHash::hash(it.value(), QCryptographicHash::Sha1).toHex());
+            objects[it.key()] = QJsonObject{ { "hash", hash }, { "size", it.value().size() } };
+        }
+        QJsonObject root{ { "objects", objects } };
+        root[isVirtual ? "virtual" : "map_to_resources"] = true;
+        FS::write(QString("assets/indexes/%1.json").arg(id), QJsonDocument(root).toJson());
+    }
+
+    QByteArray read(const QString& path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+        return file.readAll();
+    }
+
+   private slots:
+    void test_virtual()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        writeIndex("legacy", { { "sounds/a.ogg", "aaa" }, { "sounds/b.ogg", "bbb" }, { "lang/en_US.lang", "lang" } }, true);
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+
+        QCOMPARE(read("assets/virtual/legacy/sounds/a.ogg"), QByteArray("aaa"));
+        QCOMPARE(read("assets/virtual/legacy/lang/en_US.lang"), QByteArray("lang"));
+        QVERIFY(QFile::exists("assets/virtual/legacy/.assets_stamp.json"));
+#if defined(Q_OS_LINUX)
+        // shared with the object store instead of duplicated
+        QCOMPARE(FS::hardLinkCount("assets/virtual/legacy/sounds/a.ogg"), uintmax_t(2));
+#endif
+    }
+
+    void test_unchangedIndexIsSkipped()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        writeIndex("legacy", { { "sounds/a.ogg", "aaa" } }, true);
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+
+        // the stamp says it's all there, so the files aren't looked at again
+        QVERIFY(QFile::remove("assets/virtual/legacy/sounds/a.ogg"));
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+        QVERIFY(!QFile::exists("assets/virtual/legacy/sounds/a.ogg"));
+
+        // without the stamp they are
+        QVERIFY(QFile::remove("assets/virtual/legacy/.assets_stamp.json"));
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+        QCOMPARE(read("assets/virtual/legacy/sounds/a.ogg"), QByteArray("aaa"));
+    }
+
+    void test_indexChange()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        writeIndex("legacy", { { "sounds/a.ogg", "aaa" }, { "sounds/b.ogg", "bbb" } }, true);
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+        // not ours, must survive pruning
+        FS::write("assets/virtual/legacy/user.txt", "mine");
+
+        writeIndex("legacy", { { "sounds/a.ogg", "changed" }, { "sounds/c.ogg", "ccc" } }, true);
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+
+        QCOMPARE(read("assets/virtual/legacy/sounds/a.ogg"), QByteArray("changed"));
+        QCOMPARE(read("assets/virtual/legacy/sounds/c.ogg"), QByteArray("ccc"));
+        QVERIFY(!QFile::exists("assets/virtual/legacy/sounds/b.ogg"));
+        QCOMPARE(read("assets/virtual/legacy/user.txt"), QByteArray("mine"));
+    }
+
+    void test_missingObjectRetried()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        writeIndex("legacy", { { "sounds/a.ogg", "aaa" } }, true, false);
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+        QVERIFY(!QFile::exists("assets/virtual/legacy/sounds/a.ogg"));
+
+        // the stamp is incomplete, so the next launch picks up the object once it's there
+        addObject("aaa");
+        QVERIFY(AssetsUtils::reconstructAssets("legacy", "resources"));
+        QCOMPARE(read("assets/virtual/legacy/sounds/a.ogg"), QByteArray("aaa"));
+    }
+
+    void test_resources()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        writeIndex("pre-1.6", { { "sound/a.ogg", "aaa" } }, false);
+        QVERIFY(AssetsUtils::reconstructAssets("pre-1.6", "instance/resources"));
+
+        QCOMPARE(read("instance/resources/sound/a.ogg"), QByteArray("aaa"));
+        // the instance may change its resources, so they must not share the object
+        QCOMPARE(FS::hardLinkCount("instance/resources/sound/a.ogg"), uintmax_t(1));
+    }
+};
+
+QTEST_GUILESS_MAIN(AssetsUtilsTest)
+
+#include "AssetsUtils_test.moc"
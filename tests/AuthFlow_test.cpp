@@ -0,0 +1,190 @@
+#include <QDateTime>
+#include <QNetworkAccessManager>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+#include <QTimer>
+
+#include <minecraft/auth/AccountTask.h>
+#include <minecraft/auth/AuthRequest.h>
+#include <minecraft/auth/MinecraftAccount.h>
+
+/* Answers the requests of the account detail steps after a short delay, like the real services would. */
+class FakeAuthServer : public QObject {
+    Q_OBJECT
+
+   public:
+    FakeAuthServer()
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, &FakeAuthServer::onNewConnection);
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    QUrl url() const { return QUrl(QString("http://127.0.0.1:%1").arg(m_server.serverPort())); }
+
+    QStringList requests;
+    int inFlight = 0;
+    int maxInFlight = 0;
+
+   private slots:
+    void onNewConnection()
+    {
+        while (auto socket = m_server.nextPendingConnection()) {
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket] { onReadyRead(socket); });
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    }
+
+   private:
+    void onReadyRead(QTcpSocket* socket)
+    {
+        auto& buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        if (!buffer.contains("\r\n\r\n"))
+            return;
+
+        const auto head = buffer.left(buffer.indexOf("\r\n\r\n"));
+        buffer.clear();
+        const auto lines = head.split('\n');
+        const auto path = QString::fromUtf8(lines.first().split(' ').value(1));
+        bool expired = head.contains("Bearer expired");
+        requests.append(path);
+
+        inFlight++;
+        maxInFlight = qMax(maxInFlight, inFlight);
+        QTimer::singleShot(50, socket, [this, socket, path, expired] {
+            inFlight--;
+            respond(socket, path, expired);
+        });
+    }
+
+    void respond(QTcpSocket* socket, const QString& path, bool expired)
+    {
+        int status = 200;
+        QByteArray body;
+        if (path.startsWith("/api.minecraftservices.com/entitlements/license")) {
+            body = R"({"items":[{"name":"product_minecraft"},{"name":"game_minecraft"}]})";
+        } else if (path == "/api.minecraftservices.com/minecraft/profile") {
+            if (expired) {
+                status = 401;
+            } else {
+                body = QString(R"({"id":"profileid","name":"Player","skins":[{"id":"skin","state":"ACTIVE",)"
+                               R"("url":"http://textures.minecraft.net/texture/skin","variant":"CLASSIC"}],"capes":[]})")
+                           .toUtf8();
+            }
+        } else if (path == "/textures.minecraft.net/texture/skin") {
+            body = "skin data";
+        } else {
+            status = 404;
+        }
+
+        QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + (status == 200 ? " OK" : " Error") + "\r\n";
+        response += "Content-Type: application/json\r\n";
+        response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+        response += "Connection: close\r\n\r\n";
+        response += body;
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer m_server;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+};
+
+class AuthFlowTest : public QObject {
+    Q_OBJECT
+
+    MinecraftAccountPtr storedAccount(const QString& token, int secsLeft)
+    {
+        auto account = MinecraftAccount::createBlankMSA();
+        auto data = account->accountData();
+        data->yggdrasilToken.token = token;
+        data->yggdrasilToken.issueInstant = QDateTime::currentDateTimeUtc().addSecs(secsLeft - 24 * 3600);
+        data->yggdrasilToken.notAfter = QDateTime::currentDateTimeUtc().addSecs(secsLeft);
+        data->yggdrasilToken.validity = Katabasis::Validity::Assumed;
+        data->minecraftEntitlement.ownsMinecraft = true;
+        data->minecraftEntitlement.canPlayMinecraft = true;
+        data->minecraftEntitlement.validity = Katabasis::Validity::Assumed;
+        data->minecraftProfile.id = "profileid";
+        data->minecraftProfile.name = "Player";
+        data->minecraftProfile.validity = Katabasis::Validity::Assumed;
+        data->validity_ = Katabasis::Validity::Assumed;
+        return account;
+    }
+
+   private slots:
+    void cleanup() { AuthRequest::redirectForTesting(QUrl(), nullptr); }
+
+    void test_storedTokenTrust()
+    {
+        auto fresh = storedAccount("valid", 20 * 3600);
+        QVERIFY(fresh->canLaunchWithStoredToken());
+        QVERIFY(!fresh->shouldRefresh());
+
+        auto due = storedAccount("valid", 2 * 3600);
+        QVERIFY(!due->canLaunchWithStoredToken());
+        QVERIFY(due->shouldRefresh());
+        QVERIFY(due->refreshDueAt() < QDateTime::currentDateTimeUtc());
+
+        auto unknownOwnership = storedAccount("valid", 20 * 3600);
+        unknownOwnership->accountData()->minecraftEntitlement.validity = Katabasis::Validity::None;
+        QVERIFY(!unknownOwnership->canLaunchWithStoredToken());
+
+        auto broken = storedAccount("valid", 20 * 3600);
+        broken->accountData()->validity_ = Katabasis::Validity::None;
+        QVERIFY(!broken->canLaunchWithStoredToken());
+        QVERIFY(!broken->shouldRefresh());
+
+        QVERIFY(!MinecraftAccount::createOffline("Player")->canLaunchWithStoredToken());
+    }
+
+    void test_validate()
+    {
+        FakeAuthServer server;
+        QNetworkAccessManager network;
+        AuthRequest::redirectForTesting(server.url(), &network);
+
+        auto account = storedAccount("valid", 20 * 3600);
+        auto task = account->validate();
+        QVERIFY(task);
+        QSignalSpy succeeded(task.get(), &Task::succeeded);
+        task->start();
+        QVERIFY(succeeded.wait(10000));
+
+        // entitlements and profile are fetched at the same time, the skin only once the profile is known
+        QCOMPARE(server.requests.size(), 3);
+        QCOMPARE(server.maxInFlight, 2);
+        QCOMPARE(server.requests.last(), QString("/textures.minecraft.net/texture/skin"));
+
+        auto data = account->accountData();
+        QCOMPARE(data->accountState, AccountState::Online);
+        QCOMPARE(data->validity_, Katabasis::Validity::Certain);
+        QCOMPARE(data->minecraftEntitlement.validity, Katabasis::Validity::Certain);
+        QCOMPARE(data->minecraftProfile.skin.data, QByteArray("skin data"));
+        // the stored token is kept as it is
+        QCOMPARE(data->yggdrasilToken.token, QString("valid"));
+    }
+
+    void test_validateRejected()
+    {
+        FakeAuthServer server;
+        QNetworkAccessManager network;
+        AuthRequest::redirectForTesting(server.url(), &network);
+
+        auto account = storedAccount("expired", 20 * 3600);
+        auto task = account->validate();
+        QSignalSpy failed(task.get(), &Task::failed);
+        task->start();
+        QVERIFY(failed.wait(10000));
+
+        // the next launch does a full refresh instead of trusting the token again
+        QCOMPARE(account->accountState(), AccountState::Errored);
+        QVERIFY(!account->isActive());
+        QVERIFY(!account->canLaunchWithStoredToken());
+    }
+};
+
+QTEST_GUILESS_MAIN(AuthFlowTest)
+
+#include "AuthFlow_test.moc"
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QDir>
+#include <QTemporaryDir>
+
+/* A fresh data directory for one test, for code that works relative to the current one. */
+struct DataDir {
+    QTemporaryDir dir;
+    QString previous = QDir::currentPath();
+
+    DataDir() { QDir::setCurrent(dir.path()); }
+    ~DataDir() { QDir::setCurrent(previous); }
+};
@@ -0,0 +1,98 @@
+#include <QSemaphore>
+#include <QTest>
+
+#include <tasks/Executor.h>
+
+#include <atomic>
+
+class ExecutorTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_runReturnsResult()
+    {
+        Executor executor("Test", 2);
+        auto future = executor.run([] { return 42; });
+        future.waitForFinished();
+        QCOMPARE(future.result(), 42);
+
+        // the metrics are updated right after the future finished
+        executor.pool()->waitForDone();
+        auto metrics = executor.metrics();
+        QCOMPARE(metrics.name, QString("Test"));
+        QCOMPARE(metrics.submitted, qint64(1));
+        QCOMPARE(metrics.completed, qint64(1));
+        QCOMPARE(metrics.queued, 0);
+    }
+
+    void test_cancelSkipsQueuedJobs()
+    {
+        Executor executor("Test", 1);
+        QSemaphore started, release;
+        CancellationToken token;
+
+        // occupy the only thread, so the next job stays queued
+        executor.run([&] {
+            started.release();
+            release.acquire();
+        });
+        started.acquire();
+
+        std::atomic_bool ran{ false };
+        auto future = executor.run([&ran] { ran = true; }, Executor::Priority::Normal, token);
+        QCOMPARE(token.pending(), 1);
+        QCOMPARE(executor.metrics().queued, 1);
+
+        token.cancel();
+        release.release();
+        token.waitForFinished();
+
+        QVERIFY(!ran);
+        QVERIFY(future.isCanceled());
+        QCOMPARE(token.pending(), 0);
+        QCOMPARE(executor.metrics().cancelled, qint64(1));
+    }
+
+    void test_ownersAreIsolated()
+    {
+        Executor executor("Test", 2);
+        QSemaphore release;
+        CancellationToken slowOwner, fastOwner;
+
+        executor.run([&] { release.acquire(); }, Executor::Priority::Low, slowOwner);
+        executor.run([] {}, Executor::Priority::Normal, fastOwner);
+
+        // waiting for one owner doesn't wait for the other one's work
+        fastOwner.waitForFinished();
+        QCOMPARE(slowOwner.pending(), 1);
+
+        release.release();
+        slowOwner.waitForFinished();
+    }
+
+    void test_priority()
+    {
+        Executor executor("Test", 1);
+        QSemaphore started, release;
+        QList<int> order;
+
+        executor.run([&] {
+            started.release();
+            release.acquire();
+        });
+        started.acquire();
+
+        // only touched from the single pool thread
+        executor.run([&order] { order.append(0); }, Executor::Priority::Low);
+        executor.run([&order] { order.append(2); }, Executor::Priority::High);
+        executor.run([&order] { order.append(1); }, Executor::Priority::Normal);
+
+        release.release();
+        executor.pool()->waitForDone();
+        QCOMPARE(order, QList<int>({ 2, 1, 0 }));
+    }
+};
+
+QTEST_GUILESS_MAIN(ExecutorTest)
+
+#include "Executor_test.moc"
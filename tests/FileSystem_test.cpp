@@ -353,6 +353,34 @@ class FileSystemTest : public QObject {
         }
     }
 
+    void test_copy_progress()
+    {
+        QString folder = QFINDTESTDATA("testdata/FileSystem/test_folder");
+        QTemporaryDir tempDir;
+        tempDir.setAutoRemove(true);
+
+        QDir target_dir(FS::PathCombine(tempDir.path(), "test_folder"));
+        FS::copy c(folder, target_dir.path());
+
+        // a dry run only enumerates
+        QVERIFY(c(true));
+        int expectedFiles = c.totalCopied();
+        qint64 expectedBytes = c.totalBytes();
+        QVERIFY(expectedFiles > 0);
+        QVERIFY(!target_dir.exists());
+
+        QVERIFY(c());
+
+        QCOMPARE(c.totalCopied(), expectedFiles);
+        QCOMPARE(c.totalBytes(), expectedBytes);
+        QCOMPARE(c.bytesCopied(), expectedBytes);
+        QCOMPARE(QFileInfo(target_dir.filePath("pack.mcmeta")).size(), QFileInfo(FS::PathCombine(folder, "pack.mcmeta")).size());
+
+        // copying on top of existing files fails, like std::filesystem::copy does
+        QVERIFY(!c());
+        QCOMPARE(c.totalFailed(), expectedFiles);
+    }
+
     void test_getDesktop()
     {
         QCOMPARE(FS::getDesktopDir(), QStandardPaths::writableLocation(QStandardPaths::DesktopLocation));
@@ -732,6 +760,42 @@ class FileSystemTest : public QObject {
         f();
     }
 
+    void test_link_tree_max_depth()
+    {
+        QTemporaryDir tempDir;
+        tempDir.setAutoRemove(true);
+
+        // 10 folders of 30 files each
+        QDir src_dir(FS::PathCombine(tempDir.path(), "src"));
+        bool created = true;
+        for (int d = 0; d < 10; d++) {
+            QDir dir(src_dir.filePath(QString("dir%1").arg(d)));
+            created &= dir.mkpath(".");
+            for (int f = 0; f < 30; f++) {
+                QFile file(dir.filePath(QString("file%1.txt").arg(f)));
+                created &= file.open(QFile::WriteOnly);
+            }
+        }
+        QVERIFY(created);
+
+        QString all = FS::PathCombine(tempDir.path(), "all");
+        FS::create_link each(src_dir.path(), all);
+        each.linkRecursively(true).setMaxDepth(-1);
+        QVERIFY(each());
+        QCOMPARE(each.totalLinked(), 300);
+        QVERIFY(!QFileInfo(FS::PathCombine(all, "dir0")).isSymLink());
+        QVERIFY(QFileInfo(FS::PathCombine(all, "dir9", "file29.txt")).isSymLink());
+
+        // with a max depth only the top level folders should be linked
+        QString top = FS::PathCombine(tempDir.path(), "top");
+        FS::create_link lnk(src_dir.path(), top);
+        lnk.linkRecursively(true).setMaxDepth(0);
+        QVERIFY(lnk());
+        QCOMPARE(lnk.totalLinked(), 10);
+        QVERIFY(QFileInfo(FS::PathCombine(top, "dir0")).isSymLink());
+        QVERIFY(QFileInfo::exists(FS::PathCombine(top, "dir9", "file29.txt")));
+    }
+
     void test_path_depth()
     {
         QCOMPARE(FS::pathDepth(""), 0);
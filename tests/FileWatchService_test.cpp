@@ -0,0 +1,239 @@
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+
+#include <FileSystem.h>
+#include <FileWatchService.h>
+#include <RecursiveFileSystemWatcher.h>
+#include <pathmatcher/SimplePrefixMatcher.h>
+
+class FileWatchServiceTest : public QObject {
+    Q_OBJECT
+
+    static FileWatch* watch(FileWatchService& service, const QString& dir, bool recursive)
+    {
+        auto watch = service.watch(dir, recursive, &service);
+        watch->setDebounce(20);
+        return watch;
+    }
+
+    // all the changes reported until nothing happened for a while
+    static QList<FileChange> changes(QSignalSpy& spy, int timeout = 2000)
+    {
+        QList<FileChange> all;
+        if (spy.isEmpty() && !spy.wait(timeout))
+            return all;
+        while (!spy.isEmpty() || spy.wait(200)) {
+            all += spy.takeFirst().at(0).value<QList<FileChange>>();
+        }
+        return all;
+    }
+
+   private slots:
+    void initTestCase() { qRegisterMetaType<QList<FileChange>>("QList<FileChange>"); }
+
+    void test_changes()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FileWatchService service;
+        auto w = watch(service, tempDir.path(), true);
+        QVERIFY(w->isValid());
+        QSignalSpy spy(w, &FileWatch::changed);
+
+        // written right after being created, that's still just a new file
+        FS::write(path("a.txt"), "a");
+        FS::write(path("a.txt"), "aa");
+        QCOMPARE(changes(spy), QList<FileChange>({ { FileChange::Created, path("a.txt"), {} } }));
+
+        FS::write(path("b.txt"), "b");
+        changes(spy);
+        {
+            QFile file(path("b.txt"));
+            QVERIFY(file.open(QFile::Append));
+            file.write("more");
+        }
+        QCOMPARE(changes(spy), QList<FileChange>({ { FileChange::Modified, path("b.txt"), {} } }));
+
+        // saved through a temporary file right after being written to, still one change
+        {
+            QFile file(path("b.txt"));
+            QVERIFY(file.open(QFile::Append));
+            file.write("more");
+        }
+        FS::write(path("b.txt"), "b");
+        QCOMPARE(changes(spy), QList<FileChange>({ { FileChange::Modified, path("b.txt"), {} } }));
+
+        QVERIFY(QFile::remove(path("a.txt")));
+        QCOMPARE(changes(spy), QList<FileChange>({ { FileChange::Removed, path("a.txt"), {} } }));
+
+        // gone again before anyone could have looked at it
+        FS::write(path("c.txt"), "c");
+        QVERIFY(QFile::remove(path("c.txt")));
+        QVERIFY(changes(spy, 500).isEmpty());
+    }
+
+    void test_rename()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FileWatchService service;
+        FS::write(path("old.txt"), "x");
+        auto w = watch(service, tempDir.path(), true);
+        QSignalSpy spy(w, &FileWatch::changed);
+
+        QVERIFY(QFile::rename(path("old.txt"), path("new.txt")));
+        auto renamed = changes(spy);
+#if defined(Q_OS_LINUX)
+        QCOMPARE(renamed, QList<FileChange>({ { FileChange::Renamed, path("new.txt"), path("old.txt") } }));
+#else
+        QVERIFY(renamed.contains({ FileChange::Removed, path("old.txt"), {} }));
+        QVERIFY(renamed.contains({ FileChange::Created, path("new.txt"), {} }));
+#endif
+
+        // moving out of the watched folder is a removal for it
+        FS::ensureFolderPathExists(path("sub"));
+        auto sub = watch(service, path("sub"), false);
+        QSignalSpy subSpy(sub, &FileWatch::changed);
+        FS::write(path("sub/inside.txt"), "x");
+        changes(subSpy);
+        changes(spy);
+        QVERIFY(QFile::rename(path("sub/inside.txt"), path("outside.txt")));
+        QCOMPARE(changes(subSpy), QList<FileChange>({ { FileChange::Removed, path("sub/inside.txt"), {} } }));
+    }
+
+    void test_newDirectories()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FileWatchService service;
+        auto w = watch(service, tempDir.path(), true);
+        QSignalSpy spy(w, &FileWatch::changed);
+
+        // whatever is in a new folder before it's watched is reported too
+        FS::write(path("sub/deeper/file.txt"), "x");
+        auto created = changes(spy);
+        QVERIFY(created.contains({ FileChange::Created, path("sub"), {} }));
+        QVERIFY(created.contains({ FileChange::Created, path("sub/deeper/file.txt"), {} }));
+
+        FS::write(path("sub/deeper/later.txt"), "x");
+        QCOMPARE(changes(spy), QList<FileChange>({ { FileChange::Created, path("sub/deeper/later.txt"), {} } }));
+
+        QVERIFY(QDir(path("sub")).removeRecursively());
+        QVERIFY(changes(spy).contains({ FileChange::Removed, path("sub"), {} }));
+        QCOMPARE(service.watchedDirectories(), 1);
+    }
+
+    void test_nonRecursive()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FileWatchService service;
+        FS::ensureFolderPathExists(path("sub"));
+        auto w = watch(service, tempDir.path(), false);
+        QSignalSpy spy(w, &FileWatch::changed);
+
+        FS::write(path("sub/nested.txt"), "x");
+        FS::write(path("top.txt"), "x");
+        auto seen = changes(spy);
+        QVERIFY(seen.contains({ FileChange::Created, path("top.txt"), {} }));
+        QVERIFY(!seen.contains({ FileChange::Created, path("sub/nested.txt"), {} }));
+    }
+
+    void test_shared()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FileWatchService service;
+        FS::ensureFolderPathExists(path("mods"));
+        auto instance = watch(service, tempDir.path(), true);
+        auto mods = watch(service, path("mods"), false);
+        // the folders are only registered once
+        QCOMPARE(service.watchedDirectories(), 2);
+
+        QSignalSpy instanceSpy(instance, &FileWatch::changed);
+        QSignalSpy modsSpy(mods, &FileWatch::changed);
+        FS::write(path("mods/mod.jar"), "x");
+        QCOMPARE(changes(modsSpy), QList<FileChange>({ { FileChange::Created, path("mods/mod.jar"), {} } }));
+        QCOMPARE(changes(instanceSpy), QList<FileChange>({ { FileChange::Created, path("mods/mod.jar"), {} } }));
+
+        delete instance;
+        QCOMPARE(service.watchedDirectories(), 1);
+        FS::write(path("mods/other.jar"), "x");
+        QCOMPARE(changes(modsSpy), QList<FileChange>({ { FileChange::Created, path("mods/other.jar"), {} } }));
+
+        delete mods;
+        QCOMPARE(service.watchedDirectories(), 0);
+    }
+
+    void test_recursiveFileSystemWatcher()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FS::write(path("logs/latest.log"), "x");
+        RecursiveFileSystemWatcher watcher(this);
+        watcher.setMatcher(std::make_shared<SimplePrefixMatcher>(""));
+        watcher.setRootDir(QDir(tempDir.path()));
+        QCOMPARE(watcher.files(), QStringList({ "logs/latest.log" }));
+
+        watcher.enable();
+        QSignalSpy spy(&watcher, &RecursiveFileSystemWatcher::filesChanged);
+        FS::write(path("logs/debug.log"), "x");
+        QVERIFY(spy.wait(2000));
+        QCOMPARE(watcher.files(), QStringList({ "logs/latest.log", "logs/debug.log" }));
+
+        QVERIFY(QDir(tempDir.path()).rename("logs", "old-logs"));
+        QTRY_COMPARE(watcher.files().size(), 2);
+        auto files = watcher.files();
+        std::sort(files.begin(), files.end());
+        QCOMPARE(files, QStringList({ "old-logs/debug.log", "old-logs/latest.log" }));
+        watcher.disable();
+    }
+
+    // a script of file operations, every file that's left must be reported as created exactly once
+    void test_churn()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+        FileWatchService service;
+        auto w = watch(service, tempDir.path(), true);
+        QSignalSpy spy(w, &FileWatch::changed);
+
+        for (int round = 0; round < 3; round++) {
+            const auto dir = path(QString("round%1").arg(round));
+            for (int i = 0; i < 50; i++) {
+                FS::write(FS::PathCombine(dir, QString("file%1.txt").arg(i)), "content");
+            }
+            for (int i = 0; i < 50; i += 2) {
+                FS::write(FS::PathCombine(dir, QString("file%1.txt").arg(i)), "changed");
+            }
+            for (int i = 0; i < 50; i += 4) {
+                QFile::remove(FS::PathCombine(dir, QString("file%1.txt").arg(i)));
+            }
+
+            QHash<QString, int> created;
+            for (auto& change : changes(spy)) {
+                if (change.kind == FileChange::Created && change.path.endsWith(".txt"))
+                    created[change.path]++;
+            }
+            QCOMPARE(created.size(), 37);
+            QVERIFY(!created.contains(FS::PathCombine(dir, "file0.txt")));
+            for (auto count : created) {
+                QCOMPARE(count, 1);
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(FileWatchServiceTest)
+
+#include "FileWatchService_test.moc"
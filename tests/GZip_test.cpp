@@ -1,3 +1,4 @@
+#include <QBuffer>
 #include <QTest>
 
 #include <GZip.h>
@@ -45,6 +46,84 @@ class GZipTest : public QObject {
             fib(prev, cur);
         } while (cur < size);
     }
+
+    void test_Streaming()
+    {
+        QByteArray text;
+        for (int i = 0; i < 200000; i++) {
+            text += "[12:00:00] [Render thread/INFO]: Line " + QByteArray::number(i) + "\n";
+        }
+
+        // written in odd pieces, the stream is the same as zipped in one go
+        QByteArray compressed;
+        {
+            QBuffer target(&compressed);
+            GZipWriter writer(&target);
+            QVERIFY(writer.open(QIODevice::WriteOnly));
+            for (int offset = 0; offset < text.size(); offset += 7777) {
+                QCOMPARE(writer.write(text.mid(offset, 7777)), qMin<qint64>(7777, text.size() - offset));
+            }
+            QVERIFY(writer.finish());
+        }
+        QByteArray unzipped;
+        QVERIFY(GZip::unzip(compressed, unzipped));
+        QCOMPARE(unzipped, text);
+
+        // and read back in odd pieces too
+        QBuffer source(&compressed);
+        GZipReader reader(&source);
+        QVERIFY(reader.open(QIODevice::ReadOnly));
+        QByteArray read;
+        char buffer[1000];
+        qint64 length;
+        while ((length = reader.read(buffer, sizeof(buffer))) > 0) {
+            read.append(buffer, length);
+        }
+        QCOMPARE(length, 0);
+        QVERIFY(reader.atEnd());
+        QCOMPARE(read, text);
+
+        // concatenated members are one stream
+        QByteArray second;
+        QVERIFY(GZip::zip("and more", second));
+        auto concatenated = compressed + second;
+        QVERIFY(GZip::unzip(concatenated, unzipped));
+        QCOMPARE(unzipped, text + "and more");
+        QBuffer concatenatedSource(&concatenated);
+        GZipReader concatenatedReader(&concatenatedSource);
+        QVERIFY(concatenatedReader.open(QIODevice::ReadOnly));
+        QCOMPARE(concatenatedReader.readAll(), text + "and more");
+    }
+
+    void test_Corrupt()
+    {
+        QByteArray compressed;
+        QVERIFY(GZip::zip(QByteArray(100000, 'x') + QByteArray::number(12345), compressed));
+
+        auto truncated = compressed.left(compressed.size() - 10);
+        QByteArray unzipped;
+        QVERIFY(!GZip::unzip(truncated, unzipped));
+        QBuffer truncatedSource(&truncated);
+        GZipReader truncatedReader(&truncatedSource);
+        QVERIFY(truncatedReader.open(QIODevice::ReadOnly));
+        truncatedReader.readAll();
+        char byte;
+        QCOMPARE(truncatedReader.read(&byte, 1), -1);
+
+        QByteArray garbage("not compressed at all");
+        QBuffer garbageSource(&garbage);
+        GZipReader garbageReader(&garbageSource);
+        QVERIFY(garbageReader.open(QIODevice::ReadOnly));
+        char buffer[16];
+        QCOMPARE(garbageReader.read(buffer, sizeof(buffer)), -1);
+
+        QByteArray empty;
+        QBuffer emptySource(&empty);
+        GZipReader emptyReader(&emptySource);
+        QVERIFY(emptyReader.open(QIODevice::ReadOnly));
+        QVERIFY(emptyReader.readAll().isEmpty());
+        QVERIFY(emptyReader.atEnd());
+    }
 };
 
 QTEST_GUILESS_MAIN(GZipTest)
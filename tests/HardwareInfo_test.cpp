@@ -0,0 +1,159 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <HardwareInfo.h>
+
+class HardwareInfoTest : public QObject {
+    Q_OBJECT
+
+    static void write(const QString& root, const QString& path, const QByteArray& data) { FS::write(FS::PathCombine(root, path), data); }
+
+    static void addCard(const QString& root,
+                        const QString& card,
+                        const QByteArray& vendor,
+                        const QByteArray& device,
+                        const QByteArray& driver,
+                        const QByteArray& slot)
+    {
+        write(root, card + "/device/vendor", vendor + "\n");
+        write(root, card + "/device/device", device + "\n");
+        write(root, card + "/device/subsystem_vendor", "0x1043\n");
+        write(root, card + "/device/subsystem_device", "0x8866\n");
+        write(root, card + "/device/uevent", "DRIVER=" + driver + "\nPCI_CLASS=30000\nPCI_SLOT_NAME=" + slot + "\n");
+    }
+
+    /* A machine with an AMD and an NVIDIA card, as seen from /proc and /sys. */
+    static void makeSystem(const QString& root)
+    {
+        write(root, "proc/cpuinfo",
+              "processor\t: 0\nvendor_id\t: AuthenticAMD\nmodel name\t: AMD Ryzen 7 5800X 8-Core Processor\n\n"
+              "processor\t: 1\nmodel name\t: AMD Ryzen 7 5800X 8-Core Processor\n");
+        write(root, "proc/sys/kernel/osrelease", "6.1.0-test\n");
+
+        addCard(root, "sys/class/drm/card0", "0x1002", "0x73bf", "amdgpu", "0000:03:00.0");
+        addCard(root, "sys/class/drm/card1", "0x10de", "0x2484", "nvidia", "0000:04:00.0");
+        // a connector of card0, which is not another GPU
+        write(root, "sys/class/drm/card0-HDMI-A-1/status", "connected\n");
+        write(root, "sys/module/nvidia/version", "535.104.05\n");
+
+        write(root, "usr/share/hwdata/pci.ids",
+              "# comment\n"
+              "1002  Advanced Micro Devices, Inc. [AMD/ATI]\n"
+              "\t73bf  Navi 21 [Radeon RX 6800/6800 XT / 6900 XT]\n"
+              "\t\t1043 8866  Radeon RX 6900 XT\n"
+              "\t73ff  Navi 23 [Radeon RX 6600/6600 XT/6600M]\n"
+              "10de  NVIDIA Corporation\n"
+              "\t2484  GA104 [GeForce RTX 3070]\n"
+              "1043  ASUSTeK Computer Inc.\n"
+              "C 03  Display controller\n"
+              "\t00  VGA compatible controller\n");
+    }
+
+   private slots:
+    void test_readSysfs()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto root = tempDir.path();
+        makeSystem(root);
+
+        auto report = HardwareInfo::readSysfs(root);
+        QCOMPARE(report.kernelVersion, QString("6.1.0-test"));
+        QCOMPARE(report.cpuModel, QString("AMD Ryzen 7 5800X 8-Core Processor"));
+        QCOMPARE(report.gpus.size(), 2);
+
+        auto amd = report.gpus.at(0);
+        QCOMPARE(amd.vendorId, QString("1002"));
+        QCOMPARE(amd.deviceId, QString("73bf"));
+        QCOMPARE(amd.subsystemVendorId, QString("1043"));
+        QCOMPARE(amd.driver, QString("amdgpu"));
+        QCOMPARE(amd.slot, QString("0000:03:00.0"));
+        QVERIFY(amd.driverVersion.isEmpty());
+        QVERIFY(amd.deviceName.isEmpty());
+
+        QCOMPARE(report.gpus.at(1).driverVersion, QString("535.104.05"));
+    }
+
+    void test_resolveNames()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto root = tempDir.path();
+        makeSystem(root);
+
+        auto report = HardwareInfo::readSysfs(root);
+        HardwareInfo::resolveNames(report, root);
+
+        QCOMPARE(report.gpus.at(0).vendorName, QString("Advanced Micro Devices, Inc. [AMD/ATI]"));
+        QCOMPARE(report.gpus.at(0).deviceName, QString("Navi 21 [Radeon RX 6800/6800 XT / 6900 XT]"));
+        QCOMPARE(report.gpus.at(0).subsystemName, QString("Radeon RX 6900 XT"));
+        QCOMPARE(report.gpus.at(1).deviceName, QString("GA104 [GeForce RTX 3070]"));
+        QVERIFY(report.gpus.at(1).subsystemName.isEmpty());
+
+        QStringList expected{ "AMD Ryzen 7 5800X 8-Core Processor",
+                              "Advanced Micro Devices, Inc. [AMD/ATI] Navi 21 [Radeon RX 6800/6800 XT / 6900 XT] [1002:73bf]",
+                              "\tSubsystem: Radeon RX 6900 XT",
+                              "\tKernel driver in use: amdgpu",
+                              "NVIDIA Corporation GA104 [GeForce RTX 3070] [10de:2484]",
+                              "\tKernel driver in use: nvidia 535.104.05" };
+        QCOMPARE(report.logLines(), expected);
+    }
+
+    void test_unknownDevice()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto root = tempDir.path();
+        makeSystem(root);
+
+        write(root, "sys/class/drm/card1/device/device", "0xffff\n");
+        auto report = HardwareInfo::readSysfs(root);
+        HardwareInfo::resolveNames(report, root);
+        QCOMPARE(report.logLines().at(4), QString("NVIDIA Corporation Device ffff [10de:ffff]"));
+    }
+
+    void test_cache()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto root = tempDir.path();
+        makeSystem(root);
+
+        const auto cacheFile = FS::PathCombine(root, "cache/hardware.json");
+        auto first = HardwareInfo::probe(root, cacheFile);
+        QVERIFY(QFile::exists(cacheFile));
+        QCOMPARE(first.gpus.at(1).deviceName, QString("GA104 [GeForce RTX 3070]"));
+
+        // the database isn't read again while the hardware stays the same
+        QFile::remove(FS::PathCombine(root, "usr/share/hwdata/pci.ids"));
+        auto cached = HardwareInfo::probe(root, cacheFile);
+        QCOMPARE(cached.logLines(), first.logLines());
+
+        // but a driver update makes it look again
+        write(root, "sys/module/nvidia/version", "550.54.14\n");
+        auto updated = HardwareInfo::probe(root, cacheFile);
+        QCOMPARE(updated.gpus.at(1).driverVersion, QString("550.54.14"));
+        QVERIFY(updated.gpus.at(1).deviceName.isEmpty());
+    }
+
+    void test_provider()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto root = tempDir.path();
+        makeSystem(root);
+
+        HardwareInfo::Provider provider(root, QString());
+        provider.prefetch();
+        auto report = provider.report();
+        report.waitForFinished();
+#if defined(Q_OS_LINUX)
+        QCOMPARE(report.result().gpus.size(), 2);
+#endif
+    }
+};
+
+QTEST_GUILESS_MAIN(HardwareInfoTest)
+
+#include "HardwareInfo_test.moc"
@@ -0,0 +1,73 @@
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <modplatform/helpers/HashCache.h>
+#include <modplatform/helpers/HashUtils.h>
+
+class HashCacheTest : public QObject {
+    Q_OBJECT
+
+    static void writeFile(const QString& path, const QByteArray& data)
+    {
+        QFile file(path);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write(data);
+    }
+
+   private slots:
+    void test_reuseUntilChanged()
+    {
+        QTemporaryDir tempDir;
+        auto file = QDir(tempDir.path()).filePath("mod.jar");
+        writeFile(file, "some mod contents");
+
+        Hashing::HashCache cache(QDir(tempDir.path()).filePath("hashes.json"));
+        QVERIFY(cache.get(file, "murmur2").isNull());
+
+        auto fingerprint = Hashing::flameFingerprint(file);
+        QVERIFY(!fingerprint.isEmpty());
+        cache.put(file, "murmur2", fingerprint);
+        QCOMPARE(cache.get(file, "murmur2"), fingerprint);
+        QVERIFY(cache.get(file, "sha1").isNull());
+
+        // a different size invalidates every hash of the file
+        writeFile(file, "some other mod contents");
+        QVERIFY(cache.get(file, "murmur2").isNull());
+    }
+
+    void test_persist()
+    {
+        QTemporaryDir tempDir;
+        auto file = QDir(tempDir.path()).filePath("pack.zip");
+        auto index = QDir(tempDir.path()).filePath("hashes.json");
+        writeFile(file, "resource pack");
+
+        {
+            Hashing::HashCache cache(index);
+            cache.put(file, "murmur2", "1234");
+            cache.SaveNow();
+        }
+
+        Hashing::HashCache cache(index);
+        cache.Load();
+        QCOMPARE(cache.get(file, "murmur2"), QString("1234"));
+    }
+
+    void test_flameFingerprintIgnoresWhitespace()
+    {
+        QTemporaryDir tempDir;
+        auto a = QDir(tempDir.path()).filePath("a");
+        auto b = QDir(tempDir.path()).filePath("b");
+        writeFile(a, "abc def\r\n\tghi");
+        writeFile(b, "abcdefghi");
+
+        QCOMPARE(Hashing::flameFingerprint(a), Hashing::flameFingerprint(b));
+        QVERIFY(Hashing::flameFingerprint(QDir(tempDir.path()).filePath("missing")).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(HashCacheTest)
+
+#include "HashCache_test.moc"
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+#include <FileSystem.h>
+#include <java/JavaRuntimeInstallTask.h>
+
+inline QString sha1(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+}
+
+/* A runtime laid out like Mojang's, on disk next to its manifest. The first `shared` files are the same in every
+ * runtime, like the classes of runtimes that are only a patch release apart.
+ */
+inline QJsonObject makeRuntime(const QString& mirror, const QString& component, const QString& version, int count, int shared)
+{
+    auto folder = FS::PathCombine(mirror, component);
+    QJsonObject files;
+    auto addFile = [&](const QString& path, const QByteArray& data, bool executable) {
+        auto file = FS::PathCombine(folder, path);
+        FS::write(file, data);
+        QJsonObject raw{ { "sha1", sha1(data) }, { "size", data.size() }, { "url", QUrl::fromLocalFile(file).toString() } };
+        QJsonObject downloads{ { "raw", raw } };
+        files.insert(path, QJsonObject{ { "type", "file" }, { "executable", executable }, { "downloads", downloads } });
+    };
+
+    files.insert("bin", QJsonObject{ { "type", "directory" } });
+    addFile("bin/java", "java " + version.toUtf8(), true);
+    addFile("bin/javaw.exe", "javaw " + version.toUtf8(), true);
+    addFile("lib/jspawnhelper", "helper", true);
+    for (int i = 0; i < count; i++) {
+        QByteArray data = i < shared ? "class " + QByteArray::number(i) : version.toUtf8() + " class " + QByteArray::number(i);
+        addFile(QString("lib/modules/%1/Class%2.class").arg(i % 20).arg(i), data.repeated(10), false);
+    }
+    files.insert("legal/java.base", QJsonObject{ { "type", "link" }, { "target", "../lib" } });
+
+    auto manifest = QJsonDocument(QJsonObject{ { "files", files } }).toJson(QJsonDocument::Compact);
+    auto manifestPath = FS::PathCombine(mirror, component + ".json");
+    FS::write(manifestPath, manifest);
+    auto url = QUrl::fromLocalFile(manifestPath).toString();
+    QJsonObject download{ { "sha1", sha1(manifest) }, { "size", manifest.size() }, { "url", url } };
+    return QJsonObject{
+        { "availability", QJsonObject{ { "group", 1 }, { "progress", 100 } } },
+        { "manifest", download },
+        { "version", QJsonObject{ { "name", version }, { "released", "2023-08-24T14:28:03+00:00" } } },
+    };
+}
+
+inline bool install(const QUrl& index, const QString& root, const QString& component, QString* javaPath = nullptr)
+{
+    JavaRuntimeInstallTask task(index, component, "linux", root, nullptr);
+    task.start();
+    if (!task.isFinished())
+        return false;
+    if (javaPath)
+        *javaPath = task.javaPath();
+    return task.wasSuccessful();
+}
@@ -0,0 +1,204 @@
+#include <QDirIterator>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <Json.h>
+#include <java/JavaRuntime.h>
+#include <java/JavaRuntimeInstallTask.h>
+
+#include "JavaRuntimeMirror.h"
+
+class JavaRuntimeTest : public QObject {
+    Q_OBJECT
+
+    /* The index of a mirror with a couple of runtimes, two of which are almost the same. */
+    static QUrl makeIndex(const QString& mirror)
+    {
+        QJsonObject runtimes{
+            { "java-runtime-gamma", QJsonArray{ makeRuntime(mirror, "java-runtime-gamma", "17.0.8", 300, 270) } },
+            { "java-runtime-gamma-snapshot", QJsonArray{ makeRuntime(mirror, "java-runtime-gamma-snapshot", "17.0.9", 300, 270) } },
+            { "jre-legacy", QJsonArray{ makeRuntime(mirror, "jre-legacy", "8u51", 100, 0) } },
+            { "minecraft-java-exe", QJsonArray{} },
+        };
+        auto index = FS::PathCombine(mirror, "all.json");
+        FS::write(index, QJsonDocument(QJsonObject{ { "linux", runtimes } }).toJson());
+        return QUrl::fromLocalFile(index);
+    }
+
+    static QStringList objects(const QString& root)
+    {
+        QStringList objects;
+        QDirIterator it(FS::PathCombine(root, "objects"), QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            objects.append(it.next());
+        objects.sort();
+        return objects;
+    }
+
+   private slots:
+    void test_install()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto mirror = FS::PathCombine(tempDir.path(), "mirror");
+        const auto root = FS::PathCombine(tempDir.path(), "java");
+        const auto index = makeIndex(mirror);
+
+        QString javaPath;
+        QVERIFY(install(index, root, "java-runtime-gamma", &javaPath));
+
+        auto runtime = FS::PathCombine(root, "java-runtime-gamma");
+        QCOMPARE(FS::read(FS::PathCombine(runtime, "lib/modules/5/Class5.class")), QByteArray("class 5").repeated(10));
+        QCOMPARE(FS::read(FS::PathCombine(runtime, "lib/modules/19/Class299.class")), QByteArray("17.0.8 class 299").repeated(10));
+#ifdef Q_OS_WIN
+        QCOMPARE(javaPath, FS::PathCombine(runtime, "bin/javaw.exe"));
+#else
+        QCOMPARE(javaPath, FS::PathCombine(runtime, "bin/java"));
+        QVERIFY(QFileInfo(javaPath).isExecutable());
+        QVERIFY(!QFileInfo(FS::PathCombine(runtime, "lib/modules/5/Class5.class")).isExecutable());
+        QVERIFY(QFileInfo(FS::PathCombine(runtime, "legal/java.base")).isSymLink());
+#endif
+
+        // it's known without probing the Java
+        auto installed = JavaRuntime::installed(root);
+        QCOMPARE(installed.size(), 1);
+        QCOMPARE(installed.first()->path, javaPath);
+        QCOMPARE(installed.first()->id.toString(), QString("17.0.8"));
+        QCOMPARE(installed.first()->arch, QString("amd64"));
+
+        auto result = JavaRuntime::checkResultFor(javaPath);
+        QVERIFY(result.has_value());
+        QCOMPARE(result->validity, JavaCheckResult::Validity::Valid);
+        QCOMPARE(result->javaVersion.toString(), QString("17.0.8"));
+        QCOMPARE(result->mojangPlatform, QString("64"));
+        QVERIFY(!JavaRuntime::checkResultFor(FS::PathCombine(runtime, "lib/jspawnhelper")).has_value());
+        QVERIFY(!JavaRuntime::checkResultFor(FS::PathCombine(mirror, "java-runtime-gamma/bin/java")).has_value());
+
+        // Java 8 calls itself differently
+        QVERIFY(install(index, root, "jre-legacy", &javaPath));
+        QCOMPARE(JavaRuntime::checkResultFor(javaPath)->javaVersion.toString(), QString("1.8.0_51"));
+    }
+
+    void test_deduplicated()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto mirror = FS::PathCombine(tempDir.path(), "mirror");
+        const auto root = FS::PathCombine(tempDir.path(), "java");
+        const auto index = makeIndex(mirror);
+
+        QVERIFY(install(index, root, "java-runtime-gamma"));
+        QVERIFY(install(index, root, "java-runtime-gamma-snapshot"));
+
+        // 270 classes are shared, the rest and the binaries aren't
+        QCOMPARE(objects(root).size(), 270 + 2 * 30 + 2 * 2 + 1);
+
+        JavaRuntime::Store store(root);
+        auto object = store.objectPath(sha1(QByteArray("class 5").repeated(10)));
+        QCOMPARE(FS::read(FS::PathCombine(root, "java-runtime-gamma-snapshot/lib/modules/5/Class5.class")), FS::read(object));
+#ifndef Q_OS_WIN
+        // the store and both runtimes
+        QCOMPARE(int(FS::hardLinkCount(object)), 3);
+#endif
+    }
+
+    void test_reinstall()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto mirror = FS::PathCombine(tempDir.path(), "mirror");
+        const auto root = FS::PathCombine(tempDir.path(), "java");
+        const auto index = makeIndex(mirror);
+
+        QVERIFY(install(index, root, "java-runtime-gamma"));
+        auto before = objects(root);
+
+        // everything the runtime needs is in the store already
+        for (auto folder : { "java-runtime-gamma/bin", "java-runtime-gamma/lib" }) {
+            QVERIFY(FS::deletePath(FS::PathCombine(mirror, folder)));
+        }
+        QVERIFY(QFile::remove(FS::PathCombine(root, "java-runtime-gamma/lib/modules/0/Class0.class")));
+        QVERIFY(install(index, root, "java-runtime-gamma"));
+        QCOMPARE(objects(root), before);
+        QVERIFY(QFile::exists(FS::PathCombine(root, "java-runtime-gamma/lib/modules/0/Class0.class")));
+        QCOMPARE(JavaRuntime::installed(root).size(), 1);
+        QVERIFY(!QFile::exists(FS::PathCombine(root, "java-runtime-gamma.assembling")));
+    }
+
+    void test_corrupted()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto mirror = FS::PathCombine(tempDir.path(), "mirror");
+        const auto root = FS::PathCombine(tempDir.path(), "java");
+        const auto index = makeIndex(mirror);
+
+        FS::write(FS::PathCombine(mirror, "java-runtime-gamma/lib/modules/7/Class7.class"), "not what the manifest says");
+        QVERIFY(!install(index, root, "java-runtime-gamma"));
+        QVERIFY(!QFile::exists(FS::PathCombine(root, "java-runtime-gamma")));
+        QVERIFY(!JavaRuntime::Store(root).contains(sha1(QByteArray("class 7").repeated(10))));
+        QVERIFY(JavaRuntime::installed(root).isEmpty());
+    }
+
+    void test_unavailable()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto mirror = FS::PathCombine(tempDir.path(), "mirror");
+        const auto root = FS::PathCombine(tempDir.path(), "java");
+        const auto index = makeIndex(mirror);
+
+        QVERIFY(!install(index, root, "minecraft-java-exe"));
+        QVERIFY(!install(index, root, "java-runtime-omega"));
+
+        auto data = FS::read(index.toLocalFile());
+        QVERIFY(!JavaRuntime::findRelease(data, "mac-os", "java-runtime-gamma").has_value());
+        QCOMPARE(JavaRuntime::findRelease(data, "linux", "java-runtime-gamma")->version, QString("17.0.8"));
+
+        // a manifest can't put files outside of the runtime
+        QVERIFY_EXCEPTION_THROWN(JavaRuntime::parseManifest(R"({"files": {"../escape": {"type": "directory"}}})"), JSONValidationError);
+        static const QByteArray badSha1 =
+            R"({"files": {"bin/java": {"type": "file", "downloads": {"raw": {"sha1": "../../x", "url": "x"}}}}})";
+        QVERIFY_EXCEPTION_THROWN(JavaRuntime::parseManifest(badSha1), JSONValidationError);
+    }
+
+    void test_links_data()
+    {
+        QTest::addColumn<QByteArray>("manifest");
+        QTest::addColumn<bool>("valid");
+        auto manifest = [](const QByteArray& files) { return "{\"files\": {" + files + "}}"; };
+        static const QByteArray file =
+            R"({"type": "file", "downloads": {"raw": {"sha1": "0123456789abcdef0123456789abcdef01234567", "url": "x"}}})";
+
+        QTest::addRow("inside") << manifest(R"("legal/java.base": {"type": "link", "target": "../lib/./modules"})") << true;
+        QTest::addRow("absolute") << manifest(R"("lib": {"type": "link", "target": "/usr/lib"})") << false;
+        QTest::addRow("drive") << manifest(R"("lib": {"type": "link", "target": "C:\\Windows"})") << false;
+        QTest::addRow("up") << manifest(R"("legal/java.base": {"type": "link", "target": "../../lib"})") << false;
+        // the link it goes through points to the top, so going up from there is outside
+        QTest::addRow("up through a link")
+            << manifest(R"("top": {"type": "link", "target": "."}, "x": {"type": "link", "target": "top/.."})") << false;
+        QTest::addRow("directory in a link") << manifest(R"("x": {"type": "link", "target": "lib"}, "x/y": {"type": "directory"})")
+                                             << false;
+        QTest::addRow("file in a link") << manifest(R"("x": {"type": "link", "target": "lib"}, "x/y/java": )" + file) << false;
+        QTest::addRow("twice") << manifest(R"("x": {"type": "link", "target": "lib"}, "x/": {"type": "directory"})") << false;
+    }
+
+    void test_links()
+    {
+        QFETCH(QByteArray, manifest);
+        QFETCH(bool, valid);
+        if (valid) {
+            QCOMPARE(JavaRuntime::parseManifest(manifest).size(), 1);
+        } else {
+            QVERIFY_EXCEPTION_THROWN(JavaRuntime::parseManifest(manifest), JSONValidationError);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(JavaRuntimeTest)
+
+#include "JavaRuntime_test.moc"
@@ -0,0 +1,101 @@
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <thread>
+#include <vector>
+
+#include <LogSink.h>
+
+class LogSinkTest : public QObject {
+    Q_OBJECT
+
+    static int countLines(const QString& path)
+    {
+        QFile file(path);
+        if (!file.open(QFile::ReadOnly))
+            return -1;
+        return file.readAll().count('\n');
+    }
+
+   private slots:
+    void test_concurrentWriters()
+    {
+        QTemporaryDir tempDir;
+        auto pattern = QDir(tempDir.path()).filePath("test-%0.log");
+
+        LogSink sink(pattern);
+        QVERIFY(sink.open());
+
+        const int threads = 8;
+        const int perThread = 5000;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < threads; t++) {
+            writers.emplace_back([&sink, t] {
+                for (int i = 0; i < perThread; i++)
+                    sink.write(QString("thread %1 message %2\n").arg(t).arg(i));
+            });
+        }
+        for (auto& writer : writers)
+            writer.join();
+        sink.shutdown();
+
+        QCOMPARE(sink.droppedMessages(), 0ull);
+        QCOMPARE(countLines(pattern.arg(0)), threads * perThread);
+    }
+
+    void test_flushNow()
+    {
+        QTemporaryDir tempDir;
+        auto pattern = QDir(tempDir.path()).filePath("test-%0.log");
+
+        LogSink sink(pattern);
+        sink.flushInterval = std::chrono::hours(1);
+        QVERIFY(sink.open());
+
+        sink.write("fatal\n", true);
+        // must be on disk before write() returns
+        QCOMPARE(countLines(pattern.arg(0)), 1);
+    }
+
+    void test_rotation()
+    {
+        QTemporaryDir tempDir;
+        auto pattern = QDir(tempDir.path()).filePath("test-%0.log");
+
+        {
+            LogSink sink(pattern, 3, 1024);
+            QVERIFY(sink.open());
+            for (int i = 0; i < 100; i++)
+                sink.write(QString("%1\n").arg(QString(100, 'x')), true);
+        }
+
+        // only the configured amount of files is kept, none of them much larger than the limit
+        QVERIFY(QFile::exists(pattern.arg(0)));
+        QVERIFY(QFile::exists(pattern.arg(2)));
+        QVERIFY(!QFile::exists(pattern.arg(3)));
+        QVERIFY(QFileInfo(pattern.arg(1)).size() < 2048);
+    }
+
+    void test_dropWhenFull()
+    {
+        QTemporaryDir tempDir;
+        auto pattern = QDir(tempDir.path()).filePath("test-%0.log");
+
+        LogSink sink(pattern);
+        sink.maxPendingBytes = 0;
+        QVERIFY(sink.open());
+
+        sink.write("dropped\n");
+        sink.write("kept, flushes always go through\n", true);
+        sink.shutdown();
+
+        QCOMPARE(sink.droppedMessages(), 1ull);
+    }
+};
+
+QTEST_GUILESS_MAIN(LogSinkTest)
+
+#include "LogSink_test.moc"
@@ -0,0 +1,90 @@
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <MMCZip.h>
+
+#include "TestZip.h"
+
+#include <atomic>
+
+class MMCZipTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_extractOverlay()
+    {
+        QTemporaryDir tempDir;
+        const auto first = FS::PathCombine(tempDir.path(), "first.zip");
+        const auto second = FS::PathCombine(tempDir.path(), "second.zip");
+        const auto third = FS::PathCombine(tempDir.path(), "third.zip");
+        QVERIFY(writeZip(first, { { "mods/a.jar", "a1" }, { "config/a.cfg", "first" }, { "bin/", "" } }));
+        QVERIFY(writeZip(second, { { "mods/b.jar", "b" }, { "config/a.cfg", "second" } }));
+        QVERIFY(writeZip(third, { { "config/a.cfg", "third" }, { "config/deep/c.cfg", "c" } }));
+
+        const auto target = FS::PathCombine(tempDir.path(), "out");
+        std::atomic<qint64> lastProgress{ -1 }, progressTotal{ -1 };
+        auto extracted = MMCZip::extractOverlay({ first, second, third }, target, [&](qint64 current, qint64 total) {
+            qint64 last = lastProgress;
+            while (current > last && !lastProgress.compare_exchange_weak(last, current)) {
+            }
+            progressTotal = total;
+        });
+        QVERIFY(extracted.has_value());
+        QCOMPARE(extracted->size(), 4);
+
+        QCOMPARE(readFile(FS::PathCombine(target, "mods/a.jar")), QByteArray("a1"));
+        QCOMPARE(readFile(FS::PathCombine(target, "mods/b.jar")), QByteArray("b"));
+        QCOMPARE(readFile(FS::PathCombine(target, "config/a.cfg")), QByteArray("third"));
+        QCOMPARE(readFile(FS::PathCombine(target, "config/deep/c.cfg")), QByteArray("c"));
+        QVERIFY(QFileInfo(FS::PathCombine(target, "bin")).isDir());
+
+        // the overwritten copies aren't extracted at all
+        QCOMPARE(progressTotal.load(), qint64(2 + 1 + 5 + 1));
+        QCOMPARE(lastProgress.load(), progressTotal.load());
+    }
+
+    void test_extractOverlaySamePath()
+    {
+        QTemporaryDir tempDir;
+        const auto first = FS::PathCombine(tempDir.path(), "first.zip");
+        const auto second = FS::PathCombine(tempDir.path(), "second.zip");
+        QVERIFY(writeZip(first, { { "config//a.cfg", "first" } }));
+        QVERIFY(writeZip(second, { { "./config/a.cfg", "second" } }));
+
+        // both entries land on the same file, so only the last one is extracted
+        const auto target = FS::PathCombine(tempDir.path(), "out");
+        auto extracted = MMCZip::extractOverlay({ first, second }, target);
+        QVERIFY(extracted.has_value());
+        QCOMPARE(extracted->size(), 1);
+        QCOMPARE(readFile(FS::PathCombine(target, "config/a.cfg")), QByteArray("second"));
+    }
+
+    void test_extractOverlayRejectsEscapes()
+    {
+        QTemporaryDir tempDir;
+        const auto archive = FS::PathCombine(tempDir.path(), "evil.zip");
+        QVERIFY(writeZip(archive, { { "fine.txt", "fine" }, { "../evil.txt", "evil" } }));
+
+        const auto target = FS::PathCombine(tempDir.path(), "out");
+        QVERIFY(!MMCZip::extractOverlay({ archive }, target));
+        QVERIFY(!QFile::exists(FS::PathCombine(tempDir.path(), "evil.txt")));
+    }
+
+    void test_extractOverlayCancel()
+    {
+        QTemporaryDir tempDir;
+        const auto archive = FS::PathCombine(tempDir.path(), "pack.zip");
+        QVERIFY(writeZip(archive, { { "a.txt", "a" }, { "b.txt", "b" } }));
+
+        const auto target = FS::PathCombine(tempDir.path(), "out");
+        QVERIFY(!MMCZip::extractOverlay({ archive }, target, {}, [] { return true; }));
+        QVERIFY(!QFile::exists(FS::PathCombine(target, "a.txt")));
+    }
+};
+
+QTEST_GUILESS_MAIN(MMCZipTest)
+
+#include "MMCZip_test.moc"
@@ -0,0 +1,131 @@
+#include <QTest>
+
+#include <FileSystem.h>
+#include <meta/Version.h>
+#include <meta/VersionList.h>
+
+#include "DataDir.h"
+#include "MetaVersionList.h"
+
+// the snapshot can briefly be missing while it's replaced
+static QByteArray readSnapshot()
+{
+    QFile file(snapshotFile);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+class MetaSnapshotTest : public QObject {
+    Q_OBJECT
+
+    // the way the index hands out version lists, with the checksum it has for them
+    static Meta::VersionList::Ptr load(const QString& sha256)
+    {
+        auto list = std::make_shared<Meta::VersionList>(uid);
+        list->setSha256(sha256);
+        list->load(Net::Mode::Offline);
+        return list;
+    }
+
+    static void compare(const Meta::VersionList::Ptr& a, const Meta::VersionList::Ptr& b)
+    {
+        QCOMPARE(a->name(), b->name());
+        QCOMPARE(a->count(), b->count());
+        QCOMPARE(a->getRecommended() == nullptr, b->getRecommended() == nullptr);
+        for (int i = 0; i < a->count(); i++) {
+            auto va = a->versions().at(i);
+            auto vb = b->versions().at(i);
+            QCOMPARE(va->version(), vb->version());
+            QCOMPARE(va->type(), vb->type());
+            QCOMPARE(va->rawTime(), vb->rawTime());
+            QCOMPARE(va->isRecommended(), vb->isRecommended());
+            QCOMPARE(va->isVolatile(), vb->isVolatile());
+            QCOMPARE(va->requiredSet().size(), vb->requiredSet().size());
+            QVERIFY(std::equal(va->requiredSet().begin(), va->requiredSet().end(), vb->requiredSet().begin(),
+                               [](const Meta::Require& x, const Meta::Require& y) { return x.deepEquals(y); }));
+            QCOMPARE(va->conflictSet().size(), vb->conflictSet().size());
+        }
+    }
+
+   private slots:
+    void test_snapshot()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        const auto json = makeVersionList(500);
+        FS::write(jsonFile, json);
+        auto fromJson = load(checksum(json));
+        QVERIFY(fromJson->isLoaded());
+        QCOMPARE(fromJson->count(), 500);
+        QTRY_VERIFY(QFile::exists(snapshotFile));
+
+        // the JSON isn't looked at anymore while the index lists the same checksum
+        FS::write(jsonFile, makeVersionList(500, "Changed"));
+        auto fromSnapshot = load(checksum(json));
+        QVERIFY(fromSnapshot->isLoaded());
+        QCOMPARE(fromSnapshot->name(), QString("Forge"));
+        compare(fromJson, fromSnapshot);
+    }
+
+    void test_stale()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        const auto oldJson = makeVersionList(100);
+        FS::write(jsonFile, oldJson);
+        load(checksum(oldJson));
+        QTRY_VERIFY(QFile::exists(snapshotFile));
+
+        // the index moved on, and so did the file
+        const auto newJson = makeVersionList(120, "Forge (new)");
+        FS::write(jsonFile, newJson);
+        auto list = load(checksum(newJson));
+        QCOMPARE(list->name(), QString("Forge (new)"));
+        QCOMPARE(list->count(), 120);
+
+        // and the snapshot is made again for it
+        QFile::remove(jsonFile);
+        QTRY_VERIFY(load(checksum(newJson))->isLoaded());
+        QCOMPARE(load(checksum(newJson))->count(), 120);
+    }
+
+    void test_notListed()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        const auto json = makeVersionList(100);
+        FS::write(jsonFile, json);
+
+        // without a checksum from the index, or one that doesn't match the file, there's no snapshot to go by
+        QVERIFY(load(QString())->isLoaded());
+        QVERIFY(load(checksum("something else"))->isLoaded());
+        QTest::qWait(500);
+        QVERIFY(!QFile::exists(snapshotFile));
+    }
+
+    void test_brokenSnapshot()
+    {
+        DataDir dataDir;
+        QVERIFY(dataDir.dir.isValid());
+
+        const auto json = makeVersionList(100);
+        FS::write(jsonFile, json);
+        load(checksum(json));
+        QTRY_VERIFY(QFile::exists(snapshotFile));
+        const auto snapshot = readSnapshot();
+
+        for (auto broken : { QByteArray("garbage"), snapshot.left(snapshot.size() / 2), snapshot + "trailing" }) {
+            FS::write(snapshotFile, broken);
+            auto list = load(checksum(json));
+            QVERIFY(list->isLoaded());
+            QCOMPARE(list->count(), 100);
+            QTRY_COMPARE(readSnapshot(), snapshot);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(MetaSnapshotTest)
+
+#include "MetaSnapshot_test.moc"
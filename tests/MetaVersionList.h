@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+inline const QString uid = "net.minecraftforge";
+inline const QString jsonFile = "meta/net.minecraftforge/index.json";
+inline const QString snapshotFile = "cache/meta/net.minecraftforge/index.snapshot";
+
+// a version list the size of Forge's
+inline QByteArray makeVersionList(int count, const QString& name = "Forge")
+{
+    QJsonArray versions;
+    for (int i = 0; i < count; i++) {
+        QJsonObject version{
+            { "version", QString("47.%1.%2").arg(i / 100).arg(i % 100) },
+            { "releaseTime", QDateTime::fromSecsSinceEpoch(1600000000 + i * 3600, Qt::UTC).toString(Qt::ISODate) },
+            { "type", i % 10 == 0 ? "release" : "snapshot" },
+            { "recommended", i % 50 == 0 },
+            { "requires", QJsonArray{ QJsonObject{ { "uid", "net.minecraft" }, { "equals", QString("1.20.%1").arg(i % 7) } } } },
+            { "sha256", QString(QCryptographicHash::hash(QByteArray::number(i), QCryptographicHash::Sha256).toHex()) },
+        };
+        if (i % 3 == 0) {
+            version.insert("conflicts", QJsonArray{ QJsonObject{ { "uid", "net.fabricmc.fabric-loader" } } });
+        }
+        if (i % 11 == 0) {
+            version.insert("volatile", true);
+        }
+        versions.append(version);
+    }
+    QJsonObject list{ { "formatVersion", 1 }, { "uid", uid }, { "name", name }, { "versions", versions } };
+    return QJsonDocument(list).toJson(QJsonDocument::Compact);
+}
+
+inline QString checksum(const QByteArray& data)
+{
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+}
@@ -0,0 +1,151 @@
+#include <QBuffer>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <sstream>
+
+#include <FileSystem.h>
+#include <GZip.h>
+#include <minecraft/NbtPathReader.h>
+#include <minecraft/World.h>
+
+#include <io/stream_writer.h>
+#include <nbt_tags.h>
+
+// a level.dat like the ones of big modded worlds, with the fields the launcher wants in between a lot that it doesn't
+static QByteArray makeLevelDat(int registryEntries, bool compress = true)
+{
+    nbt::tag_list inventory;
+    for (int i = 0; i < 36; i++) {
+        inventory.push_back(nbt::tag_compound{ { "Slot", int8_t(i) }, { "id", "minecraft:stone" }, { "Count", int8_t(64) } });
+    }
+    nbt::tag_list registry;
+    for (int i = 0; i < registryEntries; i++) {
+        registry.push_back(nbt::tag_compound{ { "K", "somemod:block_" + std::to_string(i) }, { "V", int32_t(i) } });
+    }
+
+    nbt::tag_compound root{
+        { "Data", nbt::tag_compound{
+                      { "BorderSize", 60000000.0 },
+                      { "GameType", int32_t(1) },
+                      { "LastPlayed", int64_t(1700000000000) },
+                      { "LevelName", "Modded World" },
+                      { "Player", nbt::tag_compound{ { "Inventory", std::move(inventory) },
+                                                     { "Pos", nbt::tag_list{ 1.0, 64.0, -3.5 } },
+                                                     { "Health", 20.0f } } },
+                      { "ServerBrands", nbt::tag_list{ std::string("forge") } },
+                      { "WorldGenSettings", nbt::tag_compound{ { "bonus_chest", int8_t(0) }, { "seed", int64_t(-42) } } },
+                  } },
+        { "fml", nbt::tag_compound{ { "Registries", std::move(registry) },
+                                    { "LoadingModList", nbt::tag_int_array(std::vector<int32_t>(1000, 7)) } } },
+    };
+    std::ostringstream stream;
+    nbt::io::write_tag("", root, stream);
+    const auto raw = stream.str();
+    QByteArray data(raw.data(), int(raw.size()));
+    if (!compress) {
+        return data;
+    }
+    QByteArray compressed;
+    GZip::zip(data, compressed);
+    return compressed;
+}
+
+class NbtPathReaderTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_read()
+    {
+        auto data = makeLevelDat(100, false);
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        NbtPathReader reader({ "Data", "Data.LevelName", "Data.GameType", "Data.LastPlayed", "Data.WorldGenSettings.seed",
+                               "Data.BorderSize", "Data.Player.Health", "Data.Player.Pos", "Data.RandomSeed", "fml.Missing" });
+        QVERIFY(reader.read(&buffer));
+
+        QCOMPARE(reader.type("Data"), NbtPathReader::Compound);
+        QCOMPARE(reader.value("Data.LevelName"), QVariant(QString("Modded World")));
+        QCOMPARE(reader.type("Data.GameType"), NbtPathReader::Int);
+        QCOMPARE(reader.value("Data.GameType"), QVariant(1));
+        QCOMPARE(reader.value("Data.LastPlayed"), QVariant(qlonglong(1700000000000)));
+        QCOMPARE(reader.value("Data.WorldGenSettings.seed"), QVariant(qlonglong(-42)));
+        QCOMPARE(reader.value("Data.BorderSize"), QVariant(60000000.0));
+        QCOMPARE(reader.value("Data.Player.Health"), QVariant(20.0f));
+        // lists are only noted
+        QCOMPARE(reader.type("Data.Player.Pos"), NbtPathReader::List);
+        QVERIFY(!reader.value("Data.Player.Pos").isValid());
+        QCOMPARE(reader.type("Data.RandomSeed"), NbtPathReader::End);
+        QCOMPARE(reader.type("fml.Missing"), NbtPathReader::End);
+        QVERIFY(buffer.atEnd());
+    }
+
+    void test_stopsEarly()
+    {
+        auto data = makeLevelDat(100000);
+        QBuffer buffer(&data);
+        GZipReader uncompressed(&buffer);
+        QVERIFY(uncompressed.open(QIODevice::ReadOnly));
+
+        // everything comes before the mod registries, which are never inflated
+        NbtPathReader reader({ "Data.LevelName", "Data.WorldGenSettings.seed" });
+        QVERIFY(reader.read(&uncompressed));
+        QCOMPARE(reader.value("Data.LevelName"), QVariant(QString("Modded World")));
+        QCOMPARE(reader.value("Data.WorldGenSettings.seed"), QVariant(qlonglong(-42)));
+        QVERIFY(buffer.pos() < buffer.size() / 2);
+    }
+
+    void test_malformed()
+    {
+        auto data = makeLevelDat(100, false);
+        auto truncated = data.left(data.size() - 100);
+        QBuffer truncatedBuffer(&truncated);
+        QVERIFY(truncatedBuffer.open(QIODevice::ReadOnly));
+        NbtPathReader reader({ "Data.RandomSeed" });
+        QVERIFY(!reader.read(&truncatedBuffer));
+        QVERIFY(!reader.errorString().isEmpty());
+
+        QByteArray notCompound("\x08\x00\x00\x00\x00", 5);
+        QBuffer notCompoundBuffer(&notCompound);
+        QVERIFY(notCompoundBuffer.open(QIODevice::ReadOnly));
+        QVERIFY(!reader.read(&notCompoundBuffer));
+
+        QByteArray badType("\x0a\x00\x00\x2a\x00\x01x\x00", 8);
+        QBuffer badTypeBuffer(&badType);
+        QVERIFY(badTypeBuffer.open(QIODevice::ReadOnly));
+        QVERIFY(!reader.read(&badTypeBuffer));
+
+        // a deeply nested list of lists doesn't exhaust the stack
+        QByteArray nested("\x0a\x00\x00\x09\x00\x01x", 7);
+        for (int i = 0; i < 100000; i++) {
+            nested.append("\x09\x00\x00\x00\x01", 5);
+        }
+        QBuffer nestedBuffer(&nested);
+        QVERIFY(nestedBuffer.open(QIODevice::ReadOnly));
+        QVERIFY(!reader.read(&nestedBuffer));
+    }
+
+    void test_world()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto worldDir = FS::PathCombine(tempDir.path(), "world");
+        FS::write(FS::PathCombine(worldDir, "level.dat"), makeLevelDat(1000));
+
+        World world{ QFileInfo(worldDir) };
+        QVERIFY(world.isValid());
+        QCOMPARE(world.name(), QString("Modded World"));
+        QCOMPARE(world.lastPlayed(), QDateTime::fromMSecsSinceEpoch(1700000000000));
+        QCOMPARE(world.seed(), int64_t(-42));
+        QCOMPARE(world.gameType().type, GameType::Creative);
+
+        FS::write(FS::PathCombine(worldDir, "level.dat"), makeLevelDat(1000).left(500));
+        World broken{ QFileInfo(worldDir) };
+        QVERIFY(!broken.isValid());
+    }
+};
+
+QTEST_GUILESS_MAIN(NbtPathReaderTest)
+
+#include "NbtPathReader_test.moc"
@@ -0,0 +1,213 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <translations/POCatalog.h>
+#include <translations/POTranslator.h>
+
+static const char* const samplePO = R"(msgid ""
+msgstr ""
+"Content-Type: text/plain; charset=UTF-8\n"
+
+msgctxt "MainWindow"
+msgid "&File"
+msgstr "&Datei"
+
+msgctxt "MainWindow|menu"
+msgid "Open"
+msgstr "Öffnen (Menü)"
+
+msgctxt "MainWindow"
+msgid "Open"
+msgstr "Öffnen"
+
+#, fuzzy
+msgctxt "MainWindow"
+msgid "Close"
+msgstr "Schließen"
+
+msgctxt "Dialog"
+msgid "Line\none"
+msgstr ""
+"Zeile\n"
+"eins \"zitiert\"\tda"
+
+msgctxt "Dialog"
+msgid "Untranslated"
+msgstr ""
+
+msgctxt "Dialog"
+msgid "Again"
+msgstr "Erst"
+
+msgctxt "Dialog"
+msgid "Again"
+msgstr "Dann"
+)";
+
+class POTranslatorTest : public QObject {
+    Q_OBJECT
+
+    void checkSample(const QTranslator& translator)
+    {
+        QVERIFY(!translator.isEmpty());
+        QCOMPARE(translator.translate("MainWindow", "&File"), QString("&Datei"));
+        // the later entry wins, but the disambiguated one is still there
+        QCOMPARE(translator.translate("MainWindow", "Open"), QString::fromUtf8("Öffnen"));
+        QCOMPARE(translator.translate("MainWindow", "Open", "menu"), QString::fromUtf8("Öffnen (Menü)"));
+        QCOMPARE(translator.translate("MainWindow", "Open", "toolbar"), QString::fromUtf8("Öffnen"));
+        QCOMPARE(translator.translate("MainWindow", "Close"), QString::fromUtf8("Schließen"));
+        QCOMPARE(translator.translate("Dialog", "Line\none"), QString("Zeile\neins \"zitiert\"\tda"));
+        QCOMPARE(translator.translate("Dialog", "Again"), QString("Dann"));
+        QVERIFY(translator.translate("Dialog", "Untranslated").isEmpty());
+
+        QVERIFY(translator.translate("Dialog", "Missing").isNull());
+        QVERIFY(translator.translate("Dialog", "&File").isNull());
+        QVERIFY(translator.translate("MainWindow", "Ope").isNull());
+        QVERIFY(translator.translate("", "").isNull());
+    }
+
+   private slots:
+    void test_catalog()
+    {
+        QList<POCatalog::Message> messages{
+            { "Context", "Source", {}, "Quelle", false },
+            { "Context", "Fuzzy", "dis", "Unscharf", true },
+        };
+        POCatalog catalog;
+        QVERIFY(catalog.open(POCatalog::build(messages)));
+        QCOMPARE(catalog.size(), 3);
+
+        auto source = catalog.find("Context", "Source");
+        QVERIFY(source.found());
+        QCOMPARE(QString(source.text, source.length), QString("Quelle"));
+        QVERIFY(!source.fuzzy);
+        QVERIFY(catalog.find("Context", "Fuzzy").fuzzy);
+        QVERIFY(catalog.find("Context", "Fuzzy", "dis").found());
+        QVERIFY(!catalog.find("Context", "Source", "dis").found());
+        QVERIFY(!catalog.find(nullptr, "Source").found());
+
+        QVERIFY(catalog.open(POCatalog::build({})));
+        QCOMPARE(catalog.size(), 0);
+        QVERIFY(!catalog.find("Context", "Source").found());
+
+        QVERIFY(!catalog.open(QByteArray("not a catalog")));
+        QVERIFY(!catalog.isValid());
+        auto truncated = POCatalog::build(messages);
+        truncated.chop(1);
+        QVERIFY(!catalog.open(truncated));
+    }
+
+    void test_translate()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+
+        FS::write(path("de.po"), samplePO);
+        POTranslator translator(path("de.po"));
+        checkSample(translator);
+    }
+
+    void test_compiledCatalog()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+
+        FS::write(path("de.po"), samplePO);
+        const auto catalogFile = path("cache/de.poc");
+        {
+            POTranslator translator(path("de.po"), catalogFile);
+            checkSample(translator);
+        }
+        QVERIFY(QFile::exists(catalogFile));
+
+        // the mapped catalog gives the same translations as the parsed file
+        {
+            POCatalog catalog;
+            QVERIFY(catalog.open(catalogFile));
+            QVERIFY(catalog.isUpToDate(path("de.po")));
+        }
+        {
+            POTranslator translator(path("de.po"), catalogFile);
+            checkSample(translator);
+        }
+
+        // and it's what gets used while the file doesn't change
+        QFileInfo info(path("de.po"));
+        FS::write(catalogFile, POCatalog::build({ { "MainWindow", "&File", {}, "From the catalog", false } }, info.size(),
+                                                info.lastModified().toMSecsSinceEpoch()));
+        {
+            POTranslator translator(path("de.po"), catalogFile);
+            QCOMPARE(translator.translate("MainWindow", "&File"), QString("From the catalog"));
+        }
+
+        FS::write(path("de.po"), QByteArray(samplePO) + "\nmsgctxt \"Dialog\"\nmsgid \"New\"\nmsgstr \"Neu\"\n");
+        {
+            POTranslator translator(path("de.po"), catalogFile);
+            checkSample(translator);
+            QCOMPARE(translator.translate("Dialog", "New"), QString("Neu"));
+        }
+
+        // a damaged catalog is replaced
+        FS::write(catalogFile, "garbage");
+        {
+            POTranslator translator(path("de.po"), catalogFile);
+            checkSample(translator);
+        }
+        POCatalog catalog;
+        QVERIFY(catalog.open(catalogFile));
+    }
+
+    void test_brokenFile()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+
+        FS::write(path("broken.po"), "\"a string before anything else\"\n");
+        POTranslator broken(path("broken.po"), path("broken.poc"));
+        QVERIFY(broken.isEmpty());
+        QVERIFY(!QFile::exists(path("broken.poc")));
+
+        POTranslator missing(path("missing.po"));
+        QVERIFY(missing.isEmpty());
+    }
+
+    void test_manyMessages()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        auto path = [&tempDir](const QString& name) { return FS::PathCombine(tempDir.path(), name); };
+
+        QByteArray po;
+        for (int i = 0; i < 5000; i++) {
+            auto context = QByteArray("Context") + QByteArray::number(i % 37);
+            if (i % 5 == 0)
+                context += "|variant";
+            po += "msgctxt \"" + context + "\"\nmsgid \"Message " + QByteArray::number(i) + "\"\nmsgstr \"Nachricht " +
+                  QByteArray::number(i) + "\"\n\n";
+        }
+        FS::write(path("many.po"), po);
+
+        POTranslator translator(path("many.po"), path("many.poc"));
+        for (int i = 0; i < 5000; i++) {
+            auto context = QByteArray("Context") + QByteArray::number(i % 37);
+            auto id = QByteArray("Message ") + QByteArray::number(i);
+            QCOMPARE(translator.translate(context.constData(), id.constData()), QString("Nachricht %1").arg(i));
+            if (i % 5 == 0)
+                QCOMPARE(translator.translate(context.constData(), id.constData(), "variant"), QString("Nachricht %1").arg(i));
+        }
+        QVERIFY(translator.translate("Context0", "Message 5000").isNull());
+        QVERIFY(translator.translate("Context1", "Message 0").isNull());
+
+        POCatalog catalog;
+        QVERIFY(catalog.open(path("many.poc")));
+        QCOMPARE(catalog.size(), 6000);
+    }
+};
+
+QTEST_GUILESS_MAIN(POTranslatorTest)
+
+#include "POTranslator_test.moc"
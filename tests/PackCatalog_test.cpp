@@ -0,0 +1,184 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+
+#include <FileSystem.h>
+#include <modplatform/atlauncher/ATLPackIndex.h>
+#include <modplatform/helpers/PackCatalog.h>
+
+#include "ATLPackList.h"
+
+class PackCatalogTest : public QObject {
+    Q_OBJECT
+
+    /* What the catalog should find, the slow way. */
+    static QVector<int> bruteForce(const PackCatalog& catalog, const QString& query)
+    {
+        QVector<int> result;
+        auto terms = PackCatalog::tokenize(query);
+        for (int i = 0; i < catalog.packs().size(); i++) {
+            auto& pack = catalog.packs()[i];
+            auto words = PackCatalog::tokenize(pack.name + ' ' + pack.author + ' ' + pack.summary);
+            bool matches = true;
+            for (auto& term : terms) {
+                matches = matches && std::any_of(words.begin(), words.end(), [&](const QString& word) { return word.startsWith(term); });
+            }
+            if (matches || pack.name.toCaseFolded().contains(query.trimmed().toCaseFolded()))
+                result.append(i);
+        }
+        return result;
+    }
+
+   private slots:
+    void test_tokenize()
+    {
+        QCOMPARE(PackCatalog::tokenize("Sky Factory 4: über-Tech, sky!"), QStringList({ "4", "factory", "sky", "tech", "über" }));
+    }
+
+    void test_update()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto list = FS::PathCombine(tempDir.path(), "packsnew.json");
+        const auto index = FS::PathCombine(tempDir.path(), "packsnew.catalog");
+        FS::write(list, makePackList(500));
+
+        PackCatalog catalog(index);
+        QVERIFY(!catalog.load());
+        QVERIFY(catalog.update(list, "first", ATLauncher::parsePackList));
+        QCOMPARE(catalog.packs().size(), 350);
+        QCOMPARE(catalog.source(), QString("first"));
+
+        // the pack survives the trip through the catalog
+        auto pack = ATLauncher::fromCatalogPack(catalog.packs()[1]);
+        QCOMPARE(pack.id, 1);
+        QCOMPARE(pack.position, 499);
+        QCOMPARE(pack.versions.size(), 1);
+        QCOMPARE(pack.versions[0].minecraft, QString("1.8.2"));
+        QCOMPARE(catalog.packs()[1].gameVersion, QString("1.8.2"));
+
+        // and the catalog through the index
+        PackCatalog loaded(index);
+        QVERIFY(loaded.load());
+        QCOMPARE(loaded.source(), QString("first"));
+        QCOMPARE(loaded.packs().size(), catalog.packs().size());
+        QCOMPARE(loaded.packs()[1].name, catalog.packs()[1].name);
+        QCOMPARE(loaded.packs()[1].data, catalog.packs()[1].data);
+        QCOMPARE(loaded.search("sky fac"), catalog.search("sky fac"));
+
+        // nothing to do for the same list
+        QVERIFY(!loaded.update(list, "first", ATLauncher::parsePackList));
+        FS::write(list, makePackList(100));
+        QVERIFY(loaded.update(list, "second", ATLauncher::parsePackList));
+        QCOMPARE(loaded.packs().size(), 70);
+    }
+
+    void test_broken()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto list = FS::PathCombine(tempDir.path(), "packsnew.json");
+        const auto index = FS::PathCombine(tempDir.path(), "packsnew.catalog");
+        FS::write(list, makePackList(500));
+
+        PackCatalog catalog(index);
+        QVERIFY(catalog.update(list, "first", ATLauncher::parsePackList));
+
+        // a list that can't be read doesn't replace the one we have
+        FS::write(list, "[{\"id\": \"not a number\"}]");
+        QVERIFY(!catalog.update(list, "second", ATLauncher::parsePackList));
+        QCOMPARE(catalog.packs().size(), 350);
+        QCOMPARE(catalog.source(), QString("first"));
+
+        auto data = FS::read(index);
+        FS::write(index, data.left(data.size() / 2));
+        QVERIFY(!PackCatalog(index).load());
+        FS::write(index, "nonsense");
+        QVERIFY(!PackCatalog(index).load());
+    }
+
+    void test_search_data()
+    {
+        QTest::addColumn<QString>("query");
+        QTest::addRow("word") << "factory";
+        QTest::addRow("prefix") << "gal";
+        QTest::addRow("two words") << "sky quest";
+        QTest::addRow("case and punctuation") << "  ISLAND,   Ultim!";
+        QTest::addRow("number") << "42";
+        QTest::addRow("description") << "pack about star";
+        QTest::addRow("non-ascii") << "über";
+        QTest::addRow("inside a word") << "actor";
+        QTest::addRow("inside the name") << "ky facto";
+        QTest::addRow("nothing") << "sky nonexistent";
+    }
+
+    void test_search()
+    {
+        QFETCH(QString, query);
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto list = FS::PathCombine(tempDir.path(), "packsnew.json");
+        const auto index = FS::PathCombine(tempDir.path(), "packsnew.catalog");
+        FS::write(list, makePackList(500));
+
+        PackCatalog catalog(index);
+        QVERIFY(catalog.update(list, "first", ATLauncher::parsePackList));
+
+        auto expected = bruteForce(catalog, query);
+        QCOMPARE(catalog.search(query), expected);
+    }
+
+    void test_search_everything()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto list = FS::PathCombine(tempDir.path(), "packsnew.json");
+        const auto index = FS::PathCombine(tempDir.path(), "packsnew.catalog");
+        FS::write(list, makePackList(500));
+
+        PackCatalog catalog(index);
+        QVERIFY(catalog.update(list, "first", ATLauncher::parsePackList));
+        QCOMPARE(catalog.search("").size(), catalog.packs().size());
+        QCOMPARE(catalog.search(" - ").size(), catalog.packs().size());
+    }
+
+    void test_merge()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto index = FS::PathCombine(tempDir.path(), "technic.catalog");
+
+        PackCatalog catalog(index);
+        PackCatalog::Pack tekkit{ "tekkit", "Tekkit Classic", "Technic", "", "1.2.5", 0, "a", {} };
+        PackCatalog::Pack hexxit{ "hexxit", "Hexxit", "Technic", "Adventure", "1.5.2", 0, "b", {} };
+        QVERIFY(catalog.merge({ tekkit, hexxit }));
+        QVERIFY(!catalog.merge({ tekkit }));
+
+        tekkit.name = "Tekkit Legends";
+        QVERIFY(catalog.merge({ tekkit }));
+        QCOMPARE(catalog.packs().size(), 2);
+        QCOMPARE(catalog.search("tekkit"), QVector<int>{ 0 });
+        QCOMPARE(catalog.search("legend"), QVector<int>{ 0 });
+        QVERIFY(catalog.search("classic").isEmpty());
+        QCOMPARE(catalog.search("technic"), QVector<int>({ 0, 1 }));
+        // the name is searched for the query as a whole too
+        QCOMPARE(catalog.search("kkit leg"), QVector<int>{ 0 });
+        QCOMPARE(catalog.search("XIT"), QVector<int>{ 1 });
+
+        PackCatalog::Pack skyFactory{ "skyfactory-4", "SkyFactory 4", "Darkosto", "", "1.12.2", 0, "c", {} };
+        PackCatalog::Pack ultimate{ "ftbultimate", "FTBUltimate", "FTB", "", "1.4.7", 0, "d", {} };
+        QVERIFY(catalog.merge({ skyFactory, ultimate }));
+        QCOMPARE(catalog.search("factory"), QVector<int>{ 2 });
+        QCOMPARE(catalog.search("ultimate"), QVector<int>{ 3 });
+
+        PackCatalog loaded(index);
+        QVERIFY(loaded.load());
+        QCOMPARE(loaded.packs()[0].name, QString("Tekkit Legends"));
+        QCOMPARE(loaded.packs()[1].data, QByteArray("b"));
+    }
+};
+
+QTEST_GUILESS_MAIN(PackCatalogTest)
+
+#include "PackCatalog_test.moc"
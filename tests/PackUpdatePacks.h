@@ -0,0 +1,37 @@
+#pragma once
+
+#include <FileSystem.h>
+#include <modplatform/helpers/PackUpdatePlan.h>
+
+inline const int packSize = 1000;
+
+inline QString modPath(int i)
+{
+    return QString("mods/mod-%1.jar").arg(i);
+}
+
+/* An installed pack of 1000 mods in gameRoot, and a new version of it where
+ *   0-699 are the same
+ *   700-799 were renamed
+ *   800-899 were updated
+ *   900-999 were removed, and 50 new ones added
+ */
+inline void makePacks(const QString& gameRoot, QList<PackUpdate::File>& oldFiles, QList<PackUpdate::File>& newFiles)
+{
+    for (int i = 0; i < packSize; i++) {
+        FS::write(FS::PathCombine(gameRoot, modPath(i)), "mod " + QByteArray::number(i));
+        oldFiles.append({ modPath(i), QString("sha1:%1").arg(i) });
+    }
+    for (int i = 0; i < 700; i++) {
+        newFiles.append({ modPath(i), QString("sha1:%1").arg(i) });
+    }
+    for (int i = 700; i < 800; i++) {
+        newFiles.append({ QString("mods/renamed-%1.jar").arg(i), QString("sha1:%1").arg(i) });
+    }
+    for (int i = 800; i < 900; i++) {
+        newFiles.append({ modPath(i), QString("sha1:%1-updated").arg(i) });
+    }
+    for (int i = 0; i < 50; i++) {
+        newFiles.append({ QString("mods/new-%1.jar").arg(i), QString("sha1:new-%1").arg(i) });
+    }
+}
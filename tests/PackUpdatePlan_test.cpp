@@ -0,0 +1,124 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <modplatform/helpers/PackUpdatePlan.h>
+
+#include "PackUpdatePacks.h"
+
+class PackUpdatePlanTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_files()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto gameRoot = FS::PathCombine(tempDir.path(), "instance", ".minecraft");
+        QList<PackUpdate::File> oldFiles;
+        QList<PackUpdate::File> newFiles;
+        makePacks(gameRoot, oldFiles, newFiles);
+
+        // a disabled mod is still installed, a deleted one isn't
+        QVERIFY(QFile::rename(FS::PathCombine(gameRoot, modPath(0)), FS::PathCombine(gameRoot, modPath(0) + ".disabled")));
+        QVERIFY(QFile::remove(FS::PathCombine(gameRoot, modPath(5))));
+
+        auto plan = PackUpdate::plan(gameRoot, oldFiles, newFiles, {}, {});
+
+        QCOMPARE(plan.keep.size(), 699);
+        QVERIFY(plan.keep.contains(modPath(0)));
+        QVERIFY(!plan.keep.contains(modPath(5)));
+
+        QCOMPARE(plan.copies.size(), 100);
+        for (auto const& copy : plan.copies) {
+            QCOMPARE(copy.to, QString(copy.from).replace("mod-", "renamed-"));
+        }
+
+        QCOMPARE(plan.overwrites.size(), 100);
+        QCOMPARE(plan.overwrites.first().path, modPath(800));
+        QCOMPARE(plan.overwrites.first().hash, QString("sha1:800-updated"));
+
+        QCOMPARE(plan.downloads.size(), 51);
+        QCOMPARE(plan.downloads.first().path, modPath(5));
+
+        // the renamed and the removed ones
+        QCOMPARE(plan.deletes.size(), 200);
+        QVERIFY(plan.deletes.contains(modPath(700)));
+        QVERIFY(plan.deletes.contains(modPath(999)));
+        QVERIFY(!plan.deletes.contains(modPath(800)));
+
+        QVERIFY(plan.unchangedOverrides.isEmpty());
+    }
+
+    void test_overrides()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto gameRoot = FS::PathCombine(tempDir.path(), "instance", ".minecraft");
+        const auto staging = FS::PathCombine(tempDir.path(), "staging");
+
+        FS::write(FS::PathCombine(gameRoot, "config/a.cfg"), "a=1");
+        FS::write(FS::PathCombine(gameRoot, "config/b.cfg"), "b=1");
+        FS::write(FS::PathCombine(gameRoot, "config/c.cfg"), "c=1");
+        FS::write(FS::PathCombine(gameRoot, "options.txt"), "fov:70");
+
+        auto overrides = FS::PathCombine(staging, "overrides");
+        auto clientOverrides = FS::PathCombine(staging, "client-overrides");
+        FS::write(FS::PathCombine(overrides, "config/a.cfg"), "a=1");
+        FS::write(FS::PathCombine(overrides, "config/b.cfg"), "b=2");
+        FS::write(FS::PathCombine(overrides, "config/d.cfg"), "d=1");
+        FS::write(FS::PathCombine(overrides, "options.txt"), "fov:80");
+        // the client overrides come last
+        FS::write(FS::PathCombine(clientOverrides, "config/b.cfg"), "b=1");
+
+        auto plan = PackUpdate::plan(gameRoot, {}, {}, { "config/a.cfg", "config/b.cfg", "config/c.cfg", "options.txt", "" },
+                                     { overrides, clientOverrides });
+
+        QCOMPARE(plan.unchangedOverrides.size(), 2);
+        QVERIFY(plan.unchangedOverrides.contains("config/a.cfg"));
+        QVERIFY(plan.unchangedOverrides.contains("config/b.cfg"));
+        QCOMPARE(plan.deletes, QStringList{ "config/c.cfg" });
+
+        // a file that went from the manifest to the overrides stays
+        FS::write(FS::PathCombine(gameRoot, "config/d.cfg"), "d=0");
+        auto moved = PackUpdate::plan(gameRoot, { { "config/d.cfg", "sha1:d" } }, {}, {}, { overrides });
+        QVERIFY(moved.deletes.isEmpty());
+    }
+
+    void test_applyToStaging()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto gameRoot = FS::PathCombine(tempDir.path(), "instance", ".minecraft");
+        const auto staging = FS::PathCombine(tempDir.path(), "staging");
+        QList<PackUpdate::File> oldFiles;
+        QList<PackUpdate::File> newFiles;
+        makePacks(gameRoot, oldFiles, newFiles);
+
+        auto stagedGameRoot = FS::PathCombine(staging, ".minecraft");
+        FS::write(FS::PathCombine(gameRoot, "config/a.cfg"), "a=1");
+        FS::write(FS::PathCombine(stagedGameRoot, "config/a.cfg"), "a=1");
+        FS::write(FS::PathCombine(stagedGameRoot, "config/b.cfg"), "b=1");
+
+        auto plan = PackUpdate::plan(gameRoot, oldFiles, newFiles, { "config/a.cfg" }, { stagedGameRoot });
+        plan.copies.append({ modPath(1), "../outside.jar" });
+        plan.copies.append({ "mods/not-there.jar", "mods/there.jar" });
+
+        auto missing = PackUpdate::applyToStaging(plan, gameRoot, stagedGameRoot);
+        QCOMPARE(missing, (QStringList{ "../outside.jar", "mods/there.jar" }));
+        QVERIFY(!QFile::exists(FS::PathCombine(staging, "outside.jar")));
+
+        for (int i = 700; i < 800; i++) {
+            QCOMPARE(FS::read(FS::PathCombine(stagedGameRoot, QString("mods/renamed-%1.jar").arg(i))), "mod " + QByteArray::number(i));
+        }
+        // the instance itself isn't touched
+        QVERIFY(QFile::exists(FS::PathCombine(gameRoot, modPath(700))));
+
+        QVERIFY(!QFile::exists(FS::PathCombine(stagedGameRoot, "config/a.cfg")));
+        QVERIFY(QFile::exists(FS::PathCombine(stagedGameRoot, "config/b.cfg")));
+    }
+};
+
+QTEST_GUILESS_MAIN(PackUpdatePlanTest)
+
+#include "PackUpdatePlan_test.moc"
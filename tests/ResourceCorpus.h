@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QFileInfo>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/mod/tasks/LocalResourceParse.h>
+
+#include "TestZip.h"
+
+// lots of entries that don't tell anything, like the classes and textures of real archives
+inline ZipFiles filler(const QString& prefix, int count)
+{
+    ZipFiles files;
+    for (int i = 0; i < count; i++) {
+        files.append({ QString("%1/File%2.class").arg(prefix).arg(i), QByteArray(200, char('a' + i % 26)) });
+    }
+    return files;
+}
+
+inline const QByteArray modsToml = R"toml(modLoader="javafml"
+loaderVersion="[47,)"
+license="MIT"
+[[mods]]
+modId="examplemod"
+version="1.0.0"
+displayName="Example Mod"
+)toml";
+inline const QByteArray packMcmeta = R"({"pack": {"pack_format": 15, "description": "Example"}})";
+
+// the shapes of what people drop on the launcher
+inline QList<QPair<ZipFiles, PackedResourceType>> corpus()
+{
+    return {
+        { ZipFiles{ { "META-INF/mods.toml", modsToml }, { "pack.mcmeta", packMcmeta } } + filler("assets/examplemod/textures", 200) +
+              filler("com/example/mod", 600),
+          PackedResourceType::Mod },
+        { ZipFiles{ { "fabric.mod.json", R"({"schemaVersion": 1, "id": "example", "version": "1.0"})" } } + filler("net/example", 400),
+          PackedResourceType::Mod },
+        { ZipFiles{ { "mcmod.info", R"([{"modid": "oldmod", "name": "Old Mod"}])" } } + filler("oldmod", 100), PackedResourceType::Mod },
+        { ZipFiles{ { "META-INF/nil/mappings.json", "{}" }, { "nilloader.nilmod.css", "" }, { "example.nilmod.css", "" } },
+          PackedResourceType::Mod },
+        { ZipFiles{ { "pack.mcmeta", packMcmeta }, { "pack.png", "" } } + filler("assets/minecraft/textures/block", 1500),
+          PackedResourceType::ResourcePack },
+        { ZipFiles{ { "pack.txt", "An old texture pack" } } + filler("textures/blocks", 300), PackedResourceType::TexturePack },
+        { ZipFiles{ { "pack.mcmeta", packMcmeta } } + filler("data/example/functions", 100), PackedResourceType::DataPack },
+        { ZipFiles{ { "My World/level.dat", "" } } + filler("My World/region", 50), PackedResourceType::WorldSave },
+        { ZipFiles{ { "saves/One/level.dat", "" }, { "saves/Two/level.dat", "" } }, PackedResourceType::WorldSave },
+        { ZipFiles{ { "shaders/composite.fsh", "" }, { "shaders/final.vsh", "" } } + filler("shaders/lib", 100),
+          PackedResourceType::ShaderPack },
+        // a modpack, which isn't a resource
+        { ZipFiles{ { "manifest.json", "{}" }, { "overrides/config/example.cfg", "" } } + filler("overrides/mods", 20),
+          PackedResourceType::UNKNOWN },
+        // a pack.mcmeta alone doesn't make a pack
+        { ZipFiles{ { "pack.mcmeta", packMcmeta } }, PackedResourceType::UNKNOWN },
+    };
+}
+
+// a folder worth of downloads, every kind of archive a few times over, and a couple of files that aren't any
+inline void writeCorpus(const QString& dir, int copies, QList<QFileInfo>& files, QList<PackedResourceType>& expected)
+{
+    auto fixtures = corpus();
+    for (int copy = 0; copy < copies; copy++) {
+        for (int i = 0; i < fixtures.size(); i++) {
+            auto path = FS::PathCombine(dir, QString("resource-%1-%2.zip").arg(copy).arg(i));
+            QVERIFY(writeZip(path, fixtures[i].first));
+            files.append(QFileInfo(path));
+            expected.append(fixtures[i].second);
+        }
+    }
+    auto notAZip = FS::PathCombine(dir, "notes.txt");
+    FS::write(notAZip, "not an archive");
+    files.append(QFileInfo(notAZip));
+    expected.append(PackedResourceType::UNKNOWN);
+    files.append(QFileInfo(FS::PathCombine(dir, "missing.zip")));
+    expected.append(PackedResourceType::UNKNOWN);
+}
@@ -33,11 +33,20 @@
  *      limitations under the License.
  */
 
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSortFilterProxyModel>
 #include <QTemporaryDir>
 #include <QTest>
 #include <QTimer>
 #include "BaseInstance.h"
 
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
 #include <FileSystem.h>
 
 #include <minecraft/mod/ModFolderModel.h>
@@ -64,6 +73,34 @@
 class ResourceFolderModelTest : public QObject {
     Q_OBJECT
 
+    // a mods folder the size of a big pack's, with names, versions and authors to sort and filter by
+    static void makeModsFolder(const QString& path, int count)
+    {
+        static const QStringList words = { "Applied", "Energistics", "Create", "Botania", "Thermal",
+                                           "Mekanism", "Tinkers", "Refined", "Storage", "Quark" };
+        for (int i = 0; i < count; i++) {
+            auto name = QString("%1 %2 %3").arg(words[i % 10], words[(i / 10) % 10]).arg(i);
+            if (i % 7 == 0)
+                name.prepend("The ");
+            QJsonObject fabricModJson{
+                { "schemaVersion", 1 },
+                { "id", QString("mod%1").arg(i) },
+                { "version", QString("%1.%2.%3").arg(i % 3).arg(i % 17).arg(i) },
+                { "name", name },
+                { "description", QString("Adds %1 things").arg(words[(i / 3) % 10]) },
+                { "authors", QJsonArray{ QString("Author%1").arg(i % 50) } },
+            };
+
+            QuaZip zip(FS::PathCombine(path, QString("mod-%1.jar").arg(i)));
+            QVERIFY(zip.open(QuaZip::mdCreate));
+            QuaZipFile file(&zip);
+            QVERIFY(file.open(QIODevice::WriteOnly, QuaZipNewInfo("fabric.mod.json")));
+            file.write(QJsonDocument(fabricModJson).toJson());
+            file.close();
+            zip.close();
+        }
+    }
+
    private slots:
     // test for GH-1178 - install a folder with files to a mod list
     void test_1178()
@@ -240,6 +277,55 @@ class ResourceFolderModelTest : public QObject {
         QVERIFY(res_2.enabled() == initial_enabled_res_2);
         QVERIFY(res_2.internal_id() == id_2);
     }
+
+    void test_proxyModel()
+    {
+        QTemporaryDir tmp;
+        makeModsFolder(tmp.path(), 300);
+        ModFolderModel model(tmp.path(), nullptr);
+        { EXEC_UPDATE_TASK(model.update(), QVERIFY) }
+        QCOMPARE(model.size(), 300);
+        QTRY_VERIFY_WITH_TIMEOUT(std::all_of(model.all().begin(), model.all().end(),
+                                             [](const Resource::Ptr& mod) { return mod->isResolved(); }),
+                                 20000);
+
+        auto* proxy = model.createFilterProxyModel(&model);
+        proxy->setSourceModel(&model);
+        proxy->setFilterCaseSensitivity(Qt::CaseInsensitive);
+        auto resourceAt = [&](int row) -> const Mod& { return *model.at(proxy->mapToSource(proxy->index(row, 0)).row()); };
+
+        // names are sorted without their "The"
+        proxy->sort(ModFolderModel::NameColumn, Qt::AscendingOrder);
+        QCOMPARE(resourceAt(0).name(), QString("The Applied Applied 0"));
+        QCOMPARE(resourceAt(proxy->rowCount() - 1).name(), QString("Tinkers Tinkers 66"));
+
+        // and versions by their parts, not as text
+        proxy->sort(ModFolderModel::VersionColumn, Qt::DescendingOrder);
+        QCOMPARE(resourceAt(0).version(), QString("2.16.254"));
+        QCOMPARE(resourceAt(proxy->rowCount() - 1).version(), QString("0.0.0"));
+        auto firstRowOf = [&](const QString& prefix) {
+            for (int row = 0; row < proxy->rowCount(); row++) {
+                if (resourceAt(row).version().startsWith(prefix))
+                    return row;
+            }
+            return -1;
+        };
+        QVERIFY(firstRowOf("1.10.") >= 0);
+        QVERIFY(firstRowOf("1.10.") < firstRowOf("1.9."));
+
+        // names, descriptions and authors are searched, typing narrows down, going back widens again,
+        // and regular expressions still work
+        const QList<QPair<QString, int>> filters = {
+            { "a", 300 },      { "ap", 75 },      { "app", 75 }, { "appl", 75 },           { "ener", 84 },          { "author4", 66 },
+            { "AUTHOR4", 66 }, { "things", 300 }, { "", 300 },   { "storage things", 30 }, { "quark|create", 148 }, { "^the", 68 },
+        };
+        for (auto& [filter, count] : filters) {
+            proxy->setFilterRegularExpression(filter);
+            QCOMPARE(proxy->rowCount(), count);
+        }
+        proxy->setFilterRegularExpression("nothing like it");
+        QCOMPARE(proxy->rowCount(), 0);
+    }
 };
 
 QTEST_GUILESS_MAIN(ResourceFolderModelTest)
@@ -0,0 +1,41 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <minecraft/mod/tasks/LocalResourceParse.h>
+
+#include "ResourceCorpus.h"
+
+class ResourceIdentifyTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_identify()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QList<QFileInfo> files;
+        QList<PackedResourceType> expected;
+        writeCorpus(tempDir.path(), 1, files, expected);
+
+        for (int i = 0; i < files.size(); i++) {
+            QCOMPARE(ResourceUtils::identify(files[i]), expected[i]);
+        }
+    }
+
+    void test_identifyBatch()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        QList<QFileInfo> files;
+        QList<PackedResourceType> expected;
+        writeCorpus(tempDir.path(), 3, files, expected);
+
+        QCOMPARE(ResourceUtils::identify(files), expected);
+        QVERIFY(ResourceUtils::identify(QList<QFileInfo>()).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(ResourceIdentifyTest)
+
+#include "ResourceIdentify_test.moc"
@@ -0,0 +1,136 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+#include <tasks/SequentialTask.h>
+#include <tasks/Task.h>
+#include <tasks/TaskTrace.h>
+
+/* Pretends to do some I/O. Only used for testing. */
+class IOTask : public Task {
+    Q_OBJECT
+
+   public:
+    IOTask(qint64 bytes, bool fail = false) : Task(nullptr, false), m_bytes(bytes), m_fail(fail) {}
+
+   private:
+    void executeTask() override
+    {
+        addBytesRead(m_bytes);
+        addBytesWritten(2 * m_bytes);
+        addBytesDownloaded(3 * m_bytes);
+        if (m_fail)
+            emitFailed("broken");
+        else
+            emitSucceeded();
+    }
+
+    qint64 m_bytes;
+    bool m_fail;
+};
+
+class TaskTraceTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void init()
+    {
+        TaskTrace::instance().clear();
+        TaskTrace::instance().setEnabled(true);
+    }
+
+    void cleanup()
+    {
+        TaskTrace::instance().setEnabled(false);
+        TaskTrace::instance().clear();
+    }
+
+    void test_recordsTree()
+    {
+        auto first = makeShared<IOTask>(10);
+        auto second = makeShared<IOTask>(20);
+        SequentialTask sequence(nullptr, "Sequence");
+        sequence.addTask(first);
+        sequence.addTask(second);
+
+        sequence.start();
+        QVERIFY(QTest::qWaitFor([&] { return sequence.isFinished(); }, 1000));
+
+        auto events = TaskTrace::instance().events();
+        QCOMPARE(events.size(), 3);
+
+        // the children finish first
+        QCOMPARE(events[0].uid, first->getUid());
+        QCOMPARE(events[1].uid, second->getUid());
+        QCOMPARE(events[2].uid, sequence.getUid());
+        QCOMPARE(events[2].name, QString("Sequence"));
+
+        for (int i = 0; i < 2; i++) {
+            QCOMPARE(events[i].parent, sequence.getUid());
+            QCOMPARE(events[i].root, sequence.getUid());
+            QCOMPARE(events[i].state, QString("succeeded"));
+            QVERIFY(events[i].start >= events[2].start);
+            QVERIFY(events[i].end <= events[2].end);
+        }
+        QVERIFY(events[2].parent.isNull());
+
+        QCOMPARE(events[1].bytesRead, qint64(20));
+        QCOMPARE(events[1].bytesWritten, qint64(40));
+        QCOMPARE(events[1].bytesDownloaded, qint64(60));
+        // the counters only cover what a task did itself
+        QCOMPARE(events[2].bytesRead, qint64(0));
+    }
+
+    void test_disabledRecordsNothing()
+    {
+        TaskTrace::instance().setEnabled(false);
+
+        IOTask task(1);
+        task.start();
+
+        QVERIFY(TaskTrace::instance().events().isEmpty());
+        // the timestamps and counters are kept either way
+        QVERIFY(task.startedAt() >= 0);
+        QVERIFY(task.finishedAt() >= task.startedAt());
+        QCOMPARE(task.bytesRead(), qint64(1));
+    }
+
+    void test_chromeTraceJson()
+    {
+        IOTask task(5, true);
+        task.start();
+
+        auto document = QJsonDocument::fromJson(TaskTrace::instance().toJson());
+        QVERIFY(document.isObject());
+        auto traceEvents = document.object()["traceEvents"].toArray();
+
+        QJsonObject begin, end;
+        for (const auto& value : traceEvents) {
+            auto event = value.toObject();
+            if (event["cat"].toString() != "task")
+                continue;
+            if (event["ph"].toString() == "b")
+                begin = event;
+            else if (event["ph"].toString() == "e")
+                end = event;
+        }
+        QVERIFY(!begin.isEmpty());
+        QVERIFY(!end.isEmpty());
+
+        const auto uid = task.getUid().toString(QUuid::WithoutBraces);
+        QCOMPARE(begin["id"].toString(), uid);
+        QCOMPARE(end["id"].toString(), uid);
+        QCOMPARE(begin["name"].toString(), QString("IOTask"));
+        QVERIFY(end["ts"].toDouble() >= begin["ts"].toDouble());
+
+        auto args = begin["args"].toObject();
+        QCOMPARE(args["state"].toString(), QString("failed"));
+        QCOMPARE(args["failReason"].toString(), QString("broken"));
+        QCOMPARE(args["bytesDownloaded"].toInt(), 15);
+    }
+};
+
+QTEST_GUILESS_MAIN(TaskTraceTest)
+
+#include "TaskTrace_test.moc"
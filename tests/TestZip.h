@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+using ZipFiles = QList<QPair<QString, QByteArray>>;
+
+/** Writes an archive with the given entries, deflated unless `compress` is false. */
+inline bool writeZip(const QString& path, const ZipFiles& files, bool compress = true)
+{
+    QuaZip zip(path);
+    if (!zip.open(QuaZip::mdCreate))
+        return false;
+    for (const auto& [name, data] : files) {
+        QuaZipFile file(&zip);
+        if (!file.open(QIODevice::WriteOnly, QuaZipNewInfo(name), nullptr, 0, compress ? Z_DEFLATED : 0))
+            return false;
+        file.write(data);
+        file.close();
+    }
+    zip.close();
+    return zip.getZipError() == ZIP_OK;
+}
+
+inline QByteArray readFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    return file.readAll();
+}
@@ -0,0 +1,98 @@
+#include <QTest>
+
+#include <VersionProxyModel.h>
+#include <meta/JsonFormat.h>
+#include <meta/Version.h>
+#include <meta/VersionList.h>
+
+class VersionProxyModelTest : public QObject {
+    Q_OBJECT
+
+    // a loader with builds for a range of Minecraft versions, like Forge
+    static QVector<Meta::Version::Ptr> makeVersions(int count)
+    {
+        QVector<Meta::Version::Ptr> versions;
+        for (int i = 0; i < count; i++) {
+            auto minecraft = QString("1.%1.%2").arg(12 + i / 500).arg(i / 100 % 5);
+            auto name = QString("%1-%2.%3.%4").arg(minecraft).arg(i / 100).arg(i / 10 % 10).arg(i % 10);
+            auto version = std::make_shared<Meta::Version>("net.minecraftforge", name);
+            version->setType(i % 7 == 0 ? "snapshot" : "release");
+            version->setTime(1500000000 + i);
+            version->setRequires({ Meta::Require{ "net.minecraft", minecraft, {} } }, {});
+            versions.append(version);
+        }
+        return versions;
+    }
+
+    QStringList shown(const VersionProxyModel& proxy)
+    {
+        QStringList versions;
+        for (int i = 0; i < proxy.rowCount(); i++) {
+            versions.append(proxy.data(proxy.index(i, 0), BaseVersionList::VersionRole).toString());
+        }
+        return versions;
+    }
+
+   private slots:
+    void test_search()
+    {
+        Meta::VersionList list("net.minecraftforge");
+        list.setVersions(makeVersions(200));
+        VersionProxyModel proxy;
+        proxy.setSourceModel(&list);
+        QCOMPARE(proxy.rowCount(), 200);
+        // newest first
+        QCOMPARE(shown(proxy).first(), QString("1.12.1-1.9.9"));
+
+        proxy.setSearch("1.12.1-1.");
+        QCOMPARE(proxy.rowCount(), 100);
+        proxy.setSearch("1.12.1-1.5");
+        QCOMPARE(shown(proxy), QStringList({ "1.12.1-1.5.9", "1.12.1-1.5.8", "1.12.1-1.5.7", "1.12.1-1.5.6", "1.12.1-1.5.5",
+                                             "1.12.1-1.5.4", "1.12.1-1.5.3", "1.12.1-1.5.2", "1.12.1-1.5.1", "1.12.1-1.5.0" }));
+
+        // going back widens the search again
+        proxy.setSearch("1.12.1-1");
+        QCOMPARE(proxy.rowCount(), 100);
+        proxy.setSearch("nope");
+        QCOMPARE(proxy.rowCount(), 0);
+        proxy.setSearch("");
+        QCOMPARE(proxy.rowCount(), 200);
+    }
+
+    void test_filters()
+    {
+        Meta::VersionList list("net.minecraftforge");
+        list.setVersions(makeVersions(1000));
+        VersionProxyModel proxy;
+        proxy.setSourceModel(&list);
+
+        proxy.setFilter(BaseVersionList::ParentVersionRole, new ExactFilter("1.12.1"));
+        QCOMPARE(proxy.rowCount(), 100);
+        proxy.setFilter(BaseVersionList::TypeRole, new ExactFilter("release"));
+        QCOMPARE(proxy.rowCount(), 86);
+        proxy.setSearch("1.12.1-1.4");
+        QCOMPARE(proxy.rowCount(), 8);
+
+        // replacing one filter keeps the other
+        proxy.setFilter(BaseVersionList::ParentVersionRole, new ExactFilter("1.13.0"));
+        QCOMPARE(proxy.rowCount(), 0);
+        proxy.setSearch("");
+        QCOMPARE(proxy.rowCount(), 86);
+
+        // the list changing is picked up
+        list.getVersion("1.13.0-5.0.4")->setType("release");
+        QCOMPARE(proxy.rowCount(), 87);
+
+        proxy.clearFilters();
+        QCOMPARE(proxy.rowCount(), 1000);
+
+        // and so is it being reloaded
+        list.setVersions(makeVersions(300));
+        QCOMPARE(proxy.rowCount(), 300);
+        QCOMPARE(shown(proxy).first(), QString("1.12.2-2.9.9"));
+    }
+};
+
+QTEST_GUILESS_MAIN(VersionProxyModelTest)
+
+#include "VersionProxyModel_test.moc"
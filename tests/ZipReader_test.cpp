@@ -0,0 +1,113 @@
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <ZipReader.h>
+
+#include "TestZip.h"
+
+class ZipReaderTest : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void test_read_data()
+    {
+        QTest::addColumn<bool>("compress");
+        QTest::newRow("stored") << false;
+        QTest::newRow("deflated") << true;
+    }
+    void test_read()
+    {
+        QFETCH(bool, compress);
+
+        QTemporaryDir tempDir;
+        auto path = FS::PathCombine(tempDir.path(), "test.jar");
+        QByteArray big(256 * 1024, 'x');
+        QVERIFY(writeZip(path, { { "fabric.mod.json", "{\"id\": \"test\"}" }, { "assets/test/icon.png", big }, { "empty.txt", "" } },
+                         compress));
+
+        ZipReader zip(path);
+        QVERIFY(zip.open());
+        QCOMPARE(zip.entries().size(), 3);
+        QCOMPARE(zip.read("fabric.mod.json"), std::optional<QByteArray>("{\"id\": \"test\"}"));
+        QCOMPARE(zip.read("assets/test/icon.png"), std::optional<QByteArray>(big));
+        QCOMPARE(zip.read("empty.txt"), std::optional<QByteArray>(""));
+        QVERIFY(!zip.read("missing.txt"));
+
+        QVERIFY(zip.containsDir("assets"));
+        QVERIFY(zip.containsDir("/assets/test/"));
+        QVERIFY(!zip.containsDir("data"));
+    }
+
+    void test_extract_data()
+    {
+        QTest::addColumn<bool>("compress");
+        QTest::newRow("stored") << false;
+        QTest::newRow("deflated") << true;
+    }
+    void test_extract()
+    {
+        QFETCH(bool, compress);
+
+        QTemporaryDir tempDir;
+        auto path = FS::PathCombine(tempDir.path(), "test.zip");
+        // several chunks of data that doesn't compress to nothing
+        QByteArray big;
+        for (int i = 0; big.size() < 3 * 1024 * 1024; i++)
+            big.append(QByteArray::number(i * 2654435761u));
+        QVERIFY(writeZip(path, { { "big.bin", big }, { "small.txt", "small" }, { "empty.txt", "" } }, compress));
+
+        ZipReader zip(path);
+        QVERIFY(zip.open());
+        for (auto& entry : zip.entries()) {
+            QBuffer out;
+            out.open(QIODevice::WriteOnly);
+            QVERIFY(zip.extract(entry, out));
+            QCOMPARE(out.data(), *zip.read(entry));
+        }
+        QCOMPARE(zip.read("big.bin"), std::optional<QByteArray>(big));
+    }
+
+    void test_directoryCache()
+    {
+        QTemporaryDir tempDir;
+        auto path = FS::PathCombine(tempDir.path(), "test.zip");
+        QVERIFY(writeZip(path, { { "pack.mcmeta", "first" } }, true));
+
+        {
+            ZipReader zip(path);
+            QVERIFY(zip.open());
+            QVERIFY(zip.contains("pack.mcmeta"));
+        }
+
+        // a rewritten archive must not be served from the stale directory
+        QVERIFY(QFile::remove(path));
+        QVERIFY(writeZip(path, { { "pack.mcmeta", "second" }, { "pack.png", "not really a png" } }, true));
+
+        ZipReader zip(path);
+        QVERIFY(zip.open());
+        QCOMPARE(zip.entries().size(), 2);
+        QCOMPARE(zip.read("pack.mcmeta"), std::optional<QByteArray>("second"));
+    }
+
+    void test_notAZip()
+    {
+        QTemporaryDir tempDir;
+        auto path = FS::PathCombine(tempDir.path(), "broken.jar");
+        QFile file(path);
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write(QByteArray(1024, 'z'));
+        file.close();
+
+        ZipReader zip(path);
+        QVERIFY(!zip.open());
+        QVERIFY(!zip.read("anything"));
+    }
+};
+
+QTEST_GUILESS_MAIN(ZipReaderTest)
+
+#include "ZipReader_test.moc"
@@ -0,0 +1,54 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+
+class FileSystemBenchmark : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_tempDir;
+
+   private slots:
+    void initTestCase()
+    {
+        // 100k files, 100 folders of 10 folders of 100 files each
+        QDir src_dir(FS::PathCombine(m_tempDir.path(), "src"));
+        bool created = true;
+        for (int d = 0; d < 100; d++) {
+            for (int s = 0; s < 10; s++) {
+                QDir dir(src_dir.filePath(QString("dir%1/sub%2").arg(d).arg(s)));
+                created &= dir.mkpath(".");
+                for (int f = 0; f < 100; f++) {
+                    QFile file(dir.filePath(QString("file%1.txt").arg(f)));
+                    created &= file.open(QFile::WriteOnly);
+                }
+            }
+        }
+        QVERIFY(created);
+    }
+
+    void benchmark_link_large_tree_data()
+    {
+        QTest::addColumn<int>("maxDepth");
+
+        // the depth limited walk is the one that used to check every path against everything linked so far
+        QTest::newRow("depth 0") << 0;
+        QTest::newRow("depth 1") << 1;
+    }
+
+    void benchmark_link_large_tree()
+    {
+        QFETCH(int, maxDepth);
+
+        FS::create_link planner(FS::PathCombine(m_tempDir.path(), "src"), FS::PathCombine(m_tempDir.path(), "dst"));
+        planner.linkRecursively(true).setMaxDepth(maxDepth);
+        QBENCHMARK
+        {
+            planner(true);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(FileSystemBenchmark)
+
+#include "FileSystem_benchmark.moc"
@@ -0,0 +1,68 @@
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <algorithm>
+
+#include <FileSystem.h>
+#include <FileWatchService.h>
+
+class FileWatchServiceBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void initTestCase() { qRegisterMetaType<QList<FileChange>>("QList<FileChange>"); }
+
+    // a script of file operations, timing how long it takes from the last one to the changes arriving
+    void benchmark_churn()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        FileWatchService service;
+        const int rounds = 20;
+        const int debounce = 20;
+        auto w = service.watch(tempDir.path(), true, &service);
+        w->setDebounce(debounce);
+        QSignalSpy spy(w, &FileWatch::changed);
+
+        QList<qint64> latencies;
+        for (int round = 0; round < rounds; round++) {
+            const auto dir = FS::PathCombine(tempDir.path(), QString("round%1").arg(round));
+            for (int i = 0; i < 50; i++) {
+                FS::write(FS::PathCombine(dir, QString("file%1.txt").arg(i)), "content");
+            }
+            for (int i = 0; i < 50; i += 2) {
+                FS::write(FS::PathCombine(dir, QString("file%1.txt").arg(i)), "changed");
+            }
+            for (int i = 0; i < 50; i += 4) {
+                QFile::remove(FS::PathCombine(dir, QString("file%1.txt").arg(i)));
+            }
+            QElapsedTimer timer;
+            timer.start();
+
+            QSet<QString> created;
+            while (created.size() < 37 && (!spy.isEmpty() || spy.wait(2000))) {
+                for (auto& change : spy.takeFirst().at(0).value<QList<FileChange>>()) {
+                    if (change.kind == FileChange::Created && change.path.endsWith(".txt"))
+                        created.insert(change.path);
+                }
+            }
+            latencies.append(timer.elapsed());
+            QCOMPARE(created.size(), 37);
+
+            // let the rest of the round settle before the next one
+            while (spy.wait(200)) {
+            }
+            spy.clear();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        qInfo() << "event to callback latency with a" << debounce << "ms debounce: median" << latencies.at(rounds / 2) << "ms, max"
+                << latencies.last() << "ms";
+    }
+};
+
+QTEST_GUILESS_MAIN(FileWatchServiceBenchmark)
+
+#include "FileWatchService_benchmark.moc"
@@ -0,0 +1,51 @@
+#include <QTemporaryFile>
+#include <QTest>
+
+#include <GZip.h>
+
+class GZipBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    // going through a big compressed log a buffer at a time, the way the log viewer does it
+    void benchmark_StreamingLog()
+    {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        qint64 size = 0;
+        {
+            GZipWriter writer(&file);
+            QVERIFY(writer.open(QIODevice::WriteOnly));
+            QByteArray chunk;
+            for (int i = 0; i < 10000; i++) {
+                chunk += "[12:00:00] [Server thread/WARN]: Ambiguity between arguments [teleport, targets] with inputs: " +
+                         QByteArray::number(i) + "\n";
+            }
+            // about 256 MB of log
+            for (int i = 0; i < 256; i++) {
+                QVERIFY(writer.write(chunk) == chunk.size());
+                size += chunk.size();
+            }
+            QVERIFY(writer.finish());
+        }
+        qInfo() << "compressed" << size << "bytes of log into" << file.size();
+
+        QBENCHMARK
+        {
+            QVERIFY(file.seek(0));
+            GZipReader reader(&file);
+            QVERIFY(reader.open(QIODevice::ReadOnly));
+            qint64 read = 0;
+            char buffer[64 * 1024];
+            qint64 length;
+            while ((length = reader.read(buffer, sizeof(buffer))) > 0) {
+                read += length;
+            }
+            QCOMPARE(read, size);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(GZipBenchmark)
+
+#include "GZip_benchmark.moc"
@@ -0,0 +1,37 @@
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <java/JavaRuntimeInstallTask.h>
+
+#include "../JavaRuntimeMirror.h"
+
+class JavaRuntimeBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_assemble()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto mirror = FS::PathCombine(tempDir.path(), "mirror");
+        const auto root = FS::PathCombine(tempDir.path(), "java");
+        QJsonObject runtimes{ { "big", QJsonArray{ makeRuntime(mirror, "big", "21.0.3", 3000, 0) } } };
+        const auto index = FS::PathCombine(mirror, "all.json");
+        FS::write(index, QJsonDocument(QJsonObject{ { "linux", runtimes } }).toJson());
+        QVERIFY(install(QUrl::fromLocalFile(index), root, "big"));
+
+        // what updating to a release that shares every file takes
+        QBENCHMARK
+        {
+            QVERIFY(install(QUrl::fromLocalFile(index), root, "big"));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(JavaRuntimeBenchmark)
+
+#include "JavaRuntime_benchmark.moc"
@@ -0,0 +1,62 @@
+#include <QDir>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <meta/Version.h>
+#include <meta/VersionList.h>
+
+#include "../MetaVersionList.h"
+
+class MetaSnapshotBenchmark : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+    QString m_previousDir;
+
+    static Meta::VersionList::Ptr load(const QString& sha256)
+    {
+        auto list = std::make_shared<Meta::VersionList>(uid);
+        list->setSha256(sha256);
+        list->load(Net::Mode::Offline);
+        return list;
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        // meta entities live relative to the data directory
+        m_previousDir = QDir::currentPath();
+        QDir::setCurrent(m_dir.path());
+    }
+
+    void cleanupTestCase() { QDir::setCurrent(m_previousDir); }
+
+    void benchmark_loadJson()
+    {
+        const auto json = makeVersionList(5000);
+        FS::write(jsonFile, json);
+        QBENCHMARK
+        {
+            QCOMPARE(load(QString())->count(), 5000);
+        }
+    }
+
+    void benchmark_loadSnapshot()
+    {
+        const auto json = makeVersionList(5000);
+        FS::write(jsonFile, json);
+        load(checksum(json));
+        QTRY_VERIFY(QFile::exists(snapshotFile));
+        QFile::remove(jsonFile);
+        QBENCHMARK
+        {
+            QCOMPARE(load(checksum(json))->count(), 5000);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(MetaSnapshotBenchmark)
+
+#include "MetaSnapshot_benchmark.moc"
@@ -0,0 +1,84 @@
+#include <QBuffer>
+#include <QTest>
+
+#include <sstream>
+
+#include <GZip.h>
+#include <minecraft/NbtPathReader.h>
+
+#include <io/stream_reader.h>
+#include <io/stream_writer.h>
+#include <nbt_tags.h>
+
+// a level.dat like the ones of big modded worlds, with the fields the launcher wants in between a lot that it doesn't
+static QByteArray makeLevelDat(int registryEntries)
+{
+    nbt::tag_list inventory;
+    for (int i = 0; i < 36; i++) {
+        inventory.push_back(nbt::tag_compound{ { "Slot", int8_t(i) }, { "id", "minecraft:stone" }, { "Count", int8_t(64) } });
+    }
+    nbt::tag_list registry;
+    for (int i = 0; i < registryEntries; i++) {
+        registry.push_back(nbt::tag_compound{ { "K", "somemod:block_" + std::to_string(i) }, { "V", int32_t(i) } });
+    }
+
+    nbt::tag_compound root{
+        { "Data", nbt::tag_compound{
+                      { "BorderSize", 60000000.0 },
+                      { "GameType", int32_t(1) },
+                      { "LastPlayed", int64_t(1700000000000) },
+                      { "LevelName", "Modded World" },
+                      { "Player", nbt::tag_compound{ { "Inventory", std::move(inventory) },
+                                                     { "Pos", nbt::tag_list{ 1.0, 64.0, -3.5 } },
+                                                     { "Health", 20.0f } } },
+                      { "ServerBrands", nbt::tag_list{ std::string("forge") } },
+                      { "WorldGenSettings", nbt::tag_compound{ { "bonus_chest", int8_t(0) }, { "seed", int64_t(-42) } } },
+                  } },
+        { "fml", nbt::tag_compound{ { "Registries", std::move(registry) },
+                                    { "LoadingModList", nbt::tag_int_array(std::vector<int32_t>(1000, 7)) } } },
+    };
+    std::ostringstream stream;
+    nbt::io::write_tag("", root, stream);
+    const auto raw = stream.str();
+    QByteArray compressed;
+    GZip::zip(QByteArray(raw.data(), int(raw.size())), compressed);
+    return compressed;
+}
+
+class NbtPathReaderBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_fullParse()
+    {
+        const auto data = makeLevelDat(200000);
+        QBENCHMARK
+        {
+            QByteArray raw;
+            QVERIFY(GZip::unzip(data, raw));
+            std::istringstream stream(std::string(raw.constData(), raw.size()));
+            auto levelDat = nbt::io::read_compound(stream).second;
+            QCOMPARE(levelDat->at("Data").at("LevelName").as<nbt::tag_string>().get(), std::string("Modded World"));
+        }
+    }
+
+    void benchmark_pathReader()
+    {
+        auto data = makeLevelDat(200000);
+        QBENCHMARK
+        {
+            QBuffer buffer(&data);
+            GZipReader uncompressed(&buffer);
+            QVERIFY(uncompressed.open(QIODevice::ReadOnly));
+            // the paths the world list asks for, some of which aren't there so the whole document is read
+            NbtPathReader reader({ "Data", "Data.LevelName", "Data.LastPlayed", "Data.GameType", "Data.WorldGenSettings",
+                                   "Data.WorldGenSettings.seed", "Data.RandomSeed" });
+            QVERIFY(reader.read(&uncompressed));
+            QCOMPARE(reader.value("Data.LevelName"), QVariant(QString("Modded World")));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(NbtPathReaderBenchmark)
+
+#include "NbtPathReader_benchmark.moc"
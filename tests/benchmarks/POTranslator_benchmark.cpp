@@ -0,0 +1,34 @@
+#include <QTest>
+
+#include <translations/POCatalog.h>
+
+class POTranslatorBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_find()
+    {
+        QList<POCatalog::Message> messages;
+        for (int i = 0; i < 5000; i++) {
+            auto context = QByteArray("Context") + QByteArray::number(i % 37);
+            auto id = QByteArray("Message ") + QByteArray::number(i);
+            auto text = QString("Nachricht %1").arg(i);
+            messages.append({ context, id, {}, text, false });
+            if (i % 5 == 0)
+                messages.append({ context, id, "variant", text, false });
+        }
+        POCatalog catalog;
+        QVERIFY(catalog.open(POCatalog::build(messages)));
+        QCOMPARE(catalog.size(), 6000);
+
+        QBENCHMARK
+        {
+            for (int i = 0; i < 1000; i++)
+                catalog.find("Context3", "Message 3");
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(POTranslatorBenchmark)
+
+#include "POTranslator_benchmark.moc"
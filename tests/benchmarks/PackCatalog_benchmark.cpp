@@ -0,0 +1,60 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <modplatform/atlauncher/ATLPackIndex.h>
+#include <modplatform/helpers/PackCatalog.h>
+
+#include "../ATLPackList.h"
+
+class PackCatalogBenchmark : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+    QString m_list;
+    QString m_index;
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        m_list = FS::PathCombine(m_dir.path(), "packsnew.json");
+        m_index = FS::PathCombine(m_dir.path(), "packsnew.catalog");
+        FS::write(m_list, makePackList(5000));
+    }
+
+    void benchmark_parse()
+    {
+        auto data = FS::read(m_list);
+        QBENCHMARK
+        {
+            QCOMPARE(ATLauncher::parsePackList(data).size(), 3500);
+        }
+    }
+
+    void benchmark_load()
+    {
+        QVERIFY(PackCatalog(m_index).update(m_list, "first", ATLauncher::parsePackList));
+        QBENCHMARK
+        {
+            PackCatalog catalog(m_index);
+            QVERIFY(catalog.load());
+        }
+    }
+
+    void benchmark_search()
+    {
+        PackCatalog catalog(m_index);
+        QVERIFY(catalog.update(m_list, "first", ATLauncher::parsePackList));
+        QBENCHMARK
+        {
+            catalog.search("s");
+            catalog.search("sky fa");
+            catalog.search("magic quest about");
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PackCatalogBenchmark)
+
+#include "PackCatalog_benchmark.moc"
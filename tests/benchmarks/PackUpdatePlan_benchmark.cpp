@@ -0,0 +1,32 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <modplatform/helpers/PackUpdatePlan.h>
+
+#include "../PackUpdatePacks.h"
+
+class PackUpdatePlanBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_plan()
+    {
+        QTemporaryDir tempDir;
+        QVERIFY(tempDir.isValid());
+        const auto gameRoot = FS::PathCombine(tempDir.path(), "instance", ".minecraft");
+        QList<PackUpdate::File> oldFiles;
+        QList<PackUpdate::File> newFiles;
+        makePacks(gameRoot, oldFiles, newFiles);
+
+        QBENCHMARK
+        {
+            auto plan = PackUpdate::plan(gameRoot, oldFiles, newFiles, {}, {});
+            QCOMPARE(plan.keep.size(), 700);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PackUpdatePlanBenchmark)
+
+#include "PackUpdatePlan_benchmark.moc"
@@ -0,0 +1,121 @@
+#include <algorithm>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSortFilterProxyModel>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTimer>
+
+#include <quazip/quazip.h>
+#include <quazip/quazipfile.h>
+
+#include <FileSystem.h>
+
+#include <minecraft/mod/ModFolderModel.h>
+#include <minecraft/mod/ResourceFolderModel.h>
+
+#define EXEC_UPDATE_TASK(EXEC, VERIFY)                                                  \
+    QEventLoop loop;                                                                    \
+                                                                                        \
+    connect(&model, &ResourceFolderModel::updateFinished, &loop, &QEventLoop::quit);    \
+                                                                                        \
+    QTimer expire_timer;                                                                \
+    expire_timer.callOnTimeout(&loop, &QEventLoop::quit);                               \
+    expire_timer.setSingleShot(true);                                                   \
+    expire_timer.start(4000);                                                           \
+                                                                                        \
+    VERIFY(EXEC);                                                                       \
+    loop.exec();                                                                        \
+                                                                                        \
+    QVERIFY2(expire_timer.isActive(), "Timer has expired. The update never finished."); \
+    expire_timer.stop();                                                                \
+                                                                                        \
+    disconnect(&model, nullptr, &loop, nullptr);
+
+class ResourceFolderModelBenchmark : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+
+    // a mods folder the size of a big pack's, with names, versions and authors to sort and filter by
+    static void makeModsFolder(const QString& path, int count)
+    {
+        static const QStringList words = { "Applied", "Energistics", "Create", "Botania", "Thermal",
+                                           "Mekanism", "Tinkers", "Refined", "Storage", "Quark" };
+        for (int i = 0; i < count; i++) {
+            auto name = QString("%1 %2 %3").arg(words[i % 10], words[(i / 10) % 10]).arg(i);
+            if (i % 7 == 0)
+                name.prepend("The ");
+            QJsonObject fabricModJson{
+                { "schemaVersion", 1 },
+                { "id", QString("mod%1").arg(i) },
+                { "version", QString("%1.%2.%3").arg(i % 3).arg(i % 17).arg(i) },
+                { "name", name },
+                { "description", QString("Adds %1 things").arg(words[(i / 3) % 10]) },
+                { "authors", QJsonArray{ QString("Author%1").arg(i % 50) } },
+            };
+
+            QuaZip zip(FS::PathCombine(path, QString("mod-%1.jar").arg(i)));
+            QVERIFY(zip.open(QuaZip::mdCreate));
+            QuaZipFile file(&zip);
+            QVERIFY(file.open(QIODevice::WriteOnly, QuaZipNewInfo("fabric.mod.json")));
+            file.write(QJsonDocument(fabricModJson).toJson());
+            file.close();
+            zip.close();
+        }
+    }
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        makeModsFolder(m_dir.path(), 1000);
+    }
+
+    void benchmark_proxySort()
+    {
+        ModFolderModel model(m_dir.path(), nullptr);
+        { EXEC_UPDATE_TASK(model.update(), QVERIFY) }
+        QTRY_VERIFY_WITH_TIMEOUT(std::all_of(model.all().begin(), model.all().end(),
+                                             [](const Resource::Ptr& mod) { return mod->isResolved(); }),
+                                 60000);
+
+        auto* proxy = model.createFilterProxyModel(&model);
+        proxy->setSourceModel(&model);
+        QBENCHMARK
+        {
+            // clicking through the column headers
+            for (auto column : { ModFolderModel::NameColumn, ModFolderModel::VersionColumn, ModFolderModel::ProviderColumn }) {
+                proxy->sort(column, Qt::AscendingOrder);
+                proxy->sort(column, Qt::DescendingOrder);
+            }
+        }
+    }
+
+    void benchmark_proxyFilter()
+    {
+        ModFolderModel model(m_dir.path(), nullptr);
+        { EXEC_UPDATE_TASK(model.update(), QVERIFY) }
+        QTRY_VERIFY_WITH_TIMEOUT(std::all_of(model.all().begin(), model.all().end(),
+                                             [](const Resource::Ptr& mod) { return mod->isResolved(); }),
+                                 60000);
+
+        auto* proxy = model.createFilterProxyModel(&model);
+        proxy->setSourceModel(&model);
+        proxy->setFilterCaseSensitivity(Qt::CaseInsensitive);
+        proxy->sort(ModFolderModel::NameColumn, Qt::AscendingOrder);
+        QBENCHMARK
+        {
+            // typing into the filter box, and clearing it again
+            for (auto filter : { "e", "en", "ene", "ener", "energ", "energi", "energis", "" }) {
+                proxy->setFilterRegularExpression(filter);
+            }
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ResourceFolderModelBenchmark)
+
+#include "ResourceFolderModel_benchmark.moc"
@@ -0,0 +1,69 @@
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <FileSystem.h>
+#include <ZipReader.h>
+#include <minecraft/mod/tasks/LocalDataPackParseTask.h>
+#include <minecraft/mod/tasks/LocalModParseTask.h>
+#include <minecraft/mod/tasks/LocalResourcePackParseTask.h>
+#include <minecraft/mod/tasks/LocalResourceParse.h>
+#include <minecraft/mod/tasks/LocalShaderPackParseTask.h>
+#include <minecraft/mod/tasks/LocalTexturePackParseTask.h>
+#include <minecraft/mod/tasks/LocalWorldSaveParseTask.h>
+
+#include "../ResourceCorpus.h"
+
+class ResourceIdentifyBenchmark : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+    QList<QFileInfo> m_files;
+
+   private slots:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+        QList<PackedResourceType> expected;
+        writeCorpus(m_dir.path(), 20, m_files, expected);
+    }
+
+    // what identifying took before, with every kind of resource parsing the archive in turn
+    void benchmark_validate()
+    {
+        QBENCHMARK
+        {
+            ZipReader::clearCache();
+            int identified = 0;
+            for (auto& file : m_files) {
+                if (ModUtils::validate(file) || ResourcePackUtils::validate(file) || TexturePackUtils::validate(file) ||
+                    DataPackUtils::validate(file) || WorldSaveUtils::validate(file) || ShaderPackUtils::validate(file))
+                    identified++;
+            }
+            QVERIFY(identified > 0);
+        }
+    }
+
+    void benchmark_identify()
+    {
+        QBENCHMARK
+        {
+            ZipReader::clearCache();
+            for (auto& file : m_files) {
+                ResourceUtils::identify(file);
+            }
+        }
+    }
+
+    void benchmark_identifyBatch()
+    {
+        QBENCHMARK
+        {
+            ZipReader::clearCache();
+            ResourceUtils::identify(m_files);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ResourceIdentifyBenchmark)
+
+#include "ResourceIdentify_benchmark.moc"
@@ -0,0 +1,44 @@
+#include <QTest>
+
+#include <VersionProxyModel.h>
+#include <meta/Version.h>
+#include <meta/VersionList.h>
+
+class VersionProxyModelBenchmark : public QObject {
+    Q_OBJECT
+
+   private slots:
+    void benchmark_typing()
+    {
+        // Forge-like builds for a range of Minecraft versions
+        QVector<Meta::Version::Ptr> versions;
+        for (int i = 0; i < 5000; i++) {
+            auto minecraft = QString("1.%1.%2").arg(12 + i / 500).arg(i / 100 % 5);
+            auto name = QString("%1-%2.%3.%4").arg(minecraft).arg(i / 100).arg(i / 10 % 10).arg(i % 10);
+            auto version = std::make_shared<Meta::Version>("net.minecraftforge", name);
+            version->setType(i % 7 == 0 ? "snapshot" : "release");
+            version->setTime(1500000000 + i);
+            version->setRequires({ Meta::Require{ "net.minecraft", minecraft, {} } }, {});
+            versions.append(version);
+        }
+        Meta::VersionList list("net.minecraftforge");
+        list.setVersions(versions);
+
+        VersionProxyModel proxy;
+        proxy.setSourceModel(&list);
+        proxy.setFilter(BaseVersionList::TypeRole, new ExactFilter("release"));
+
+        QBENCHMARK
+        {
+            for (auto search : { "1", "1.", "1.2", "1.20", "1.20.", "1.20.3", "1.20.3-", "1.20.3-4", "1.20.3-43", "1.20.3-43.5" }) {
+                proxy.setSearch(search);
+            }
+            proxy.setSearch("");
+        }
+        QCOMPARE(proxy.rowCount(), 4285);
+    }
+};
+
+QTEST_GUILESS_MAIN(VersionProxyModelBenchmark)
+
+#include "VersionProxyModel_benchmark.moc"